@@ -128,13 +128,28 @@ Geom: Enables logging of geometry-related native code"
         GUILayout.Label("Playback Settings", EditorStyles.boldLabel);
 
         _target.playOnStart = EditorGUILayout.Toggle("Play On Start", _target.playOnStart);
+        _target.openAsync = EditorGUILayout.Toggle("Open Async", _target.openAsync);
+        _target.progressivePreload = EditorGUILayout.Toggle("Progressive Preload", _target.progressivePreload);
+        _target.compressedPreload = EditorGUILayout.Toggle("Compressed Preload", _target.compressedPreload);
+        _target.automaticLoadMode = EditorGUILayout.Toggle("Automatic Load Mode", _target.automaticLoadMode);
+        if (_target.automaticLoadMode)
+        {
+            _target.memoryBudgetMegabytes = EditorGUILayout.IntField("Memory Budget (MB)", _target.memoryBudgetMegabytes);
+        }
         _target.isLooping = EditorGUILayout.Toggle("Is Looping", _target.isLooping);
+        _target.playbackMode = (VolEnums.PlaybackMode) EditorGUILayout.EnumPopup("Playback Mode", _target.playbackMode);
+        if (_target.playbackMode != VolEnums.PlaybackMode.Forward)
+        {
+            _target.reverseCacheMegabytes = EditorGUILayout.IntField("Reverse Cache (MB)", _target.reverseCacheMegabytes);
+        }
         _target.audioOn = EditorGUILayout.Toggle("Audio On", _target.audioOn);
         
         EditorGUILayout.Separator();
         GUILayout.Label("Rendering Settings", EditorStyles.boldLabel);
         _target.material = EditorGUILayout.ObjectField("Material", _target.material, typeof(Material), false) as Material;
         _target.textureShaderId = EditorGUILayout.TextField("Texture Shader ID", _target.textureShaderId);
+        _target.videoTextureFormat = (VolEnums.VideoTextureFormat) EditorGUILayout.EnumPopup("Video Texture Format", _target.videoTextureFormat);
+        _target.renderThreadUpload = EditorGUILayout.Toggle("Render Thread Upload", _target.renderThreadUpload);
         
         EditorGUILayout.Separator();
         _debugFoldout = EditorGUILayout.Foldout(_debugFoldout, "Debug Logging Options", EditorStyles.foldoutHeader);
@@ -193,14 +208,6 @@ Geom: Enables logging of geometry-related native code"
             }
             
         }
-
-        #if UNITY_ANDROID 
-        if (_target.audioOn)
-        {
-            EditorGUILayout.HelpBox("Audio in Android is still a work in progress. " +
-                                    "Audio is disabled in Android builds.", MessageType.Warning, true);
-        }
-        #endif
     }
     
 }
@@ -11,7 +11,7 @@ using System.Runtime.InteropServices;
 using Unity.Collections;
 using UnityEngine;
 using UnityEngine.Experimental.Rendering;
-using UnityEngine.Video;
+using UnityEngine.Rendering;
 
 [RequireComponent(typeof(MeshFilter))]
 [RequireComponent(typeof(MeshRenderer))]
@@ -26,12 +26,31 @@ public class VolPlayer : MonoBehaviour
 
     [Header("Playback Settings")]
     public bool playOnStart = true;
+    // Open the files on a worker thread so the scene doesn't stall while they load. Playback can start once IsOpen is set.
+    public bool openAsync = false;
+    // Load the geometry sequence into memory in the background, so playback starts without waiting for the whole file. Frames not loaded yet are read from disk.
+    public bool progressivePreload = false;
+    // Keep the geometry sequence in memory compressed, for sequences too big to preload. Frames are decompressed as they are read. Overrides Progressive Preload.
+    public bool compressedPreload = false;
+    // Choose between preloading, compressed preloading, memory mapping and streaming from the sequence size and what is left of the memory budget.
+    // Overrides the preload settings above. Geometry memory is trimmed when the OS reports low memory.
+    public bool automaticLoadMode = false;
+    // Memory for geometry sequences, shared by every vologram opened with Automatic Load Mode. 0 for no limit.
+    public int memoryBudgetMegabytes = 512;
     public bool isLooping = true;
+    public VolEnums.PlaybackMode playbackMode = VolEnums.PlaybackMode.Forward;
     public bool audioOn = false;
+    // Memory for video frames decoded ahead when playing backwards. More means fewer decodes per GOP for high-resolution textures.
+    public int reverseCacheMegabytes = 64;
 
     [Header("Rendering Settings")] 
     public Material material;
     public string textureShaderId = "_MainTex";
+    // Compressed formats are encoded on the CPU as frames are decoded, so they upload 6x smaller. Falls back to RGB24 if the GPU can't use them.
+    public VolEnums.VideoTextureFormat videoTextureFormat = VolEnums.VideoTextureFormat.RGB24;
+    // Upload RGB24 video frames on the render thread straight from native memory, instead of copying them on the main thread.
+    // Needs a native plugin built with ENABLE_UNITY_RENDER_FUNCS. Falls back to main thread uploads otherwise.
+    public bool renderThreadUpload = false;
 
     [Header("Debug Logging Options")]
     public VolEnums.LoggingLevel interfaceLoggingLevel = VolEnums.LoggingLevel.None;
@@ -43,9 +62,15 @@ public class VolPlayer : MonoBehaviour
     private int _currentlyLoadedFrameIndex; // Start at -1 so after loading first frame it gets set to 0.
     private int _numFrames;
     private bool _hasVideoTexture;
+    private VolEnums.VideoTextureFormat _videoTextureFormat;
+    private bool _renderThreadUpload;
+    private IntPtr _textureUpdateCallback;
+    private CommandBuffer _textureCommandBuffer;
     // When an animation starts this value is 0. When the last frame is played it is == video duration. On loop it resets to zero.
     private double _animationAccumulatedSeconds;
     private double _secondsPerFrame;
+    private double _lastFrameSeconds;
+    private int _playbackDirection = 1;
     private MeshFilter _meshFilter;
     private MeshRenderer _meshRenderer;
     private ushort[] _keyShortIndices;
@@ -54,13 +79,31 @@ public class VolPlayer : MonoBehaviour
     private IntPtr _colorPtr;
     private VolPluginInterface.VolGeometryData _geometryData;
     private byte[] _meshData;
+    // The native plugin writes each frame's mesh attributes straight into these pinned arrays, which are kept for the whole sequence.
+    private Vector3[] _vertexBuffer;
+    private Vector3[] _normalBuffer;
+    private ushort[] _indexBuffer;
+    private Vector2[] _uvBuffer;
+    private GCHandle[] _geomBufferHandles;
     private int _textureId;
-    private VideoPlayer _audioPlayer;
+    // Audio is decoded natively from the same pass as the video texture, and streamed into this source.
+    private AudioSource _audioSource;
+    private int _audioChannels;
+    private bool _audioPaused;
 
     public bool IsOpen { get; private set; }
+    public bool IsOpening { get; private set; }
     public bool IsPlaying { get; private set; }
     //public int Frame => _currentFrameIndex; // TODO(Anton) have i broken something here?
-    public bool IsMuted => audioOn && _audioPlayer != null && _audioPlayer.GetDirectAudioMute(0);
+    public bool IsMuted => audioOn && _audioSource != null && _audioSource.mute;
+    public VolPluginInterface.VolMemoryUsage MemoryUsage
+    {
+        get
+        {
+            VolPluginInterface.VolGetMemoryUsage(out VolPluginInterface.VolMemoryUsage usage);
+            return usage;
+        }
+    }
     
     /// <summary>
     /// Unity's Start function - called on the first frame
@@ -79,18 +122,22 @@ public class VolPlayer : MonoBehaviour
         }
 #endif
         
-#if UNITY_ANDROID
-        audioOn = false;
-#endif
-        
         if (audioOn)
         {
-            if (!TryGetComponent<VideoPlayer>(out _audioPlayer))
+            if (!TryGetComponent<AudioSource>(out _audioSource))
             {
-                _audioPlayer = gameObject.AddComponent<VideoPlayer>();
+                _audioSource = gameObject.AddComponent<AudioSource>();
             }
+            _audioSource.playOnAwake = false;
         }
         
+        if (openAsync)
+        {
+            // Play() is called when the open completes.
+            OpenAsync();
+            return;
+        }
+
         Open();
         
         if (playOnStart)
@@ -105,15 +152,57 @@ public class VolPlayer : MonoBehaviour
     /// </summary>
     private void Update()
     {
+        if (IsOpening)
+            PollOpen();
         if (!IsPlaying) return;
         
         // Work out the frame index to play based on elapsed animation time. This lets us skip to the correct frame when the player is going slowly.
-        _animationAccumulatedSeconds += Time.deltaTime;
-        int desiredFrameIndex = (int)(_animationAccumulatedSeconds / _secondsPerFrame);
-        // Not enough time has passed to advance to the next frame yet.
-        if ( desiredFrameIndex == _currentlyLoadedFrameIndex ) { return; }
+        // With audio, video and geometry follow the audio clock so they stay in sync with the sound.
+        double audioClock = (_audioSource != null && _audioSource.isPlaying) ? VolPluginInterface.VolGetAudioClock() : -1.0;
+        if (audioClock >= 0.0)
+        {
+            _animationAccumulatedSeconds = audioClock;
+        }
+        else
+        {
+            _animationAccumulatedSeconds += _playbackDirection * Time.deltaTime;
+        }
 
-        if (desiredFrameIndex >= _numFrames )
+        // Playing backwards past the first frame.
+        if (_animationAccumulatedSeconds < 0.0)
+        {
+            if (isLooping && playbackMode == VolEnums.PlaybackMode.PingPong)
+            {
+                _animationAccumulatedSeconds = -_animationAccumulatedSeconds;
+                _playbackDirection = 1;
+            }
+            else if (isLooping)
+            {
+                _animationAccumulatedSeconds += _lastFrameSeconds;
+            }
+            else
+            {
+                IsPlaying = false;
+                Close();
+                return;
+            }
+        }
+
+        // One native call picks the video frame due at this time, reads the geometry frame matching it, and gives back both.
+        if (!VolPluginInterface.VolUpdate(_animationAccumulatedSeconds, true, out VolPluginInterface.VolUpdateResult update))
+        {
+            Debug.LogError("Error reading frame");
+            return;
+        }
+
+        if (update.frame.endOfStream && playbackMode == VolEnums.PlaybackMode.PingPong)
+        {
+            // Turn around at the last frame, and play back towards the start.
+            _animationAccumulatedSeconds = Math.Max(2.0 * _lastFrameSeconds - _animationAccumulatedSeconds, 0.0);
+            _playbackDirection = -1;
+            return;
+        }
+        if (update.frame.endOfStream)
         {
             if (isLooping)
             {
@@ -124,22 +213,147 @@ public class VolPlayer : MonoBehaviour
             }
             return;
         }
-        // --VIDEO TEXTURE--
-        // Always skip video frames to desired frame.
-        ReadVideoFrame(_currentlyLoadedFrameIndex, desiredFrameIndex);
 
-        { // --GEOMETRY--
-            int previousKeyframeIndex = VolPluginInterface.VolGeomFindPreviousKeyframe(desiredFrameIndex);
-            bool desiredIsKeyframe = VolPluginInterface.VolGeomIsKeyframe(desiredFrameIndex);
-            // If our desired frame would jump over its proceeding keyframe, we need to stop and load that first,
-            // unless it is a keyframe itself.
-            bool needToLoadKeyframe = (_currentlyLoadedFrameIndex < previousKeyframeIndex) && !desiredIsKeyframe;
-            if ( needToLoadKeyframe ) { ReadGeomFrame( previousKeyframeIndex); }
-            ReadGeomFrame( desiredFrameIndex);
+        ShowUpdateResult(update);
+    }
+
+    /// <summary>
+    /// Upload the video texture and apply the geometry from a native update result, which carries the geometry data with it
+    /// </summary>
+    private void ShowUpdateResult(VolPluginInterface.VolUpdateResult update)
+    {
+        VolPluginInterface.VolFrameResult result = update.frame;
+        if (_hasVideoTexture && result.videoChanged && result.pixelsPtr != IntPtr.Zero)
+        {
+            _colorPtr = result.pixelsPtr;
+            UploadVideoTexture(result.width, result.height, result.dataSize);
+        }
+
+        if (result.geomChanged && _geomBufferHandles != null)
+        {
+            ApplyGeomBuffers(result);
         }
+        else if (result.geomChanged)
+        {
+            _geometryData = update.geometry;
+            ApplyGeomFrame(_geometryData, result.geomKeyframe ? update.keyGeometry : (VolPluginInterface.VolGeometryData?)null);
+        }
+        _currentlyLoadedFrameIndex = result.frameIndex;
+    }
 
-        // Advance frame
-        _currentlyLoadedFrameIndex = desiredFrameIndex;
+    /// <summary>
+    /// Allocate and pin the arrays the native plugin writes mesh attributes into, and register them for the open sequence.
+    /// The arrays are kept across Restart() as they are already big enough for the sequence.
+    /// </summary>
+    private void PinGeometryBuffers()
+    {
+        long maxSize = VolPluginInterface.VolGeomGetMaxAttribSize();
+        if (maxSize <= 0 || maxSize > int.MaxValue)
+            return;
+
+        int maxBytes = (int)maxSize;
+        if (_vertexBuffer == null || _vertexBuffer.Length * 12 < maxBytes)
+        {
+            _vertexBuffer = new Vector3[(maxBytes + 11) / 12];
+            _normalBuffer = new Vector3[(maxBytes + 11) / 12];
+            _indexBuffer = new ushort[(maxBytes + 1) / 2];
+            _uvBuffer = new Vector2[(maxBytes + 7) / 8];
+        }
+
+        _geomBufferHandles = new[]
+        {
+            GCHandle.Alloc(_vertexBuffer, GCHandleType.Pinned),
+            GCHandle.Alloc(_normalBuffer, GCHandleType.Pinned),
+            GCHandle.Alloc(_indexBuffer, GCHandleType.Pinned),
+            GCHandle.Alloc(_uvBuffer, GCHandleType.Pinned)
+        };
+        int[] capacities = { _vertexBuffer.Length * 12, _normalBuffer.Length * 12, _indexBuffer.Length * 2, _uvBuffer.Length * 8 };
+        if (!VolPluginInterface.VolGeomSetOutputBuffers(_geomBufferHandles[0].AddrOfPinnedObject(), _geomBufferHandles[1].AddrOfPinnedObject(),
+                _geomBufferHandles[2].AddrOfPinnedObject(), _geomBufferHandles[3].AddrOfPinnedObject(), capacities))
+        {
+            UnpinGeometryBuffers();
+        }
+    }
+
+    /// <summary>
+    /// Release the pins on the mesh attribute arrays. The native plugin must have stopped writing into them first
+    /// </summary>
+    private void UnpinGeometryBuffers()
+    {
+        if (_geomBufferHandles == null)
+            return;
+        foreach (GCHandle handle in _geomBufferHandles)
+            handle.Free();
+        _geomBufferHandles = null;
+    }
+
+    /// <summary>
+    /// Set the mesh from the pinned attribute arrays, uploading only the attributes the frame changed
+    /// </summary>
+    private void ApplyGeomBuffers(VolPluginInterface.VolFrameResult result)
+    {
+#if UNITY_EDITOR
+        Mesh mesh = _meshFilter.sharedMesh;
+#else
+        Mesh mesh = _meshFilter.mesh;
+#endif
+        VolEnums.GeomAttribs changed = result.geomAttribsChanged;
+        int vertexCount = result.verticesSize / 12;
+
+        // Frames in a segment share the keyframe's topology, so tracked frames only replace the vertices and normals.
+        bool newTopology = (changed & VolEnums.GeomAttribs.Indices) != 0 || mesh.vertexCount != vertexCount;
+        if (newTopology)
+            mesh.Clear();
+        if ((changed & VolEnums.GeomAttribs.Vertices) != 0 || newTopology)
+            mesh.SetVertices(_vertexBuffer, 0, vertexCount);
+        if (result.normalsSize > 0 && ((changed & VolEnums.GeomAttribs.Normals) != 0 || newTopology))
+            mesh.SetNormals(_normalBuffer, 0, result.normalsSize / 12);
+        if (newTopology)
+        {
+            mesh.SetIndices(_indexBuffer, 0, result.indicesSize / 2, MeshTopology.Triangles, 0);
+            mesh.SetUVs(0, _uvBuffer, 0, result.uvsSize / 8);
+        }
+        mesh.RecalculateBounds();
+        mesh.MarkModified();
+    }
+
+    /// <summary>
+    /// Upload the video texture and apply the geometry from a native frame result, for whichever has changed
+    /// </summary>
+    private void ShowFrameResult(VolPluginInterface.VolFrameResult result)
+    {
+        if (_hasVideoTexture && result.videoChanged && result.pixelsPtr != IntPtr.Zero)
+        {
+            _colorPtr = result.pixelsPtr;
+            UploadVideoTexture(result.width, result.height, result.dataSize);
+        }
+
+        ApplyFrameGeometry(result);
+        _currentlyLoadedFrameIndex = result.frameIndex;
+    }
+
+    /// <summary>
+    /// Apply the geometry from a native frame result to the mesh, if it changed
+    /// </summary>
+    private void ApplyFrameGeometry(VolPluginInterface.VolFrameResult result)
+    {
+        if (!result.geomChanged)
+            return;
+
+        if (_geomBufferHandles != null)
+        {
+            ApplyGeomBuffers(result);
+            return;
+        }
+        _geometryData = VolPluginInterface.VolGeomGetPtrData();
+        if (result.geomKeyframe)
+        {
+            ApplyGeomFrame(_geometryData, VolPluginInterface.VolGeomGetKeyPtrData());
+        }
+        else
+        {
+            ApplyGeomFrame(_geometryData, null);
+        }
     }
 
     /// <summary>
@@ -149,6 +363,7 @@ public class VolPlayer : MonoBehaviour
     {
         _meshFilter = GetComponent<MeshFilter>();
         _meshRenderer = GetComponent<MeshRenderer>();
+        Application.lowMemory += OnLowMemory;
     }
 
     /// <summary>
@@ -156,30 +371,34 @@ public class VolPlayer : MonoBehaviour
     /// </summary>
     private void OnDisable()
     {
+        Application.lowMemory -= OnLowMemory;
         Close();
     }
 
+    /// <summary>
+    /// Called when the OS is running low on memory. Frees some of the geometry's memory without stopping playback
+    /// </summary>
+    private void OnLowMemory()
+    {
+        if (!IsOpen)
+            return;
+        if (VolPluginInterface.VolTrimMemory())
+            Debug.Log($"Trimmed vologram memory, geometry is now {MemoryUsage.geomLoadMode}");
+    }
+
     /// <summary>
     /// Open the given vologram files
     /// </summary>
     /// <returns>True if successful</returns>
     public bool Open()
     {
-        if (IsOpen)
+        if (IsOpen || IsOpening)
         {
             Debug.LogWarning("Cannot open a vologram while another is open");
             return false;
         }
 
-        VolPluginInterface.interfaceLoggingLevel = interfaceLoggingLevel;
-        VolPluginInterface.avLoggingLevel = avLoggingLevel;
-        VolPluginInterface.geomLoggingLevel = geomLoggingLevel;
-        VolPluginInterface.EnableInterfaceLogging();
-        VolPluginInterface.EnableAvLogging();
-        VolPluginInterface.EnableGeomLogging();
-
-        _hasVideoTexture = !string.IsNullOrEmpty(volVideoTexture);
-        _fullVideoPath = volVideoTexturePathType.ResolvePath(volVideoTexture);
+        PrepareOpen();
 
         if (_hasVideoTexture)
         {
@@ -192,35 +411,9 @@ public class VolPlayer : MonoBehaviour
             }
         }
 
-        if (audioOn)
-        {
-            _audioPlayer.Stop();
-            _audioPlayer.sendFrameReadyEvents = true;
-            _audioPlayer.source = VideoSource.Url;
-            _audioPlayer.url = _fullVideoPath;
-            
-            _audioPlayer.frameReady -= AudioVideoPlayerOnFrameReady;
-            _audioPlayer.frameReady += AudioVideoPlayerOnFrameReady;
-            _audioPlayer.loopPointReached -= AudioVideoPlayerOnLoopPointReached;
-            _audioPlayer.loopPointReached += AudioVideoPlayerOnLoopPointReached;
-            _audioPlayer.prepareCompleted -= AudioVideoPlayerOnPrepareCompleted;
-            _audioPlayer.prepareCompleted += AudioVideoPlayerOnPrepareCompleted;
-            _audioPlayer.errorReceived -= AudioVideoPlayerOnErrorReceived;
-            _audioPlayer.errorReceived += AudioVideoPlayerOnErrorReceived;
-            
-            _audioPlayer.renderMode = VideoRenderMode.APIOnly;
-            _audioPlayer.audioOutputMode = VideoAudioOutputMode.Direct;
-            _audioPlayer.EnableAudioTrack(0, true);
-            _audioPlayer.SetDirectAudioVolume(0, 1f);
-            _audioPlayer.SetDirectAudioMute(0, false);
-            _audioPlayer.controlledAudioTrackCount = 1;
-            _audioPlayer.Prepare();
-        }
-
-        _fullGeomPath = volFolderPathType.ResolvePath(volFolder);
         string headerFile = Path.Combine(_fullGeomPath, "header.vols");
         string sequenceFile = Path.Combine(_fullGeomPath, "sequence_0.vols");
-        bool geomOpened = VolPluginInterface.VolGeomOpenFile(headerFile, sequenceFile, true);
+        bool geomOpened = OpenGeomFile(headerFile, sequenceFile);
         
         if (!geomOpened)
         {
@@ -231,17 +424,153 @@ public class VolPlayer : MonoBehaviour
             return false;
         }
 
+        CompleteOpen();
+        return true;
+    }
+
+    /// <summary>
+    /// Open the geometry files, streamed, progressively pre-loaded, or pre-loaded compressed as set by Progressive Preload and Compressed Preload,
+    /// or as chosen from the memory budget by Automatic Load Mode
+    /// </summary>
+    /// <returns>True if successful</returns>
+    private bool OpenGeomFile(string headerFile, string sequenceFile)
+    {
+        switch (GeomLoadMode())
+        {
+            case VolEnums.GeomLoadMode.Auto:
+                return VolPluginInterface.VolGeomOpenFileAuto(headerFile, sequenceFile);
+            case VolEnums.GeomLoadMode.PreloadCompressed:
+                return VolPluginInterface.VolGeomOpenFileCompressed(headerFile, sequenceFile);
+            case VolEnums.GeomLoadMode.Progressive:
+                return VolPluginInterface.VolGeomOpenFileProgressive(headerFile, sequenceFile);
+            default:
+                return VolPluginInterface.VolGeomOpenFile(headerFile, sequenceFile, true);
+        }
+    }
+
+    /// <summary>
+    /// The load mode set by Automatic Load Mode, Compressed Preload and Progressive Preload, or streaming.
+    /// With Automatic Load Mode, this also sets the memory budget the mode is chosen from
+    /// </summary>
+    private VolEnums.GeomLoadMode GeomLoadMode()
+    {
+        if (automaticLoadMode)
+        {
+            VolPluginInterface.VolSetMemoryBudget((long)memoryBudgetMegabytes * 1024 * 1024);
+            return VolEnums.GeomLoadMode.Auto;
+        }
+        if (compressedPreload)
+            return VolEnums.GeomLoadMode.PreloadCompressed;
+        if (progressivePreload)
+            return VolEnums.GeomLoadMode.Progressive;
+        return VolEnums.GeomLoadMode.Streaming;
+    }
+
+    /// <summary>
+    /// Start opening the given vologram files on a worker thread, so the calling frame doesn't stall on loading them.
+    /// The geometry is loaded in the same mode as Open() would use.
+    /// IsOpening is set until the open completes in a later Update(), when IsOpen is set and playback starts if Play On Start is set.
+    /// </summary>
+    /// <returns>True if the open was started</returns>
+    public bool OpenAsync()
+    {
+        if (IsOpen || IsOpening)
+        {
+            Debug.LogWarning("Cannot open a vologram while another is open");
+            return false;
+        }
+
+        PrepareOpen();
+
+        string headerFile = Path.Combine(_fullGeomPath, "header.vols");
+        string sequenceFile = Path.Combine(_fullGeomPath, "sequence_0.vols");
+        if (!VolPluginInterface.VolOpenAsync(headerFile, sequenceFile, GeomLoadMode(), _hasVideoTexture ? _fullVideoPath : null, false))
+        {
+            Debug.LogError("Could not start opening the vologram");
+            return false;
+        }
+        IsOpening = true;
+        return true;
+    }
+
+    /// <summary>
+    /// Stop an open started by OpenAsync(), and close whatever it opened. Waits for the worker thread to finish the file it is opening
+    /// </summary>
+    public void CancelOpen()
+    {
+        if (!IsOpening)
+            return;
+        VolPluginInterface.VolCancelOpen();
+        IsOpening = false;
+    }
+
+    /// <summary>
+    /// Check on an open started by OpenAsync(), and complete it once the files are open
+    /// </summary>
+    private void PollOpen()
+    {
+        VolEnums.OpenStatus status = VolPluginInterface.VolPollOpen();
+        if (status == VolEnums.OpenStatus.Pending)
+            return;
+
+        IsOpening = false;
+        if (status != VolEnums.OpenStatus.Ready)
+        {
+            Debug.LogError("Failed to open the vologram");
+            return;
+        }
+        CompleteOpen();
+        if (playOnStart)
+            Play();
+    }
+
+    /// <summary>
+    /// Set up logging and resolve the paths, before the files are opened
+    /// </summary>
+    private void PrepareOpen()
+    {
+        VolPluginInterface.interfaceLoggingLevel = interfaceLoggingLevel;
+        VolPluginInterface.avLoggingLevel = avLoggingLevel;
+        VolPluginInterface.geomLoggingLevel = geomLoggingLevel;
+        VolPluginInterface.EnableInterfaceLogging();
+        VolPluginInterface.EnableAvLogging();
+        VolPluginInterface.EnableGeomLogging();
+
+        _hasVideoTexture = !string.IsNullOrEmpty(volVideoTexture);
+        _videoTextureFormat = VolEnums.VideoTextureFormat.RGB24;
+        _renderThreadUpload = false;
+        _fullVideoPath = volVideoTexturePathType.ResolvePath(volVideoTexture);
+        _fullGeomPath = volFolderPathType.ResolvePath(volFolder);
+    }
+
+    /// <summary>
+    /// Set up playback, the texture and the material once the files are open
+    /// </summary>
+    private void CompleteOpen()
+    {
+        if (_hasVideoTexture)
+        {
+            SetReverseCache();
+            _videoTextureFormat = videoTextureFormat;
+            SetVideoTextureFormat();
+            SetRenderThreadUpload();
+        }
+
+        OpenAudio();
+
+        PinGeometryBuffers();
         _currentlyLoadedFrameIndex = -1;
-        _animationAccumulatedSeconds = 0f;
         _numFrames = VolPluginInterface.VolGeomGetFrameCount();
         double fps = VolPluginInterface.VolGetFrameRate();
         if ( 0.0 == fps ) { fps = 30.0; }
         _secondsPerFrame = 1f / fps; // TODO(Anton) -- we should fetch this from vol_av rather than rely on 30fps.
+        _lastFrameSeconds = Math.Max(_numFrames - 1, 0) * _secondsPerFrame;
+        ResetPlaybackPosition();
 
         _voloTexture = new Texture2D(
             VolPluginInterface.VolGetVideoWidth(),
             VolPluginInterface.VolGetVideoHeight(), 
-            TextureFormat.RGB24, false, false);
+            UnityTextureFormat(_videoTextureFormat), false, false);
 
         _textureId = Shader.PropertyToID(textureShaderId);
 
@@ -288,7 +617,6 @@ public class VolPlayer : MonoBehaviour
         
         IsOpen = true;
         //VolPluginInterface.InitCommandBuffer();
-        return true;
     }
     
     /// <summary>
@@ -297,18 +625,20 @@ public class VolPlayer : MonoBehaviour
     /// <returns>True if successful</returns>
     public bool Close()
     {
+        CancelOpen();
         if (!IsOpen) 
             return false;
         
         IsPlaying = false;
+        // Stop pulling audio before the file it is read from is closed.
+        CloseAudio();
         bool closedVideo = VolPluginInterface.VolCloseFile();
         bool freedGeom = VolPluginInterface.VolFreeGeomData();
+        UnpinGeometryBuffers();
         IsOpen = false;
-
-        if (audioOn)
-        {
-            _audioPlayer.Stop();
-        }
+        _renderThreadUpload = false;
+        _textureCommandBuffer?.Release();
+        _textureCommandBuffer = null;
         
         VolPluginInterface.ClearLoggingFunctions();
         
@@ -325,9 +655,17 @@ public class VolPlayer : MonoBehaviour
         
         IsPlaying = true;
 
-        if (audioOn && _audioPlayer != null)
+        if (_audioSource != null && _audioSource.clip != null)
         {
-            _audioPlayer.Play();
+            if (_audioPaused)
+            {
+                _audioSource.UnPause();
+            }
+            else
+            {
+                _audioSource.Play();
+            }
+            _audioPaused = false;
         }
     }
 
@@ -341,9 +679,10 @@ public class VolPlayer : MonoBehaviour
         
         IsPlaying = false;
         
-        if (audioOn && _audioPlayer != null)
+        if (_audioSource != null && _audioSource.isPlaying)
         {
-            _audioPlayer.Pause();
+            _audioSource.Pause();
+            _audioPaused = true;
         }
     }
 
@@ -368,11 +707,15 @@ public class VolPlayer : MonoBehaviour
                 IsOpen = false;
                 return false;
             }
+            SetReverseCache();
+            SetVideoTextureFormat();
+            SetRenderThreadUpload();
         }
+        OpenAudio();
 
         string headerFile = Path.Combine(_fullGeomPath, "header.vols");
         string sequenceFile = Path.Combine(_fullGeomPath, "sequence_0.vols");
-        bool geomOpened = VolPluginInterface.VolGeomOpenFile(headerFile, sequenceFile, true);
+        bool geomOpened = OpenGeomFile(headerFile, sequenceFile);
         
         if (!geomOpened)
         {
@@ -382,8 +725,9 @@ public class VolPlayer : MonoBehaviour
             return false;
         }
 
+        PinGeometryBuffers();
         _currentlyLoadedFrameIndex = -1;
-        _animationAccumulatedSeconds = 0f;
+        ResetPlaybackPosition();
 
         IsOpen = true;
         if (playOnStart)
@@ -391,6 +735,110 @@ public class VolPlayer : MonoBehaviour
         return true;
     }
 
+    /// <summary>
+    /// Pause and show a quick preview of the vologram at a time, for dragging a timeline scrubber.
+    /// Only video and geometry keyframes are decoded, so the preview is the nearest keyframe at or before the time.
+    /// Play() carries on from the previewed time at full quality.
+    /// </summary>
+    /// <param name="seconds">Time from the start of the vologram</param>
+    /// <param name="scaleLevel">Video preview size: 0 for full, 1 for half, or 2 for quarter width and height</param>
+    /// <param name="maxLatencySeconds">Time limit for decoding when dragging forwards</param>
+    /// <returns>True if successful</returns>
+    public bool Scrub(double seconds, int scaleLevel = 1, double maxLatencySeconds = 0.03)
+    {
+        if (!IsOpen)
+            return false;
+
+        Pause();
+        _animationAccumulatedSeconds = Math.Min(Math.Max(seconds, 0.0), _lastFrameSeconds);
+        if (!VolPluginInterface.VolScrubToTime(_animationAccumulatedSeconds, true, scaleLevel, maxLatencySeconds, out VolPluginInterface.VolFrameResult result))
+        {
+            Debug.LogError("Error reading scrub preview");
+            return false;
+        }
+
+        ShowFrameResult(result);
+        return true;
+    }
+
+    /// <summary>
+    /// Go to the first frame to be played, which is the last frame when playing in reverse
+    /// </summary>
+    private void ResetPlaybackPosition()
+    {
+        bool reverse = playbackMode == VolEnums.PlaybackMode.Reverse;
+        _animationAccumulatedSeconds = reverse ? _lastFrameSeconds : 0.0;
+        _playbackDirection = reverse ? -1 : 1;
+    }
+
+    /// <summary>
+    /// Ask the video decoder for frames in the texture format chosen when the vologram was opened, if the GPU can use it
+    /// </summary>
+    private void SetVideoTextureFormat()
+    {
+        if (_videoTextureFormat == VolEnums.VideoTextureFormat.RGB24)
+            return;
+        if (!SystemInfo.SupportsTextureFormat(UnityTextureFormat(_videoTextureFormat)) ||
+            !VolPluginInterface.VolSetVideoTextureFormat((int)_videoTextureFormat))
+        {
+            Debug.LogWarning($"Video texture format {_videoTextureFormat} is not available. Using RGB24");
+            _videoTextureFormat = VolEnums.VideoTextureFormat.RGB24;
+        }
+    }
+
+    /// <summary>
+    /// Have video frames decoded into native buffers that the render thread uploads from, if the plugin supports it
+    /// </summary>
+    private void SetRenderThreadUpload()
+    {
+        _renderThreadUpload = false;
+        if (!renderThreadUpload || _videoTextureFormat != VolEnums.VideoTextureFormat.RGB24)
+            return;
+        try
+        {
+            _textureUpdateCallback = VolPluginInterface.VolGetTextureUpdateCallback();
+        }
+        catch (EntryPointNotFoundException)
+        {
+            _textureUpdateCallback = IntPtr.Zero;
+        }
+        if (_textureUpdateCallback == IntPtr.Zero || !VolPluginInterface.VolSetRenderThreadUpload(true))
+        {
+            Debug.LogWarning("Render thread upload is not available in this build of the native plugin. Uploading on the main thread");
+            return;
+        }
+        _renderThreadUpload = true;
+        if (_textureCommandBuffer == null)
+            _textureCommandBuffer = new CommandBuffer { name = "Vologram texture update" };
+    }
+
+    /// <summary>
+    /// The Unity texture format matching a video texture format
+    /// </summary>
+    private static TextureFormat UnityTextureFormat(VolEnums.VideoTextureFormat format)
+    {
+        switch (format)
+        {
+            case VolEnums.VideoTextureFormat.BC1:
+                return TextureFormat.DXT1;
+            case VolEnums.VideoTextureFormat.ETC2_RGB:
+                return TextureFormat.ETC2_RGB;
+            case VolEnums.VideoTextureFormat.RGB24:
+            default:
+                return TextureFormat.RGB24;
+        }
+    }
+
+    /// <summary>
+    /// Give the video decoder memory to play backwards with, if this vologram can be
+    /// </summary>
+    private void SetReverseCache()
+    {
+        if (playbackMode == VolEnums.PlaybackMode.Forward)
+            return;
+        VolPluginInterface.VolSetVideoReverseCacheSize((long)Math.Max(reverseCacheMegabytes, 0) * 1024 * 1024);
+    }
+
     /// <summary>
     /// (EXPERIMENTAL) Move forward one frame
     /// </summary>
@@ -410,6 +858,13 @@ public class VolPlayer : MonoBehaviour
             }
             return;
         }
+        // Compressed frames, and frames for the render thread, are only given by the timestamp-driven read.
+        if (_videoTextureFormat != VolEnums.VideoTextureFormat.RGB24 || _renderThreadUpload)
+        {
+            if (VolPluginInterface.VolReadFrameAtTime(desiredFrameIndex * _secondsPerFrame, true, out VolPluginInterface.VolFrameResult result))
+                ShowFrameResult(result);
+            return;
+        }
         // Always skip video frames to desired frame.
         ReadVideoFrame(_currentlyLoadedFrameIndex, desiredFrameIndex);
         ReadGeomFrame(desiredFrameIndex);
@@ -421,9 +876,9 @@ public class VolPlayer : MonoBehaviour
     /// <param name="mute">Value for mute</param>
     public void SetMute(bool mute)
     {
-        if (audioOn && _audioPlayer != null)
+        if (audioOn && _audioSource != null)
         {
-            _audioPlayer.SetDirectAudioMute(0, mute);
+            _audioSource.mute = mute;
         }
     }
 
@@ -548,15 +1003,44 @@ public class VolPlayer : MonoBehaviour
         }
         // This is the frame we want, and we vertically flip this too.
         _colorPtr = VolPluginInterface.VolReadNextVideoFrame(true);
-        { // Upload only the texture from the desired frame to the GPU via Unity.
-            _voloTexture.LoadRawTextureData(_colorPtr, (int) VolPluginInterface.VolGetFrameSize());
+        int width = VolPluginInterface.VolGetVideoWidth();
+        int height = VolPluginInterface.VolGetVideoHeight();
+        UploadVideoTexture(width, height, (long)width * height * 3);
+    }
+
+    /// <summary>
+    /// Upload the image at _colorPtr to the GPU via Unity
+    /// </summary>
+    /// <param name="width">Width of the image, which is smaller than the video's for scrub previews</param>
+    /// <param name="height">Height of the image</param>
+    /// <param name="dataSize">Size of the image in bytes, which is smaller than width * height * 3 for compressed formats</param>
+    private void UploadVideoTexture(int width, int height, long dataSize)
+    {
+        if (_voloTexture.width != width || _voloTexture.height != height)
+        {
+#if UNITY_2021_2_OR_NEWER
+            _voloTexture.Reinitialize(width, height, _voloTexture.format, false);
+#else
+            _voloTexture.Resize(width, height, _voloTexture.format, false);
+#endif
+        }
+        if (_renderThreadUpload)
+        {
+            // The render thread copies the newest decoded frame into the texture, so there is nothing to copy here.
+            _textureCommandBuffer.IssuePluginCustomTextureUpdateV2(_textureUpdateCallback, _voloTexture, 0);
+            Graphics.ExecuteCommandBuffer(_textureCommandBuffer);
+            _textureCommandBuffer.Clear();
+        }
+        else
+        {
+            _voloTexture.LoadRawTextureData(_colorPtr, (int)dataSize);
             _voloTexture.Apply();
+        }
 #if UNITY_EDITOR
-            _meshRenderer.sharedMaterial.SetTexture(_textureId, _voloTexture);
+        _meshRenderer.sharedMaterial.SetTexture(_textureId, _voloTexture);
 #else
-            _meshRenderer.material.SetTexture(_textureId, _voloTexture);
+        _meshRenderer.material.SetTexture(_textureId, _voloTexture);
 #endif
-        }
     }
 
     /// <summary>
@@ -576,13 +1060,47 @@ public class VolPlayer : MonoBehaviour
         }
         
         _geometryData = VolPluginInterface.VolGeomGetPtrData();
+        if (isKeyframe)
+        {
+            ApplyGeomFrame(_geometryData, _geometryData);
+        }
+        else
+        {
+            ApplyGeomFrame(_geometryData, null);
+        }
+    }
 
-        if (_geometryData.blockDataSize == 0)
+    /// <summary>
+    /// Copy a frame's geometry data into the mesh
+    /// </summary>
+    /// <param name="frameData">The frame's vertices and normals</param>
+    /// <param name="keyData">The keyframe's indices and UVs if they changed, otherwise null to keep the current ones</param>
+    private void ApplyGeomFrame(VolPluginInterface.VolGeometryData frameData, VolPluginInterface.VolGeometryData? keyData)
+    {
+        if (frameData.blockDataSize == 0)
             return;
 
+        // The keyframe's data may be in a separate block, so take its indices and UVs first.
+        if (keyData.HasValue && keyData.Value.blockDataSize > 0)
+        {
+            VolPluginInterface.VolGeometryData key = keyData.Value;
+            byte[] keyMeshData = new byte[key.blockDataSize];
+            Marshal.Copy(key.blockDataPtr, keyMeshData, 0, (int)key.blockDataSize);
+            NativeArray<byte> nativeKeyData = new NativeArray<byte>(keyMeshData, Allocator.Temp);
+            if (key.indicesSize > 0)
+            {
+                _keyShortIndices = nativeKeyData.Slice((int) key.indicesOffset, key.indicesSize).SliceConvert<ushort>().ToArray();
+            }
+            if (key.uvSize > 0)
+            {
+                _keyUvs = nativeKeyData.Slice((int) key.uvOffset, key.uvSize).SliceConvert<Vector2>().ToArray();
+            }
+            nativeKeyData.Dispose();
+        }
+
         // TODO(Anton) maybe can remove a memcopy here with a cast/pointer? 
-        _meshData = new byte[_geometryData.blockDataSize];
-        Marshal.Copy(_geometryData.blockDataPtr, _meshData, 0, (int)_geometryData.blockDataSize);
+        _meshData = new byte[frameData.blockDataSize];
+        Marshal.Copy(frameData.blockDataPtr, _meshData, 0, (int)frameData.blockDataSize);
         NativeArray<byte> nativeMeshData = new NativeArray<byte>(_meshData, Allocator.Temp);
 
 #if UNITY_EDITOR
@@ -592,7 +1110,7 @@ public class VolPlayer : MonoBehaviour
 #endif
         
         NativeSlice<Vector3> verticesSlice =
-            nativeMeshData.Slice((int)_geometryData.verticesOffset, _geometryData.verticesSize).SliceConvert<Vector3>();
+            nativeMeshData.Slice((int)frameData.verticesOffset, frameData.verticesSize).SliceConvert<Vector3>();
         
 #if UNITY_EDITOR
         _meshFilter.sharedMesh.SetVertices(verticesSlice.ToArray());
@@ -600,47 +1118,26 @@ public class VolPlayer : MonoBehaviour
         _meshFilter.mesh.SetVertices(verticesSlice.ToArray());
 #endif
 
-        if (_geometryData.normalSize > 0)
+        if (frameData.normalSize > 0)
         {
             NativeSlice<Vector3> normalsSlice = nativeMeshData
-                .Slice((int) _geometryData.normalOffset, _geometryData.normalSize).SliceConvert<Vector3>();
+                .Slice((int) frameData.normalOffset, frameData.normalSize).SliceConvert<Vector3>();
 #if UNITY_EDITOR
             _meshFilter.sharedMesh.SetNormals(normalsSlice.ToArray());
 #else
             _meshFilter.mesh.SetNormals(normalsSlice.ToArray());
 #endif
         }
-        // TODO(Anton) - Patrick please check this, I was hoping to skip some updates here
-        isKeyframe = true; // HACK(Anton) ... but it didn't work.
- 
-        if ( isKeyframe && _geometryData.indicesSize > 0)
-        {
-            NativeSlice<ushort> indicesSlice =
-                nativeMeshData.Slice((int) _geometryData.indicesOffset, _geometryData.indicesSize).SliceConvert<ushort>();
-            _keyShortIndices = indicesSlice.ToArray();
-        }
-
-        if ( isKeyframe ) {
-#if UNITY_EDITOR
-            _meshFilter.sharedMesh.SetIndices(_keyShortIndices, MeshTopology.Triangles, 0);
-#else
-            _meshFilter.mesh.SetIndices(_keyShortIndices, MeshTopology.Triangles, 0);
-#endif
-        }
 
-        if ( isKeyframe && _geometryData.uvSize > 0)
-        {
-            NativeSlice<Vector2> uvSlice = nativeMeshData.Slice((int) _geometryData.uvOffset, _geometryData.uvSize)
-                .SliceConvert<Vector2>();
-            _keyUvs = uvSlice.ToArray();
-        }
-        
+        // Clear() dropped the indices and UVs, so the keyframe's are set again on every frame.
 #if UNITY_EDITOR
-        if ( isKeyframe ) { _meshFilter.sharedMesh.SetUVs(0, _keyUvs); } // TODO(Anton) check this if statement makes sense.
+        _meshFilter.sharedMesh.SetIndices(_keyShortIndices, MeshTopology.Triangles, 0);
+        _meshFilter.sharedMesh.SetUVs(0, _keyUvs);
         _meshFilter.sharedMesh.RecalculateBounds();
         _meshFilter.sharedMesh.MarkModified();
 #else 
-        if ( isKeyframe ) { _meshFilter.mesh.SetUVs(0, _keyUvs); } // TODO(Anton) check this if statement makes sense.
+        _meshFilter.mesh.SetIndices(_keyShortIndices, MeshTopology.Triangles, 0);
+        _meshFilter.mesh.SetUVs(0, _keyUvs);
         _meshFilter.mesh.RecalculateBounds();
         _meshFilter.mesh.MarkModified();
 #endif
@@ -662,24 +1159,56 @@ public class VolPlayer : MonoBehaviour
 #endif
     }
 
-    private void AudioVideoPlayerOnErrorReceived(VideoPlayer source, string message)
+    /// <summary>
+    /// Set up streaming of the audio decoded alongside the video texture, if audio is on and the video has any
+    /// </summary>
+    private void OpenAudio()
     {
-        Debug.LogError(message);
-    }
+        if (!_hasVideoTexture)
+            return;
 
-    private void AudioVideoPlayerOnPrepareCompleted(VideoPlayer source)
-    {
-        source.Play();
-        Play();
+        // Skip decoding the audio entirely if it won't be played. Audio can't be played backwards, so it is only played going forwards.
+        bool playAudio = audioOn && playbackMode == VolEnums.PlaybackMode.Forward;
+        VolPluginInterface.VolSetAudioEnabled(playAudio);
+        if (!playAudio || _audioSource == null || !VolPluginInterface.VolHasAudio())
+            return;
+
+        int sampleRate = VolPluginInterface.VolGetAudioSampleRate();
+        _audioChannels = VolPluginInterface.VolGetAudioChannels();
+        int lengthSamples = Math.Max((int)(VolPluginInterface.VolGetDuration() * sampleRate), sampleRate);
+        _audioSource.clip = AudioClip.Create("VologramAudio", lengthSamples, _audioChannels, sampleRate, true, OnAudioRead);
+        _audioPaused = false;
     }
 
-    private void AudioVideoPlayerOnLoopPointReached(VideoPlayer source)
+    /// <summary>
+    /// Stop the audio and release its clip
+    /// </summary>
+    private void CloseAudio()
     {
-        Restart();
+        if (_audioSource == null)
+            return;
+
+        _audioSource.Stop();
+        if (_audioSource.clip != null)
+        {
+            Destroy(_audioSource.clip);
+            _audioSource.clip = null;
+        }
+        _audioChannels = 0;
+        _audioPaused = false;
     }
 
-    private void AudioVideoPlayerOnFrameReady(VideoPlayer source, long frameidx)
+    /// <summary>
+    /// Unity's streaming audio callback - copies the next block of decoded samples from the native audio ring
+    /// </summary>
+    /// <param name="data">Interleaved samples to fill</param>
+    private void OnAudioRead(float[] data)
     {
-
+        if (_audioChannels <= 0)
+        {
+            Array.Clear(data, 0, data.Length);
+            return;
+        }
+        VolPluginInterface.VolReadAudio(data, data.Length / _audioChannels);
     }
 }
@@ -94,6 +94,64 @@ public static class VolEnums
         return PathType.Absolute;
     }
 
+    /// <summary>
+    /// The direction a vologram is played in
+    /// </summary>
+    public enum PlaybackMode
+    {
+        Forward,
+        Reverse,
+        PingPong    // Forward to the end, then backwards to the start
+    }
+
+    /// <summary>
+    /// The format video frames are uploaded to the GPU in. Matches vol_av_texture_format_t in the native plugin
+    /// </summary>
+    public enum VideoTextureFormat
+    {
+        RGB24,      // Uncompressed
+        BC1,        // DXT1, for desktop GPUs. 6x smaller than RGB24
+        ETC2_RGB    // For mobile GPUs. 6x smaller than RGB24
+    }
+
+    /// <summary>
+    /// Progress of an asynchronous open. Matches vol_interface_open_status_t in the native plugin
+    /// </summary>
+    public enum OpenStatus
+    {
+        None,
+        Pending,
+        Ready,
+        Failed,
+        Cancelled
+    }
+
+    /// <summary>
+    /// How a vologram's geometry sequence is held in memory. Matches vol_geom_load_mode_t in the native plugin
+    /// </summary>
+    public enum GeomLoadMode
+    {
+        Streaming,
+        Preload,
+        Progressive,
+        PreloadCompressed,
+        Mapped,
+        Auto        // Chosen from the memory budget when opening. Never reported by VolGetMemoryUsage
+    }
+
+    /// <summary>
+    /// The mesh attribute arrays a geometry frame wrote into the registered buffers. Matches vol_geom_attrib_flags_t in the native plugin
+    /// </summary>
+    [Flags]
+    public enum GeomAttribs
+    {
+        None = 0,
+        Vertices = 1,
+        Normals = 1 << 1,
+        Indices = 1 << 2,
+        Uvs = 1 << 3
+    }
+
     /// <summary>
     /// Refers to the type of log messages that the native code sends to Unity
     /// Is aligned with the `vol_geom_log_type_t` and `vol_av_log_type_t` enums
@@ -55,6 +55,57 @@ public class VolPluginInterface
         }
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VolFrameResult
+    {
+        public IntPtr pixelsPtr;
+        public double ptsSeconds;
+        public int frameIndex;
+        [MarshalAs(UnmanagedType.I1)] public bool videoChanged;
+        [MarshalAs(UnmanagedType.I1)] public bool geomChanged;
+        [MarshalAs(UnmanagedType.I1)] public bool geomKeyframe;
+        [MarshalAs(UnmanagedType.I1)] public bool endOfStream;
+        public int width;
+        public int height;
+        public long dataSize;
+        // The arrays written into the buffers registered with VolGeomSetOutputBuffers, and their sizes in bytes
+        public VolEnums.GeomAttribs geomAttribsChanged;
+        public int verticesSize;
+        public int normalsSize;
+        public int indicesSize;
+        public int uvsSize;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VolUpdateResult
+    {
+        public VolFrameResult frame;
+        // Only valid when frame.geomChanged is set
+        public VolGeometryData geometry;
+        // Only valid when frame.geomKeyframe is set
+        public VolGeometryData keyGeometry;
+    }
+
+    // Sizes in bytes of the memory held by the open vologram
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VolMemoryUsage
+    {
+        public VolEnums.GeomLoadMode geomLoadMode;
+        // The geometry directory and sequence are shared with other players of the same vologram
+        [MarshalAs(UnmanagedType.I1)] public bool geomShared;
+        public long geomDirectorySize;
+        public long geomFrameBlobsSize;
+        // Pre-loaded or compressed sequence, which counts against the memory budget
+        public long geomSequenceSize;
+        // Memory-mapped sequence file, of which only the pages in use are resident
+        public long geomMappedSize;
+        public long videoSize;
+        // Geometry sequence memory of every open vologram
+        public long budgetUsedSize;
+        // Decoders and frames of every video opened for instances, counted once however many instances share them
+        public long sharedVideoSize;
+    }
+
 #if UNITY_EDITOR_WIN || UNITY_STANDALONE_WIN
     [UnmanagedFunctionPointer(CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
 #else
@@ -78,6 +129,32 @@ public class VolPluginInterface
     [DllImport(DLL, EntryPoint = "native_vol_open_geom_file")]
     public static extern bool VolGeomOpenFile(string headerFile, string sequenceFile, bool streamingMode);
 
+    [DllImport(DLL, EntryPoint = "native_vol_open_geom_file_progressive")]
+    public static extern bool VolGeomOpenFileProgressive(string headerFile, string sequenceFile);
+
+    [DllImport(DLL, EntryPoint = "native_vol_open_geom_file_compressed")]
+    public static extern bool VolGeomOpenFileCompressed(string headerFile, string sequenceFile);
+
+    // Pre-loads, compresses, maps or streams the sequence, whichever fits in what is left of the memory budget
+    [DllImport(DLL, EntryPoint = "native_vol_open_geom_file_auto")]
+    public static extern bool VolGeomOpenFileAuto(string headerFile, string sequenceFile);
+
+    [DllImport(DLL, EntryPoint = "native_vol_open_geom_memory")]
+    public static extern bool VolGeomOpenMemory(byte[] header, long headerSize, byte[] sequence, long sequenceSize);
+
+    // Geometry and video of a packed vologram, from one file
+    [DllImport(DLL, EntryPoint = "native_vol_open_packed_file")]
+    public static extern bool VolOpenPackedFile(string packFile);
+
+    [DllImport(DLL, EntryPoint = "native_vol_enable_geom_readahead")]
+    public static extern bool VolGeomEnableReadahead(int depth, bool directIO);
+
+    [DllImport(DLL, EntryPoint = "native_vol_resolve_geom_frame_sections")]
+    public static extern bool VolGeomResolveFrameSections();
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_geom_frames_in_memory")]
+    public static extern int VolGeomGetFramesInMemory();
+
     [DllImport(DLL, EntryPoint = "native_vol_free_geom_data")]
     public static extern bool VolFreeGeomData();
 
@@ -93,13 +170,44 @@ public class VolPluginInterface
     [DllImport(DLL, EntryPoint = "native_vol_geom_find_previous_keyframe")]
     public static extern int VolGeomFindPreviousKeyframe(int frame);
 
+    [DllImport(DLL, EntryPoint = "native_vol_geom_find_reverse_keyframe")]
+    public static extern int VolGeomFindReverseKeyframe(int frame);
+
     [DllImport(DLL, EntryPoint = "native_vol_get_geom_ptr_data")]
     public static extern VolGeometryData VolGeomGetPtrData();
 
+    [DllImport(DLL, EntryPoint = "native_vol_get_geom_key_ptr_data")]
+    public static extern VolGeometryData VolGeomGetKeyPtrData();
+
+    [DllImport(DLL, EntryPoint = "native_vol_set_geom_output_buffers")]
+    public static extern bool VolGeomSetOutputBuffers(IntPtr vertices, IntPtr normals, IntPtr indices, IntPtr uvs, int[] capacities);
+
+    [DllImport(DLL, EntryPoint = "native_vol_clear_geom_output_buffers")]
+    public static extern void VolGeomClearOutputBuffers();
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_geom_max_attrib_size")]
+    public static extern long VolGeomGetMaxAttribSize();
+
+    // Asynchronous open of both the geometry and video files
+    [DllImport(DLL, EntryPoint = "native_vol_open_async")]
+    public static extern bool VolOpenAsync(string headerFile, string sequenceFile, VolEnums.GeomLoadMode loadMode, string videoFile, bool preloadVideo);
+
+    [DllImport(DLL, EntryPoint = "native_vol_poll_open")]
+    public static extern VolEnums.OpenStatus VolPollOpen();
+
+    [DllImport(DLL, EntryPoint = "native_vol_cancel_open")]
+    public static extern void VolCancelOpen();
+
     // Video file functions
     [DllImport(DLL, EntryPoint = "native_vol_open_video_file")]
     public static extern bool VolOpenFile(string filename);
 
+    [DllImport(DLL, EntryPoint = "native_vol_open_video_memory")]
+    public static extern bool VolOpenVideoMemory(IntPtr data, long size);
+
+    [DllImport(DLL, EntryPoint = "native_vol_open_video_file_preloaded")]
+    public static extern bool VolOpenFilePreloaded(string filename);
+
     [DllImport(DLL, EntryPoint = "native_vol_close_video_file")]
     public static extern bool VolCloseFile();
 
@@ -124,10 +232,99 @@ public class VolPluginInterface
     [DllImport(DLL, EntryPoint = "native_vol_read_next_video_frame")]
     public static extern IntPtr VolReadNextVideoFrame(bool flipVertical);
 
-    //[DllImport(DLL, EntryPoint = "get_texture_update_callback")]
-    //private static extern System.IntPtr GetTextureUpdateCallback();
+    [DllImport(DLL, EntryPoint = "native_vol_set_video_output_scale")]
+    public static extern bool VolSetVideoOutputScale(int level);
+
+    [DllImport(DLL, EntryPoint = "native_vol_set_video_texture_format")]
+    public static extern bool VolSetVideoTextureFormat(int format);
+
+    [DllImport(DLL, EntryPoint = "native_vol_set_video_reverse_cache_size")]
+    public static extern bool VolSetVideoReverseCacheSize(long maxBytes);
+
+    [DllImport(DLL, EntryPoint = "native_vol_set_video_output_buffers")]
+    public static extern bool VolSetVideoOutputBuffers(IntPtr[] buffers, int numBuffers, long bufferSize);
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_video_output_buffer_index")]
+    public static extern int VolGetVideoOutputBufferIndex();
+
+    [DllImport(DLL, EntryPoint = "native_vol_release_video_output_buffer")]
+    public static extern void VolReleaseVideoOutputBuffer(int bufferIndex);
+
+    [DllImport(DLL, EntryPoint = "native_vol_start_video_decode_thread")]
+    public static extern bool VolStartVideoDecodeThread(int numBuffers, bool flipVertical);
+
+    [DllImport(DLL, EntryPoint = "native_vol_start_decode_scheduler")]
+    public static extern bool VolStartDecodeScheduler(int numWorkers);
+
+    [DllImport(DLL, EntryPoint = "native_vol_stop_decode_scheduler")]
+    public static extern bool VolStopDecodeScheduler();
+
+    [DllImport(DLL, EntryPoint = "native_vol_set_video_decode_priority")]
+    public static extern void VolSetVideoDecodePriority(float priority);
+
+    [DllImport(DLL, EntryPoint = "native_vol_acquire_video_frame")]
+    public static extern IntPtr VolAcquireVideoFrame(double ptsSeconds);
+
+    [DllImport(DLL, EntryPoint = "native_vol_has_audio")]
+    public static extern bool VolHasAudio();
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_audio_sample_rate")]
+    public static extern int VolGetAudioSampleRate();
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_audio_channels")]
+    public static extern int VolGetAudioChannels();
+
+    [DllImport(DLL, EntryPoint = "native_vol_set_audio_enabled")]
+    public static extern void VolSetAudioEnabled(bool enabled);
+
+    [DllImport(DLL, EntryPoint = "native_vol_read_audio")]
+    public static extern int VolReadAudio(float[] samples, int numFrames);
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_audio_clock")]
+    public static extern double VolGetAudioClock();
+
+    // Combined video and geometry functions
+    [DllImport(DLL, EntryPoint = "native_vol_read_frame_at_time")]
+    public static extern bool VolReadFrameAtTime(double seconds, bool flipVertical, out VolFrameResult result);
+
+    [DllImport(DLL, EntryPoint = "native_vol_update")]
+    public static extern bool VolUpdate(double seconds, bool flipVertical, out VolUpdateResult result);
+
+    [DllImport(DLL, EntryPoint = "native_vol_scrub_to_time")]
+    public static extern bool VolScrubToTime(double seconds, bool flipVertical, int scaleLevel, double maxLatencySeconds, out VolFrameResult result);
+
+    // Instances: players of the same vologram, each with its own playback position, that share its geometry and decoded video frames
+    [DllImport(DLL, EntryPoint = "native_vol_instance_open")]
+    public static extern IntPtr VolInstanceOpen(string headerFile, string sequenceFile, string videoFile, bool streamingMode);
+
+    [DllImport(DLL, EntryPoint = "native_vol_instance_close")]
+    public static extern void VolInstanceClose(IntPtr instance);
+
+    [DllImport(DLL, EntryPoint = "native_vol_instance_update")]
+    public static extern bool VolInstanceUpdate(IntPtr instance, double seconds, bool flipVertical, out VolUpdateResult result);
+
+    [DllImport(DLL, EntryPoint = "native_vol_instance_set_video_output_scale")]
+    public static extern bool VolInstanceSetVideoOutputScale(IntPtr instance, int level);
+
+    [DllImport(DLL, EntryPoint = "native_vol_instance_get_memory_usage")]
+    public static extern bool VolInstanceGetMemoryUsage(IntPtr instance, out VolMemoryUsage usage);
+
+    // Memory budget, usage, and trimming on low memory
+    [DllImport(DLL, EntryPoint = "native_vol_set_memory_budget")]
+    public static extern void VolSetMemoryBudget(long budgetBytes);
+
+    [DllImport(DLL, EntryPoint = "native_vol_get_memory_usage")]
+    public static extern bool VolGetMemoryUsage(out VolMemoryUsage usage);
+
+    [DllImport(DLL, EntryPoint = "native_vol_trim_memory")]
+    public static extern bool VolTrimMemory();
+
+    // Render thread texture upload. get_texture_update_callback is only in plugins built with ENABLE_UNITY_RENDER_FUNCS
+    [DllImport(DLL, EntryPoint = "native_vol_set_render_thread_upload")]
+    public static extern bool VolSetRenderThreadUpload(bool enabled);
 
-    //private static CommandBuffer _commandBuffer;
+    [DllImport(DLL, EntryPoint = "get_texture_update_callback")]
+    public static extern IntPtr VolGetTextureUpdateCallback();
     
     [MonoPInvokeCallback(typeof(DebugDelegate))]
     private static void DebugCallbackFunction(int logType, string debugString)
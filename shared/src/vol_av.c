@@ -1,46 +1,233 @@
 /** @file vol_av.c
  * Volograms SDK Audio-Video Decoding API
  *
- * Version:   0.9.0 \n
+ * Version:   0.10.0 \n
  * Authors:   Anton Gerdelan <anton@volograms.com> \n
  * Copyright: 2021, Volograms (http://volograms.com/) \n
  * Language:  C99 \n
  * Licence:   The MIT License. See LICENSE.md for details. \n
  */
 
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#define _POSIX_C_SOURCE 200809L // nanosleep() and clock_gettime() in vol_threads.h aren't declared by -std=c99 on its own.
+#endif
+#if defined( __APPLE__ ) && !defined( _DARWIN_C_SOURCE )
+#define _DARWIN_C_SOURCE // _POSIX_C_SOURCE alone hides Apple's extensions, e.g. _SC_NPROCESSORS_ONLN in vol_threads.h.
+#endif
+
 #include "vol_av.h"
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/imgutils.h> // av_image_get_buffer_size()
+#include <libswresample/swresample.h>
 #include <libswscale/swscale.h>
+#include <errno.h>  // EINVAL, ENOMEM
+#include <float.h>  // DBL_MAX
+#include <limits.h> // INT_MAX
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "vol_threads.h" // The decode thread, the decode scheduler and the block compression workers.
 
 #define VOL_AV_LOG_STR_MAX_LEN 512 // Careful - this is stored on the stack to be thread and memory-safe so don't make it too large.
 
+#ifndef VOL_AV_THREAD_TYPE
+/** Types of decoder threading to use when built with VOL_AV_THREADED. Define as FF_THREAD_SLICE or FF_THREAD_FRAME to compare them. */
+#define VOL_AV_THREAD_TYPE ( FF_THREAD_FRAME | FF_THREAD_SLICE )
+#endif
+
+#ifndef VOL_AV_AUDIO_LEAD_S
+/** Seconds of audio to demux ahead of the most recent video frame, so the audio ring doesn't run dry between video reads. */
+#define VOL_AV_AUDIO_LEAD_S 0.5
+#endif
+
+#ifndef VOL_AV_AUDIO_RING_S
+/** Capacity of the audio ring in seconds. Must comfortably exceed VOL_AV_AUDIO_LEAD_S plus the size of the engine's audio reads. */
+#define VOL_AV_AUDIO_RING_S 2
+#endif
+
+#ifndef VOL_AV_IO_BUFFER_SZ
+/** Default size of the buffer between FFmpeg and application-supplied input, when vol_av_io_t::buffer_sz is 0. */
+#define VOL_AV_IO_BUFFER_SZ ( 256 * 1024 )
+#endif
+
+#ifndef VOL_AV_PTS_TOLERANCE_S
+/** A frame counts as due this many seconds before its timestamp, so that rounding in coarse time bases doesn't hold a frame back a whole display interval. */
+#define VOL_AV_PTS_TOLERANCE_S 0.001
+#endif
+
+#ifndef VOL_AV_SEEK_AHEAD_S
+/** vol_av_read_frame_at_time() seeks, rather than decoding every frame in between, when asked for a time this many seconds past the last frame decoded.
+ * This is what makes jumping from the start to the end, to loop reverse play, cheap. */
+#define VOL_AV_SEEK_AHEAD_S 2.0
+#endif
+
+/** Maximum number of video packets held back while demuxing audio ahead of the video. */
+#define VOL_AV_VIDEO_QUEUE_LEN 64
+
+#ifndef VOL_AV_SCHED_MAX_STREAMS
+/** Most streams that the shared decode scheduler serves at once. Further streams fall back to their own decode thread. */
+#define VOL_AV_SCHED_MAX_STREAMS 64
+#endif
+
+#ifndef VOL_AV_SCHED_CODEC_THREADS
+/** Decoder threads for each stream opened while the shared decode scheduler runs. The pool already decodes streams in parallel. */
+#define VOL_AV_SCHED_CODEC_THREADS 1
+#endif
+
+#ifndef VOL_AV_SHARED_MAX_DECODERS
+/** Most decoders a shared video opens, for instances that are playing too far apart to share one. Further instances make a decoder seek instead. */
+#define VOL_AV_SHARED_MAX_DECODERS 8
+#endif
+
 #define LIBAVUTIL_VERSION_CHECK(maj, min, mic) (((LIBAVUTIL_VERSION_MAJOR >= maj) && (LIBAVUTIL_VERSION_MINOR >= min) && (LIBAVUTIL_VERSION_MICRO >= mic))? 1 : 0)
 
+/** One converted RGB frame in the decode thread's ring of output frames. */
+typedef struct vol_av_frame_slot_t {
+  uint8_t* data[4]; /** RGB image allocated with av_image_alloc(), or an application buffer. Only data[0] is used. */
+  int linesize[4];
+  bool external; /** data[0] is an application buffer from vol_av_set_output_buffers() and must not be freed here. */
+  int w, h;
+  double pts_s; /** Presentation time of the frame, in seconds from the start of the stream. */
+  uint8_t* compressed_ptr; /** The image block-compressed, if vol_av_set_output_compression() chose a compressed format. Only used by the decode thread. */
+  int64_t compressed_sz;
+} vol_av_frame_slot_t;
+
 /** Internal ffmepg-specific context variables. This struct lives inside the vol_av_video_t interface struct. */
 struct vol_av_internal_t {
   // Video File Codec Context
   AVFormatContext* fmt_ctx_ptr;  /** Holds the header information from the format (Container). http://ffmpeg.org/doxygen/trunk/structAVFormatContext.html */
+  AVIOContext* avio_ctx_ptr;     /** Custom input when opened with vol_av_open_io() or vol_av_open_memory(). Not freed by avformat_close_input(). */
+  vol_av_io_t io;                /** Application callbacks from vol_av_open_io(). */
+  const uint8_t* mem_ptr;        /** Application memory from vol_av_open_memory(). */
+  int64_t mem_sz, mem_pos;
   AVCodec* codec_ptr;            /** Video codec - decoder found for file format. http://ffmpeg.org/doxygen/trunk/structAVCodec.html */
   AVCodecContext* codec_ctx_ptr; /** Video codec context. https://ffmpeg.org/doxygen/trunk/structAVCodecContext.html */
   int video_stream_idx;          /** The valid video stream index we found by looping over the stream ptrs. */
 
+  AVPacket* packet_ptr;          /** Reused for every packet read from the file. Payloads are unreferenced after each use, but the struct is kept. */
+
   // Current Decoded Frame Output
   AVFrame* output_frame_ptr;     /** Decoded frame in native format. // https://ffmpeg.org/doxygen/trunk/structAVFrame.html */
   AVFrame* output_frame_rgb_ptr; /** Conversion of `output_frame_ptr` to a RGB format for use in engines. */
   uint8_t* internal_buffer_ptr;  /** Temporary decoding storage. */
+  AVFrame* due_frame_ptr;        /** vol_av_read_frame_at_time() keeps the newest due frame here while it checks if the next one is due too. */
 
   // Tools
   struct SwsContext* sws_conv_ctx_ptr; /** Scaling/image conversion context. */
 
   int w, h; /** Dimensions of `output_frame_rgb_ptr`. */
+
+  double frame_pts_s;     /** Presentation time of the frame in `output_frame_ptr`, in seconds. */
+  int64_t frames_decoded; /** Incremented every time the decoder outputs a frame. */
+  bool demux_eof;         /** Set when av_read_frame() has no more packets to give, and the decoder has been told to drain. */
+  bool decoder_eof;       /** Set when the decoder has output every frame it was holding back. */
+  bool frame_pending;     /** `output_frame_ptr` holds a decoded frame that has not been handed to the application yet. */
+  double decoded_s;       /** Time of the last frame taken from the decoder, or -1 after a seek. Earlier frames need a seek, or the reverse cache. */
+
+  // Application-owned output buffers. See vol_av_set_output_buffers().
+  uint8_t** user_buffers_ptr; /** Copy of the application's array of buffer pointers. */
+  bool* user_buffer_held_ptr; /** True while the application owns the frame in that buffer. */
+  int n_user_buffers;
+  int next_user_buffer; /** Round-robin position, so a just-released buffer is not immediately overwritten. */
+  uint8_t** user_compressed_ptr; /** One compressed image per output buffer, if compression is on, so a held frame's blocks aren't overwritten either. */
+
+  // Decode Thread. See vol_av_start_decode_thread().
+  // slots_ptr is a single-producer, single-consumer ring: the decode thread only writes slots_written, the application only writes slots_read.
+  vol_av_frame_slot_t* slots_ptr;
+  int n_slots;
+  volatile uint32_t slots_written;   /** Count of frames published by the decode thread. */
+  volatile uint32_t slots_read;      /** Count of frames released by the application. slot[slots_read % n_slots] is the one currently held. */
+  volatile uint32_t thread_quit;     /** Set by the application to ask the decode thread to return. */
+  volatile uint32_t thread_finished; /** Set by the decode thread when it reaches the end of the stream or an error. */
+  vol_mutex_t slots_lock;            /** Only guards slots_freed, so the decode thread can sleep until the application frees a slot. */
+  vol_cond_t slots_freed;            /** Signalled when slots_read moves on, or thread_quit is set. Unused when scheduled. */
+  vol_thread_t decode_thread;
+  bool decode_thread_running;
+  bool flip_vertical;
+  double due_tolerance_s;          /** Half a frame. vol_av_acquire_frame() counts a frame as due this long before its timestamp. */
+  bool scheduled;                  /** Frames are produced by the shared worker pool instead of decode_thread. See vol_av_start_decode_scheduler(). */
+  volatile uint32_t sched_busy;    /** Set while a pool worker is decoding this stream, so that no other worker takes it. */
+  float decode_priority;           /** Scheduling weight from vol_av_set_decode_priority(). 0 or less is culled. */
+
+  volatile uint32_t output_scale_level; /** Frames are converted to the video size divided by 2^level. See vol_av_set_output_scale(). */
+  vol_av_texture_format_t texture_format; /** Frames are also encoded in this format if it isn't RGB24. See vol_av_set_output_compression(). */
+  uint8_t* compressed_ptr;                /** Compressed frame given by the single-threaded read functions without output buffers. Sized for the full video size. */
+
+  // Reverse play. Frames are only decodable forwards from a keyframe, so a stretch of a GOP is decoded once and presented backwards from here.
+  // See vol_av_set_reverse_cache_size().
+  vol_av_frame_slot_t* rev_slots_ptr; /** Ring of converted frames in time order, from rev_first. Each image is allocated the first time its slot is used. */
+  int rev_max_slots;                  /** Number of full-size frames that fit in the cache size. 0 if reverse caching is off. */
+  int rev_first, rev_count;
+  double rev_end_s;                   /** Time of the frame after the newest cached one, so the cache covers [oldest frame's time, rev_end_s). */
+  bool rev_flip;                      /** The cached frames were converted with this vertical flip. */
+
+  // Scrubbing. See vol_av_scrub_to_time().
+  AVCodecContext* scrub_codec_ctx_ptr; /** A second decoder for keyframes only, opened on the first scrub. It is drained after each frame, so it never holds frames back. */
+  bool scrubbing;                      /** The demuxer has been used by the scrub decoder, so the main decoder must seek before it decodes again. */
+  int scrub_scale_level;               /** Output scale level used while scrubbing, if it is smaller than the normal one. */
+
+  // Audio. Decoded from the same demux pass as the video. See vol_av_read_audio().
+  int audio_stream_idx;                /** -1 if the file has no audio stream, or its decoder could not be opened. */
+  AVCodec* audio_codec_ptr;
+  AVCodecContext* audio_codec_ctx_ptr;
+  AVFrame* audio_frame_ptr;
+  struct SwrContext* swr_ctx_ptr;      /** Converts decoded audio, usually planar, to interleaved 32-bit float. */
+  float* audio_scratch_ptr;            /** swr_convert() output, before it is copied into the ring. Grown only when a frame is larger than any before. */
+  int audio_scratch_frames;
+  int audio_sample_rate, audio_channels;
+  volatile uint32_t audio_enabled;     /** If 0, audio packets are discarded by the demuxer without being decoded. */
+  double audio_demuxed_s;              /** End time of the most recent audio packet read from the file. */
+  bool audio_started;
+  vol_mutex_t audio_clock_lock;        /** Guards audio_start_s and audio_start_idx, which the decoding thread sets together and the audio clock reads together. */
+  double audio_start_s;                /** Time of the first sample frame written to the ring since opening or seeking. */
+  uint32_t audio_start_idx;            /** Value of audio_written when audio_start_s was set. */
+  volatile uint32_t audio_discard_to;  /** Set by a seek. The reader skips samples before this, as they are from before the seek. */
+  // audio_ring_ptr is a single-producer, single-consumer ring of interleaved sample frames: whichever thread decodes video only writes audio_written,
+  // the engine's audio thread only writes audio_read.
+  float* audio_ring_ptr;
+  uint32_t audio_ring_frames;
+  volatile uint32_t audio_written; /** Count of sample frames written to the ring. */
+  volatile uint32_t audio_read;    /** Count of sample frames read from the ring. Also drives the audio clock. */
+
+  // Video packets read while demuxing audio ahead, waiting to be sent to the video decoder. A FIFO of preallocated packets.
+  AVPacket* video_queue_ptr[VOL_AV_VIDEO_QUEUE_LEN];
+  int video_queue_head, video_queue_count;
+  bool file_eof; /** Set when av_read_frame() has no more packets. The video decoder is only drained once the queue is empty too. */
+
+  // Shared videos. See vol_av_open_shared().
+  struct vol_av_shared_t* shared_ptr; /** Registry entry this instance is a cursor on, or NULL if it has a decoder of its own. */
+  int shared_frame_idx;               /** Frame of the registry entry that this cursor is presenting, or -1. */
 };
 
+/** The process-wide decode worker pool. streams_ptr, n_streams, quit, and each stream's decode_priority and sched_busy are only changed with `lock` held. */
+typedef struct vol_av_scheduler_t {
+  vol_mutex_t lock;
+  vol_cond_t work;    /** Signalled when a stream may have a free slot: a frame was released, or a stream was added. Idle workers wait on this. */
+  vol_cond_t idle;    /** Broadcast when a worker finishes a frame, so a stream being removed can wait for its worker. */
+  vol_thread_t* workers_ptr;
+  int n_workers;
+  vol_av_internal_t* streams_ptr[VOL_AV_SCHED_MAX_STREAMS];
+  int n_streams;
+  volatile uint32_t quit;
+  bool running;
+} vol_av_scheduler_t;
+
+static vol_av_scheduler_t _sched;
+
+static int _read_next_frame( vol_av_internal_t* p );
+static bool _open_audio( vol_av_internal_t* p );
+static void _close_audio( vol_av_internal_t* p );
+static void _decode_audio_packet( vol_av_internal_t* p, const AVPacket* packet_ptr );
+static void _free_reverse_cache( vol_av_internal_t* p );
+static void _free_user_compressed( vol_av_internal_t* p );
+static void _end_scrub( vol_av_internal_t* p );
+static bool _resume_after_scrub( vol_av_internal_t* p, double shown_s );
+static bool _seek( vol_av_internal_t* p, double pts_s );
+static bool _shared_read_frame_at_time( vol_av_video_t* info_ptr, double pts_s, bool flip_vertical );
+static void _release_shared_cursor( vol_av_internal_t* p );
+
 static void _default_logger( vol_av_log_type_t log_type, const char* message_str ) {
   FILE* stream_ptr = ( VOL_AV_LOG_TYPE_ERROR == log_type || VOL_AV_LOG_TYPE_WARNING == log_type ) ? stderr : stdout;
   fprintf( stream_ptr, "%s", message_str );
@@ -60,22 +247,661 @@ static void _vol_loggerf( vol_av_log_type_t log_type, const char* message_str, .
   _logger_ptr( log_type, log_str );
 }
 
+/** Instances of a shared video are only a cursor on frames decoded for them, so functions that drive a decoder of their own can't be used on them.
+ * @return True, after logging an error, if `info_ptr` is an instance of a shared video. */
+static bool _is_shared_cursor( const vol_av_video_t* info_ptr, const char* func_str ) {
+  if ( !info_ptr->_context_ptr->shared_ptr ) { return false; }
+  _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: %s() can not be used on an instance of a shared video. See vol_av_open_shared().\n", func_str );
+  return true;
+}
+
+/******************************************************************************
+  FFMPEG ALLOCATOR
+  With VOL_AV_MALLOC_PREFIX defined, and FFmpeg configured with --malloc-prefix=vol_av_mem_, every av_malloc(), av_realloc() and av_free()
+  comes here instead of the system allocator. Freed blocks are kept on lists by size and handed out again, so once playback has warmed up the
+  buffer and frame references the decoder makes for each frame, and the demuxer's packet payloads, are recycled rather than allocated.
+******************************************************************************/
+
+#ifdef VOL_AV_MALLOC_PREFIX
+#ifdef _WIN32
+#error "VOL_AV_MALLOC_PREFIX needs FFmpeg to allocate with posix_memalign(). Windows builds of FFmpeg use _aligned_malloc(), which --malloc-prefix doesn't replace."
+#endif
+
+/** Bytes before each block for its header. Also the alignment of every block, which covers FFmpeg's largest, for AVX-512. */
+#define VOL_AV_MEM_HEADER_SZ 64
+/** The smallest block is 1 << VOL_AV_MEM_MIN_SHIFT bytes. */
+#define VOL_AV_MEM_MIN_SHIFT 6
+/** Blocks larger than 1 << VOL_AV_MEM_MAX_SHIFT bytes are not recycled. */
+#define VOL_AV_MEM_MAX_SHIFT 26
+/** Each power of two is split into 4 sizes, so a block wastes at most a quarter of itself. */
+#define VOL_AV_MEM_N_CLASSES ( ( VOL_AV_MEM_MAX_SHIFT - VOL_AV_MEM_MIN_SHIFT ) * 4 + 1 )
+/** A request whose own list is empty takes a free block up to this many sizes larger, so a packet of a size not seen in the warm-up isn't allocated. */
+#define VOL_AV_MEM_FIT_CLASSES 4
+/** Size class of blocks too large to recycle. They go straight back to the system allocator. */
+#define VOL_AV_MEM_UNPOOLED -1
+
+typedef struct vol_av_mem_header_t {
+  int size_class;
+  size_t sz;                            /** Usable bytes after the header. */
+  struct vol_av_mem_header_t* next_ptr; /** Next free block of the same class, while this one is on a free list. */
+} vol_av_mem_header_t;
+
+/** Guards the free lists and the count of open videos. */
+static vol_mutex_t _mem_lock = VOL_MUTEX_INITIALIZER;
+static vol_av_mem_header_t* _mem_free_ptr[VOL_AV_MEM_N_CLASSES];
+/** When the last video is closed the free lists are given back to the system. */
+static int _mem_n_videos;
+
+static int _mem_class( size_t sz ) {
+  if ( sz <= ( (size_t)1 << VOL_AV_MEM_MIN_SHIFT ) ) { return 0; }
+  if ( sz > ( (size_t)1 << VOL_AV_MEM_MAX_SHIFT ) ) { return VOL_AV_MEM_UNPOOLED; }
+  int shift = VOL_AV_MEM_MIN_SHIFT;
+  while ( ( sz - 1 ) >> ( shift + 1 ) ) { shift++; }
+  return ( shift - VOL_AV_MEM_MIN_SHIFT ) * 4 + (int)( ( ( sz - 1 ) >> ( shift - 2 ) ) & 3 ) + 1;
+}
+
+static size_t _mem_class_sz( int size_class ) {
+  if ( 0 == size_class ) { return (size_t)1 << VOL_AV_MEM_MIN_SHIFT; }
+  int shift = ( size_class - 1 ) / 4 + VOL_AV_MEM_MIN_SHIFT;
+  return (size_t)( 5 + ( size_class - 1 ) % 4 ) << ( shift - 2 );
+}
+
+void vol_av_mem_free( void* ptr );
+
+/** Allocate a block of `sz` usable bytes, which is the full size of `size_class` for a pooled block, from the system. */
+static void* _mem_system_alloc( int size_class, size_t sz ) {
+  if ( sz > SIZE_MAX - VOL_AV_MEM_HEADER_SZ ) { return NULL; }
+  void* block_ptr = NULL;
+  if ( 0 != posix_memalign( &block_ptr, VOL_AV_MEM_HEADER_SZ, VOL_AV_MEM_HEADER_SZ + sz ) ) { return NULL; }
+  vol_av_mem_header_t* header_ptr = block_ptr;
+  header_ptr->size_class          = size_class;
+  header_ptr->sz                  = sz;
+  header_ptr->next_ptr            = NULL;
+  return (uint8_t*)block_ptr + VOL_AV_MEM_HEADER_SZ;
+}
+
+void* vol_av_mem_malloc( size_t sz ) {
+  int size_class                  = _mem_class( sz );
+  vol_av_mem_header_t* header_ptr = NULL;
+  if ( VOL_AV_MEM_UNPOOLED != size_class ) {
+    _mutex_lock( &_mem_lock );
+    for ( int c = size_class; c < size_class + VOL_AV_MEM_FIT_CLASSES && c < VOL_AV_MEM_N_CLASSES && !header_ptr; c++ ) {
+      header_ptr = _mem_free_ptr[c];
+      if ( header_ptr ) { _mem_free_ptr[c] = header_ptr->next_ptr; }
+    }
+    _mutex_unlock( &_mem_lock );
+    if ( header_ptr ) { return (uint8_t*)header_ptr + VOL_AV_MEM_HEADER_SZ; }
+    sz = _mem_class_sz( size_class );
+  }
+  void* ptr = _mem_system_alloc( size_class, sz );
+  // A pooled size ran out, so the decoder has more of them in flight than ever before. Frame threads finish in a different order each time,
+  // so that count creeps up a block at a time, and a spare on the free list stops the next step from allocating again.
+  if ( ptr && VOL_AV_MEM_UNPOOLED != size_class ) {
+    void* spare_ptr = _mem_system_alloc( size_class, sz );
+    if ( spare_ptr ) { vol_av_mem_free( spare_ptr ); }
+  }
+  return ptr;
+}
+
+int vol_av_mem_posix_memalign( void** ptr_ptr, size_t alignment, size_t sz ) {
+  if ( alignment > VOL_AV_MEM_HEADER_SZ ) { return EINVAL; }
+  *ptr_ptr = vol_av_mem_malloc( sz );
+  return *ptr_ptr ? 0 : ENOMEM;
+}
+
+void* vol_av_mem_memalign( size_t alignment, size_t sz ) { return alignment > VOL_AV_MEM_HEADER_SZ ? NULL : vol_av_mem_malloc( sz ); }
+
+/** A block that already has room is returned as it is. */
+void* vol_av_mem_realloc( void* ptr, size_t sz ) {
+  if ( !ptr ) { return vol_av_mem_malloc( sz ); }
+  const vol_av_mem_header_t* header_ptr = (const vol_av_mem_header_t*)( (uint8_t*)ptr - VOL_AV_MEM_HEADER_SZ );
+  if ( sz <= header_ptr->sz ) { return ptr; }
+  void* new_ptr = vol_av_mem_malloc( sz );
+  if ( !new_ptr ) { return NULL; }
+  memcpy( new_ptr, ptr, header_ptr->sz );
+  vol_av_mem_free( ptr );
+  return new_ptr;
+}
+
+void vol_av_mem_free( void* ptr ) {
+  if ( !ptr ) { return; }
+  vol_av_mem_header_t* header_ptr = (vol_av_mem_header_t*)( (uint8_t*)ptr - VOL_AV_MEM_HEADER_SZ );
+  if ( VOL_AV_MEM_UNPOOLED == header_ptr->size_class ) {
+    free( header_ptr );
+    return;
+  }
+  _mutex_lock( &_mem_lock );
+  header_ptr->next_ptr                  = _mem_free_ptr[header_ptr->size_class];
+  _mem_free_ptr[header_ptr->size_class] = header_ptr;
+  _mutex_unlock( &_mem_lock );
+}
+
+static void _mem_video_opened( void ) {
+  _mutex_lock( &_mem_lock );
+  _mem_n_videos++;
+  _mutex_unlock( &_mem_lock );
+}
+
+/** FFmpeg's blocks still in use when the last video closes, e.g. its static tables, go on the free lists when they are freed, and stay there. */
+static void _mem_video_closed( void ) {
+  _mutex_lock( &_mem_lock );
+  if ( 0 == --_mem_n_videos ) {
+    for ( int c = 0; c < VOL_AV_MEM_N_CLASSES; c++ ) {
+      while ( _mem_free_ptr[c] ) {
+        vol_av_mem_header_t* header_ptr = _mem_free_ptr[c];
+        _mem_free_ptr[c]                = header_ptr->next_ptr;
+        free( header_ptr );
+      }
+    }
+  }
+  _mutex_unlock( &_mem_lock );
+}
+#else
+static void _mem_video_opened( void ) {}
+static void _mem_video_closed( void ) {}
+#endif
+
+/******************************************************************************
+  BLOCK COMPRESSION
+  Real-time encoders for GPU texture formats, so frames can be uploaded compressed. Quality is traded for speed: each 4x4 block is fitted
+  in one pass with no iterative refinement, and rows of blocks are shared out between threads.
+******************************************************************************/
+
+/** Bands that vol_av_compress_rgb() splits an image between are held on the stack, so this caps their number, and the compression pool's size. */
+#define VOL_AV_COMPRESS_MAX_THREADS 16
+
+/** ETC1 modifier tables. Each pixel adds +a, +b, -a, or -b from its sub-block's table to all three channels of the sub-block's base colour. */
+static const int _etc1_modifiers[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+/** Pixels of the two ETC1 sub-blocks, as indices y * 4 + x. Without flip they are the left and right 2x4 halves, with flip the top and bottom 4x2 halves. */
+static const int _etc1_subblock_pixels[2][2][8] = {
+  { { 0, 1, 4, 5, 8, 9, 12, 13 }, { 2, 3, 6, 7, 10, 11, 14, 15 } }, //
+  { { 0, 1, 2, 3, 4, 5, 6, 7 }, { 8, 9, 10, 11, 12, 13, 14, 15 } }   //
+};
+
+/** A band of block rows for one thread to compress. */
+typedef struct vol_av_compress_job_t {
+  const uint8_t* rgb_ptr;
+  int linesize, w, h;
+  vol_av_texture_format_t format;
+  uint8_t* dst_ptr;
+  int block_row_first, block_row_end;
+} vol_av_compress_job_t;
+
+/** One vol_av_compress_rgb() call's bands. Lives on the caller's stack, and is queued on the pool until every band has been claimed. */
+typedef struct vol_av_compress_batch_t {
+  vol_av_compress_job_t* jobs_ptr;
+  int n_jobs;
+  int next_job; /** Bands before this have been claimed, by a pool worker or the caller. */
+  int n_done;
+  struct vol_av_compress_batch_t* next_ptr;
+} vol_av_compress_batch_t;
+
+/** Process-wide compression workers, so frames are not compressed by threads created and joined for each frame.
+ * Each video with compression on holds a reference, from vol_av_set_output_compression() until it is turned off or the video is closed, and
+ * vol_av_compress_rgb() holds one for the call if the pool is already running. The workers are started by the first video's reference and
+ * joined when the last one goes. */
+typedef struct vol_av_compress_pool_t {
+  vol_mutex_t users_lock; /** Guards n_users, and is held while workers are started or joined. */
+  int n_users;
+  vol_mutex_t lock;  /** Guards the queue and the batches on it. */
+  vol_cond_t work;   /** Signalled when a batch is queued, or quit is set. */
+  vol_cond_t done;   /** Signalled when a batch's last band is finished. */
+  vol_av_compress_batch_t* queue_ptr; /** Batches with unclaimed bands, oldest first. */
+  bool quit;
+  vol_thread_t threads[VOL_AV_COMPRESS_MAX_THREADS];
+  int n_threads;
+} vol_av_compress_pool_t;
+
+static vol_av_compress_pool_t _compress_pool = { VOL_MUTEX_INITIALIZER, 0, VOL_MUTEX_INITIALIZER, VOL_COND_INITIALIZER, VOL_COND_INITIALIZER, NULL, false, { 0 }, 0 };
+
+/** Copy a 4x4 block of pixels, with x and y of each in px[y * 4 + x]. Pixels past the right or bottom edge repeat the last column or row. */
+static void _load_block( const vol_av_compress_job_t* job_ptr, int bx, int by, uint8_t px[16][3] ) {
+  for ( int y = 0; y < 4; y++ ) {
+    int sy                 = by * 4 + y < job_ptr->h ? by * 4 + y : job_ptr->h - 1;
+    const uint8_t* row_ptr = job_ptr->rgb_ptr + (size_t)sy * job_ptr->linesize;
+    for ( int x = 0; x < 4; x++ ) {
+      int sx = bx * 4 + x < job_ptr->w ? bx * 4 + x : job_ptr->w - 1;
+      memcpy( px[y * 4 + x], &row_ptr[sx * 3], 3 );
+    }
+  }
+}
+
+static uint16_t _rgb_to_565( const int rgb[3] ) {
+  return (uint16_t)( ( ( rgb[0] * 31 + 127 ) / 255 ) << 11 | ( ( rgb[1] * 63 + 127 ) / 255 ) << 5 | ( ( rgb[2] * 31 + 127 ) / 255 ) );
+}
+
+static void _565_to_rgb( uint16_t c, int rgb[3] ) {
+  int r = c >> 11, g = ( c >> 5 ) & 63, b = c & 31;
+  rgb[0] = ( r << 3 ) | ( r >> 2 );
+  rgb[1] = ( g << 2 ) | ( g >> 4 );
+  rgb[2] = ( b << 3 ) | ( b >> 2 );
+}
+
+/** Encode a BC1 block. The end points are the corners of the colour bounding box, on the diagonal that follows the block's correlation,
+ * inset slightly so that the interpolated colours land closer to the pixels. This is the usual real-time approach (J.M.P. van Waveren, 2006). */
+static void _encode_bc1_block( const uint8_t px[16][3], uint8_t* out_ptr ) {
+  int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 }, sum[3] = { 0, 0, 0 };
+  for ( int i = 0; i < 16; i++ ) {
+    for ( int c = 0; c < 3; c++ ) {
+      if ( px[i][c] < lo[c] ) { lo[c] = px[i][c]; }
+      if ( px[i][c] > hi[c] ) { hi[c] = px[i][c]; }
+      sum[c] += px[i][c];
+    }
+  }
+  // Red and blue are swapped end-to-end if they fall while green rises. Values are scaled by 16 so the means stay integers.
+  int cov_rg = 0, cov_bg = 0;
+  for ( int i = 0; i < 16; i++ ) {
+    int dg = px[i][1] * 16 - sum[1];
+    cov_rg += ( px[i][0] * 16 - sum[0] ) * dg;
+    cov_bg += ( px[i][2] * 16 - sum[2] ) * dg;
+  }
+  if ( cov_rg < 0 ) {
+    int tmp = lo[0];
+    lo[0]   = hi[0];
+    hi[0]   = tmp;
+  }
+  if ( cov_bg < 0 ) {
+    int tmp = lo[2];
+    lo[2]   = hi[2];
+    hi[2]   = tmp;
+  }
+  for ( int c = 0; c < 3; c++ ) {
+    int inset = ( hi[c] - lo[c] ) / 16;
+    hi[c] -= inset;
+    lo[c] += inset;
+  }
+
+  // c0 > c1 selects the 4-colour mode. If they are equal every index is 0, which is that one colour in either mode.
+  uint16_t c0 = _rgb_to_565( hi ), c1 = _rgb_to_565( lo );
+  if ( c0 < c1 ) {
+    uint16_t tmp = c0;
+    c0           = c1;
+    c1           = tmp;
+  }
+  uint32_t indices = 0;
+  if ( c0 != c1 ) {
+    int pal[4][3];
+    _565_to_rgb( c0, pal[0] );
+    _565_to_rgb( c1, pal[1] );
+    for ( int c = 0; c < 3; c++ ) {
+      pal[2][c] = ( 2 * pal[0][c] + pal[1][c] ) / 3;
+      pal[3][c] = ( pal[0][c] + 2 * pal[1][c] ) / 3;
+    }
+    // The palette lies on a line, so each pixel's nearest entry is found by projecting it onto the line and comparing with the midpoints
+    // between entries, which run c1, 1/3, 2/3, c0 along it.
+    int dir[3], stops[4];
+    for ( int c = 0; c < 3; c++ ) { dir[c] = pal[0][c] - pal[1][c]; }
+    for ( int j = 0; j < 4; j++ ) { stops[j] = pal[j][0] * dir[0] + pal[j][1] * dir[1] + pal[j][2] * dir[2]; }
+    int mid_13 = ( stops[1] + stops[3] ) / 2, mid_32 = ( stops[3] + stops[2] ) / 2, mid_20 = ( stops[2] + stops[0] ) / 2;
+    for ( int i = 0; i < 16; i++ ) {
+      int dot = px[i][0] * dir[0] + px[i][1] * dir[1] + px[i][2] * dir[2];
+      int idx = dot > mid_20 ? 0 : ( dot > mid_32 ? 2 : ( dot > mid_13 ? 3 : 1 ) );
+      indices |= (uint32_t)idx << ( 2 * i );
+    }
+  }
+
+  out_ptr[0] = (uint8_t)( c0 & 0xFF );
+  out_ptr[1] = (uint8_t)( c0 >> 8 );
+  out_ptr[2] = (uint8_t)( c1 & 0xFF );
+  out_ptr[3] = (uint8_t)( c1 >> 8 );
+  for ( int i = 0; i < 4; i++ ) { out_ptr[4 + i] = (uint8_t)( indices >> ( 8 * i ) ); }
+}
+
+/** Pick the modifier table, and each pixel's modifier, for one ETC1 sub-block of 8 pixels around a base colour.
+ * Modifiers are chosen as if they weren't clamped to 0-255, which lets the error be worked out from each pixel's distance to the base colour.
+ * @param pix_idx  Indices into `px` of the sub-block's pixels.
+ * @param sel      Set to each pixel's modifier: bit 1 for negative, and bit 0 for the larger of the pair, as in the ETC1 pixel index bits.
+ * @return         Squared error of the fit.
+ */
+static int _etc1_fit_subblock( const uint8_t px[16][3], const int pix_idx[8], const int base[3], int* table_ptr, int sel[8] ) {
+  // Error of adding m to every channel is s - 2 * m * d + 3 * m^2, for s the squared distance to the base colour and d the channel sum.
+  int s[8], d[8], s_sum = 0;
+  for ( int k = 0; k < 8; k++ ) {
+    const uint8_t* p_ptr = px[pix_idx[k]];
+    int dr = p_ptr[0] - base[0], dg = p_ptr[1] - base[1], db = p_ptr[2] - base[2];
+    s[k]   = dr * dr + dg * dg + db * db;
+    d[k]   = dr + dg + db;
+    s_sum += s[k];
+  }
+
+  // The tables grow steadily, so the error falls to a minimum and rises again. Most blocks of a video are smooth and stop after two or three.
+  int best_err = INT_MAX;
+  for ( int t = 0; t < 8; t++ ) {
+    int a = _etc1_modifiers[t][0], b = _etc1_modifiers[t][1];
+    int err = s_sum, t_sel[8];
+    for ( int k = 0; k < 8; k++ ) {
+      // The nearest modifier to d / 3, on the same side of 0 as d.
+      int ad    = d[k] < 0 ? -d[k] : d[k];
+      int large = 2 * ad > 3 * ( a + b );
+      int m     = large ? b : a;
+      t_sel[k]  = ( d[k] < 0 ? 2 : 0 ) | large;
+      err += 3 * m * m - 2 * m * ad;
+    }
+    if ( err >= best_err ) { break; }
+    best_err   = err;
+    *table_ptr = t;
+    memcpy( sel, t_sel, sizeof( t_sel ) );
+  }
+  return best_err;
+}
+
+/** Encode an ETC2 RGB block. Only the individual and differential modes are used, which are also ETC1, and the differential mode is only
+ * used when neither base colour overflows, so a decoder never reads the block as one of ETC2's extra modes. Both orientations of the two
+ * sub-blocks are tried, each with its sub-blocks' mean colours as the base colours. */
+static void _encode_etc2_rgb_block( const uint8_t px[16][3], uint8_t* out_ptr ) {
+  uint32_t best_hi = 0, best_lo = 0;
+  int best_err     = INT_MAX;
+
+  for ( int flip = 0; flip < 2; flip++ ) {
+    const int( *pix_idx )[8] = _etc1_subblock_pixels[flip];
+    int sum[2][3]            = { { 0 } };
+    for ( int h = 0; h < 2; h++ ) {
+      for ( int k = 0; k < 8; k++ ) {
+        for ( int c = 0; c < 3; c++ ) { sum[h][c] += px[pix_idx[h][k]][c]; }
+      }
+    }
+
+    // Differential mode stores the first base colour in 5 bits per channel and the second as a 3-bit offset from it.
+    int q5[2][3], q4[2][3], base[2][3];
+    bool differential = true;
+    for ( int c = 0; c < 3; c++ ) {
+      for ( int h = 0; h < 2; h++ ) {
+        q5[h][c] = ( sum[h][c] * 31 + 4 * 255 ) / ( 8 * 255 );
+        q4[h][c] = ( sum[h][c] * 15 + 4 * 255 ) / ( 8 * 255 );
+      }
+      int delta = q5[1][c] - q5[0][c];
+      if ( delta < -4 || delta > 3 ) { differential = false; }
+    }
+    for ( int h = 0; h < 2; h++ ) {
+      for ( int c = 0; c < 3; c++ ) { base[h][c] = differential ? ( q5[h][c] << 3 ) | ( q5[h][c] >> 2 ) : q4[h][c] * 17; }
+    }
+
+    int table[2], sel[2][8];
+    int err = _etc1_fit_subblock( px, pix_idx[0], base[0], &table[0], sel[0] );
+    if ( err >= best_err ) { continue; }
+    err += _etc1_fit_subblock( px, pix_idx[1], base[1], &table[1], sel[1] );
+    if ( err >= best_err ) { continue; }
+
+    uint32_t hi = (uint32_t)( table[0] << 5 | table[1] << 2 | flip );
+    if ( differential ) {
+      hi |= 1u << 1;
+      for ( int c = 0; c < 3; c++ ) { hi |= (uint32_t)( q5[0][c] << 3 | ( ( q5[1][c] - q5[0][c] ) & 7 ) ) << ( 24 - 8 * c ); }
+    } else {
+      for ( int c = 0; c < 3; c++ ) { hi |= (uint32_t)( q4[0][c] << 4 | q4[1][c] ) << ( 24 - 8 * c ); }
+    }
+    // Pixel indices are stored column by column. The high bit of pixel i is at bit 16 + i, and the low bit at bit i.
+    uint32_t lo = 0;
+    for ( int h = 0; h < 2; h++ ) {
+      for ( int k = 0; k < 8; k++ ) {
+        int x = pix_idx[h][k] % 4, y = pix_idx[h][k] / 4, i = x * 4 + y;
+        lo |= (uint32_t)( sel[h][k] >> 1 ) << ( 16 + i ) | (uint32_t)( sel[h][k] & 1 ) << i;
+      }
+    }
+    best_err = err;
+    best_hi  = hi;
+    best_lo  = lo;
+  }
+
+  for ( int i = 0; i < 4; i++ ) {
+    out_ptr[i]     = (uint8_t)( best_hi >> ( 24 - 8 * i ) );
+    out_ptr[4 + i] = (uint8_t)( best_lo >> ( 24 - 8 * i ) );
+  }
+}
+
+static void _compress_block_rows( const vol_av_compress_job_t* job_ptr ) {
+  int blocks_w = ( job_ptr->w + 3 ) / 4;
+  uint8_t px[16][3];
+  for ( int by = job_ptr->block_row_first; by < job_ptr->block_row_end; by++ ) {
+    uint8_t* out_ptr = job_ptr->dst_ptr + (size_t)by * blocks_w * 8;
+    for ( int bx = 0; bx < blocks_w; bx++, out_ptr += 8 ) {
+      _load_block( job_ptr, bx, by, px );
+      if ( VOL_AV_TEXTURE_FORMAT_BC1 == job_ptr->format ) {
+        _encode_bc1_block( px, out_ptr );
+      } else {
+        _encode_etc2_rgb_block( px, out_ptr );
+      }
+    }
+  }
+}
+
+/** Claim the next band of the oldest queued batch. Call with the pool locked.
+ * @return The band, or NULL if the queue is empty. */
+static vol_av_compress_job_t* _compress_claim( vol_av_compress_batch_t** batch_pp ) {
+  vol_av_compress_batch_t* batch_ptr = _compress_pool.queue_ptr;
+  if ( !batch_ptr ) { return NULL; }
+  vol_av_compress_job_t* job_ptr = &batch_ptr->jobs_ptr[batch_ptr->next_job++];
+  if ( batch_ptr->next_job == batch_ptr->n_jobs ) { _compress_pool.queue_ptr = batch_ptr->next_ptr; }
+  *batch_pp = batch_ptr;
+  return job_ptr;
+}
+
+/** Mark a claimed band as finished. Call with the pool locked. */
+static void _compress_finish( vol_av_compress_batch_t* batch_ptr ) {
+  if ( ++batch_ptr->n_done == batch_ptr->n_jobs ) { _cond_broadcast( &_compress_pool.done ); }
+}
+
+static VOL_THREAD_FUNC _compress_thread_main( void* arg_ptr ) {
+  (void)arg_ptr;
+  _mutex_lock( &_compress_pool.lock );
+  while ( !_compress_pool.quit ) {
+    vol_av_compress_batch_t* batch_ptr = NULL;
+    vol_av_compress_job_t* job_ptr     = _compress_claim( &batch_ptr );
+    if ( !job_ptr ) {
+      _cond_wait( &_compress_pool.work, &_compress_pool.lock );
+      continue;
+    }
+    _mutex_unlock( &_compress_pool.lock );
+    _compress_block_rows( job_ptr );
+    _mutex_lock( &_compress_pool.lock );
+    _compress_finish( batch_ptr );
+  }
+  _mutex_unlock( &_compress_pool.lock );
+  return VOL_THREAD_RETURN;
+}
+
+/** Take a reference to the compression pool, starting its workers if this is the first. If they can't be started, callers compress alone. */
+static void _compress_pool_acquire( void ) {
+  _mutex_lock( &_compress_pool.users_lock );
+  if ( 0 == _compress_pool.n_users++ ) {
+    // The caller always does a band itself, so one worker fewer than the cores keeps them all busy.
+    int n_workers = _cpu_count() - 1;
+    if ( n_workers > VOL_AV_COMPRESS_MAX_THREADS ) { n_workers = VOL_AV_COMPRESS_MAX_THREADS; }
+    _compress_pool.quit      = false;
+    _compress_pool.n_threads = 0;
+    for ( int i = 0; i < n_workers; i++ ) {
+      if ( !_thread_create( &_compress_pool.threads[i], _compress_thread_main, NULL ) ) {
+        _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: could only start %i of %i compression threads.\n", i, n_workers );
+        break;
+      }
+      _compress_pool.n_threads++;
+    }
+  }
+  _mutex_unlock( &_compress_pool.users_lock );
+}
+
+/** Take a reference to the compression pool only if its workers are already running for a video.
+ * @return False if the pool isn't running, and no reference was taken. */
+static bool _compress_pool_join( void ) {
+  _mutex_lock( &_compress_pool.users_lock );
+  bool running = _compress_pool.n_users > 0;
+  if ( running ) { _compress_pool.n_users++; }
+  _mutex_unlock( &_compress_pool.users_lock );
+  return running;
+}
+
+/** Drop a reference taken by _compress_pool_acquire() or _compress_pool_join(), joining the workers if it was the last. No batch can be queued without a reference. */
+static void _compress_pool_release( void ) {
+  _mutex_lock( &_compress_pool.users_lock );
+  if ( 0 == --_compress_pool.n_users ) {
+    _mutex_lock( &_compress_pool.lock );
+    _compress_pool.quit = true;
+    _cond_broadcast( &_compress_pool.work );
+    _mutex_unlock( &_compress_pool.lock );
+    for ( int i = 0; i < _compress_pool.n_threads; i++ ) { _thread_join( _compress_pool.threads[i] ); }
+    _compress_pool.n_threads = 0;
+  }
+  _mutex_unlock( &_compress_pool.users_lock );
+}
+
 //
 //
-bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
-  if ( !filename || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+int64_t vol_av_compressed_size( int w, int h, vol_av_texture_format_t format ) {
+  if ( w <= 0 || h <= 0 ) { return 0; }
+  switch ( format ) {
+  case VOL_AV_TEXTURE_FORMAT_RGB24: return (int64_t)w * h * 3;
+  case VOL_AV_TEXTURE_FORMAT_BC1:
+  case VOL_AV_TEXTURE_FORMAT_ETC2_RGB: return (int64_t)( ( w + 3 ) / 4 ) * ( ( h + 3 ) / 4 ) * 8;
+  default: return 0;
+  }
+}
 
-  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening URL `%s`...\n", filename );
+//
+//
+bool vol_av_compress_rgb( const uint8_t* rgb_ptr, int linesize, int w, int h, vol_av_texture_format_t format, int n_threads, uint8_t* dst_ptr ) {
+  if ( !rgb_ptr || !dst_ptr || w <= 0 || h <= 0 ) { return false; }
+  if ( VOL_AV_TEXTURE_FORMAT_BC1 != format && VOL_AV_TEXTURE_FORMAT_ETC2_RGB != format ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: texture format %i is not a compressed format.\n", (int)format );
+    return false;
+  }
+
+  int block_rows = ( h + 3 ) / 4;
+  if ( n_threads <= 0 ) { n_threads = _cpu_count(); }
+  if ( n_threads > VOL_AV_COMPRESS_MAX_THREADS ) { n_threads = VOL_AV_COMPRESS_MAX_THREADS; }
+  if ( n_threads > block_rows ) { n_threads = block_rows; }
+  // Without a video keeping the workers running, starting them for one image would cost more than they save.
+  if ( n_threads > 1 && !_compress_pool_join() ) { n_threads = 1; }
+
+  vol_av_compress_job_t jobs[VOL_AV_COMPRESS_MAX_THREADS];
+  for ( int i = 0; i < n_threads; i++ ) {
+    jobs[i].rgb_ptr         = rgb_ptr;
+    jobs[i].linesize        = linesize;
+    jobs[i].w               = w;
+    jobs[i].h               = h;
+    jobs[i].format          = format;
+    jobs[i].dst_ptr         = dst_ptr;
+    jobs[i].block_row_first = block_rows * i / n_threads;
+    jobs[i].block_row_end   = block_rows * ( i + 1 ) / n_threads;
+  }
+  if ( 1 == n_threads ) {
+    _compress_block_rows( &jobs[0] );
+    return true;
+  }
+
+  // Queue the bands for the pool's workers, and work through them here too, so the image is finished even if no worker is free.
+  vol_av_compress_batch_t batch = { jobs, n_threads, 0, 0, NULL };
+  _mutex_lock( &_compress_pool.lock );
+  vol_av_compress_batch_t** tail_pp = &_compress_pool.queue_ptr;
+  while ( *tail_pp ) { tail_pp = &( *tail_pp )->next_ptr; }
+  *tail_pp = &batch;
+  _cond_broadcast( &_compress_pool.work );
+  while ( batch.next_job < batch.n_jobs ) {
+    vol_av_compress_job_t* job_ptr = &batch.jobs_ptr[batch.next_job++];
+    if ( batch.next_job == batch.n_jobs ) { // Unqueue the batch. It may not be at the head if other callers are compressing too.
+      for ( tail_pp = &_compress_pool.queue_ptr; *tail_pp != &batch; tail_pp = &( *tail_pp )->next_ptr ) {}
+      *tail_pp = batch.next_ptr;
+    }
+    _mutex_unlock( &_compress_pool.lock );
+    _compress_block_rows( job_ptr );
+    _mutex_lock( &_compress_pool.lock );
+    _compress_finish( &batch );
+  }
+  while ( batch.n_done < batch.n_jobs ) { _cond_wait( &_compress_pool.done, &_compress_pool.lock ); }
+  _mutex_unlock( &_compress_pool.lock );
+  _compress_pool_release();
+
+  return true;
+}
+
+/******************************************************************************
+  CUSTOM INPUT
+  FFmpeg reads through these when opened with vol_av_open_io() or vol_av_open_memory(), instead of its file protocol.
+******************************************************************************/
+
+static int _avio_read( void* opaque, uint8_t* buf, int buf_size ) {
+  vol_av_internal_t* p = (vol_av_internal_t*)opaque;
+  int n                = 0;
+  if ( p->mem_ptr ) {
+    int64_t remaining = p->mem_sz - p->mem_pos;
+    n                 = remaining < buf_size ? (int)remaining : buf_size;
+    if ( n > 0 ) {
+      memcpy( buf, &p->mem_ptr[p->mem_pos], n );
+      p->mem_pos += n;
+    }
+  } else {
+    n = p->io.read_fn( p->io.user_ptr, buf, buf_size );
+  }
+  return n > 0 ? n : AVERROR_EOF;
+}
+
+static int64_t _avio_seek( void* opaque, int64_t offset, int whence ) {
+  vol_av_internal_t* p = (vol_av_internal_t*)opaque;
+  whence &= ~AVSEEK_FORCE;
+  if ( !p->mem_ptr ) { return p->io.seek_fn( p->io.user_ptr, offset, whence ); }
+
+  if ( AVSEEK_SIZE == whence ) { return p->mem_sz; }
+  int64_t pos = -1;
+  switch ( whence ) {
+  case SEEK_SET: pos = offset; break;
+  case SEEK_CUR: pos = p->mem_pos + offset; break;
+  case SEEK_END: pos = p->mem_sz + offset; break;
+  default: return -1;
+  }
+  if ( pos < 0 || pos > p->mem_sz ) { return -1; }
+  p->mem_pos = pos;
+  return pos;
+}
+
+/** Allocate the format context with a custom AVIOContext that reads through _avio_read(), so that avformat_open_input() doesn't open a file. */
+static bool _open_custom_io( vol_av_internal_t* p, int buffer_sz ) {
+  if ( buffer_sz <= 0 ) { buffer_sz = VOL_AV_IO_BUFFER_SZ; }
+  // The buffer must come from av_malloc(), because FFmpeg may replace it.
+  uint8_t* buffer_ptr = av_malloc( buffer_sz );
+  if ( !buffer_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate %i byte I/O buffer.\n", buffer_sz );
+    return false;
+  }
+  bool seekable   = p->mem_ptr || p->io.seek_fn;
+  p->avio_ctx_ptr = avio_alloc_context( buffer_ptr, buffer_sz, 0, p, _avio_read, NULL, seekable ? _avio_seek : NULL );
+  if ( !p->avio_ctx_ptr ) {
+    av_free( buffer_ptr );
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate AVIOContext.\n" );
+    return false;
+  }
+  p->fmt_ctx_ptr = avformat_alloc_context();
+  if ( !p->fmt_ctx_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate AVFormatContext.\n" );
+    return false;
+  }
+  p->fmt_ctx_ptr->pb = p->avio_ctx_ptr;
+  p->fmt_ctx_ptr->flags |= AVFMT_FLAG_CUSTOM_IO;
+  return true;
+}
 
+/** Zero `info_ptr` and allocate its internal context. */
+static bool _create_context( vol_av_video_t* info_ptr ) {
   memset( info_ptr, 0, sizeof( vol_av_video_t ) );
   info_ptr->_context_ptr = calloc( 1, sizeof( vol_av_internal_t ) );
   if ( !info_ptr->_context_ptr ) {
     _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for internal pointer\n" );
     return false;
   }
+  _mem_video_opened();
+  info_ptr->buffer_idx                    = -1;
+  info_ptr->_context_ptr->decoded_s       = -1.0;
+  info_ptr->_context_ptr->decode_priority = 1.0f;
+  return true;
+}
+
+/** Everything vol_av_open() does after the context is created. Reads the container header, opens the decoders, and decodes the first frame.
+ * @param filename File or URL to open, or NULL if the format context was already set up to read through _open_custom_io().
+ */
+static bool _open_streams( vol_av_video_t* info_ptr, const char* filename ) {
   vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( !filename ) { filename = ""; }
 
   { // Open the file and read its header. The codecs are not opened. -- note that if first param is NULL then this allocates memory.
+    // With custom I/O the format context was allocated by _open_custom_io(), and FFmpeg frees it here if this fails.
     if ( avformat_open_input( &p->fmt_ctx_ptr, filename, NULL, NULL ) < 0 ) { // NOTE(Anton) the second param is `url` and we can try a web stream.
       _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to open input file.\n" );
       return false;
@@ -96,6 +922,7 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
 
     AVCodecParameters* codec_params_ptr = NULL; // https://ffmpeg.org/doxygen/trunk/structAVCodecParameters.html
     p->video_stream_idx                 = -1;
+    p->audio_stream_idx                 = -1;
     // Now p->fmt_ctx_ptr->streams is just an array of pointers, so let's walk through it until we find a video stream.
     for ( unsigned int i = 0; i < p->fmt_ctx_ptr->nb_streams; ++i ) {
       _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "AVStream->time_base before open coded %d/%d\n", p->fmt_ctx_ptr->streams[i]->time_base.num,
@@ -125,6 +952,10 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
         }
         _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Video Codec: resolution %dx%d\n", tmp_codec_params_ptr->width, tmp_codec_params_ptr->height );
       } else if ( tmp_codec_params_ptr->codec_type == AVMEDIA_TYPE_AUDIO ) {
+        if ( p->audio_stream_idx == -1 ) {
+          p->audio_stream_idx = i;
+          p->audio_codec_ptr  = (AVCodec*)tmp_codec_ptr;
+        }
 #if LIBAVUTIL_VERSION_CHECK(57, 28, 100)
         _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Audio Codec: %d channels, sample rate %d\n", tmp_codec_params_ptr->ch_layout.nb_channels, tmp_codec_params_ptr->sample_rate );
 #else
@@ -157,19 +988,23 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
     // multi-threading set-up ( called before avcodec_open2 ).
     // This was 9 on Android and Windows desktop.
     {
-      // 0 lets device choose number of threads.
-      p->codec_ctx_ptr->thread_count = 0;
-      // NOTE(Anton) don't use FF_THREAD_FRAME - it causes desync.
+      // 0 lets device choose number of threads. Under the shared scheduler the pool spreads streams over the cores instead, so ten streams
+      // don't each start a thread per core.
+      p->codec_ctx_ptr->thread_count = _sched.running ? VOL_AV_SCHED_CODEC_THREADS : 0;
+      // Frame threading is safe because _read_next_frame() doesn't assume one output frame per packet, and drains delayed frames at the end of file.
       // https://ffmpeg.org/doxygen/3.2/structAVCodecContext.html#a7651614f4309122981d70e06a4b42fcb
-      /*  if ( p->codec_ptr->capabilities | AV_CODEC_CAP_FRAME_THREADS ) {
-          p->codec_ctx_ptr->thread_type = FF_THREAD_FRAME;*/
-      if ( p->codec_ptr->capabilities | AV_CODEC_CAP_SLICE_THREADS ) {
-        p->codec_ctx_ptr->thread_type = FF_THREAD_SLICE;
+      int thread_type = 0;
+      if ( ( VOL_AV_THREAD_TYPE & FF_THREAD_FRAME ) && ( p->codec_ptr->capabilities & AV_CODEC_CAP_FRAME_THREADS ) ) { thread_type |= FF_THREAD_FRAME; }
+      if ( ( VOL_AV_THREAD_TYPE & FF_THREAD_SLICE ) && ( p->codec_ptr->capabilities & AV_CODEC_CAP_SLICE_THREADS ) ) { thread_type |= FF_THREAD_SLICE; }
+      if ( thread_type ) {
+        p->codec_ctx_ptr->thread_type = thread_type;
       } else {
         p->codec_ctx_ptr->thread_count = 1; // Don't use multithreading.
       }
     }
 #endif
+    // Lets the decoder work out best_effort_timestamp, which is used instead of counting frames.
+    p->codec_ctx_ptr->pkt_timebase = p->fmt_ctx_ptr->streams[p->video_stream_idx]->time_base;
 
     // Initialise the AVCodecContext to use the given AVCodec.
     // https://ffmpeg.org/doxygen/trunk/group__lavc__core.html#ga11f785a188d7d9df71621001465b0f1d
@@ -177,15 +1012,35 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
       _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to open codec through avcodec_open2\n" );
       return false;
     }
+#ifdef VOL_AV_THREADED
+    _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Decoder threads %i, thread type %i\n", p->codec_ctx_ptr->thread_count, p->codec_ctx_ptr->active_thread_type );
+#endif
   } // endblock Video Codec Context
 
-  { // Allocate Frame Storage
+  // Audio is optional, so if it can't be decoded the file is still played without it.
+  if ( p->audio_stream_idx >= 0 && !_open_audio( p ) ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: failed to open the audio stream. Playing without audio.\n" );
+    _close_audio( p );
+  }
+
+  { // Allocate Frame Storage. These are allocated once here and reused for every frame, to avoid allocator contention during playback.
+    p->packet_ptr           = av_packet_alloc(); // https://ffmpeg.org/doxygen/trunk/structAVPacket.html
     p->output_frame_ptr     = av_frame_alloc();
     p->output_frame_rgb_ptr = av_frame_alloc();
-    if ( !p->output_frame_ptr || !p->output_frame_rgb_ptr ) {
+    p->due_frame_ptr        = av_frame_alloc();
+    if ( !p->packet_ptr || !p->output_frame_ptr || !p->output_frame_rgb_ptr || !p->due_frame_ptr ) {
       _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocate frame storage.\n" );
       return false;
     }
+    if ( p->audio_stream_idx >= 0 ) {
+      for ( int i = 0; i < VOL_AV_VIDEO_QUEUE_LEN; i++ ) {
+        p->video_queue_ptr[i] = av_packet_alloc();
+        if ( !p->video_queue_ptr[i] ) {
+          _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocate packet queue.\n" );
+          return false;
+        }
+      }
+    }
     p->output_frame_rgb_ptr->format = AV_PIX_FMT_RGB24;
     p->output_frame_rgb_ptr->width  = p->codec_ctx_ptr->width;
     p->output_frame_rgb_ptr->height = p->codec_ctx_ptr->height;
@@ -224,9 +1079,58 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
       NULL, NULL, NULL                    // filters and param
     );
   } // endblock init SWS context
+
+  // Decode the first frame now, so that the decoder's start-up delay (several packets with frame threading) is paid when opening rather than
+  // as a hitch on the first frame of playback. It is handed out by the first read.
+  if ( _read_next_frame( p ) < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to decode the first frame.\n" );
+    return false;
+  }
+  p->frame_pending = true;
+
   return true;
 }
 
+//
+//
+bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
+  if ( !filename || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+
+  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening URL `%s`...\n", filename );
+
+  if ( !_create_context( info_ptr ) ) { return false; }
+  return _open_streams( info_ptr, filename );
+}
+
+//
+//
+bool vol_av_open_io( const vol_av_io_t* io_ptr, vol_av_video_t* info_ptr ) {
+  if ( !io_ptr || !io_ptr->read_fn || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+
+  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening video from application I/O callbacks...\n" );
+
+  if ( !_create_context( info_ptr ) ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  p->io                = *io_ptr;
+  if ( !_open_custom_io( p, io_ptr->buffer_sz ) ) { return false; }
+  return _open_streams( info_ptr, NULL );
+}
+
+//
+//
+bool vol_av_open_memory( const uint8_t* data_ptr, int64_t data_sz, int buffer_sz, vol_av_video_t* info_ptr ) {
+  if ( !data_ptr || data_sz <= 0 || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+
+  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening video from %lld bytes of memory...\n", (long long)data_sz );
+
+  if ( !_create_context( info_ptr ) ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  p->mem_ptr           = data_ptr;
+  p->mem_sz            = data_sz;
+  if ( !_open_custom_io( p, buffer_sz ) ) { return false; }
+  return _open_streams( info_ptr, NULL );
+}
+
 //
 //
 bool vol_av_close( vol_av_video_t* info_ptr ) {
@@ -235,162 +1139,1900 @@ bool vol_av_close( vol_av_video_t* info_ptr ) {
   _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "Releasing all the resources...\n" );
 
   vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->shared_ptr ) { _release_shared_cursor( p ); } // Everything else below is NULL for an instance of a shared video.
+
+  // The decode thread uses the contexts below, so it must be stopped first.
+  if ( p->decode_thread_running ) { vol_av_stop_decode_thread( info_ptr ); }
 
   if ( p->fmt_ctx_ptr ) { avformat_close_input( &p->fmt_ctx_ptr ); }
+  // The buffer may have been replaced by FFmpeg, so free the one the context holds now rather than the one we allocated.
+  if ( p->avio_ctx_ptr ) {
+    av_freep( &p->avio_ctx_ptr->buffer );
+    avio_context_free( &p->avio_ctx_ptr );
+  }
+  if ( p->packet_ptr ) { av_packet_free( &p->packet_ptr ); }
+  for ( int i = 0; i < VOL_AV_VIDEO_QUEUE_LEN; i++ ) {
+    if ( p->video_queue_ptr[i] ) { av_packet_free( &p->video_queue_ptr[i] ); }
+  }
+  _close_audio( p );
   if ( p->output_frame_ptr ) { av_frame_free( &p->output_frame_ptr ); }
+  if ( p->due_frame_ptr ) { av_frame_free( &p->due_frame_ptr ); }
+  _free_reverse_cache( p );
   if ( p->output_frame_rgb_ptr ) {
     av_freep( &p->output_frame_rgb_ptr->data[0] );
     av_frame_free( &p->output_frame_rgb_ptr );
   }
   if ( p->codec_ctx_ptr ) { avcodec_free_context( &p->codec_ctx_ptr ); }
+  if ( p->scrub_codec_ctx_ptr ) { avcodec_free_context( &p->scrub_codec_ctx_ptr ); }
+  free( p->compressed_ptr );
+  _free_user_compressed( p );
+  if ( VOL_AV_TEXTURE_FORMAT_RGB24 != p->texture_format ) { _compress_pool_release(); }
 
   // tools
   if ( p->sws_conv_ctx_ptr ) { sws_freeContext( p->sws_conv_ctx_ptr ); }
 
+  // The buffers themselves belong to the application, only the lists are ours.
+  free( p->user_buffers_ptr );
+  free( p->user_buffer_held_ptr );
+
   free( info_ptr->_context_ptr );                  // this is our internal struct we allocated
   memset( info_ptr, 0, sizeof( vol_av_video_t ) ); // wipe for subsequent use
+  _mem_video_closed();
 
   return true;
 }
 
-//
-//
-static void _save_rgb_frame( vol_av_video_t* info_ptr ) {
-  vol_av_internal_t* p = info_ptr->_context_ptr;
+/** Get the size that frames are currently converted to, for the output scale level set by vol_av_set_output_scale(). */
+static void _output_dims( vol_av_internal_t* p, int* w_ptr, int* h_ptr ) {
+  int level = (int)_atomic_load_u32( &p->output_scale_level );
+  if ( p->scrubbing && p->scrub_scale_level > level ) { level = p->scrub_scale_level; }
+  *w_ptr    = p->codec_ctx_ptr->width >> level;
+  *h_ptr    = p->codec_ctx_ptr->height >> level;
+  if ( *w_ptr < 1 ) { *w_ptr = 1; }
+  if ( *h_ptr < 1 ) { *h_ptr = 1; }
+}
 
-  info_ptr->w = p->output_frame_ptr->width;
-  info_ptr->h = p->output_frame_ptr->height;
-  //   printf("[vol_av] DEBUG - frame wxh %ix%i linesize %i\n", info_ptr->w, info_ptr->h, p->output_frame_rgb_ptr->linesize[0] );
-  // Convert the image from its native format to RGB
-  sws_scale( p->sws_conv_ctx_ptr,                     // context.
-    (uint8_t const* const*)p->output_frame_ptr->data, // src slice.
-    p->output_frame_ptr->linesize,                    // src stride.
-    0,                                                // slice y.
-    info_ptr->h,                                      // slice h.
-    p->output_frame_rgb_ptr->data,                    // dst.
-    p->output_frame_rgb_ptr->linesize                 // dst stride.
+/** Convert the decoded image in `src_ptr` from its native format to RGB of size `dst_w` x `dst_h`, writing to `dst_data`.
+ * The scaling context is only rebuilt when the source or destination size or format changes, e.g. after vol_av_set_output_scale().
+ * If `flip_vertical` is set the rows are written bottom-up using a negative stride, which mirrors the image as part of the conversion.
+ * @return False if a scaling context could not be created for this conversion.
+ */
+static bool _convert_frame(
+  vol_av_internal_t* p, const AVFrame* src_ptr, uint8_t* const dst_data[4], const int dst_linesize[4], int dst_w, int dst_h, bool flip_vertical ) {
+  p->sws_conv_ctx_ptr = sws_getCachedContext( p->sws_conv_ctx_ptr, //
+    src_ptr->width, src_ptr->height, (enum AVPixelFormat)src_ptr->format,  // src
+    dst_w, dst_h, AV_PIX_FMT_RGB24,                                        // dst
+    SWS_BILINEAR, NULL, NULL, NULL                                         // scaling flags, filters and param
   );
-  // Remember that you can cast an AVFrame pointer to an AVPicture pointer.
-  // can now save or use this data and increment frame counter
-  info_ptr->pixels_ptr = p->output_frame_rgb_ptr->data[0]; // [0] is the first (red) channel. output usually has 3 but can have 4 channels.
-}
+  if ( !p->sws_conv_ctx_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to get SWS context for %ix%i -> %ix%i.\n", src_ptr->width, src_ptr->height, dst_w, dst_h );
+    return false;
+  }
 
-//
-//
-static int _decode_packet( vol_av_video_t* info_ptr, AVPacket* packet_ptr ) {
-  vol_av_internal_t* p = info_ptr->_context_ptr;
+  uint8_t* dst_ptrs[4] = { dst_data[0], NULL, NULL, NULL };
+  int dst_strides[4]   = { dst_linesize[0], 0, 0, 0 };
+  if ( flip_vertical ) {
+    dst_ptrs[0]    = dst_data[0] + ( dst_h - 1 ) * dst_linesize[0];
+    dst_strides[0] = -dst_linesize[0];
+  }
+  sws_scale( p->sws_conv_ctx_ptr,             // context.
+    (uint8_t const* const*)src_ptr->data,     // src slice.
+    src_ptr->linesize,                        // src stride.
+    0,                                        // slice y.
+    src_ptr->height,                          // slice h.
+    dst_ptrs,                                 // dst.
+    dst_strides                               // dst stride.
+  );
+  return true;
+}
 
-  /*
-  * Important Note:
-  *
-  * Return codes such as AVERROR_EOF and AVERROR( EAGAIN ) are negative return codes, but not necessarily errors. We still need to decode packets left behind
-  after finding EOF, and there may be additional trailing packets that need processing after finding EOF.
-  * All /other/ negative values are errors.
-  * The first few frame reads often produce EAGAIN codes, meaning we need to call frame read again to buffer the full frame of packets (otherwise the first
-  few frames of the video sequence are blank).
-  * This is IMO an error-prone error handling API design and lots of examples/tutorials misunderstand this and end up dropping the last few frames in a video.
-  * A better video processing API would handle these states internally, not require the programmer to call 'read_frame' an unpredictable number of times in
-  order to read a frame, and then loop over unknown numbers of packets that spit out unreliably.
-  * -- Anton.
-  */
-
-  // Supply raw packet data as input to a decoder
-  int response = avcodec_send_packet( p->codec_ctx_ptr, packet_ptr ); // https://ffmpeg.org/doxygen/trunk/group__lavc__decoding.html#ga58bc4bf1e0ac59e27362597e467efff3
-  if ( response < 0 && response != AVERROR_EOF ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while sending a packet to the decoder: %s\n", av_err2str( response ) );
-    return response;
+/** @return Index of the next application output buffer that is not held by the application, or -1 if they are all held. */
+static int _find_free_user_buffer( const vol_av_internal_t* p ) {
+  for ( int i = 0; i < p->n_user_buffers; i++ ) {
+    int idx = ( p->next_user_buffer + i ) % p->n_user_buffers;
+    if ( !p->user_buffer_held_ptr[idx] ) { return idx; }
   }
+  return -1;
+}
 
-  // Counter to escape infinite loop if API requests a frame off the end of the video and it doesn't exist.
-  const int overflow_retry_limit = 16; // NOTE(Anton) I have no idea how many overflow frames there can be - assume it's <5 !
-  int overflow_retry_count       = 0;
+/** @return Index of the frame presented at `pts_s`, counting from 0 at the stream's frame rate. This is also the index of the matching geometry frame. */
+static int64_t _frame_index( const vol_av_internal_t* p, double pts_s ) {
+  AVRational avfr = p->fmt_ctx_ptr->streams[p->video_stream_idx]->avg_frame_rate;
+  if ( avfr.num <= 0 || avfr.den <= 0 || pts_s <= 0.0 ) { return 0; }
+  return (int64_t)( pts_s * av_q2d( avfr ) + 0.5 ); // Rounded, as timestamps in coarse time bases are truncated.
+}
 
-  while ( ( response >= 0 || response == AVERROR_EOF ) && ( overflow_retry_count < overflow_retry_limit ) ) {
-    // Return decoded output data (into a frame) from a decoder
-    response = avcodec_receive_frame( p->codec_ctx_ptr, p->output_frame_ptr ); // https://ffmpeg.org/doxygen/trunk/group__lavc__decoding.html#ga11e6542c4e66d3028668788a1a74217c
-    if ( response == AVERROR( EAGAIN ) ) {                                     //|| response == AVERROR_EOF
-      return response;
-    } else if ( response < 0 && response != AVERROR_EOF ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while receiving a frame from the decoder: %s\n", av_err2str( response ) );
+/** Encode the RGB image just given to the application, if compression is on, and point `info_ptr` at the result. */
+static void _compress_output( vol_av_video_t* info_ptr, const uint8_t* rgb_ptr, int linesize ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  uint8_t* dst_ptr     = NULL;
+  if ( VOL_AV_TEXTURE_FORMAT_RGB24 != p->texture_format ) { dst_ptr = info_ptr->buffer_idx >= 0 ? p->user_compressed_ptr[info_ptr->buffer_idx] : p->compressed_ptr; }
+  if ( !dst_ptr || !vol_av_compress_rgb( rgb_ptr, linesize, info_ptr->w, info_ptr->h, p->texture_format, 0, dst_ptr ) ) {
+    info_ptr->compressed_ptr = NULL;
+    info_ptr->compressed_sz  = 0;
+    return;
+  }
+  info_ptr->compressed_ptr = dst_ptr;
+  info_ptr->compressed_sz  = vol_av_compressed_size( info_ptr->w, info_ptr->h, p->texture_format );
+}
+
+/** Convert the decoded frame `src_ptr`, with presentation time `pts_s`, to RGB and point `info_ptr` at the result.
+ * @return False if the frame could not be converted, leaving `info_ptr` pointing at the previous frame.
+ */
+static bool _save_rgb_frame( vol_av_video_t* info_ptr, const AVFrame* src_ptr, double pts_s, int user_buffer_idx, bool flip_vertical ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  p->decoded_s         = pts_s;
+
+  int w = 0, h = 0;
+  _output_dims( p, &w, &h );
+  //   printf("[vol_av] DEBUG - frame wxh %ix%i linesize %i\n", w, h, p->output_frame_rgb_ptr->linesize[0] );
+
+  // Convert straight into the application's buffer, if it gave us some, so it doesn't need to copy the image out before the next decode.
+  if ( user_buffer_idx >= 0 ) {
+    uint8_t* dst_data[4] = { p->user_buffers_ptr[user_buffer_idx], NULL, NULL, NULL };
+    int dst_linesize[4]  = { w * 3, 0, 0, 0 };
+    if ( !_convert_frame( p, src_ptr, dst_data, dst_linesize, w, h, flip_vertical ) ) { return false; }
+    info_ptr->pts_s                          = pts_s;
+    info_ptr->frame_idx                      = _frame_index( p, pts_s );
+    info_ptr->w                              = w;
+    info_ptr->h                              = h;
+    p->user_buffer_held_ptr[user_buffer_idx] = true;
+    p->next_user_buffer                      = ( user_buffer_idx + 1 ) % p->n_user_buffers;
+    info_ptr->pixels_ptr                     = dst_data[0];
+    info_ptr->buffer_idx                     = user_buffer_idx;
+    _compress_output( info_ptr, dst_data[0], dst_linesize[0] );
+    return true;
+  }
+
+  // Convert the image from its native format to RGB. The buffer is sized for the full video, so a reduced output scale still fits when tightly packed.
+  int dst_linesize[4] = { w * 3, 0, 0, 0 };
+  if ( !_convert_frame( p, src_ptr, p->output_frame_rgb_ptr->data, dst_linesize, w, h, flip_vertical ) ) { return false; }
+  info_ptr->pts_s     = pts_s;
+  info_ptr->frame_idx = _frame_index( p, pts_s );
+  info_ptr->w         = w;
+  info_ptr->h         = h;
+  // Remember that you can cast an AVFrame pointer to an AVPicture pointer.
+  // can now save or use this data and increment frame counter
+  info_ptr->pixels_ptr = p->output_frame_rgb_ptr->data[0]; // [0] is the first (red) channel. output usually has 3 but can have 4 channels.
+  info_ptr->buffer_idx = -1;
+  _compress_output( info_ptr, info_ptr->pixels_ptr, dst_linesize[0] );
+  return true;
+}
+
+/** @return A timestamp from stream `stream_idx` converted to seconds from the start of that stream. */
+static double _stream_time_s( const vol_av_internal_t* p, int stream_idx, int64_t ts ) {
+  const AVStream* strm_ptr = p->fmt_ctx_ptr->streams[stream_idx];
+  if ( AV_NOPTS_VALUE != strm_ptr->start_time ) { ts -= strm_ptr->start_time; }
+  return (double)ts * av_q2d( strm_ptr->time_base );
+}
+
+/** @return The presentation time, in seconds from the start of the video stream, of a frame that was output by the decoder. */
+static double _frame_pts_s( const vol_av_internal_t* p, const AVFrame* frame_ptr ) {
+  int64_t ts = frame_ptr->best_effort_timestamp;
+  if ( AV_NOPTS_VALUE == ts ) { ts = frame_ptr->pts; }
+  if ( AV_NOPTS_VALUE == ts ) { return 0.0; }
+  return _stream_time_s( p, p->video_stream_idx, ts );
+}
+
+/** @return True if audio packets should be decoded, rather than discarded. Audio is skipped while scrubbing, as it won't be played. */
+static bool _decoding_audio( vol_av_internal_t* p ) { return p->audio_codec_ctx_ptr && _atomic_load_u32( &p->audio_enabled ) && !p->scrubbing; }
+
+/** Read packets from the file until a video packet is in `packet_ptr`. Audio packets met on the way are decoded into the audio ring, and
+ * packets from any other stream are discarded.
+ * @return 0 if a video packet was read, or a negative value at the end of the file or on a read error.
+ */
+static int _demux_video_packet( vol_av_internal_t* p ) {
+  AVPacket* packet_ptr = p->packet_ptr;
+  while ( !p->file_eof ) {
+    // fill the Packet with data from the Stream
+    // https://ffmpeg.org/doxygen/trunk/group__lavf__decoding.html#ga4fdb3084415a82e3810de6ee60e46a61
+    int response = av_read_frame( p->fmt_ctx_ptr, packet_ptr );
+    if ( response < 0 ) {
+      if ( response != AVERROR_EOF ) { _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: stopped reading packets: %s\n", av_err2str( response ) ); }
+      p->file_eof = true;
+      // Flush the audio decoder's last samples into the ring.
+      if ( _decoding_audio( p ) ) { _decode_audio_packet( p, NULL ); }
       return response;
     }
-    // NOTE(Anton) i think this is always true >=0 at this point.
+    if ( packet_ptr->stream_index == p->video_stream_idx ) { return 0; }
+    if ( packet_ptr->stream_index == p->audio_stream_idx && _decoding_audio( p ) ) {
+      _decode_audio_packet( p, packet_ptr );
+    }
+    av_packet_unref( packet_ptr );
+  }
+  return AVERROR_EOF;
+}
+
+/** Keep demuxing until there is VOL_AV_AUDIO_LEAD_S seconds of audio past `pts_s`. The video packets read on the way are queued for the
+ * video decoder. Audio and video are interleaved in the file by time, so without this the audio would only be as far ahead as the last video frame
+ * read, and the engine's audio thread, which reads ahead of what is playing, would run dry.
+ */
+static void _demux_audio_ahead( vol_av_internal_t* p, double pts_s ) {
+  if ( !_decoding_audio( p ) ) { return; }
+  while ( !p->file_eof && p->audio_demuxed_s < pts_s + VOL_AV_AUDIO_LEAD_S && p->video_queue_count < VOL_AV_VIDEO_QUEUE_LEN ) {
+    if ( _demux_video_packet( p ) < 0 ) { break; }
+    int tail = ( p->video_queue_head + p->video_queue_count ) % VOL_AV_VIDEO_QUEUE_LEN;
+    av_packet_move_ref( p->video_queue_ptr[tail], p->packet_ptr );
+    p->video_queue_count++;
+  }
+}
+
+/** Demux and decode packets until the decoder outputs a frame into `output_frame_ptr`.
+ *
+ * Important Note:
+ *
+ * Return codes such as AVERROR_EOF and AVERROR( EAGAIN ) are negative return codes, but not necessarily errors.
+ * With frame threading the decoder holds back up to `thread_count` frames, so it can take many packets before the first frame comes out, and the
+ * last frames only come out after the decoder is put into draining mode at the end of the file. We therefore never assume one frame per packet, or one
+ * frame per call - we keep feeding packets until a frame is received, and identify frames by their timestamp rather than by how many calls were made.
+ * All /other/ negative values are errors.
+ *
+ * vol_av doesn't allocate here: the packet, frames, and conversion buffers are allocated once by vol_av_open() and reused. FFmpeg still allocates each
+ * packet's payload and its buffer references on every frame, unless built with VOL_AV_MALLOC_PREFIX, when those blocks are recycled by the allocator above.
+ *
+ * @return 0 if a frame was output, AVERROR_EOF once all frames have been drained from the decoder, or another negative value on error.
+ */
+static int _read_next_frame( vol_av_internal_t* p ) {
+  AVPacket* packet_ptr = p->packet_ptr;
+  int response         = 0;
+  while ( true ) {
+    // Return decoded output data (into a frame) from a decoder
+    response = avcodec_receive_frame( p->codec_ctx_ptr, p->output_frame_ptr ); // https://ffmpeg.org/doxygen/trunk/group__lavc__decoding.html#ga11e6542c4e66d3028668788a1a74217c
     if ( response >= 0 ) {
 #ifdef VOL_AV_DEBUG_EXTRA
       _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Frame %d (type=%c, size=%d bytes, format=%d) pts %d key_frame %d [DTS %d]\n", p->codec_ctx_ptr->frame_number,
         av_get_picture_type_char( p->output_frame_ptr->pict_type ), p->output_frame_ptr->pkt_size, p->output_frame_ptr->format, p->output_frame_ptr->pts,
         p->output_frame_ptr->key_frame, p->output_frame_ptr->coded_picture_number );
 #endif
-      _save_rgb_frame( info_ptr );
-      return response;
+      p->frame_pts_s = _frame_pts_s( p, p->output_frame_ptr );
+      p->frames_decoded++;
+      _demux_audio_ahead( p, p->frame_pts_s );
+      response = 0;
+      break;
+    }
+    if ( response == AVERROR_EOF ) { // Every delayed frame has been drained.
+      p->decoder_eof = true;
+      break;
+    }
+    if ( response != AVERROR( EAGAIN ) ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while receiving a frame from the decoder: %s\n", av_err2str( response ) );
+      break;
+    }
+
+    // The decoder needs more input. Packets already read ahead for the audio come first.
+    int read_response = 0;
+    if ( p->video_queue_count > 0 ) {
+      av_packet_move_ref( packet_ptr, p->video_queue_ptr[p->video_queue_head] );
+      p->video_queue_head = ( p->video_queue_head + 1 ) % VOL_AV_VIDEO_QUEUE_LEN;
+      p->video_queue_count--;
+    } else {
+      read_response = _demux_video_packet( p );
+    }
+    if ( read_response < 0 ) {
+      if ( p->demux_eof ) { // Already draining, but the decoder did not report EOF. Don't loop forever.
+        p->decoder_eof = true;
+        response       = AVERROR_EOF;
+        break;
+      }
+      // A NULL packet puts the decoder into draining mode, so that it outputs the frames it is holding back.
+      p->demux_eof = true;
+      avcodec_send_packet( p->codec_ctx_ptr, NULL );
+      continue;
+    }
+
+    // Supply raw packet data as input to a decoder
+    response = avcodec_send_packet( p->codec_ctx_ptr, packet_ptr ); // https://ffmpeg.org/doxygen/trunk/group__lavc__decoding.html#ga58bc4bf1e0ac59e27362597e467efff3
+    // https://ffmpeg.org/doxygen/trunk/group__lavc__packet.html#ga63d5a489b419bd5d45cfd09091cbcbc2
+    av_packet_unref( packet_ptr );
+    if ( response < 0 && response != AVERROR( EAGAIN ) ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while sending a packet to the decoder: %s\n", av_err2str( response ) );
+      break;
     }
-    overflow_retry_count++;
   } // endwhile
 
-  return response;
+  return response;
+}
+
+//
+//
+bool vol_av_read_next_frame( vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: info_ptr || !info_ptr->_context_ptr NULL.\n" );
+    return false;
+  }
+  if ( _is_shared_cursor( info_ptr, "vol_av_read_next_frame" ) ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: vol_av_read_next_frame() can not be used while the decode thread is running. Use vol_av_acquire_frame().\n" );
+    return false;
+  }
+
+  // Check there is somewhere to put the frame before decoding it, so it isn't lost.
+  int user_buffer_idx = -1;
+  if ( p->n_user_buffers > 0 ) {
+    user_buffer_idx = _find_free_user_buffer( p );
+    if ( user_buffer_idx < 0 ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: all output buffers are held by the application. Call vol_av_release_output_buffer() first.\n" );
+      return false;
+    }
+  }
+
+  // Scrubbing moved the demuxer on without the main decoder, so carry on from the frame after the one shown.
+  if ( p->scrubbing && !_resume_after_scrub( p, info_ptr->pts_s ) ) { return false; }
+
+  // The first frame was already decoded by vol_av_open() to absorb the decoder's start-up delay.
+  if ( p->frame_pending ) {
+    p->frame_pending = false;
+    return _save_rgb_frame( info_ptr, p->output_frame_ptr, p->frame_pts_s, user_buffer_idx, false );
+  }
+
+  int response = _read_next_frame( p );
+  if ( response == AVERROR_EOF ) { return false; }
+  if ( response < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: packet response was %i.\n", response );
+    return false;
+  }
+  return _save_rgb_frame( info_ptr, p->output_frame_ptr, p->frame_pts_s, user_buffer_idx, false );
+}
+
+/** Rewind or skip the demuxer and decoders to the keyframe at or before `pts_s`. The frames between that keyframe and `pts_s` are still to be decoded. */
+static bool _seek( vol_av_internal_t* p, double pts_s ) {
+  const AVStream* v_strm_ptr = p->fmt_ctx_ptr->streams[p->video_stream_idx];
+  int64_t ts                 = (int64_t)( pts_s / av_q2d( v_strm_ptr->time_base ) );
+  if ( AV_NOPTS_VALUE != v_strm_ptr->start_time ) { ts += v_strm_ptr->start_time; }
+  int response = av_seek_frame( p->fmt_ctx_ptr, p->video_stream_idx, ts, AVSEEK_FLAG_BACKWARD );
+  if ( response < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to seek to %f s: %s\n", pts_s, av_err2str( response ) );
+    return false;
+  }
+  avcodec_flush_buffers( p->codec_ctx_ptr );
+  while ( p->video_queue_count > 0 ) { // Packets read ahead are from before the seek.
+    av_packet_unref( p->video_queue_ptr[p->video_queue_head] );
+    p->video_queue_head = ( p->video_queue_head + 1 ) % VOL_AV_VIDEO_QUEUE_LEN;
+    p->video_queue_count--;
+  }
+  p->file_eof      = false;
+  p->demux_eof     = false;
+  p->decoder_eof   = false;
+  p->frame_pending = false;
+  p->decoded_s     = -1.0;
+  if ( p->audio_codec_ctx_ptr ) {
+    avcodec_flush_buffers( p->audio_codec_ctx_ptr );
+    p->audio_demuxed_s = pts_s;
+    p->audio_started   = false;
+    // The ring can only be emptied by its reader, so tell it where the audio from after the seek starts.
+    _atomic_store_u32( &p->audio_discard_to, p->audio_written );
+  }
+  return true;
+}
+
+static void _free_reverse_cache( vol_av_internal_t* p ) {
+  if ( !p->rev_slots_ptr ) { return; }
+  for ( int i = 0; i < p->rev_max_slots; i++ ) {
+    if ( p->rev_slots_ptr[i].data[0] ) { av_freep( &p->rev_slots_ptr[i].data[0] ); }
+  }
+  free( p->rev_slots_ptr );
+  p->rev_slots_ptr = NULL;
+  p->rev_first     = 0;
+  p->rev_count     = 0;
+}
+
+/** @return Index in rev_slots_ptr of the newest cached frame that is due at `due_s`, or -1 if the reverse cache doesn't cover that time. */
+static int _find_reverse_slot( vol_av_internal_t* p, double due_s, bool flip_vertical ) {
+  if ( 0 == p->rev_count || p->rev_flip != flip_vertical || due_s >= p->rev_end_s ) { return -1; }
+  int w = 0, h = 0;
+  _output_dims( p, &w, &h );
+  int found_idx = -1;
+  for ( int i = 0; i < p->rev_count; i++ ) {
+    int idx = ( p->rev_first + i ) % p->rev_max_slots;
+    if ( p->rev_slots_ptr[idx].pts_s > due_s ) { break; }
+    found_idx = idx;
+  }
+  // Converted before the output scale was changed.
+  if ( found_idx >= 0 && ( p->rev_slots_ptr[found_idx].w != w || p->rev_slots_ptr[found_idx].h != h ) ) { return -1; }
+  return found_idx;
+}
+
+/** Seek to the keyframe before `pts_s` and decode forwards to the frame due at `due_s`, converting each frame into the reverse cache, which keeps
+ * the newest rev_max_slots of them. The frame after is left pending, so forward play can carry on from there without another seek.
+ * If the GOP is longer than the cache, the frames converted first are overwritten, which wastes their conversions but keeps memory bounded.
+ * @return False on error.
+ */
+static bool _fill_reverse_cache( vol_av_internal_t* p, double pts_s, double due_s, bool flip_vertical ) {
+  if ( !p->rev_slots_ptr ) {
+    p->rev_slots_ptr = calloc( p->rev_max_slots, sizeof( vol_av_frame_slot_t ) );
+    if ( !p->rev_slots_ptr ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for reverse cache slots\n" );
+      return false;
+    }
+  }
+  if ( !_seek( p, pts_s ) ) { return false; }
+
+  int frame_sz  = av_image_get_buffer_size( AV_PIX_FMT_RGB24, p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, 1 );
+  p->rev_first  = 0;
+  p->rev_count  = 0;
+  p->rev_end_s  = DBL_MAX; // Unless a later frame is found, the cache runs to the end of the stream.
+  p->rev_flip   = flip_vertical;
+  while ( true ) {
+    if ( _read_next_frame( p ) < 0 ) { break; }
+    if ( p->frame_pts_s > due_s ) {
+      p->frame_pending = true;
+      p->rev_end_s     = p->frame_pts_s;
+      break;
+    }
+    int idx = ( p->rev_first + p->rev_count ) % p->rev_max_slots;
+    if ( p->rev_count < p->rev_max_slots ) {
+      p->rev_count++;
+    } else {
+      p->rev_first = ( p->rev_first + 1 ) % p->rev_max_slots;
+    }
+    vol_av_frame_slot_t* slot_ptr = &p->rev_slots_ptr[idx];
+    if ( !slot_ptr->data[0] ) {
+      slot_ptr->data[0] = av_malloc( frame_sz ); // Full size, so the slot is big enough at every output scale.
+      if ( !slot_ptr->data[0] ) {
+        _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate reverse cache frame.\n" );
+        p->rev_count = 0;
+        return false;
+      }
+    }
+    _output_dims( p, &slot_ptr->w, &slot_ptr->h );
+    slot_ptr->linesize[0] = slot_ptr->w * 3; // Tightly packed, as it is handed to the application as-is.
+    if ( !_convert_frame( p, p->output_frame_ptr, slot_ptr->data, slot_ptr->linesize, slot_ptr->w, slot_ptr->h, flip_vertical ) ) {
+      p->rev_count = 0; // The slot may have held the oldest cached frame, so none of the cache can be trusted.
+      return false;
+    }
+    slot_ptr->pts_s = p->frame_pts_s;
+    p->decoded_s    = p->frame_pts_s;
+  }
+  return true;
+}
+
+/** Point `info_ptr` at a frame from the reverse cache, or copy it into an application output buffer if the application gave us some. */
+static void _deliver_cached_frame( vol_av_video_t* info_ptr, const vol_av_frame_slot_t* slot_ptr, int user_buffer_idx ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  info_ptr->pts_s      = slot_ptr->pts_s;
+  info_ptr->frame_idx  = _frame_index( p, slot_ptr->pts_s );
+  info_ptr->w          = slot_ptr->w;
+  info_ptr->h          = slot_ptr->h;
+  if ( user_buffer_idx >= 0 ) {
+    memcpy( p->user_buffers_ptr[user_buffer_idx], slot_ptr->data[0], (size_t)slot_ptr->w * slot_ptr->h * 3 );
+    p->user_buffer_held_ptr[user_buffer_idx] = true;
+    p->next_user_buffer                      = ( user_buffer_idx + 1 ) % p->n_user_buffers;
+    info_ptr->pixels_ptr                     = p->user_buffers_ptr[user_buffer_idx];
+    info_ptr->buffer_idx                     = user_buffer_idx;
+    _compress_output( info_ptr, info_ptr->pixels_ptr, slot_ptr->w * 3 );
+    return;
+  }
+  info_ptr->pixels_ptr = slot_ptr->data[0];
+  info_ptr->buffer_idx = -1;
+  _compress_output( info_ptr, info_ptr->pixels_ptr, slot_ptr->linesize[0] );
+}
+
+//
+//
+bool vol_av_read_frame_at_time( vol_av_video_t* info_ptr, double pts_s, bool flip_vertical ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->shared_ptr ) { return _shared_read_frame_at_time( info_ptr, pts_s, flip_vertical ); }
+  if ( p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: vol_av_read_frame_at_time() can not be used while the decode thread is running. Use vol_av_acquire_frame().\n" );
+    return false;
+  }
+  if ( pts_s < 0.0 ) { pts_s = 0.0; }
+  double due_s = pts_s + VOL_AV_PTS_TOLERANCE_S;
+  if ( p->scrubbing ) { _end_scrub( p ); } // Forces a seek below.
+
+  // Playing backwards, or turning around, within frames that were already converted for reverse play.
+  int slot_idx = _find_reverse_slot( p, due_s, flip_vertical );
+  if ( slot_idx >= 0 && info_ptr->pixels_ptr && p->rev_slots_ptr[slot_idx].pts_s == info_ptr->pts_s ) { return true; }
+
+  // Check there is somewhere to put a new frame before decoding it, so it isn't lost.
+  int user_buffer_idx = -1;
+  if ( p->n_user_buffers > 0 ) {
+    user_buffer_idx = _find_free_user_buffer( p );
+    if ( user_buffer_idx < 0 ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: all output buffers are held by the application. Call vol_av_release_output_buffer() first.\n" );
+      return false;
+    }
+  }
+
+  if ( slot_idx < 0 ) {
+    bool backwards = info_ptr->pixels_ptr && info_ptr->pts_s > due_s;
+    if ( backwards && p->rev_max_slots > 0 ) {
+      // Reverse play, a loop, or a scrub. Decode this stretch of the GOP once, and present it backwards over the next calls.
+      if ( !_fill_reverse_cache( p, pts_s, due_s, flip_vertical ) ) { return false; }
+      slot_idx = _find_reverse_slot( p, due_s, flip_vertical );
+      if ( slot_idx < 0 ) { return true; } // Before the first frame. Hold the frame already delivered.
+    } else if ( p->decoded_s > due_s || due_s - ( p->frame_pending ? p->frame_pts_s : p->decoded_s ) > VOL_AV_SEEK_AHEAD_S ) {
+      // Time went backwards, or jumped far ahead. Only the frames from the keyframe before `pts_s` onwards need decoding.
+      if ( !_seek( p, pts_s ) ) { return false; }
+    }
+  }
+  if ( slot_idx >= 0 ) {
+    _deliver_cached_frame( info_ptr, &p->rev_slots_ptr[slot_idx], user_buffer_idx );
+    return true;
+  }
+
+  // Decode forwards, keeping the newest frame that is due. A due frame is superseded, without paying to convert it, when the next one is due too.
+  // The first frame that isn't due yet is left pending for a later call.
+  bool have_due_frame = false;
+  double due_frame_s  = 0.0;
+  while ( true ) {
+    if ( !p->frame_pending ) {
+      if ( _read_next_frame( p ) < 0 ) { break; } // End of stream, or an error that has been logged.
+      p->frame_pending = true;
+    }
+    if ( p->frame_pts_s > due_s ) { break; }
+    av_frame_unref( p->due_frame_ptr );
+    av_frame_move_ref( p->due_frame_ptr, p->output_frame_ptr );
+    due_frame_s      = p->frame_pts_s;
+    have_due_frame   = true;
+    p->frame_pending = false;
+  }
+  // Nothing new is due, so hold the frame already delivered.
+  if ( !have_due_frame ) { return info_ptr->pixels_ptr != NULL; }
+
+  bool saved = _save_rgb_frame( info_ptr, p->due_frame_ptr, due_frame_s, user_buffer_idx, flip_vertical );
+  av_frame_unref( p->due_frame_ptr );
+
+  return saved;
+}
+
+/******************************************************************************
+  SCRUBBING
+******************************************************************************/
+
+/** Open the keyframe-only decoder used for scrubbing. It has no frame threading, which would hold frames back until more packets arrive. */
+static bool _open_scrub_decoder( vol_av_internal_t* p ) {
+  const AVStream* v_strm_ptr = p->fmt_ctx_ptr->streams[p->video_stream_idx];
+  p->scrub_codec_ctx_ptr     = avcodec_alloc_context3( p->codec_ptr );
+  if ( !p->scrub_codec_ctx_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for the scrub AVCodecContext\n" );
+    return false;
+  }
+  if ( avcodec_parameters_to_context( p->scrub_codec_ctx_ptr, v_strm_ptr->codecpar ) < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to copy codec params to the scrub codec context\n" );
+    avcodec_free_context( &p->scrub_codec_ctx_ptr );
+    return false;
+  }
+#ifdef VOL_AV_THREADED
+  p->scrub_codec_ctx_ptr->thread_count = 0;
+  p->scrub_codec_ctx_ptr->thread_type  = FF_THREAD_SLICE;
+#endif
+  p->scrub_codec_ctx_ptr->pkt_timebase = v_strm_ptr->time_base;
+  p->scrub_codec_ctx_ptr->skip_frame   = AVDISCARD_NONKEY;
+  if ( avcodec_open2( p->scrub_codec_ctx_ptr, p->codec_ptr, NULL ) < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to open the scrub decoder through avcodec_open2\n" );
+    avcodec_free_context( &p->scrub_codec_ctx_ptr );
+    return false;
+  }
+  return true;
+}
+
+/** Leave scrubbing. The main decoder's position no longer matches the demuxer's, so the caller must seek before decoding with it. */
+static void _end_scrub( vol_av_internal_t* p ) {
+  p->scrubbing     = false;
+  p->frame_pending = false;
+  p->decoded_s     = DBL_MAX;
+}
+
+/** Leave scrubbing to play on from the frame after the keyframe shown at `shown_s`. The seek lands on that keyframe, so it is decoded and dropped,
+ * along with anything before it, and the frame after is left pending.
+ * @return False on error. At the end of the stream nothing is left pending, and the next read reports it.
+ */
+static bool _resume_after_scrub( vol_av_internal_t* p, double shown_s ) {
+  _end_scrub( p );
+  if ( !_seek( p, shown_s ) ) { return false; }
+  while ( true ) {
+    int response = _read_next_frame( p );
+    if ( response == AVERROR_EOF ) { return true; }
+    if ( response < 0 ) { return false; }
+    if ( p->frame_pts_s > shown_s + VOL_AV_PTS_TOLERANCE_S ) { break; }
+  }
+  p->frame_pending = true;
+  return true;
+}
+
+/** Demux to the next video keyframe and decode only that, into `output_frame_ptr`. Other video packets are discarded without being decoded.
+ * The decoder is drained and flushed after each frame, so the frame comes out of this call rather than after the decoder's reordering delay.
+ * @return 0 if a frame was output, AVERROR_EOF at the end of the file, or another negative value on error.
+ */
+static int _read_next_keyframe( vol_av_internal_t* p ) {
+  AVPacket* packet_ptr = p->packet_ptr;
+  while ( true ) {
+    if ( p->video_queue_count > 0 ) {
+      av_packet_move_ref( packet_ptr, p->video_queue_ptr[p->video_queue_head] );
+      p->video_queue_head = ( p->video_queue_head + 1 ) % VOL_AV_VIDEO_QUEUE_LEN;
+      p->video_queue_count--;
+    } else if ( _demux_video_packet( p ) < 0 ) {
+      p->decoder_eof = true;
+      return AVERROR_EOF;
+    }
+    if ( packet_ptr->flags & AV_PKT_FLAG_KEY ) { break; }
+    av_packet_unref( packet_ptr );
+  }
+
+  int response = avcodec_send_packet( p->scrub_codec_ctx_ptr, packet_ptr );
+  av_packet_unref( packet_ptr );
+  if ( response < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while sending a keyframe to the scrub decoder: %s\n", av_err2str( response ) );
+    return response;
+  }
+  avcodec_send_packet( p->scrub_codec_ctx_ptr, NULL );
+  response = avcodec_receive_frame( p->scrub_codec_ctx_ptr, p->output_frame_ptr );
+  avcodec_flush_buffers( p->scrub_codec_ctx_ptr );
+  if ( response < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while receiving a keyframe from the scrub decoder: %s\n", av_err2str( response ) );
+    return response;
+  }
+  p->frame_pts_s = _frame_pts_s( p, p->output_frame_ptr );
+  p->frames_decoded++;
+  return 0;
+}
+
+//
+//
+bool vol_av_scrub_to_time( vol_av_video_t* info_ptr, double pts_s, bool flip_vertical, int scale_level, double max_latency_s ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  if ( _is_shared_cursor( info_ptr, "vol_av_scrub_to_time" ) ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: vol_av_scrub_to_time() can not be used while the decode thread is running.\n" );
+    return false;
+  }
+  if ( !p->scrub_codec_ctx_ptr && !_open_scrub_decoder( p ) ) { return false; }
+  double start_s = _time_s();
+  if ( pts_s < 0.0 ) { pts_s = 0.0; }
+  double due_s = pts_s + VOL_AV_PTS_TOLERANCE_S;
+  if ( scale_level < 0 ) { scale_level = 0; }
+  if ( scale_level > VOL_AV_OUTPUT_SCALE_MAX ) { scale_level = VOL_AV_OUTPUT_SCALE_MAX; }
+  bool rescaled        = p->scrubbing && scale_level != p->scrub_scale_level; // The keyframe shown is at the old scale, so it must be decoded again.
+  p->scrub_scale_level = scale_level;
+
+  // The main decoder's frames in flight are from wherever it was, so they can't be handed out as previews.
+  if ( !p->scrubbing ) {
+    p->scrubbing     = true;
+    p->frame_pending = false;
+    p->decoded_s     = DBL_MAX;
+  }
+
+  // Check there is somewhere to put a new frame before decoding it, so it isn't lost.
+  int user_buffer_idx = -1;
+  if ( p->n_user_buffers > 0 ) {
+    user_buffer_idx = _find_free_user_buffer( p );
+    if ( user_buffer_idx < 0 ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: all output buffers are held by the application. Call vol_av_release_output_buffer() first.\n" );
+      return false;
+    }
+  }
+
+  // Going backwards or jumping far ahead costs one seek and one keyframe. Dragging forwards a little walks through the keyframes in between.
+  bool seeked = false;
+  if ( rescaled || p->decoded_s > due_s || due_s - ( p->frame_pending ? p->frame_pts_s : p->decoded_s ) > VOL_AV_SEEK_AHEAD_S ) {
+    if ( !_seek( p, pts_s ) ) { return false; }
+    avcodec_flush_buffers( p->scrub_codec_ctx_ptr );
+    seeked = true;
+  }
+
+  bool have_due_frame = false;
+  double due_frame_s  = 0.0;
+  while ( true ) {
+    if ( !p->frame_pending ) {
+      if ( _read_next_keyframe( p ) < 0 ) { break; }
+      p->frame_pending = true;
+    }
+    if ( p->frame_pts_s > due_s && !( seeked && !have_due_frame ) ) { break; }
+    av_frame_unref( p->due_frame_ptr );
+    av_frame_move_ref( p->due_frame_ptr, p->output_frame_ptr );
+    due_frame_s      = p->frame_pts_s;
+    have_due_frame   = true;
+    p->frame_pending = false;
+    p->decoded_s     = due_frame_s;
+    // The seek landed on the keyframe at or before `pts_s`, so that is the one to show, and looking at the next would cost another decode.
+    if ( seeked ) { break; }
+    // Out of time. Show the newest keyframe so far, and carry on from here on the next call.
+    if ( _time_s() - start_s > max_latency_s ) { break; }
+  }
+  if ( !have_due_frame ) { return info_ptr->pixels_ptr != NULL; }
+
+  bool saved = _save_rgb_frame( info_ptr, p->due_frame_ptr, due_frame_s, user_buffer_idx, flip_vertical );
+  av_frame_unref( p->due_frame_ptr );
+  return saved;
+}
+
+/******************************************************************************
+  DECODE THREAD
+******************************************************************************/
+
+static void _free_frame_slots( vol_av_internal_t* p ) {
+  if ( !p->slots_ptr ) { return; }
+  for ( int i = 0; i < p->n_slots; i++ ) {
+    if ( p->slots_ptr[i].data[0] && !p->slots_ptr[i].external ) { av_freep( &p->slots_ptr[i].data[0] ); }
+    free( p->slots_ptr[i].compressed_ptr );
+  }
+  free( p->slots_ptr );
+  p->slots_ptr = NULL;
+  p->n_slots   = 0;
+}
+
+/** The producer side of the frame ring. Demuxes, decodes and converts one frame into the next free slot.
+ * Only one thread at a time may call this for a stream: its own decode thread, or the pool worker that claimed it.
+ * @return 1 if a frame was published, 0 if all slots are full or held by the application, or -1 at the end of the stream or on error.
+ */
+static int _decode_one_slot( vol_av_internal_t* p ) {
+  uint32_t written = p->slots_written; // Only the producer writes to slots_written.
+  uint32_t read    = _atomic_load_u32( &p->slots_read );
+  if ( written - read >= (uint32_t)p->n_slots ) { return 0; }
+
+  if ( p->frame_pending ) {
+    p->frame_pending = false;
+  } else if ( _read_next_frame( p ) < 0 ) {
+    return -1;
+  }
+
+  vol_av_frame_slot_t* slot_ptr = &p->slots_ptr[written % (uint32_t)p->n_slots];
+  _output_dims( p, &slot_ptr->w, &slot_ptr->h );
+  slot_ptr->linesize[0] = slot_ptr->w * 3; // Tightly packed, as it is handed to the application as-is, at whatever output scale.
+  // The slot isn't published if the conversion fails, so the application never sees the old frame still in it.
+  if ( !_convert_frame( p, p->output_frame_ptr, slot_ptr->data, slot_ptr->linesize, slot_ptr->w, slot_ptr->h, p->flip_vertical ) ) { return -1; }
+  slot_ptr->pts_s = p->frame_pts_s;
+  // Pool workers are already spread over the cores, so under the scheduler a stream's frame is compressed on its worker alone.
+  if ( slot_ptr->compressed_ptr ) {
+    vol_av_compress_rgb( slot_ptr->data[0], slot_ptr->linesize[0], slot_ptr->w, slot_ptr->h, p->texture_format, p->scheduled ? 1 : 0, slot_ptr->compressed_ptr );
+    slot_ptr->compressed_sz = vol_av_compressed_size( slot_ptr->w, slot_ptr->h, p->texture_format );
+  }
+  // Publish only after the slot's contents are fully written.
+  _atomic_store_u32( &p->slots_written, written + 1 );
+  return 1;
+}
+
+/** A stream's own decode thread. Fills slots until the stream ends or it is asked to quit. */
+static VOL_THREAD_FUNC _decode_thread_main( void* arg_ptr ) {
+  vol_av_internal_t* p = (vol_av_internal_t*)arg_ptr;
+
+  while ( !_atomic_load_u32( &p->thread_quit ) ) {
+    int ret = _decode_one_slot( p );
+    if ( ret < 0 ) { break; }
+    if ( ret > 0 ) { continue; }
+    // All slots are full, or held by the application - sleep until it releases one. The check is repeated under the lock that
+    // _slots_released() signals with, so a release between the check in _decode_one_slot() and the wait isn't missed.
+    _mutex_lock( &p->slots_lock );
+    while ( !_atomic_load_u32( &p->thread_quit ) && p->slots_written - _atomic_load_u32( &p->slots_read ) >= (uint32_t)p->n_slots ) {
+      _cond_wait( &p->slots_freed, &p->slots_lock );
+    }
+    _mutex_unlock( &p->slots_lock );
+  }
+
+  _atomic_store_u32( &p->thread_finished, 1 );
+  return VOL_THREAD_RETURN;
+}
+
+/******************************************************************************
+  SHARED DECODE SCHEDULER
+******************************************************************************/
+
+/** Pick the stream that most needs a frame decoded, and mark it busy. Must be called with `_sched.lock` held.
+ * A stream's deadline is when its queue of decoded frames runs dry, so streams are ordered by how many seconds of frames they have queued,
+ * divided by their priority. Culled streams, with a priority of 0 or less, are only served when no visible stream has free slots.
+ * @return NULL if no stream has work.
+ */
+static vol_av_internal_t* _sched_claim_stream( void ) {
+  vol_av_internal_t* best_ptr = NULL;
+  bool best_visible           = false;
+  double best_score           = DBL_MAX;
+
+  for ( int i = 0; i < _sched.n_streams; i++ ) {
+    vol_av_internal_t* p = _sched.streams_ptr[i];
+    if ( _atomic_load_u32( &p->sched_busy ) || _atomic_load_u32( &p->thread_finished ) ) { continue; }
+    uint32_t queued = _atomic_load_u32( &p->slots_written ) - _atomic_load_u32( &p->slots_read );
+    if ( queued >= (uint32_t)p->n_slots ) { continue; }
+
+    AVRational avfr = p->fmt_ctx_ptr->streams[p->video_stream_idx]->avg_frame_rate;
+    double queued_s = ( avfr.num > 0 && avfr.den > 0 ) ? queued / av_q2d( avfr ) : (double)queued;
+    bool visible    = p->decode_priority > 0.0f;
+    double score    = visible ? queued_s / p->decode_priority : queued_s;
+    if ( best_ptr && ( best_visible && !visible ) ) { continue; }
+    if ( best_ptr && best_visible == visible && score >= best_score ) { continue; }
+    best_ptr     = p;
+    best_visible = visible;
+    best_score   = score;
+  }
+
+  if ( best_ptr ) { _atomic_store_u32( &best_ptr->sched_busy, 1 ); }
+  return best_ptr;
+}
+
+/** A pool worker. Decodes one frame at a time for whichever stream is most urgent, so no stream is tied to a worker. */
+static VOL_THREAD_FUNC _sched_worker_main( void* arg_ptr ) {
+  (void)arg_ptr;
+
+  _mutex_lock( &_sched.lock );
+  while ( !_sched.quit ) {
+    vol_av_internal_t* p = _sched_claim_stream();
+    if ( !p ) {
+      // Every stream is full, finished, or being decoded by another worker. Nothing changes that without signalling `work`.
+      _cond_wait( &_sched.work, &_sched.lock );
+      continue;
+    }
+    _mutex_unlock( &_sched.lock );
+
+    int ret = _decode_one_slot( p );
+
+    _mutex_lock( &_sched.lock );
+    if ( ret < 0 ) { _atomic_store_u32( &p->thread_finished, 1 ); }
+    _atomic_store_u32( &p->sched_busy, 0 );
+    _cond_broadcast( &_sched.idle );
+  }
+  _mutex_unlock( &_sched.lock );
+
+  return VOL_THREAD_RETURN;
+}
+
+/** Wake whatever produces frames for a stream, after the application moved slots_read on. */
+static void _slots_released( vol_av_internal_t* p ) {
+  if ( p->scheduled ) {
+    _mutex_lock( &_sched.lock );
+    _cond_signal( &_sched.work );
+    _mutex_unlock( &_sched.lock );
+  } else {
+    _mutex_lock( &p->slots_lock );
+    _cond_signal( &p->slots_freed );
+    _mutex_unlock( &p->slots_lock );
+  }
+}
+
+/** Hand a stream to the worker pool. @return False if the scheduler isn't running or is serving as many streams as it can. */
+static bool _sched_add_stream( vol_av_internal_t* p ) {
+  if ( !_sched.running ) { return false; }
+
+  _mutex_lock( &_sched.lock );
+  bool added = _sched.n_streams < VOL_AV_SCHED_MAX_STREAMS;
+  if ( added ) {
+    p->sched_busy                          = 0;
+    p->scheduled                           = true; // Before the stream is visible to the workers, which read it.
+    _sched.streams_ptr[_sched.n_streams++] = p;
+    _cond_signal( &_sched.work );
+  }
+  _mutex_unlock( &_sched.lock );
+
+  if ( !added ) { _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: decode scheduler is full. Stream will use its own decode thread.\n" ); }
+  return added;
+}
+
+/** Take a stream back from the worker pool, waiting for any worker that is decoding it to finish. */
+static void _sched_remove_stream( vol_av_internal_t* p ) {
+  _mutex_lock( &_sched.lock );
+  for ( int i = 0; i < _sched.n_streams; i++ ) {
+    if ( _sched.streams_ptr[i] != p ) { continue; }
+    _sched.streams_ptr[i] = _sched.streams_ptr[--_sched.n_streams];
+    break;
+  }
+  // No worker can claim the stream now, but one may still be part-way through a frame.
+  while ( _atomic_load_u32( &p->sched_busy ) ) { _cond_wait( &_sched.idle, &_sched.lock ); }
+  _mutex_unlock( &_sched.lock );
+}
+
+//
+//
+bool vol_av_start_decode_scheduler( int n_workers ) {
+  if ( _sched.running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: decode scheduler is already running.\n" );
+    return false;
+  }
+  if ( n_workers <= 0 ) { n_workers = _cpu_count(); }
+
+  _sched.workers_ptr = calloc( n_workers, sizeof( vol_thread_t ) );
+  if ( !_sched.workers_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for decode workers\n" );
+    return false;
+  }
+  _mutex_init( &_sched.lock );
+  _cond_init( &_sched.work );
+  _cond_init( &_sched.idle );
+  _sched.n_streams = 0;
+  _sched.n_workers = 0;
+  _sched.quit      = 0;
+  for ( int i = 0; i < n_workers; i++ ) {
+    if ( !_thread_create( &_sched.workers_ptr[i], _sched_worker_main, NULL ) ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: failed to create decode worker %i. Running with %i workers.\n", i, i );
+      break;
+    }
+    _sched.n_workers++;
+  }
+  if ( 0 == _sched.n_workers ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to create any decode workers.\n" );
+    _cond_destroy( &_sched.work );
+    _cond_destroy( &_sched.idle );
+    _mutex_destroy( &_sched.lock );
+    free( _sched.workers_ptr );
+    _sched.workers_ptr = NULL;
+    return false;
+  }
+  _sched.running = true;
+  _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Decode scheduler started with %i workers\n", _sched.n_workers );
+
+  return true;
+}
+
+//
+//
+bool vol_av_stop_decode_scheduler( void ) {
+  if ( !_sched.running ) { return false; }
+  _mutex_lock( &_sched.lock );
+  int n_streams = _sched.n_streams;
+  if ( 0 == n_streams ) {
+    _atomic_store_u32( &_sched.quit, 1 );
+    _cond_broadcast( &_sched.work );
+  }
+  _mutex_unlock( &_sched.lock );
+  if ( n_streams > 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: decode scheduler still has %i streams. Stop their decode threads first.\n", n_streams );
+    return false;
+  }
+
+  for ( int i = 0; i < _sched.n_workers; i++ ) { _thread_join( _sched.workers_ptr[i] ); }
+  free( _sched.workers_ptr );
+  _sched.workers_ptr = NULL;
+  _sched.n_workers   = 0;
+  _cond_destroy( &_sched.work );
+  _cond_destroy( &_sched.idle );
+  _mutex_destroy( &_sched.lock );
+  _sched.running = false;
+
+  return true;
+}
+
+//
+//
+void vol_av_set_decode_priority( vol_av_video_t* info_ptr, float priority ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return; }
+
+  if ( _sched.running ) { _mutex_lock( &_sched.lock ); }
+  info_ptr->_context_ptr->decode_priority = priority;
+  if ( _sched.running ) { _mutex_unlock( &_sched.lock ); }
+}
+
+//
+//
+bool vol_av_start_decode_thread( vol_av_video_t* info_ptr, int n_buffers, bool flip_vertical ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  if ( _is_shared_cursor( info_ptr, "vol_av_start_decode_thread" ) ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: decode thread is already running.\n" );
+    return false;
+  }
+  // If the application registered its own output buffers then the decode thread converts into those instead of allocating a pool.
+  if ( p->n_user_buffers > 0 ) { n_buffers = p->n_user_buffers; }
+  if ( n_buffers < 2 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: decode thread needs at least 2 frame buffers, %i requested.\n", n_buffers );
+    return false;
+  }
+
+  p->slots_ptr = calloc( n_buffers, sizeof( vol_av_frame_slot_t ) );
+  if ( !p->slots_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for frame slots\n" );
+    return false;
+  }
+  p->n_slots = n_buffers;
+  for ( int i = 0; i < n_buffers; i++ ) {
+    if ( VOL_AV_TEXTURE_FORMAT_RGB24 != p->texture_format ) {
+      p->slots_ptr[i].compressed_ptr = malloc( (size_t)vol_av_compressed_size( p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, p->texture_format ) );
+      if ( !p->slots_ptr[i].compressed_ptr ) {
+        _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate compressed frame slot %i.\n", i );
+        _free_frame_slots( p );
+        return false;
+      }
+    }
+    if ( p->n_user_buffers > 0 ) {
+      p->slots_ptr[i].data[0]     = p->user_buffers_ptr[i];
+      p->slots_ptr[i].linesize[0] = p->codec_ctx_ptr->width * 3;
+      p->slots_ptr[i].external    = true;
+      continue;
+    }
+    if ( av_image_alloc( p->slots_ptr[i].data, p->slots_ptr[i].linesize, p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, AV_PIX_FMT_RGB24, 32 ) < 0 ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate frame slot %i.\n", i );
+      _free_frame_slots( p );
+      return false;
+    }
+  }
+
+  if ( p->scrubbing && !_resume_after_scrub( p, info_ptr->pts_s ) ) {
+    _free_frame_slots( p );
+    return false;
+  }
+
+  p->slots_written   = 0;
+  p->slots_read      = 0;
+  p->thread_quit     = 0;
+  p->thread_finished = 0;
+  p->flip_vertical   = flip_vertical;
+  // Half a frame either way of a frame's timestamp rounds to that frame, so a clock that lands on it doesn't show the one before.
+  double fps         = vol_av_frame_rate( info_ptr );
+  p->due_tolerance_s = fps > 0.0 ? 0.5 / fps : VOL_AV_PTS_TOLERANCE_S;
+  _mutex_init( &p->slots_lock );
+  _cond_init( &p->slots_freed );
+  p->scheduled = false;
+  if ( !_sched_add_stream( p ) && !_thread_create( &p->decode_thread, _decode_thread_main, p ) ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to create decode thread.\n" );
+    _cond_destroy( &p->slots_freed );
+    _mutex_destroy( &p->slots_lock );
+    _free_frame_slots( p );
+    return false;
+  }
+  p->decode_thread_running = true;
+  info_ptr->pixels_ptr     = NULL;
+  info_ptr->compressed_ptr = NULL;
+
+  return true;
+}
+
+//
+//
+bool vol_av_stop_decode_thread( vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( !p->decode_thread_running ) { return false; }
+
+  if ( p->scheduled ) {
+    _sched_remove_stream( p );
+    p->scheduled = false;
+  } else {
+    _mutex_lock( &p->slots_lock );
+    _atomic_store_u32( &p->thread_quit, 1 );
+    _cond_signal( &p->slots_freed );
+    _mutex_unlock( &p->slots_lock );
+    _thread_join( p->decode_thread );
+  }
+  _cond_destroy( &p->slots_freed );
+  _mutex_destroy( &p->slots_lock );
+  p->decode_thread_running = false;
+  _free_frame_slots( p );
+  info_ptr->pixels_ptr     = NULL;
+  info_ptr->compressed_ptr = NULL;
+
+  return true;
 }
 
 //
 //
-bool vol_av_read_next_frame( vol_av_video_t* info_ptr ) {
-  if ( !info_ptr || !info_ptr->_context_ptr ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: info_ptr || !info_ptr->_context_ptr NULL.\n" );
+bool vol_av_acquire_frame( vol_av_video_t* info_ptr, double pts_s ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( !p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: vol_av_acquire_frame() called without a running decode thread.\n" );
     return false;
   }
 
+  uint32_t read    = p->slots_read; // Only this thread writes to slots_read.
+  uint32_t written = _atomic_load_u32( &p->slots_written );
+  if ( read == written ) { return false; } // Nothing decoded yet, or the stream has ended.
+
+  // Release frames that are already late, keeping the newest frame that is due.
+  if ( pts_s >= 0.0 ) {
+    uint32_t n    = (uint32_t)p->n_slots;
+    uint32_t held = read;
+    double due_s  = pts_s + p->due_tolerance_s;
+    while ( written - read >= 2 && p->slots_ptr[( read + 1 ) % n].pts_s <= due_s ) { read++; }
+    if ( read != held ) {
+      _atomic_store_u32( &p->slots_read, read );
+      _slots_released( p );
+    }
+  }
+
+  const vol_av_frame_slot_t* slot_ptr = &p->slots_ptr[read % (uint32_t)p->n_slots];
+  info_ptr->pixels_ptr                = slot_ptr->data[0];
+  info_ptr->w                         = slot_ptr->w;
+  info_ptr->h                         = slot_ptr->h;
+  info_ptr->pts_s                     = slot_ptr->pts_s;
+  info_ptr->frame_idx                 = _frame_index( p, slot_ptr->pts_s );
+  info_ptr->compressed_ptr            = slot_ptr->compressed_ptr;
+  info_ptr->compressed_sz             = slot_ptr->compressed_ptr ? slot_ptr->compressed_sz : 0;
+
+  return true;
+}
+
+//
+//
+void vol_av_release_frame( vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( !p->decode_thread_running ) { return; }
+
+  uint32_t read = p->slots_read;
+  if ( read == _atomic_load_u32( &p->slots_written ) ) { return; }
+  info_ptr->pixels_ptr     = NULL;
+  info_ptr->compressed_ptr = NULL;
+  _atomic_store_u32( &p->slots_read, read + 1 );
+  _slots_released( p );
+}
+
+//
+//
+bool vol_av_end_of_stream( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return true; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->shared_ptr ) { return info_ptr->pixels_ptr && info_ptr->frame_idx >= vol_av_frame_count( info_ptr ) - 1; } // The shared decoders aren't its own.
+  if ( !p->decode_thread_running ) { return p->decoder_eof && !p->frame_pending; }
+  if ( !_atomic_load_u32( &p->thread_finished ) ) { return false; }
+  // The held frame is the last one if there is nothing queued after it.
+  return _atomic_load_u32( &p->slots_written ) - p->slots_read <= 1;
+}
+
+//
+//
+int64_t vol_av_memory_usage( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return 0; }
+
+  const vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->shared_ptr ) { return 0; } // Counted once for every instance, by vol_av_shared_memory_usage().
+  int w = p->codec_ctx_ptr->width, h = p->codec_ctx_ptr->height;
+  int64_t image_sz = av_image_get_buffer_size( AV_PIX_FMT_RGB24, w, h, 32 );
+  int64_t sz       = 0;
+  if ( p->output_frame_rgb_ptr && p->output_frame_rgb_ptr->data[0] ) { sz += image_sz; }
+  if ( p->compressed_ptr ) { sz += vol_av_compressed_size( w, h, p->texture_format ); }
+  if ( p->user_compressed_ptr ) { sz += p->n_user_buffers * vol_av_compressed_size( w, h, p->texture_format ); }
+  for ( int i = 0; p->slots_ptr && i < p->n_slots; i++ ) {
+    if ( p->slots_ptr[i].data[0] && !p->slots_ptr[i].external ) { sz += image_sz; }
+    if ( p->slots_ptr[i].compressed_ptr ) { sz += vol_av_compressed_size( w, h, p->texture_format ); }
+  }
+  for ( int i = 0; p->rev_slots_ptr && i < p->rev_max_slots; i++ ) {
+    if ( p->rev_slots_ptr[i].data[0] ) { sz += av_image_get_buffer_size( AV_PIX_FMT_RGB24, w, h, 1 ); }
+  }
+  if ( p->audio_ring_ptr ) { sz += (int64_t)p->audio_ring_frames * p->audio_channels * (int64_t)sizeof( float ); }
+  sz += (int64_t)p->audio_scratch_frames * p->audio_channels * (int64_t)sizeof( float );
+  return sz;
+}
+
+/******************************************************************************
+  SHARED VIDEOS
+  Instances of a vologram opened with vol_av_open_shared() are cursors on one registry entry per file. The entry decodes each frame once, for
+  every instance showing it, and keeps the converted frames that instances are presenting. So copies of a vologram playing in step cost one
+  decode and one frame between them, and a copy that has drifted away from the others gets a decoder of its own, up to VOL_AV_SHARED_MAX_DECODERS.
+******************************************************************************/
+
+/** A converted frame of a shared video, for every instance presenting it. */
+typedef struct vol_av_shared_frame_t {
+  uint8_t* pixels_ptr;     /** Tightly-packed RGB, allocated for the full video size when the frame is first used. */
+  uint8_t* compressed_ptr; /** The image in the shared video's texture format. Grown as needed. */
+  int64_t compressed_sz, compressed_cap;
+  int w, h;
+  double pts_s;
+  int64_t frame_idx;
+  bool valid;         /** False if the image is from before the output compression was changed, or there is none, so it can't be presented again. */
+  int n_cursors;      /** Instances presenting this frame. It isn't overwritten while any are. */
+  uint64_t last_used; /** `use_count` of the shared video when the frame was last presented, so the least recently shown is replaced first. */
+} vol_av_shared_frame_t;
+
+/** A video opened by vol_av_open_shared(), shared by every instance opened from the same file. */
+typedef struct vol_av_shared_t {
+  char* filename;
+  int ref_count;    /** Instances open. Only changed with both `_shared_videos_lock` and `lock` held. */
+  vol_mutex_t lock; /** Held by each instance's read, so instances can be read from different threads. Guards everything below. */
+  vol_av_video_t decoders[VOL_AV_SHARED_MAX_DECODERS]; /** decoders[0] is opened with the entry and kept until it is freed, for the stream's details. */
+  uint64_t decoder_used[VOL_AV_SHARED_MAX_DECODERS];   /** `use_count` when each decoder was last read, so the least recently read one seeks. */
+  int n_decoders;
+  vol_av_shared_frame_t* frames_ptr; /** One more than the instances presenting frames at most, so an instance just behind another can still share. */
+  int n_frames;
+  uint64_t use_count;
+  int flip_vertical;      /** -1 until the first read, then whether every frame is flipped, as instances share images. */
+  int output_scale_level; /** Set on each decoder when it is opened. */
+  vol_av_texture_format_t texture_format;
+  struct vol_av_shared_t* next_ptr;
+} vol_av_shared_t;
+
+/** Registry of shared videos. Only accessed with `_shared_videos_lock` held. */
+static vol_av_shared_t* _shared_videos_ptr;
+static vol_mutex_t _shared_videos_lock = VOL_MUTEX_INITIALIZER;
+
+/** @return The context with the stream's details: the instance's own, or for an instance of a shared video, its registry entry's first decoder's. */
+static vol_av_internal_t* _stream_context( const vol_av_video_t* info_ptr ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  return p->shared_ptr ? p->shared_ptr->decoders[0]._context_ptr : p;
+}
+
+static void _free_shared_frame( vol_av_shared_frame_t* frame_ptr ) {
+  free( frame_ptr->pixels_ptr );
+  free( frame_ptr->compressed_ptr );
+  memset( frame_ptr, 0, sizeof( vol_av_shared_frame_t ) );
+}
+
+static void _free_shared_video( vol_av_shared_t* s ) {
+  for ( int i = 0; i < s->n_decoders; i++ ) { vol_av_close( &s->decoders[i] ); }
+  for ( int i = 0; i < s->n_frames; i++ ) { _free_shared_frame( &s->frames_ptr[i] ); }
+  free( s->frames_ptr );
+  free( s->filename );
+  _mutex_destroy( &s->lock );
+  free( s );
+}
+
+/** Open another decoder for a shared video, with the output settings the instances chose.
+ * @return Its index, or -1 on error. */
+static int _open_shared_decoder( vol_av_shared_t* s ) {
+  vol_av_video_t* decoder_ptr = &s->decoders[s->n_decoders];
+  memset( decoder_ptr, 0, sizeof( vol_av_video_t ) );
+  if ( !vol_av_open( s->filename, decoder_ptr ) || !vol_av_set_output_scale( decoder_ptr, s->output_scale_level ) ||
+       !vol_av_set_output_compression( decoder_ptr, s->texture_format ) ) {
+    vol_av_close( decoder_ptr );
+    return -1;
+  }
+  _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Opened decoder %i of shared video `%s`\n", s->n_decoders, s->filename );
+  s->decoder_used[s->n_decoders] = s->use_count;
+  return s->n_decoders++;
+}
+
+/** Pick the decoder to bring to `due_s`: the nearest one before it, if that is close enough to decode forwards, or else a new decoder while there
+ * are fewer than instances, or else the one read least recently, which seeks.
+ * @return Its index. */
+static int _pick_shared_decoder( vol_av_shared_t* s, double due_s ) {
+  int nearest_idx = -1, oldest_idx = 0;
+  double nearest_gap_s = DBL_MAX;
+  for ( int i = 0; i < s->n_decoders; i++ ) {
+    const vol_av_video_t* decoder_ptr = &s->decoders[i];
+    double at_s = decoder_ptr->pixels_ptr ? decoder_ptr->pts_s : 0.0; // A decoder that hasn't delivered a frame yet is at the start.
+    if ( at_s <= due_s && due_s - at_s < nearest_gap_s ) {
+      nearest_idx   = i;
+      nearest_gap_s = due_s - at_s;
+    }
+    if ( s->decoder_used[i] < s->decoder_used[oldest_idx] ) { oldest_idx = i; }
+  }
+  if ( nearest_idx >= 0 && nearest_gap_s <= VOL_AV_SEEK_AHEAD_S ) { return nearest_idx; }
+  // Behind every decoder, or far ahead of them, so this instance has drifted away from the others.
+  if ( s->n_decoders < s->ref_count && s->n_decoders < VOL_AV_SHARED_MAX_DECODERS ) {
+    int new_idx = _open_shared_decoder( s );
+    if ( new_idx >= 0 ) { return new_idx; }
+  }
+  return oldest_idx;
+}
+
+/** @return Index of the frame that another instance already presented for `due_s`, or -1. */
+static int _find_due_shared_frame( const vol_av_shared_t* s, double due_s ) {
+  double fps = vol_av_frame_rate( &s->decoders[0] );
+  if ( fps <= 0.0 ) { return -1; }
+  int w = 0, h = 0;
+  vol_av_output_dimensions( &s->decoders[0], &w, &h );
+  // Timestamps in coarse time bases can be truncated to a little before their frame's time. The frame's own time is checked below.
+  int64_t due_frame_idx = (int64_t)( due_s * fps + 0.1 );
+  for ( int i = 0; i < s->n_frames; i++ ) {
+    const vol_av_shared_frame_t* frame_ptr = &s->frames_ptr[i];
+    if ( frame_ptr->valid && frame_ptr->frame_idx == due_frame_idx && frame_ptr->pts_s <= due_s && frame_ptr->w == w && frame_ptr->h == h ) { return i; }
+  }
+  return -1;
+}
+
+/** Find the frame holding the image a decoder just delivered, or copy it into the least recently shown frame no instance is presenting, adding
+ * a frame if every one is presented.
+ * @return The frame's index, or -1 if memory ran out. */
+static int _store_shared_frame( vol_av_shared_t* s, const vol_av_video_t* decoder_ptr ) {
+  int idx = -1;
+  for ( int i = 0; i < s->n_frames; i++ ) {
+    const vol_av_shared_frame_t* frame_ptr = &s->frames_ptr[i];
+    if ( frame_ptr->valid && frame_ptr->pts_s == decoder_ptr->pts_s && frame_ptr->w == decoder_ptr->w && frame_ptr->h == decoder_ptr->h ) { return i; }
+    if ( 0 == frame_ptr->n_cursors && ( idx < 0 || frame_ptr->last_used < s->frames_ptr[idx].last_used ) ) { idx = i; }
+  }
+  if ( idx < 0 ) {
+    vol_av_shared_frame_t* tmp_ptr = realloc( s->frames_ptr, ( s->n_frames + 1 ) * sizeof( vol_av_shared_frame_t ) );
+    if ( !tmp_ptr ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for shared video frames.\n" );
+      return -1;
+    }
+    s->frames_ptr = tmp_ptr;
+    idx           = s->n_frames++;
+    memset( &s->frames_ptr[idx], 0, sizeof( vol_av_shared_frame_t ) );
+  }
+
+  vol_av_shared_frame_t* frame_ptr = &s->frames_ptr[idx];
+  frame_ptr->valid                 = false; // Until the copy is complete.
+  if ( !frame_ptr->pixels_ptr ) {
+    int w = 0, h = 0;
+    vol_av_dimensions( decoder_ptr, &w, &h );
+    frame_ptr->pixels_ptr = malloc( (size_t)w * h * 3 ); // Full size, so the frame is big enough at every output scale.
+  }
+  if ( decoder_ptr->compressed_ptr && decoder_ptr->compressed_sz > frame_ptr->compressed_cap ) {
+    uint8_t* tmp_ptr = realloc( frame_ptr->compressed_ptr, (size_t)decoder_ptr->compressed_sz );
+    if ( tmp_ptr ) {
+      frame_ptr->compressed_ptr = tmp_ptr;
+      frame_ptr->compressed_cap = decoder_ptr->compressed_sz;
+    }
+  }
+  if ( !frame_ptr->pixels_ptr || ( decoder_ptr->compressed_ptr && decoder_ptr->compressed_sz > frame_ptr->compressed_cap ) ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate a shared video frame.\n" );
+    return -1;
+  }
+  memcpy( frame_ptr->pixels_ptr, decoder_ptr->pixels_ptr, (size_t)decoder_ptr->w * decoder_ptr->h * 3 );
+  frame_ptr->compressed_sz = 0;
+  if ( decoder_ptr->compressed_ptr ) {
+    memcpy( frame_ptr->compressed_ptr, decoder_ptr->compressed_ptr, (size_t)decoder_ptr->compressed_sz );
+    frame_ptr->compressed_sz = decoder_ptr->compressed_sz;
+  }
+  frame_ptr->w         = decoder_ptr->w;
+  frame_ptr->h         = decoder_ptr->h;
+  frame_ptr->pts_s     = decoder_ptr->pts_s;
+  frame_ptr->frame_idx = decoder_ptr->frame_idx;
+  frame_ptr->valid     = true;
+  return idx;
+}
+
+/** vol_av_read_frame_at_time() for an instance of a shared video. The frame is taken from another instance that is showing it, or else decoded.
+ * @return False on error, if the instance flips frames differently to the others, or if no frame has been delivered yet and none is due. */
+static bool _shared_read_frame_at_time( vol_av_video_t* info_ptr, double pts_s, bool flip_vertical ) {
   vol_av_internal_t* p = info_ptr->_context_ptr;
+  vol_av_shared_t* s   = p->shared_ptr;
+  if ( pts_s < 0.0 ) { pts_s = 0.0; }
+  double due_s = pts_s + VOL_AV_PTS_TOLERANCE_S;
 
-  AVPacket* packet_ptr = av_packet_alloc(); // https://ffmpeg.org/doxygen/trunk/structAVPacket.html
-  if ( !packet_ptr ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocated memory for AVPacket.\n" );
+  _mutex_lock( &s->lock );
+  if ( s->flip_vertical < 0 ) { s->flip_vertical = flip_vertical ? 1 : 0; }
+  if ( s->flip_vertical != ( flip_vertical ? 1 : 0 ) ) {
+    _mutex_unlock( &s->lock );
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: instances of shared video `%s` must all be flipped the same way, as they share frames.\n", s->filename );
     return false;
   }
-  int packet_response = -1;
-  // fill the Packet with data from the Stream
-  // https://ffmpeg.org/doxygen/trunk/group__lavf__decoding.html#ga4fdb3084415a82e3810de6ee60e46a61
+  int frame_idx = _find_due_shared_frame( s, due_s );
+  if ( frame_idx < 0 ) {
+    int decoder_idx             = _pick_shared_decoder( s, due_s );
+    vol_av_video_t* decoder_ptr = &s->decoders[decoder_idx];
+    s->decoder_used[decoder_idx] = ++s->use_count;
+    if ( vol_av_read_frame_at_time( decoder_ptr, pts_s, flip_vertical ) ) { frame_idx = _store_shared_frame( s, decoder_ptr ); }
+  }
+  if ( frame_idx >= 0 ) {
+    vol_av_shared_frame_t* frame_ptr = &s->frames_ptr[frame_idx];
+    if ( p->shared_frame_idx != frame_idx ) {
+      if ( p->shared_frame_idx >= 0 ) { s->frames_ptr[p->shared_frame_idx].n_cursors--; }
+      frame_ptr->n_cursors++;
+      p->shared_frame_idx = frame_idx;
+    }
+    frame_ptr->last_used     = ++s->use_count;
+    info_ptr->pixels_ptr     = frame_ptr->pixels_ptr;
+    info_ptr->w              = frame_ptr->w;
+    info_ptr->h              = frame_ptr->h;
+    info_ptr->pts_s          = frame_ptr->pts_s;
+    info_ptr->frame_idx      = frame_ptr->frame_idx;
+    info_ptr->compressed_ptr = frame_ptr->compressed_sz > 0 ? frame_ptr->compressed_ptr : NULL;
+    info_ptr->compressed_sz  = frame_ptr->compressed_sz;
+    info_ptr->buffer_idx     = -1;
+  }
+  _mutex_unlock( &s->lock );
+  return frame_idx >= 0;
+}
 
-  // Try a few times, in case there are dangling packets at the beginning or end of file to clean up. -- Anton.
-  for ( int i = 0; i < 8; i++ ) {
-    if ( av_read_frame( p->fmt_ctx_ptr, packet_ptr ) >= 0 ) {
-      // if it's the video stream
-      if ( packet_ptr->stream_index == p->video_stream_idx ) {
-        packet_response = _decode_packet( info_ptr, packet_ptr );
-        if ( packet_response == AVERROR( EAGAIN ) || packet_response == AVERROR_EOF ) {
-          av_packet_unref( packet_ptr );
-          continue;
-        }
-        // https://ffmpeg.org/doxygen/trunk/group__lavc__packet.html#ga63d5a489b419bd5d45cfd09091cbcbc2
-        break;
-      }      // endwhile
-    } else { // maybe there are some leftover packets from last read
-      if ( packet_ptr->stream_index == p->video_stream_idx ) {
-        packet_response = _decode_packet( info_ptr, packet_ptr );
-        if ( packet_response == AVERROR( EAGAIN ) || packet_response == AVERROR_EOF ) {
-          av_packet_unref( packet_ptr );
-          continue;
-        }
+/** Called by vol_av_close() for an instance of a shared video. The registry entry is freed with its last instance. */
+static void _release_shared_cursor( vol_av_internal_t* p ) {
+  vol_av_shared_t* s = p->shared_ptr;
+  _mutex_lock( &_shared_videos_lock );
+  _mutex_lock( &s->lock );
+  if ( p->shared_frame_idx >= 0 ) { s->frames_ptr[p->shared_frame_idx].n_cursors--; }
+  s->ref_count--;
+  // Keep at most a decoder per instance, and one frame more than the instances can present.
+  if ( s->ref_count > 0 && s->n_decoders > s->ref_count ) { vol_av_close( &s->decoders[--s->n_decoders] ); }
+  int n_allocated = 0;
+  for ( int i = 0; i < s->n_frames; i++ ) { n_allocated += s->frames_ptr[i].pixels_ptr ? 1 : 0; }
+  while ( n_allocated > s->ref_count + 1 ) {
+    int idx = -1;
+    for ( int i = 0; i < s->n_frames; i++ ) {
+      const vol_av_shared_frame_t* frame_ptr = &s->frames_ptr[i];
+      if ( frame_ptr->pixels_ptr && 0 == frame_ptr->n_cursors && ( idx < 0 || frame_ptr->last_used < s->frames_ptr[idx].last_used ) ) { idx = i; }
+    }
+    if ( idx < 0 ) { break; }
+    _free_shared_frame( &s->frames_ptr[idx] );
+    n_allocated--;
+  }
+  _mutex_unlock( &s->lock );
+
+  if ( 0 == s->ref_count ) {
+    for ( vol_av_shared_t** link_ptr = &_shared_videos_ptr; *link_ptr; link_ptr = &( *link_ptr )->next_ptr ) {
+      if ( *link_ptr == s ) {
+        *link_ptr = s->next_ptr;
         break;
-      } // endwhile
+      }
     }
+    _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Freeing shared video `%s`\n", s->filename );
+    _free_shared_video( s );
   }
+  _mutex_unlock( &_shared_videos_lock );
+  p->shared_ptr       = NULL;
+  p->shared_frame_idx = -1;
+}
 
-  av_packet_unref( packet_ptr );
-  av_packet_free( &packet_ptr );
+/** vol_av_set_output_scale() for every instance of a shared video. */
+static void _shared_set_output_scale( vol_av_shared_t* s, int level ) {
+  _mutex_lock( &s->lock );
+  s->output_scale_level = level;
+  for ( int i = 0; i < s->n_decoders; i++ ) { vol_av_set_output_scale( &s->decoders[i], level ); }
+  _mutex_unlock( &s->lock );
+}
+
+/** vol_av_set_output_compression() for every instance of a shared video. Instances keep presenting the frames they have until they next read one. */
+static bool _shared_set_output_compression( vol_av_shared_t* s, vol_av_texture_format_t format ) {
+  _mutex_lock( &s->lock );
+  bool set = true;
+  for ( int i = 0; i < s->n_decoders; i++ ) { set = vol_av_set_output_compression( &s->decoders[i], format ) && set; }
+  if ( !set ) {
+    format = VOL_AV_TEXTURE_FORMAT_RGB24; // So the decoders all agree.
+    for ( int i = 0; i < s->n_decoders; i++ ) { vol_av_set_output_compression( &s->decoders[i], format ); }
+  }
+  s->texture_format = format;
+  for ( int i = 0; i < s->n_frames; i++ ) { s->frames_ptr[i].valid = false; }
+  _mutex_unlock( &s->lock );
+  return set;
+}
+
+//
+//
+bool vol_av_open_shared( const char* filename, vol_av_video_t* info_ptr ) {
+  if ( !filename || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+
+  if ( !_create_context( info_ptr ) ) { return false; }
+  _mutex_lock( &_shared_videos_lock );
+  vol_av_shared_t* s = _shared_videos_ptr;
+  while ( s && 0 != strcmp( s->filename, filename ) ) { s = s->next_ptr; }
+  if ( !s ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening shared video `%s`...\n", filename );
+    size_t len = strlen( filename );
+    s          = calloc( 1, sizeof( vol_av_shared_t ) );
+    if ( s ) { s->filename = malloc( len + 1 ); }
+    if ( !s || !s->filename ) {
+      _mutex_unlock( &_shared_videos_lock );
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for shared video `%s`\n", filename );
+      free( s );
+      return false;
+    }
+    memcpy( s->filename, filename, len + 1 );
+    _mutex_init( &s->lock );
+    s->flip_vertical = -1;
+    if ( _open_shared_decoder( s ) < 0 ) {
+      _mutex_unlock( &_shared_videos_lock );
+      _free_shared_video( s );
+      return false;
+    }
+    s->next_ptr        = _shared_videos_ptr;
+    _shared_videos_ptr = s;
+  }
+  _mutex_lock( &s->lock );
+  s->ref_count++;
+  _mutex_unlock( &s->lock );
+  _mutex_unlock( &_shared_videos_lock );
+
+  info_ptr->_context_ptr->shared_ptr       = s;
+  info_ptr->_context_ptr->shared_frame_idx = -1;
+  return true;
+}
+
+//
+//
+int64_t vol_av_shared_memory_usage( void ) {
+  int64_t sz = 0;
+  _mutex_lock( &_shared_videos_lock );
+  for ( vol_av_shared_t* s = _shared_videos_ptr; s; s = s->next_ptr ) {
+    _mutex_lock( &s->lock );
+    int w = 0, h = 0;
+    vol_av_dimensions( &s->decoders[0], &w, &h );
+    for ( int i = 0; i < s->n_decoders; i++ ) { sz += vol_av_memory_usage( &s->decoders[i] ); }
+    for ( int i = 0; i < s->n_frames; i++ ) {
+      if ( s->frames_ptr[i].pixels_ptr ) { sz += (int64_t)w * h * 3; }
+      sz += s->frames_ptr[i].compressed_cap;
+    }
+    _mutex_unlock( &s->lock );
+  }
+  _mutex_unlock( &_shared_videos_lock );
+  return sz;
+}
+
+/******************************************************************************
+  AUDIO
+******************************************************************************/
+
+/** Open the decoder for `audio_stream_idx`, and set up conversion to interleaved float at the stream's own sample rate and channel count. */
+static bool _open_audio( vol_av_internal_t* p ) {
+  const AVStream* a_strm_ptr = p->fmt_ctx_ptr->streams[p->audio_stream_idx];
+
+  p->audio_codec_ctx_ptr = avcodec_alloc_context3( p->audio_codec_ptr );
+  if ( !p->audio_codec_ctx_ptr ) { return false; }
+  if ( avcodec_parameters_to_context( p->audio_codec_ctx_ptr, a_strm_ptr->codecpar ) < 0 ) { return false; }
+  p->audio_codec_ctx_ptr->pkt_timebase = a_strm_ptr->time_base;
+  if ( avcodec_open2( p->audio_codec_ctx_ptr, p->audio_codec_ptr, NULL ) < 0 ) { return false; }
+
+  AVCodecContext* ctx_ptr = p->audio_codec_ctx_ptr;
+  p->audio_sample_rate    = ctx_ptr->sample_rate;
+#if LIBAVUTIL_VERSION_CHECK(57, 28, 100)
+  p->audio_channels = ctx_ptr->ch_layout.nb_channels;
+#else
+  p->audio_channels = ctx_ptr->channels;
+#endif
+  if ( p->audio_sample_rate <= 0 || p->audio_channels <= 0 ) { return false; }
+
+  // The sample rate and channel count are kept, so swresample only has to interleave and convert the sample format. The engine mixes and
+  // resamples to its output rate, as it does for any other audio clip.
+#if LIBAVUTIL_VERSION_CHECK(57, 28, 100)
+  AVChannelLayout out_layout;
+  av_channel_layout_default( &out_layout, p->audio_channels );
+  int ret = swr_alloc_set_opts2( &p->swr_ctx_ptr, &out_layout, AV_SAMPLE_FMT_FLT, p->audio_sample_rate, &ctx_ptr->ch_layout, ctx_ptr->sample_fmt,
+    ctx_ptr->sample_rate, 0, NULL );
+  av_channel_layout_uninit( &out_layout );
+  if ( ret < 0 ) { return false; }
+#else
+  int64_t in_layout = ctx_ptr->channel_layout ? (int64_t)ctx_ptr->channel_layout : av_get_default_channel_layout( ctx_ptr->channels );
+  p->swr_ctx_ptr    = swr_alloc_set_opts( NULL, av_get_default_channel_layout( p->audio_channels ), AV_SAMPLE_FMT_FLT, p->audio_sample_rate, in_layout,
+    ctx_ptr->sample_fmt, ctx_ptr->sample_rate, 0, NULL );
+#endif
+  if ( !p->swr_ctx_ptr || swr_init( p->swr_ctx_ptr ) < 0 ) { return false; }
+
+  p->audio_frame_ptr   = av_frame_alloc();
+  p->audio_ring_frames = (uint32_t)p->audio_sample_rate * VOL_AV_AUDIO_RING_S;
+  p->audio_ring_ptr    = malloc( (size_t)p->audio_ring_frames * p->audio_channels * sizeof( float ) );
+  if ( p->audio_ring_ptr ) { _mutex_init( &p->audio_clock_lock ); } // Destroyed by _close_audio() along with the ring.
+  if ( !p->audio_frame_ptr || !p->audio_ring_ptr ) { return false; }
+  p->audio_enabled = 1;
+
+  _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Audio output: %d channels, sample rate %d\n", p->audio_channels, p->audio_sample_rate );
+  return true;
+}
 
-  if ( packet_response < 0 && packet_response != AVERROR_EOF && packet_response != AVERROR( EAGAIN ) ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: packet response was %i.\n", packet_response );
+/** Free everything allocated by _open_audio(), which may have only partly succeeded. */
+static void _close_audio( vol_av_internal_t* p ) {
+  if ( p->audio_codec_ctx_ptr ) { avcodec_free_context( &p->audio_codec_ctx_ptr ); }
+  if ( p->audio_frame_ptr ) { av_frame_free( &p->audio_frame_ptr ); }
+  if ( p->swr_ctx_ptr ) { swr_free( &p->swr_ctx_ptr ); }
+  free( p->audio_scratch_ptr );
+  if ( p->audio_ring_ptr ) { _mutex_destroy( &p->audio_clock_lock ); }
+  free( p->audio_ring_ptr );
+  p->audio_scratch_ptr    = NULL;
+  p->audio_scratch_frames = 0;
+  p->audio_ring_ptr       = NULL;
+  p->audio_stream_idx     = -1;
+  p->audio_enabled        = 0;
+}
+
+/** Convert a decoded audio frame to interleaved float and append it to the ring. If the application isn't reading audio fast enough, the samples
+ * that don't fit are dropped rather than blocking video decoding. */
+static void _write_audio_frame( vol_av_internal_t* p, const AVFrame* frame_ptr ) {
+  int max_out = swr_get_out_samples( p->swr_ctx_ptr, frame_ptr->nb_samples );
+  if ( max_out <= 0 ) { return; }
+  if ( max_out > p->audio_scratch_frames ) {
+    float* tmp_ptr = realloc( p->audio_scratch_ptr, (size_t)max_out * p->audio_channels * sizeof( float ) );
+    if ( !tmp_ptr ) { return; }
+    p->audio_scratch_ptr    = tmp_ptr;
+    p->audio_scratch_frames = max_out;
+  }
+  uint8_t* out_ptr = (uint8_t*)p->audio_scratch_ptr;
+  int n_frames     = swr_convert( p->swr_ctx_ptr, &out_ptr, max_out, (const uint8_t**)frame_ptr->extended_data, frame_ptr->nb_samples );
+  if ( n_frames <= 0 ) { return; }
+
+  uint32_t written = p->audio_written; // Only the decoding thread writes to audio_written.
+  if ( !p->audio_started ) {
+    int64_t ts     = frame_ptr->best_effort_timestamp;
+    double start_s = ( AV_NOPTS_VALUE == ts ) ? 0.0 : _stream_time_s( p, p->audio_stream_idx, ts );
+    _mutex_lock( &p->audio_clock_lock );
+    p->audio_start_s   = start_s;
+    p->audio_start_idx = written;
+    _mutex_unlock( &p->audio_clock_lock );
+    p->audio_started = true;
+  }
+
+  uint32_t space   = p->audio_ring_frames - ( written - _atomic_load_u32( &p->audio_read ) );
+  if ( (uint32_t)n_frames > space ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "audio ring full, dropped %u sample frames\n", (uint32_t)n_frames - space );
+    n_frames = (int)space;
+  }
+  // Copy in up to two parts, if the write wraps around the end of the ring.
+  uint32_t start = written % p->audio_ring_frames;
+  uint32_t first = p->audio_ring_frames - start;
+  if ( first > (uint32_t)n_frames ) { first = (uint32_t)n_frames; }
+  int n_ch = p->audio_channels;
+  memcpy( &p->audio_ring_ptr[start * n_ch], p->audio_scratch_ptr, first * n_ch * sizeof( float ) );
+  memcpy( p->audio_ring_ptr, &p->audio_scratch_ptr[first * n_ch], ( n_frames - first ) * n_ch * sizeof( float ) );
+  // Publish only after the samples are fully written.
+  _atomic_store_u32( &p->audio_written, written + (uint32_t)n_frames );
+}
+
+/** Send an audio packet to the audio decoder and write every frame that comes out to the ring. A NULL packet drains the decoder. */
+static void _decode_audio_packet( vol_av_internal_t* p, const AVPacket* packet_ptr ) {
+  if ( packet_ptr && AV_NOPTS_VALUE != packet_ptr->pts ) {
+    p->audio_demuxed_s = _stream_time_s( p, p->audio_stream_idx, packet_ptr->pts + packet_ptr->duration );
+  }
+  // Every frame is received after each packet is sent, so the decoder never refuses input with EAGAIN.
+  int response = avcodec_send_packet( p->audio_codec_ctx_ptr, packet_ptr );
+  if ( response < 0 && response != AVERROR_EOF ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: while sending a packet to the audio decoder: %s\n", av_err2str( response ) );
+    return;
+  }
+  while ( avcodec_receive_frame( p->audio_codec_ctx_ptr, p->audio_frame_ptr ) >= 0 ) { _write_audio_frame( p, p->audio_frame_ptr ); }
+}
+
+//
+//
+bool vol_av_has_audio( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  return info_ptr->_context_ptr->audio_codec_ctx_ptr != NULL;
+}
+
+//
+//
+void vol_av_audio_format( const vol_av_video_t* info_ptr, int* sample_rate, int* n_channels ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || !sample_rate || !n_channels ) { return; }
+  *sample_rate = info_ptr->_context_ptr->audio_sample_rate;
+  *n_channels  = info_ptr->_context_ptr->audio_channels;
+}
+
+//
+//
+void vol_av_set_audio_enabled( vol_av_video_t* info_ptr, bool enabled ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return; }
+  _atomic_store_u32( &info_ptr->_context_ptr->audio_enabled, enabled ? 1 : 0 );
+}
+
+//
+//
+int vol_av_read_audio( vol_av_video_t* info_ptr, float* samples_ptr, int n_frames ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || !samples_ptr || n_frames <= 0 ) { return 0; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  int n_ch             = p->audio_channels;
+  int n_read           = 0;
+  if ( p->audio_ring_ptr ) {
+    uint32_t read      = p->audio_read; // Only the audio thread writes to audio_read.
+    uint32_t discard   = _atomic_load_u32( &p->audio_discard_to );
+    if ( (int32_t)( discard - read ) > 0 ) { read = discard; } // Skip audio from before a seek.
+    uint32_t available = _atomic_load_u32( &p->audio_written ) - read;
+    n_read             = (uint32_t)n_frames < available ? n_frames : (int)available;
+    uint32_t start     = read % p->audio_ring_frames;
+    uint32_t first     = p->audio_ring_frames - start;
+    if ( first > (uint32_t)n_read ) { first = (uint32_t)n_read; }
+    memcpy( samples_ptr, &p->audio_ring_ptr[start * n_ch], first * n_ch * sizeof( float ) );
+    memcpy( &samples_ptr[first * n_ch], p->audio_ring_ptr, ( n_read - first ) * n_ch * sizeof( float ) );
+    _atomic_store_u32( &p->audio_read, read + (uint32_t)n_read );
+  }
+  // Pad an underrun with silence, so the engine always gets a full buffer.
+  if ( n_read < n_frames ) { memset( &samples_ptr[n_read * n_ch], 0, ( n_frames - n_read ) * n_ch * sizeof( float ) ); }
+
+  return n_read;
+}
+
+//
+//
+double vol_av_audio_clock_s( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return -1.0; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( !p->audio_ring_ptr || !_atomic_load_u32( &p->audio_written ) ) { return -1.0; } // audio_start_s is set before the first samples are published.
+  // The start is reset by each seek, on the decoding thread, so both halves are read under the lock to get a matching pair.
+  _mutex_lock( &p->audio_clock_lock );
+  double start_s     = p->audio_start_s;
+  uint32_t start_idx = p->audio_start_idx;
+  _mutex_unlock( &p->audio_clock_lock );
+  int32_t n_since_start = (int32_t)( _atomic_load_u32( &p->audio_read ) - start_idx );
+  if ( n_since_start < 0 ) { n_since_start = 0; } // Still reading up to a seek.
+  return start_s + (double)n_since_start / (double)p->audio_sample_rate;
+}
+
+/******************************************************************************
+  OUTPUT SCALE
+******************************************************************************/
+
+//
+//
+bool vol_av_set_output_scale( vol_av_video_t* info_ptr, int level ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  if ( level < 0 || level > VOL_AV_OUTPUT_SCALE_MAX ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: output scale level %i is not in the range 0-%i.\n", level, VOL_AV_OUTPUT_SCALE_MAX );
     return false;
   }
 
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->shared_ptr ) {
+    _shared_set_output_scale( p->shared_ptr, level );
+    return true;
+  }
+  // Read by the decode thread before each conversion, so the change takes effect from the next frame converted.
+  _atomic_store_u32( &p->output_scale_level, (uint32_t)level );
   return true;
 }
 
 //
 //
-void vol_av_dimensions( const vol_av_video_t* info_ptr, int* w, int* h ) {
+void vol_av_output_dimensions( const vol_av_video_t* info_ptr, int* w, int* h ) {
   if ( !info_ptr || !info_ptr->_context_ptr || !w || !h ) { return; }
 
+  _output_dims( _stream_context( info_ptr ), w, h );
+}
+
+/******************************************************************************
+  OUTPUT COMPRESSION
+******************************************************************************/
+
+static void _free_user_compressed( vol_av_internal_t* p ) {
+  for ( int i = 0; p->user_compressed_ptr && i < p->n_user_buffers; i++ ) { free( p->user_compressed_ptr[i] ); }
+  free( p->user_compressed_ptr );
+  p->user_compressed_ptr = NULL;
+}
+
+/** Give each application output buffer a compressed image of its own, if there are output buffers and compression is on.
+ * @return False if memory ran out, in which case there are none. */
+static bool _alloc_user_compressed( vol_av_internal_t* p ) {
+  _free_user_compressed( p );
+  if ( 0 == p->n_user_buffers || VOL_AV_TEXTURE_FORMAT_RGB24 == p->texture_format ) { return true; }
+
+  size_t sz              = (size_t)vol_av_compressed_size( p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, p->texture_format );
+  p->user_compressed_ptr = calloc( p->n_user_buffers, sizeof( uint8_t* ) );
+  for ( int i = 0; p->user_compressed_ptr && i < p->n_user_buffers; i++ ) {
+    p->user_compressed_ptr[i] = malloc( sz );
+    if ( !p->user_compressed_ptr[i] ) {
+      _free_user_compressed( p );
+      break;
+    }
+  }
+  if ( !p->user_compressed_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate compressed frames for the output buffers.\n" );
+    return false;
+  }
+  return true;
+}
+
+//
+//
+bool vol_av_set_output_compression( vol_av_video_t* info_ptr, vol_av_texture_format_t format ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  if ( format < VOL_AV_TEXTURE_FORMAT_RGB24 || format >= VOL_AV_TEXTURE_FORMAT_MAX ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: unknown texture format %i.\n", (int)format );
+    return false;
+  }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->shared_ptr ) {
+    info_ptr->compressed_ptr = NULL;
+    info_ptr->compressed_sz  = 0;
+    return _shared_set_output_compression( p->shared_ptr, format );
+  }
+  // Each slot of the decode thread's ring has its own compressed buffer, allocated when the thread starts.
+  if ( p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: output compression can not be changed while the decode thread is running.\n" );
+    return false;
+  }
+
+  free( p->compressed_ptr );
+  _free_user_compressed( p );
+  if ( VOL_AV_TEXTURE_FORMAT_RGB24 != p->texture_format ) { _compress_pool_release(); }
+  p->compressed_ptr        = NULL;
+  p->texture_format        = VOL_AV_TEXTURE_FORMAT_RGB24;
+  info_ptr->compressed_ptr = NULL;
+  info_ptr->compressed_sz  = 0;
+  if ( VOL_AV_TEXTURE_FORMAT_RGB24 == format ) { return true; }
+
+  p->compressed_ptr = malloc( (size_t)vol_av_compressed_size( p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, format ) );
+  if ( !p->compressed_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: malloc() failed to allocate memory for compressed frames\n" );
+    return false;
+  }
+  p->texture_format = format;
+  if ( !_alloc_user_compressed( p ) ) {
+    free( p->compressed_ptr );
+    p->compressed_ptr = NULL;
+    p->texture_format = VOL_AV_TEXTURE_FORMAT_RGB24;
+    return false;
+  }
+  // Keep the compression workers for as long as this video compresses, rather than starting them for each frame.
+  _compress_pool_acquire();
+  return true;
+}
+
+/******************************************************************************
+  REVERSE PLAY
+******************************************************************************/
+
+//
+//
+bool vol_av_set_reverse_cache_size( vol_av_video_t* info_ptr, int64_t max_sz ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || max_sz < 0 ) { return false; }
+  if ( _is_shared_cursor( info_ptr, "vol_av_set_reverse_cache_size" ) ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  // The application may be showing a cached frame, which is about to be freed.
+  if ( info_ptr->pixels_ptr && info_ptr->buffer_idx < 0 && info_ptr->pixels_ptr != p->output_frame_rgb_ptr->data[0] ) { info_ptr->pixels_ptr = NULL; }
+  _free_reverse_cache( p );
+
+  int64_t frame_sz = (int64_t)av_image_get_buffer_size( AV_PIX_FMT_RGB24, p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, 1 );
+  int64_t n_slots  = frame_sz > 0 ? max_sz / frame_sz : 0;
+  p->rev_max_slots = n_slots > INT32_MAX ? INT32_MAX : (int)n_slots;
+  if ( max_sz > 0 && 0 == p->rev_max_slots ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: reverse cache of %lld bytes can't hold one %lld byte frame, so it is off.\n", (long long)max_sz,
+      (long long)frame_sz );
+  }
+  return true;
+}
+
+/******************************************************************************
+  APPLICATION OUTPUT BUFFERS
+******************************************************************************/
+
+//
+//
+bool vol_av_set_output_buffers( vol_av_video_t* info_ptr, uint8_t** buffers_ptr, int n_buffers, int64_t buffer_sz ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  if ( _is_shared_cursor( info_ptr, "vol_av_set_output_buffers" ) ) { return false; }
+
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( p->decode_thread_running ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: output buffers can not be changed while the decode thread is running.\n" );
+    return false;
+  }
+
+  // Forget any previous buffers. If the application still points at one then that pointer is now its own business.
+  if ( info_ptr->buffer_idx >= 0 ) {
+    info_ptr->pixels_ptr     = NULL;
+    info_ptr->compressed_ptr = NULL;
+    info_ptr->compressed_sz  = 0;
+  }
+  info_ptr->buffer_idx = -1;
+  _free_user_compressed( p );
+  free( p->user_buffers_ptr );
+  free( p->user_buffer_held_ptr );
+  p->user_buffers_ptr     = NULL;
+  p->user_buffer_held_ptr = NULL;
+  p->n_user_buffers       = 0;
+  p->next_user_buffer     = 0;
+  if ( !buffers_ptr || n_buffers <= 0 ) { return true; }
+
+  int64_t min_sz = (int64_t)p->codec_ctx_ptr->width * (int64_t)p->codec_ctx_ptr->height * 3;
+  if ( buffer_sz < min_sz ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: output buffers of %lld bytes are too small for %ix%i RGB frames.\n", (long long)buffer_sz,
+      p->codec_ctx_ptr->width, p->codec_ctx_ptr->height );
+    return false;
+  }
+  for ( int i = 0; i < n_buffers; i++ ) {
+    if ( !buffers_ptr[i] ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: output buffer %i is NULL.\n", i );
+      return false;
+    }
+  }
+
+  p->user_buffers_ptr     = malloc( n_buffers * sizeof( uint8_t* ) );
+  p->user_buffer_held_ptr = calloc( n_buffers, sizeof( bool ) );
+  if ( !p->user_buffers_ptr || !p->user_buffer_held_ptr ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for output buffer list.\n" );
+    free( p->user_buffers_ptr );
+    free( p->user_buffer_held_ptr );
+    p->user_buffers_ptr     = NULL;
+    p->user_buffer_held_ptr = NULL;
+    return false;
+  }
+  memcpy( p->user_buffers_ptr, buffers_ptr, n_buffers * sizeof( uint8_t* ) );
+  p->n_user_buffers = n_buffers;
+  if ( !_alloc_user_compressed( p ) ) {
+    free( p->user_buffers_ptr );
+    free( p->user_buffer_held_ptr );
+    p->user_buffers_ptr     = NULL;
+    p->user_buffer_held_ptr = NULL;
+    p->n_user_buffers       = 0;
+    return false;
+  }
+
+  return true;
+}
+
+//
+//
+void vol_av_release_output_buffer( vol_av_video_t* info_ptr, int buffer_idx ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return; }
+
   vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( buffer_idx < 0 || buffer_idx >= p->n_user_buffers ) { return; }
+  p->user_buffer_held_ptr[buffer_idx] = false;
+}
+
+//
+//
+void vol_av_dimensions( const vol_av_video_t* info_ptr, int* w, int* h ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || !w || !h ) { return; }
+
+  vol_av_internal_t* p = _stream_context( info_ptr );
   *w                   = p->codec_ctx_ptr->width;
   *h                   = p->codec_ctx_ptr->height;
 }
@@ -400,7 +3042,7 @@ void vol_av_dimensions( const vol_av_video_t* info_ptr, int* w, int* h ) {
 double vol_av_frame_rate( const vol_av_video_t* info_ptr ) {
   if ( !info_ptr || !info_ptr->_context_ptr ) { return 0.0; }
 
-  vol_av_internal_t* p = info_ptr->_context_ptr;
+  vol_av_internal_t* p = _stream_context( info_ptr );
   int v_idx            = p->video_stream_idx;
   AVStream* v_strm     = p->fmt_ctx_ptr->streams[v_idx];
   AVRational avfr      = v_strm->avg_frame_rate;
@@ -414,7 +3056,7 @@ double vol_av_frame_rate( const vol_av_video_t* info_ptr ) {
 int64_t vol_av_frame_count( const vol_av_video_t* info_ptr ) {
   if ( !info_ptr || !info_ptr->_context_ptr ) { return 0; }
 
-  vol_av_internal_t* p = info_ptr->_context_ptr;
+  vol_av_internal_t* p = _stream_context( info_ptr );
   int v_idx            = p->video_stream_idx;
   AVStream* v_strm     = p->fmt_ctx_ptr->streams[v_idx];
   // this variable is 0 if nb_frames "is not known" by libav
@@ -435,7 +3077,7 @@ int64_t vol_av_frame_count( const vol_av_video_t* info_ptr ) {
 double vol_av_duration_s( const vol_av_video_t* info_ptr ) {
   if ( !info_ptr || !info_ptr->_context_ptr ) { return 0.0; }
   if ( AV_TIME_BASE <= 0 ) { return 0.0; } // Safety catch for div by zero.
-  vol_av_internal_t* p = info_ptr->_context_ptr;
+  vol_av_internal_t* p = _stream_context( info_ptr );
   int64_t duration     = p->fmt_ctx_ptr->duration; // eg. output.mpg 5394000.  Duration: 00:00:59.93. in AV_TIME_BASE units.
   double duration_s    = duration / (double)AV_TIME_BASE;
   return duration_s;
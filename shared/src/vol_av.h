@@ -3,7 +3,7 @@
  *
  * vol_av    | Audio-Video Decoding API
  * --------- | ----------
- * Version   | 0.9
+ * Version   | 0.10
  * Authors   | Anton Gerdelan <anton@volograms.com>
  * Copyright | 2021, Volograms (http://volograms.com/)
  * Language  | C99
@@ -13,17 +13,41 @@
  *
  * Current Limitations
  * -----------
- * * Only video is currently processed, audio is ignored.
- * * Seek frame is not implemented.
- * * Reverse play is not implemented.
+ * * Only the first audio stream is decoded, and it is given to the application at its own sample rate and channel count.
+ * * Seeking is only done by vol_av_read_frame_at_time(), when the requested time is before the current frame.
+ * * Reverse play converts a stretch of each GOP into memory, so it needs vol_av_set_reverse_cache_size(). Without a cache each frame backwards
+ *   is decoded forwards from its keyframe. Audio isn't played in reverse.
  * * Network streaming is not implemented.
  *
  * References
  * -----------
  * - A decent libav/ffmpeg implementation reference material is this tutorial series: https://github.com/mpenkov/ffmpeg-tutorial
  *
+ * Build Options
+ * -------------
+ * - VOL_AV_THREADED      - Decode with FFmpeg's decoder threads.
+ * - VOL_AV_MALLOC_PREFIX - Recycle FFmpeg's heap blocks in size-classed free lists, so playback makes no heap allocations after warm-up. Needs an
+ *                          FFmpeg configured with --malloc-prefix=vol_av_mem_, which then calls vol_av_mem_malloc() and friends. Not on Windows.
+ *
  * History
  * -----------
+ * - 0.10.0 (2026/10/18) - Decoding performance:
+ *                          - Optional background decode thread that fills a lock-free queue of converted frames.
+ *                          - Frame-threaded decoding. Frames are tracked by timestamp, decoder delay is absorbed on open, and delayed frames are
+ *                            flushed at end of file.
+ *                          - Packet and frame structs are allocated once on open and reused.
+ *                          - VOL_AV_MALLOC_PREFIX recycles FFmpeg's own heap blocks, for no allocations per frame after warm-up.
+ *                          - Frames can be decoded into application-owned output buffers with explicit ownership.
+ *                          - Runtime-adjustable output scale, to convert small or distant volograms at half or quarter resolution.
+ *                          - Audio is decoded from the same demux pass as the video into a lock-free ring of float samples, with an audio clock.
+ *                          - vol_av_open_io() and vol_av_open_memory() read video from application callbacks or memory instead of a file.
+ *                          - vol_av_read_frame_at_time() selects frames by timestamp, with `frame_idx` for matching geometry frames.
+ *                          - A bounded cache of converted frames for reverse and ping-pong play, and seeking on long jumps forward.
+ *                          - vol_av_scrub_to_time() decodes only keyframes at reduced resolution for interactive timeline scrubbing.
+ *                          - An optional process-wide decode scheduler, so many streams share one worker pool with per-stream priorities.
+ *                          - Optional BC1 and ETC2 RGB output, encoded in parallel on the CPU, so frames upload 6x smaller than RGB.
+ *                          - vol_av_memory_usage() reports the frame buffers held by a video.
+ *                          - vol_av_open_shared() opens instances of a video that share its decoders and decoded frames.
  * - 0.9.0 (2022/03/23) - Added log reset from Unity plugin, multithreaded decoding, and tidied docs.
  * - 0.8.0 (2021/01/20) - Added customisable debug callback.
  * - 0.7.1 (2021/12/10) - Tidied comments.
@@ -67,8 +91,47 @@ VOL_AV_EXPORT typedef struct vol_av_video_t {
   uint8_t* pixels_ptr;
   /** Dimensions of image in `pixels_ptr`. */
   int w, h;
+  /** Presentation time of the image in `pixels_ptr`, in seconds from the start of the video stream. */
+  double pts_s;
+  /** Index of the application output buffer that `pixels_ptr` points into, or -1 if it points to internal storage. See vol_av_set_output_buffers(). */
+  int buffer_idx;
+  /** Index of the frame in `pixels_ptr`, from `pts_s` and the stream's frame rate. Use this to pick the geometry frame, so both come from the same clock. */
+  int64_t frame_idx;
+  /** The image in `pixels_ptr` encoded in the format set by vol_av_set_output_compression(), or NULL if frames are not being compressed. */
+  uint8_t* compressed_ptr;
+  /** Size in bytes of the data at `compressed_ptr`. */
+  int64_t compressed_sz;
 } vol_av_video_t;
 
+/** `whence` value given to vol_av_io_t::seek_fn to ask for the total size of the input instead of seeking. Same as FFmpeg's AVSEEK_SIZE. */
+#define VOL_AV_SEEK_SIZE 0x10000
+
+/** Application-supplied input for vol_av_open_io(), for reading a video out of an archive, a packed bundle, or any other source that isn't a plain file. */
+typedef struct vol_av_io_t {
+  /** Passed back as the first argument of the callbacks. */
+  void* user_ptr;
+  /** Copy up to `buf_size` bytes of input into `buf`. Must not be NULL.
+   * @return The number of bytes copied, or 0 or a negative value at the end of the input or on error. */
+  int ( *read_fn )( void* user_ptr, uint8_t* buf, int buf_size );
+  /** Seek to `offset` from `whence`, which is SEEK_SET, SEEK_CUR, or SEEK_END, or return the size of the input if `whence` is VOL_AV_SEEK_SIZE.
+   * May be NULL if the input can't seek, but most containers need to seek while opening.
+   * @return The new position, or the size, or a negative value on error. */
+  int64_t ( *seek_fn )( void* user_ptr, int64_t offset, int whence );
+  /** Size in bytes of the buffer FFmpeg reads into through `read_fn`. Larger buffers mean fewer, larger reads. If 0, 256kB is used. */
+  int buffer_sz;
+} vol_av_io_t;
+
+/** Largest level accepted by vol_av_set_output_scale(). Level 2 converts frames to a quarter of the video's width and height. */
+#define VOL_AV_OUTPUT_SCALE_MAX 2
+
+/** GPU texture formats that frames can be encoded into. See vol_av_set_output_compression(). */
+typedef enum vol_av_texture_format_t {
+  VOL_AV_TEXTURE_FORMAT_RGB24 = 0, // Uncompressed, tightly-packed 3-channel RGB. 3 bytes per pixel.
+  VOL_AV_TEXTURE_FORMAT_BC1,       // BC1, also called DXT1, for desktop GPUs. 8 bytes per 4x4 block.
+  VOL_AV_TEXTURE_FORMAT_ETC2_RGB,  // ETC2 RGB, for mobile GPUs. 8 bytes per 4x4 block. Only the ETC1 modes are used, so ETC1 GPUs can read it too.
+  VOL_AV_TEXTURE_FORMAT_MAX        // Not a format, just used to count the formats.
+} vol_av_texture_format_t;
+
 /** In your application these enum values can be used to filter out or categorise messages given by vol_av_log_callback. */
 typedef enum vol_av_log_type_t {
   VOL_AV_LOG_TYPE_INFO = 0, //
@@ -83,18 +146,50 @@ VOL_AV_EXPORT void vol_av_set_log_callback( void ( *user_function_ptr )( vol_av_
 VOL_AV_EXPORT void vol_av_reset_log_callback( void );
 
 /** Open a video file given by `filename`.
+ * Each context has its own demuxer and decoder, and contexts never share decoded frames, even for the same file at the same time. To share them
+ * between instances of the same vologram, use vol_av_open_shared() instead.
  * @param filename File path to the movie file to open. Must not be NULL.
  * @param info_ptr This function populates the struct pointed to with context data about the file. Must not be NULL.
  * @return         False on error. If info_ptr points to a struct where _context_ptr is not initialised to NULL this function will fail and return false.
  */
 VOL_AV_EXPORT bool vol_av_open( const char* filename, vol_av_video_t* info_ptr );
 
+/** Open a video that is read through application callbacks instead of from a file.
+ * Callbacks are made from whichever thread is decoding, which is the decode thread if one is started, but never from more than one at a time.
+ * @param io_ptr   The callbacks. Copied, so the struct itself doesn't need to outlive this call, but `user_ptr` does until vol_av_close(). Must not be NULL.
+ * @param info_ptr This function populates the struct pointed to with context data about the video. Must not be NULL.
+ * @return         False on error. As for vol_av_open(), call vol_av_close() to free a context that failed to open.
+ */
+VOL_AV_EXPORT bool vol_av_open_io( const vol_av_io_t* io_ptr, vol_av_video_t* info_ptr );
+
+/** Open a video that has already been loaded into memory, for example a short clip read fully up-front so that playback makes no file reads.
+ * @param data_ptr  The entire video file. Not copied, so it must stay allocated and unchanged until vol_av_close(). Must not be NULL.
+ * @param data_sz   Size of `data_ptr` in bytes.
+ * @param buffer_sz Size in bytes of the buffer FFmpeg reads through. If 0, 256kB is used.
+ * @param info_ptr  This function populates the struct pointed to with context data about the video. Must not be NULL.
+ * @return          False on error.
+ */
+VOL_AV_EXPORT bool vol_av_open_memory( const uint8_t* data_ptr, int64_t data_sz, int buffer_sz, vol_av_video_t* info_ptr );
+
 /** Close a video file.
  * @param info_ptr The context data for the file to close. Must not be NULL.
  * @return         False on error.
  */
 VOL_AV_EXPORT bool vol_av_close( vol_av_video_t* info_ptr );
 
+/** Open an instance of a video file that is shared with every other instance opened from the same file, for example copies of a vologram in a
+ * crowd. Instances showing the same frame share one decode and one image, so `pixels_ptr` is the same for each and must not be written to.
+ * Instances that play too far apart to share are given decoders of their own, up to VOL_AV_SHARED_MAX_DECODERS per file.
+ * Only vol_av_read_frame_at_time() reads frames for an instance. vol_av_set_output_scale() and vol_av_set_output_compression() change every
+ * instance of the file, and each instance must be flipped the same way. Instances have no audio. An instance can be read from a different
+ * thread to the other instances.
+ * @param filename File path to the movie file to open. Must not be NULL.
+ * @param info_ptr This function populates the struct pointed to with context data about the instance. Must not be NULL.
+ * @return         False on error. As for vol_av_open(), call vol_av_close() to free a context that failed to open. The file's shared decoders and
+ *                 frames are freed when its last instance is closed.
+ */
+VOL_AV_EXPORT bool vol_av_open_shared( const char* filename, vol_av_video_t* info_ptr );
+
 /**
  * @param info_ptr The context data for the file. Must not be NULL.
  * @param w        Pointer to variable this function will write the video's width in pixels. Must not be NULL.
@@ -102,6 +197,53 @@ VOL_AV_EXPORT bool vol_av_close( vol_av_video_t* info_ptr );
  */
 VOL_AV_EXPORT void vol_av_dimensions( const vol_av_video_t* info_ptr, int* w, int* h );
 
+/** Set the resolution that frames are converted to, so that small or distant volograms cost a fraction of the conversion and texture upload bandwidth.
+ * Frames are converted to the video's dimensions divided by 2^`level`, so 0 is full size, 1 is half, and 2 is a quarter.
+ * This can be changed at any time, including while the decode thread is running, and takes effect from the next frame converted.
+ * Output buffers sized for the full resolution remain large enough at every level.
+ * @note Downscaling is done during RGB conversion. The decoder's own `lowres` mode isn't used because the VP9 and H.264 decoders used for
+ *       vologram textures don't support it, and it can only be changed by re-opening the decoder.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param level    0 to VOL_AV_OUTPUT_SCALE_MAX.
+ * @return         False on error.
+ */
+VOL_AV_EXPORT bool vol_av_set_output_scale( vol_av_video_t* info_ptr, int level );
+
+/** Encode each converted frame into a GPU block-compressed format too, so it uploads 6x smaller than RGB and takes less texture memory.
+ * The compressed frame is given in `compressed_ptr` and `compressed_sz` alongside the RGB image. Encoding is real-time quality, and each frame
+ * is split by rows of blocks between the decoding thread and a pool of workers shared by every video, which stays up while any video compresses.
+ * Under the shared decode scheduler each stream's frame is encoded on its scheduler worker alone. The application only receives finished blocks.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param format   VOL_AV_TEXTURE_FORMAT_RGB24 to stop compressing, or a compressed format.
+ * @return         False on error, or if the decode thread is running.
+ */
+VOL_AV_EXPORT bool vol_av_set_output_compression( vol_av_video_t* info_ptr, vol_av_texture_format_t format );
+
+/** Get the size in bytes of an image in a texture format. Compressed formats round the dimensions up to whole 4x4 blocks.
+ * @return The size, or 0 for an unknown format or empty image.
+ */
+VOL_AV_EXPORT int64_t vol_av_compressed_size( int w, int h, vol_av_texture_format_t format );
+
+/** Encode an RGB image into a compressed texture format. This is the encoder used by vol_av_set_output_compression(), for measuring or
+ * testing it without a video, or for compressing images that didn't come from vol_av.
+ * @param rgb_ptr   3-channel RGB image. Must not be NULL.
+ * @param linesize  Bytes from the start of one row of the image to the next.
+ * @param format    VOL_AV_TEXTURE_FORMAT_BC1 or VOL_AV_TEXTURE_FORMAT_ETC2_RGB.
+ * @param n_threads Number of bands to split the image into, shared between the calling thread and the compression pool's workers.
+ *                  0 or less uses one per logical core. 1 compresses on the calling thread alone, as does any value while no video has
+ *                  compression turned on, since the pool's workers only run while one does.
+ * @param dst_ptr   Output, which must hold vol_av_compressed_size() bytes. Blocks are stored in rows, in the same row order as the image.
+ * @return          False on error.
+ */
+VOL_AV_EXPORT bool vol_av_compress_rgb( const uint8_t* rgb_ptr, int linesize, int w, int h, vol_av_texture_format_t format, int n_threads, uint8_t* dst_ptr );
+
+/** Get the dimensions frames are currently converted to, which can be smaller than vol_av_dimensions() after vol_av_set_output_scale().
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param w        Pointer to variable this function will write the output width in pixels. Must not be NULL.
+ * @param h        Pointer to variable this function will write the output height in pixels. Must not be NULL.
+ */
+VOL_AV_EXPORT void vol_av_output_dimensions( const vol_av_video_t* info_ptr, int* w, int* h );
+
 /** Get the frame rate of an opened video file.
  * @param info_ptr The context data for the file. Must not be NULL.
  * @return         The frequency in Hz (frames per second).
@@ -125,6 +267,9 @@ VOL_AV_EXPORT int64_t vol_av_frame_count( const vol_av_video_t* info_ptr );
 VOL_AV_EXPORT double vol_av_duration_s( const vol_av_video_t* info_ptr );
 
 /** Construct the next frame from an opened video stream.
+* The decoder may need several packets before it outputs a frame, particularly with frame threading, so this reads as many as needed.
+* At the end of the file it drains any frames the decoder was holding back before returning false.
+* `pts_s` gives the timestamp of the frame, which is more reliable than counting calls.
 * @param info_ptr The context data for the file. Must not be NULL.
 * @return          False on error or end of file.
 * EXAMPLE:
@@ -143,6 +288,183 @@ while ( next_frame > frame ) {
 */
 VOL_AV_EXPORT bool vol_av_read_next_frame( vol_av_video_t* info_ptr );
 
+/** Get the frame that should be on screen at a playback time, decoding forwards as far as needed.
+ * Frames that are already late are skipped without being converted. If no newer frame is due the frame from the previous call is held, and if
+ * `pts_s` is before that frame the video is rewound to the keyframe before `pts_s` and decoded forwards from there.
+ * `pts_s` and `frame_idx` are set to the frame actually delivered, which can be earlier than the requested time.
+ * The application only needs to upload the image again when `pts_s` has changed.
+ * With a reverse cache, going backwards decodes from the keyframe to `pts_s` once, and the following calls for earlier times are served from the
+ * cache until it runs out. See vol_av_set_reverse_cache_size().
+ * @param info_ptr      The context data for the file. Must not be NULL.
+ * @param pts_s         Playback time in seconds from the start of the video.
+ * @param flip_vertical If set, the image is vertically mirrored during conversion.
+ * @return              False on error, or if no frame has been delivered yet and none is due. At the end of the stream the last frame is held.
+ */
+VOL_AV_EXPORT bool vol_av_read_frame_at_time( vol_av_video_t* info_ptr, double pts_s, bool flip_vertical );
+
+/** Show a preview of the video at a time quickly, for dragging a timeline scrubber, by decoding only keyframes.
+ * The preview is the keyframe at or before `pts_s`. Keyframes are decoded by a second decoder without frame threading, which is opened on the
+ * first call, and other frames are discarded unread, so going backwards or jumping costs one seek and one keyframe decode whatever the distance.
+ * Dragging forwards a little walks through the keyframes in between, until `max_latency_s` is used up, and then shows the newest one decoded so far.
+ * Audio is not decoded while scrubbing. The next call to vol_av_read_frame_at_time() goes back to full decoding at the time it is given.
+ * vol_av_read_next_frame(), or the decode thread started by vol_av_start_decode_thread(), carries on from the frame after the keyframe shown.
+ * @param info_ptr      The context data for the file. Must not be NULL.
+ * @param pts_s         Time in seconds from the start of the video to preview.
+ * @param flip_vertical If set, the image is vertically mirrored during conversion.
+ * @param scale_level   Output scale level for previews, as for vol_av_set_output_scale(). The larger of this and the normal level is used, so
+ *                      `w` and `h` can be smaller than for normal frames.
+ * @param max_latency_s Time to stop decoding keyframes after, when walking forwards. At least one keyframe is always decoded if one is due.
+ * @return              False on error, or if no frame has been delivered yet and none is due. `pts_s` and `frame_idx` are set to the keyframe shown.
+ */
+VOL_AV_EXPORT bool vol_av_scrub_to_time( vol_av_video_t* info_ptr, double pts_s, bool flip_vertical, int scale_level, double max_latency_s );
+
+/** Set the memory allowed for reverse play. Frames decoded while going backwards are kept converted, so that a GOP is decoded once rather than once per frame.
+ * The cache holds `max_sz` / (width * height * 3) frames of the video's full size. When a GOP has more frames than fit, the frames nearest the
+ * requested time are kept and the cache is refilled when play runs past the oldest. Memory is only allocated as frames are cached.
+ * The cache is off by default. It is only used by vol_av_read_frame_at_time().
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param max_sz   Maximum size of the cache in bytes. 0 turns the cache off and frees it. If `pixels_ptr` points into the old cache it is set to NULL.
+ * @return         False on error.
+ */
+VOL_AV_EXPORT bool vol_av_set_reverse_cache_size( vol_av_video_t* info_ptr, int64_t max_sz );
+
+/** Register application-owned memory to decode frames into, for example a pinned array or a mapped texture upload buffer.
+ * Frames are then converted straight into the next free buffer, as tightly-packed RGB with `w * 3` bytes per row, rather than into internal storage.
+ *
+ * Without the decode thread, vol_av_read_next_frame() sets `buffer_idx` and the application owns that buffer until it calls vol_av_release_output_buffer(),
+ * so the image stays valid while later frames are decoded into the other buffers. With output compression on, each buffer also has its own
+ * compressed image, so `compressed_ptr` stays valid for as long as the buffer is held. If every buffer is held, vol_av_read_next_frame() fails without
+ * decoding. With the decode thread, the buffers form the thread's frame pool and ownership follows vol_av_acquire_frame() and vol_av_release_frame().
+ *
+ * @param info_ptr    The context data for the file. Must not be NULL.
+ * @param buffers_ptr Array of `n_buffers` pointers to buffers, which must stay allocated until the file is closed or this is called again.
+ *                    NULL, or `n_buffers` of 0, goes back to internal storage.
+ * @param n_buffers   Number of buffers. Two or more lets the application upload one frame while the next is decoded.
+ * @param buffer_sz   Size of each buffer in bytes. Must be at least width * height * 3 of the video.
+ * @return            False on error, or if the decode thread is running.
+ */
+VOL_AV_EXPORT bool vol_av_set_output_buffers( vol_av_video_t* info_ptr, uint8_t** buffers_ptr, int n_buffers, int64_t buffer_sz );
+
+/** Give an application output buffer back to vol_av, once the application has finished with the frame in it.
+ * @param info_ptr   The context data for the file. Must not be NULL.
+ * @param buffer_idx The `buffer_idx` value given with the frame.
+ */
+VOL_AV_EXPORT void vol_av_release_output_buffer( vol_av_video_t* info_ptr, int buffer_idx );
+
+/** Start demuxing, decoding, and converting frames on a background thread.
+ * Frames are converted into a fixed pool of `n_buffers` RGB images, and handed to the application through a lock-free single-producer,
+ * single-consumer queue, so the calling thread only pays for a pointer hand-off per frame. Use vol_av_acquire_frame() instead of
+ * vol_av_read_next_frame() while the thread is running. vol_av_close() stops the thread if it is still running.
+ * @param info_ptr      The context data for the file. Must not be NULL.
+ * @param n_buffers     Number of frame buffers in the pool. One is held by the application, so this must be at least 2.
+ *                      Ignored if buffers were registered with vol_av_set_output_buffers(), which are used as the pool instead.
+ * @param flip_vertical If set, images are vertically mirrored during conversion.
+ * @return              False on error, or if the thread was already running.
+ */
+VOL_AV_EXPORT bool vol_av_start_decode_thread( vol_av_video_t* info_ptr, int n_buffers, bool flip_vertical );
+
+/** Stop a decode thread started with vol_av_start_decode_thread() and free its frame buffers. Any acquired frame is no longer valid.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         False if the thread was not running.
+ */
+VOL_AV_EXPORT bool vol_av_stop_decode_thread( vol_av_video_t* info_ptr );
+
+/** Start a process-wide pool of decode workers, shared by every stream's vol_av_start_decode_thread().
+ * Without it each stream gets its own decode thread, and its decoder starts a thread per core, so ten volograms oversubscribe the CPU.
+ * With it, streams opened afterwards use VOL_AV_SCHED_CODEC_THREADS decoder threads each, and workers decode and convert one frame at a time
+ * for whichever stream has the fewest seconds of frames queued, weighted by vol_av_set_decode_priority().
+ * Call this before opening the files that should use it. Streams opened before keep their decoder threads, but are still served by the pool.
+ * @param n_workers Number of worker threads. 0 or less uses one per logical core.
+ * @return          False on error, or if the scheduler is already running.
+ */
+VOL_AV_EXPORT bool vol_av_start_decode_scheduler( int n_workers );
+
+/** Stop the shared decode workers. Every stream's decode thread must be stopped first, with vol_av_stop_decode_thread() or vol_av_close().
+ * @return False if the scheduler was not running, or still has streams.
+ */
+VOL_AV_EXPORT bool vol_av_stop_decode_scheduler( void );
+
+/** Set how urgently the shared decode scheduler serves a stream, e.g. from its screen coverage. The default is 1.
+ * A stream with priority 2 is kept twice as many seconds ahead as one with priority 1 when the workers can't keep up with both.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param priority Weight of the stream. 0 or less marks it culled, so it is only decoded when no visible stream needs a frame.
+ */
+VOL_AV_EXPORT void vol_av_set_decode_priority( vol_av_video_t* info_ptr, float priority );
+
+/** Acquire a decoded frame from the decode thread. On success `pixels_ptr`, `w`, `h`, and `pts_s` are set.
+ * The frame stays valid, and will be returned again, until it is released by vol_av_release_frame() or superseded by a later call to this function.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param pts_s    Playback time in seconds. Queued frames that are already late are released, and the newest frame with a time up to half a frame
+ *                 after `pts_s` is returned, so rounding in the clock never holds back the frame it lands on.
+ *                 If negative, the oldest queued frame is returned and frames are only released by vol_av_release_frame().
+ * @return         False if no frame is ready yet, at the end of the stream, or on error.
+ */
+VOL_AV_EXPORT bool vol_av_acquire_frame( vol_av_video_t* info_ptr, double pts_s );
+
+/** Hand the currently acquired frame's buffer back to the decode thread.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ */
+VOL_AV_EXPORT void vol_av_release_frame( vol_av_video_t* info_ptr );
+
+/** Check if the file has an audio stream that can be decoded.
+ * Audio is decoded as the demuxer reaches it, which vol_av keeps VOL_AV_AUDIO_LEAD_S seconds ahead of the most recently decoded video frame, so
+ * the file is only demuxed and decoded once for both. The application must keep decoding video for audio to keep flowing, either by
+ * calling vol_av_read_next_frame() or with the decode thread.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         True if vol_av_read_audio() will give samples.
+ */
+VOL_AV_EXPORT bool vol_av_has_audio( const vol_av_video_t* info_ptr );
+
+/** Get the format of the samples given by vol_av_read_audio(). Samples are always 32-bit float, with channels interleaved.
+ * @param info_ptr    The context data for the file. Must not be NULL.
+ * @param sample_rate Pointer to variable this function will write the sample rate in Hz to. Must not be NULL.
+ * @param n_channels  Pointer to variable this function will write the number of channels to. Must not be NULL.
+ */
+VOL_AV_EXPORT void vol_av_audio_format( const vol_av_video_t* info_ptr, int* sample_rate, int* n_channels );
+
+/** Audio is decoded by default if the file has any. Disabling it skips audio packets without decoding them, which saves the work if the
+ * application isn't going to play the sound.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param enabled  If false, audio packets are discarded.
+ */
+VOL_AV_EXPORT void vol_av_set_audio_enabled( vol_av_video_t* info_ptr, bool enabled );
+
+/** Take decoded audio from the ring. This is lock-free and does not allocate, so it can be called from the engine's audio thread while another thread decodes.
+ * Only one thread may read audio.
+ * @param info_ptr    The context data for the file. Must not be NULL.
+ * @param samples_ptr Interleaved float output, with room for `n_frames` * the number of channels given by vol_av_audio_format(). Must not be NULL.
+ *                    If fewer than `n_frames` are available, the rest is filled with silence.
+ * @param n_frames    Number of sample frames wanted (one sample per channel).
+ * @return            Number of sample frames of decoded audio written. Lower than `n_frames` on an underrun or at the end of the stream.
+ */
+VOL_AV_EXPORT int vol_av_read_audio( vol_av_video_t* info_ptr, float* samples_ptr, int n_frames );
+
+/** Get the audio clock, for presenting video frames and geometry in sync with the sound.
+ * This is the time of the next sample frame that vol_av_read_audio() will give, so it only advances as the engine consumes audio, and it stops
+ * when the engine's audio is paused. The engine's own output latency can be subtracted if it is known.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         Seconds from the start of the audio stream, or -1.0 if there is no audio or none has been decoded yet.
+ */
+VOL_AV_EXPORT double vol_av_audio_clock_s( const vol_av_video_t* info_ptr );
+
+/**
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         True if the demuxer has run out of packets and, when using the decode thread, no frames are queued after the currently held one.
+ */
+VOL_AV_EXPORT bool vol_av_end_of_stream( const vol_av_video_t* info_ptr );
+
+/** Get the memory vol_av has allocated for a video's frames: converted and compressed output images, decode thread slots, the reverse cache, and
+ * audio buffers. Application buffers from vol_av_set_output_buffers(), and FFmpeg's own demuxer and decoder buffers, are not included.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         Size in bytes, or 0 if the video isn't open or is an instance of a shared video.
+ */
+VOL_AV_EXPORT int64_t vol_av_memory_usage( const vol_av_video_t* info_ptr );
+
+/** Get the memory vol_av has allocated for the frames of every shared video, counted once for all of a file's instances. See vol_av_open_shared().
+ * @return Size in bytes.
+ */
+VOL_AV_EXPORT int64_t vol_av_shared_memory_usage( void );
+
 #ifdef __cplusplus
 }
 #endif /* CPP */
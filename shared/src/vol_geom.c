@@ -3,7 +3,7 @@
  *
  * vol_geom  | .vol Geometry Decoding API
  * --------- | ---------------------
- * Version   | 0.10.1
+ * Version   | 0.11.0
  * Authors   | See matching header file.
  * Copyright | 2021, Volograms (http://volograms.com/)
  * Language  | C99
@@ -11,15 +11,44 @@
  * Licence   | The MIT License. See LICENSE.md for details.
  */
 
+#if defined( VOL_GEOM_IO_URING ) && defined( __linux__ )
+#define VOL_GEOM_HAS_IO_URING
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // O_DIRECT
+#endif
+#endif
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#define _POSIX_C_SOURCE 200809L // fileno(), fseeko() and ftello() aren't declared by -std=c99 on its own.
+#endif
+#if defined( __APPLE__ ) && !defined( _DARWIN_C_SOURCE )
+#define _DARWIN_C_SOURCE // _POSIX_C_SOURCE alone hides Apple's extensions, e.g. _SC_NPROCESSORS_ONLN in vol_threads.h.
+#endif
+
 #include "vol_geom.h"
+#include "vol_threads.h" // The shared sequence registry lock, and the progressive pre-load thread.
 #include <assert.h>
 #include <inttypes.h> // 64-bit printfs (PRId64 for integer, PRIu64 for unsigned int, PRIx64 for hex)
 #include <stdarg.h>
+#include <stddef.h> // offsetof() to check the v13 struct layouts.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h> // Used for reading file sizes.
 #include <sys/types.h>
+#ifdef _WIN32
+#include <io.h>      // _get_osfhandle() to map packed volograms.
+#include <windows.h> // CreateFileMapping() to map packed volograms.
+#else
+#include <sys/mman.h> // mmap() for packed volograms.
+#endif
+#ifdef VOL_GEOM_HAS_IO_URING
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 // NOTE: ftello() and fseeko() are replace ftell(), fseek(), and their Windows equivalents, to support 64-bit indices to >2GB files.
 #ifdef _WIN32
@@ -39,6 +68,16 @@
 #define VOL_GEOM_FILE_HDR_V10_MIN_SZ 24 /// "VOLS" (4 bytes) + 4 string length bytes + 4 ints in v10 hdr.
 /// File header section size in bytes. Used in sanity checks to test for corrupted files that are below minimum sizes expected.
 #define VOL_GEOM_FRAME_MIN_SZ 17 /// 3 ints, 1 byte, 1 int inside vertices array. the rest are optional
+/// Bytes read at a time by the progressive pre-load thread. Frames become available, and cancellation is checked, between reads.
+#define VOL_GEOM_PROGRESSIVE_CHUNK_SZ ( 4 * 1024 * 1024 )
+/// Size, as a power of two, of the hash table the compressed pre-load uses to find matches. 16k entries fit in L1/L2 cache.
+#define VOL_GEOM_LZ_HASH_BITS 14
+/// Shortest match the compressed pre-load encodes. Also the number of bytes hashed to find one.
+#define VOL_GEOM_LZ_MIN_MATCH 4
+/// Longest distance back a match can be, as offsets are stored in 2 bytes.
+#define VOL_GEOM_LZ_MAX_OFFSET 65535
+/// Compression ratio `VOL_GEOM_LOAD_AUTO` assumes when deciding if a compressed pre-load fits the memory budget. Geometry usually does better.
+#define VOL_GEOM_AUTO_COMPRESSION_RATIO 2
 
 static void _default_logger( vol_geom_log_type_t log_type, const char* message_str ) {
   FILE* stream_ptr = ( VOL_GEOM_LOG_TYPE_ERROR == log_type || VOL_GEOM_LOG_TYPE_WARNING == log_type ) ? stderr : stdout;
@@ -67,62 +106,1025 @@ typedef struct vol_geom_file_record_t {
 } vol_geom_file_record_t;
 
 /******************************************************************************
-  BASIC API
+  I/O BACKENDS
 ******************************************************************************/
 
-/** Helper function to check the actual size of a file on disk.
- * @param filename Pointer to nul-terminated file path string. Must not be NULL.
- * @param sz_ptr   Size of the file, in bytes, is written to address pointed to by sz_ptr. Must not be NULL. Not written when returning false.
- * @return         False on any error, including bad parameters or file not found. Otherwise true on success, where sz_ptr is set.
- */
-static bool _get_file_sz( const char* filename, vol_geom_size_t* sz_ptr ) {
-  struct vol_geom_stat64_t stbuf;
-  if ( 0 != vol_geom_stat64( filename, &stbuf ) ) { return false; }
-  *sz_ptr = stbuf.st_size;
+static void* _file_io_open( void* user_ptr, const char* name ) {
+  (void)user_ptr;
+  return fopen( name, "rb" );
+}
+
+static bool _file_io_size( void* handle_ptr, vol_geom_size_t* sz_ptr ) {
+  FILE* f_ptr = (FILE*)handle_ptr;
+  if ( 0 != vol_geom_fseeko( f_ptr, 0, SEEK_END ) ) { return false; }
+  vol_geom_size_t sz = vol_geom_ftello( f_ptr );
+  if ( sz < 0 ) { return false; }
+  *sz_ptr = sz;
+  return true;
+}
+
+static bool _file_io_read_at( void* handle_ptr, vol_geom_size_t offset, void* dst_ptr, vol_geom_size_t sz ) {
+  FILE* f_ptr = (FILE*)handle_ptr;
+  if ( 0 != vol_geom_fseeko( f_ptr, offset, SEEK_SET ) ) { return false; }
+  return 0 == sz || 1 == fread( dst_ptr, (size_t)sz, 1, f_ptr );
+}
+
+static void _file_io_close( void* handle_ptr ) { fclose( (FILE*)handle_ptr ); }
+
+/// The default backend, for files on disk.
+static const vol_geom_io_t _file_io = { .open_fn = _file_io_open, .size_fn = _file_io_size, .read_at_fn = _file_io_read_at, .close_fn = _file_io_close };
+
+static void* _memory_io_open( void* user_ptr, const char* name ) {
+  for ( const vol_geom_memory_file_t* file_ptr = (const vol_geom_memory_file_t*)user_ptr; file_ptr->name; file_ptr++ ) {
+    if ( 0 == strcmp( file_ptr->name, name ) ) { return (void*)file_ptr; }
+  }
+  return NULL;
+}
+
+static bool _memory_io_size( void* handle_ptr, vol_geom_size_t* sz_ptr ) {
+  *sz_ptr = ( (const vol_geom_memory_file_t*)handle_ptr )->sz;
+  return true;
+}
+
+static bool _memory_io_read_at( void* handle_ptr, vol_geom_size_t offset, void* dst_ptr, vol_geom_size_t sz ) {
+  const vol_geom_memory_file_t* file_ptr = (const vol_geom_memory_file_t*)handle_ptr;
+  if ( offset < 0 || sz < 0 || offset > file_ptr->sz || sz > file_ptr->sz - offset ) { return false; }
+  if ( sz > 0 ) { memcpy( dst_ptr, &file_ptr->byte_ptr[offset], (size_t)sz ); }
+  return true;
+}
+
+static const uint8_t* _memory_io_map( void* handle_ptr ) { return ( (const vol_geom_memory_file_t*)handle_ptr )->byte_ptr; }
+
+static void _memory_io_close( void* handle_ptr ) { (void)handle_ptr; }
+
+vol_geom_io_t vol_geom_memory_io( const vol_geom_memory_file_t* files_ptr ) {
+  return ( vol_geom_io_t ){ .user_ptr = (void*)files_ptr,
+    .open_fn                           = _memory_io_open,
+    .size_fn                           = _memory_io_size,
+    .read_at_fn                        = _memory_io_read_at,
+    .map_fn                            = _memory_io_map,
+    .close_fn                          = _memory_io_close };
+}
+
+/// Handle of the mapped-file backend. The file is mapped by the first `map_fn` call, and unmapped when the handle is closed.
+typedef struct vol_geom_mapped_file_t {
+  FILE* f_ptr;
+  vol_geom_size_t sz;
+  const uint8_t* map_ptr;
+#ifdef _WIN32
+  HANDLE mapping;
+#endif
+} vol_geom_mapped_file_t;
+
+static void* _mapped_file_io_open( void* user_ptr, const char* name ) {
+  (void)user_ptr;
+  vol_geom_mapped_file_t* mf_ptr = calloc( 1, sizeof( vol_geom_mapped_file_t ) );
+  if ( !mf_ptr ) { return NULL; }
+  mf_ptr->f_ptr = fopen( name, "rb" );
+  if ( !mf_ptr->f_ptr || !_file_io_size( mf_ptr->f_ptr, &mf_ptr->sz ) ) {
+    if ( mf_ptr->f_ptr ) { fclose( mf_ptr->f_ptr ); }
+    free( mf_ptr );
+    return NULL;
+  }
+  return mf_ptr;
+}
+
+static bool _mapped_file_io_size( void* handle_ptr, vol_geom_size_t* sz_ptr ) {
+  *sz_ptr = ( (vol_geom_mapped_file_t*)handle_ptr )->sz;
   return true;
 }
 
+static bool _mapped_file_io_read_at( void* handle_ptr, vol_geom_size_t offset, void* dst_ptr, vol_geom_size_t sz ) {
+  return _file_io_read_at( ( (vol_geom_mapped_file_t*)handle_ptr )->f_ptr, offset, dst_ptr, sz );
+}
+
+static const uint8_t* _mapped_file_io_map( void* handle_ptr ) {
+  vol_geom_mapped_file_t* mf_ptr = (vol_geom_mapped_file_t*)handle_ptr;
+  if ( mf_ptr->map_ptr ) { return mf_ptr->map_ptr; }
+  // Empty files can't be mapped, and on 32-bit platforms neither can files bigger than the address space.
+  if ( mf_ptr->sz <= 0 || (uint64_t)mf_ptr->sz > (uint64_t)SIZE_MAX ) { return NULL; }
+#ifdef _WIN32
+  mf_ptr->mapping = CreateFileMappingA( (HANDLE)_get_osfhandle( _fileno( mf_ptr->f_ptr ) ), NULL, PAGE_READONLY, 0, 0, NULL );
+  if ( !mf_ptr->mapping ) { return NULL; }
+  mf_ptr->map_ptr = MapViewOfFile( mf_ptr->mapping, FILE_MAP_READ, 0, 0, 0 );
+  if ( !mf_ptr->map_ptr ) {
+    CloseHandle( mf_ptr->mapping );
+    mf_ptr->mapping = NULL;
+  }
+#else
+  void* map_ptr = mmap( NULL, (size_t)mf_ptr->sz, PROT_READ, MAP_PRIVATE, fileno( mf_ptr->f_ptr ), 0 );
+  mf_ptr->map_ptr = MAP_FAILED == map_ptr ? NULL : map_ptr;
+#endif
+  return mf_ptr->map_ptr;
+}
+
+static void _mapped_file_io_close( void* handle_ptr ) {
+  vol_geom_mapped_file_t* mf_ptr = (vol_geom_mapped_file_t*)handle_ptr;
+  if ( mf_ptr->map_ptr ) {
+#ifdef _WIN32
+    UnmapViewOfFile( mf_ptr->map_ptr );
+    CloseHandle( mf_ptr->mapping );
+#else
+    munmap( (void*)mf_ptr->map_ptr, (size_t)mf_ptr->sz );
+#endif
+  }
+  fclose( mf_ptr->f_ptr );
+  free( mf_ptr );
+}
+
+/// Files on disk, which can be memory-mapped. Used for packed volograms, whose frames are read in place from the mapping.
+static const vol_geom_io_t _mapped_file_io = { .open_fn = _mapped_file_io_open,
+  .size_fn                                         = _mapped_file_io_size,
+  .read_at_fn                                      = _mapped_file_io_read_at,
+  .map_fn                                          = _mapped_file_io_map,
+  .close_fn                                        = _mapped_file_io_close };
+
+/** Helper function to get the backend that a sequence's files are read with. */
+static const vol_geom_io_t* _get_io( const vol_geom_info_t* info_ptr ) { return info_ptr->io.open_fn ? &info_ptr->io : &_file_io; }
+
+/** Helper function to open a file through a backend and get its size.
+ * @return NULL on any error, otherwise a handle that must be closed with the backend's `close_fn`.
+ */
+static void* _io_open_sized( const vol_geom_io_t* io_ptr, const char* filename, vol_geom_size_t* sz_ptr ) {
+  void* handle_ptr = io_ptr->open_fn( io_ptr->user_ptr, filename );
+  if ( !handle_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to open file `%s` (permissions or missing).\n", filename );
+    return NULL;
+  }
+  if ( !io_ptr->size_fn( handle_ptr, sz_ptr ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to get file size.\n" );
+    io_ptr->close_fn( handle_ptr );
+    return NULL;
+  }
+  return handle_ptr;
+}
+
 /** Helper function to read an entire file into an array of bytes within struct pointed to by `fr_ptr`.
  * @warning        This function allocates memory that the caller must manually free after use.
+ * @param io_ptr   Backend to read the file with. Must not be NULL.
  * @param filename Pointer to nul-terminated file path string. Must not be NULL.
  * @param fr_ptr   File contents and size are written to a structure pointed to by `fr_ptr`. Must not be NULL.
  * @return         False on any error.
  */
-static bool _read_entire_file( const char* filename, vol_geom_file_record_t* fr_ptr ) {
-  FILE* f_ptr = NULL;
+static bool _read_entire_file( const vol_geom_io_t* io_ptr, const char* filename, vol_geom_file_record_t* fr_ptr ) {
+  void* handle_ptr = NULL;
 
   if ( !filename || !fr_ptr ) { goto vol_geom_read_entire_file_failed; }
 
-  if ( !_get_file_sz( filename, &fr_ptr->sz ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to get file size.\n" );
-    goto vol_geom_read_entire_file_failed;
-  }
+  handle_ptr = _io_open_sized( io_ptr, filename, &fr_ptr->sz );
+  if ( !handle_ptr ) { goto vol_geom_read_entire_file_failed; }
 
   _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for reading file\n", fr_ptr->sz );
-  fr_ptr->byte_ptr = malloc( (size_t)fr_ptr->sz );
+  fr_ptr->byte_ptr = malloc( fr_ptr->sz > 0 ? (size_t)fr_ptr->sz : 1 ); // The sequence file of a vologram with no frames is 0 bytes.
   if ( !fr_ptr->byte_ptr ) { 
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for file.\n" );
     goto vol_geom_read_entire_file_failed;
   }
 
-  f_ptr = fopen( filename, "rb" );
-  if ( !f_ptr ) { 
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to open file (permissions or missing).\n" );
-    goto vol_geom_read_entire_file_failed;
-  }
-  vol_geom_size_t nr = fread( fr_ptr->byte_ptr, fr_ptr->sz, 1, f_ptr );
-  if ( 1 != nr ) {
+  if ( !io_ptr->read_at_fn( handle_ptr, 0, fr_ptr->byte_ptr, fr_ptr->sz ) ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to read file to memory.\n" );
     goto vol_geom_read_entire_file_failed;
   }
 
-  fclose( f_ptr );
+  io_ptr->close_fn( handle_ptr );
   return true;
 vol_geom_read_entire_file_failed:
-  if ( f_ptr ) { fclose( f_ptr ); }
+  if ( handle_ptr ) { io_ptr->close_fn( handle_ptr ); }
+  if ( fr_ptr ) {
+    free( fr_ptr->byte_ptr );
+    fr_ptr->byte_ptr = NULL;
+  }
+  return false;
+}
+
+/******************************************************************************
+  MEMORY BUDGET
+******************************************************************************/
+
+/// Budget for sequences held in memory, from `vol_geom_set_memory_budget()`. 0 for no budget.
+static volatile int64_t _memory_budget_sz;
+/// Bytes of sequence blobs and compressed sequences allocated by every `vol_geom_info_t` and shared sequence. Mapped files aren't counted.
+static volatile int64_t _resident_sz;
+
+/** Helper function to count sequence memory allocated, or freed if `delta_sz` is negative, against the budget. */
+static void _track_resident_sz( vol_geom_size_t delta_sz ) { _atomic_add_i64( &_resident_sz, delta_sz ); }
+
+void vol_geom_set_memory_budget( vol_geom_size_t budget_sz ) { _atomic_store_i64( &_memory_budget_sz, budget_sz > 0 ? budget_sz : 0 ); }
+
+vol_geom_size_t vol_geom_get_memory_budget_used( void ) { return _atomic_load_i64( &_resident_sz ); }
+
+/******************************************************************************
+  PROGRESSIVE PRE-LOAD
+******************************************************************************/
+
+/// State of a sequence blob being filled by a background thread. Owned by the `vol_geom_info_t` that started it.
+typedef struct vol_geom_progressive_preload_t {
+  /// Backend and handle of the sequence file. The thread closes the handle when it finishes.
+  vol_geom_io_t io;
+  void* handle_ptr;
+  /// The blob being filled, and its size. Set before the thread starts and never moved.
+  uint8_t* blob_ptr;
+  vol_geom_size_t blob_sz;
+  const vol_geom_frame_directory_entry_t* frames_directory_ptr;
+  int frame_count;
+  /// Number of frames, from the start, fully read into the blob. Written by the thread only, after the bytes it covers.
+  volatile int32_t frames_available;
+  /// Set to ask the thread to stop.
+  volatile int32_t cancel;
+  vol_thread_t thread;
+} vol_geom_progressive_preload_t;
+
+/** Reads the sequence file into the blob, front-to-back, publishing each frame as soon as all of its bytes are in.
+ * On a read error the thread stops, and the frames it didn't reach keep being read from the file.
+ */
+static VOL_THREAD_FUNC _progressive_preload_thread_main( void* arg_ptr ) {
+  vol_geom_progressive_preload_t* preload_ptr = (vol_geom_progressive_preload_t*)arg_ptr;
+  vol_geom_size_t loaded_sz = 0;
+  int frames_available      = 0;
+  while ( loaded_sz < preload_ptr->blob_sz && !_atomic_load_i32( &preload_ptr->cancel ) ) {
+    vol_geom_size_t chunk_sz = preload_ptr->blob_sz - loaded_sz;
+    if ( chunk_sz > VOL_GEOM_PROGRESSIVE_CHUNK_SZ ) { chunk_sz = VOL_GEOM_PROGRESSIVE_CHUNK_SZ; }
+    if ( !preload_ptr->io.read_at_fn( preload_ptr->handle_ptr, loaded_sz, &preload_ptr->blob_ptr[loaded_sz], chunk_sz ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: progressive pre-load failed to read file at %" PRId64 " bytes.\n", loaded_sz );
+      break;
+    }
+    loaded_sz += chunk_sz;
+    // Frames are stored in order in the file, so the ones available are always a prefix of the sequence.
+    while ( frames_available < preload_ptr->frame_count &&
+            preload_ptr->frames_directory_ptr[frames_available].offset_sz + preload_ptr->frames_directory_ptr[frames_available].total_sz <= loaded_sz ) {
+      frames_available++;
+    }
+    _atomic_store_i32( &preload_ptr->frames_available, frames_available );
+  }
+  preload_ptr->io.close_fn( preload_ptr->handle_ptr );
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Progressive pre-load stopped with %i/%i frames in memory\n", frames_available, preload_ptr->frame_count );
+  return VOL_THREAD_RETURN;
+}
+
+/** Helper function to allocate the sequence blob of `info_ptr` and start filling it on a background thread.
+ * The frames directory must already be built. On success `info_ptr` owns the blob and the thread, which are freed by `vol_geom_free_file_info()`.
+ * @return False on any error, leaving `info_ptr` unchanged.
+ */
+static bool _start_progressive_preload( const char* seq_filename, vol_geom_info_t* info_ptr ) {
+  vol_geom_progressive_preload_t* preload_ptr = calloc( 1, sizeof( vol_geom_progressive_preload_t ) );
+  if ( !preload_ptr ) { return false; }
+  vol_geom_size_t seq_sz  = 0;
+  preload_ptr->io         = *_get_io( info_ptr );
+  preload_ptr->handle_ptr = _io_open_sized( &preload_ptr->io, seq_filename, &seq_sz );
+  if ( !preload_ptr->handle_ptr ) { goto failed_progressive_preload; }
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for progressive pre-load\n", seq_sz );
+  preload_ptr->blob_ptr = malloc( seq_sz > 0 ? (size_t)seq_sz : 1 ); // A sequence with no frames can be 0 bytes.
+  if ( !preload_ptr->blob_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for file.\n" );
+    goto failed_progressive_preload;
+  }
+  preload_ptr->blob_sz              = seq_sz;
+  preload_ptr->frames_directory_ptr = info_ptr->frames_directory_ptr;
+  preload_ptr->frame_count          = info_ptr->hdr.frame_count;
+
+  if ( !_thread_create( &preload_ptr->thread, _progressive_preload_thread_main, preload_ptr ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to start progressive pre-load thread.\n" );
+    goto failed_progressive_preload;
+  }
+  info_ptr->sequence_blob_byte_ptr  = preload_ptr->blob_ptr;
+  info_ptr->sequence_blob_sz        = seq_sz;
+  info_ptr->progressive_preload_ptr = preload_ptr;
+  _track_resident_sz( seq_sz );
+  return true;
+
+failed_progressive_preload:
+  if ( preload_ptr->handle_ptr ) { preload_ptr->io.close_fn( preload_ptr->handle_ptr ); }
+  free( preload_ptr->blob_ptr );
+  free( preload_ptr );
+  return false;
+}
+
+/** Helper function to stop a progressive pre-load's thread and free its state. The blob itself is left to the caller. */
+static void _stop_progressive_preload( vol_geom_progressive_preload_t* preload_ptr ) {
+  _atomic_store_i32( &preload_ptr->cancel, 1 );
+  _thread_join( preload_ptr->thread );
+  free( preload_ptr );
+}
+
+int vol_geom_get_frames_in_memory( const vol_geom_info_t* info_ptr ) {
+  assert( info_ptr );
+  if ( !info_ptr ) { return 0; }
+  if ( info_ptr->compressed_seq_ptr ) { return info_ptr->hdr.frame_count; }
+  if ( !info_ptr->sequence_blob_byte_ptr ) { return 0; }
+  if ( !info_ptr->progressive_preload_ptr ) { return info_ptr->hdr.frame_count; }
+  return _atomic_load_i32( &( (const vol_geom_progressive_preload_t*)info_ptr->progressive_preload_ptr )->frames_available );
+}
+
+/******************************************************************************
+  COMPRESSED PRE-LOAD
+******************************************************************************/
+
+/// Frames kept in memory by `VOL_GEOM_LOAD_PRELOAD_COMPRESSED`. Owned by the `vol_geom_info_t` that loaded it, or by a shared sequence's registry entry.
+typedef struct vol_geom_compressed_seq_t {
+  /// Every frame's compressed bytes, back-to-back.
+  uint8_t* blob_ptr;
+  vol_geom_size_t blob_sz;
+  /// Offset of each frame's compressed bytes in the blob, with one more entry for the end of the last frame.
+  vol_geom_size_t* frame_offsets_ptr;
+} vol_geom_compressed_seq_t;
+
+/*
+Frames are compressed with a small LZ77 coder in the style of LZ4, which decompresses at memory speed. Each sequence is a token byte, with the
+literal count in its high 4 bits and the match length minus VOL_GEOM_LZ_MIN_MATCH in its low 4 bits, either of which continues in following bytes
+of 255 when it is 15. Then come the literals, then a 2-byte little-endian offset back to the match. The last sequence has only literals.
+Before compressing, the bytes of each 4-byte word of the frame's payload are split into 4 planes, so that the similar high bytes of neighbouring
+floats and indices are next to each other, which makes runs the coder can find.
+*/
+
+/** Largest number of bytes `_lz_compress()` can write for `sz` bytes of input. */
+static vol_geom_size_t _lz_bound( vol_geom_size_t sz ) { return sz + sz / 255 + 16; }
+
+static uint32_t _lz_read32( const uint8_t* ptr ) {
+  uint32_t v;
+  memcpy( &v, ptr, sizeof( v ) );
+  return v;
+}
+
+static uint32_t _lz_hash( uint32_t v ) { return ( v * 2654435761u ) >> ( 32 - VOL_GEOM_LZ_HASH_BITS ); }
+
+/** Write the part of a length that didn't fit in its token's 4 bits. */
+static uint8_t* _lz_write_len( uint8_t* op, vol_geom_size_t len ) {
+  for ( ; len >= 255; len -= 255 ) { *op++ = 255; }
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+/** Read the rest of a length whose token bits were 15. */
+static bool _lz_read_len( const uint8_t** ip_ptr, const uint8_t* iend, vol_geom_size_t* len_ptr ) {
+  if ( 15 != *len_ptr ) { return true; }
+  uint8_t b = 255;
+  while ( 255 == b ) {
+    if ( *ip_ptr >= iend ) { return false; }
+    b = *( *ip_ptr )++;
+    *len_ptr += b;
+  }
+  return true;
+}
+
+/** Compress `src_sz` bytes into `dst_ptr`, which must hold `_lz_bound( src_sz )` bytes.
+ * @param table_ptr Scratch hash table of 1 << VOL_GEOM_LZ_HASH_BITS entries.
+ * @return          The compressed size.
+ */
+static vol_geom_size_t _lz_compress( const uint8_t* src_ptr, vol_geom_size_t src_sz, uint8_t* dst_ptr, uint32_t* table_ptr ) {
+  memset( table_ptr, 0, sizeof( uint32_t ) << VOL_GEOM_LZ_HASH_BITS );
+  const uint8_t* ip          = src_ptr;
+  const uint8_t* anchor      = src_ptr;
+  const uint8_t* iend        = src_ptr + src_sz;
+  const uint8_t* match_limit = src_sz > VOL_GEOM_LZ_MIN_MATCH ? iend - VOL_GEOM_LZ_MIN_MATCH : src_ptr;
+  uint8_t* op                = dst_ptr;
+
+  while ( ip < match_limit ) {
+    uint32_t seq       = _lz_read32( ip );
+    uint32_t h         = _lz_hash( seq );
+    const uint8_t* ref = src_ptr + table_ptr[h];
+    table_ptr[h]       = (uint32_t)( ip - src_ptr );
+    if ( ref >= ip || ip - ref > VOL_GEOM_LZ_MAX_OFFSET || _lz_read32( ref ) != seq ) {
+      // Step further the longer nothing has matched, so incompressible data, like texture bytes, is skipped over quickly.
+      ip += 1 + ( ( ip - anchor ) >> 6 );
+      continue;
+    }
+    const uint8_t* mp = ip + VOL_GEOM_LZ_MIN_MATCH;
+    const uint8_t* rp = ref + VOL_GEOM_LZ_MIN_MATCH;
+    while ( mp < iend && *mp == *rp ) {
+      mp++;
+      rp++;
+    }
+    vol_geom_size_t lit_len   = ip - anchor;
+    vol_geom_size_t match_len = mp - ip - VOL_GEOM_LZ_MIN_MATCH;
+    vol_geom_size_t offset    = ip - ref;
+    uint8_t* token_ptr        = op++;
+    *token_ptr                = (uint8_t)( ( lit_len < 15 ? lit_len : 15 ) << 4 | ( match_len < 15 ? match_len : 15 ) );
+    if ( lit_len >= 15 ) { op = _lz_write_len( op, lit_len - 15 ); }
+    memcpy( op, anchor, (size_t)lit_len );
+    op += lit_len;
+    *op++ = (uint8_t)( offset & 0xff );
+    *op++ = (uint8_t)( offset >> 8 );
+    if ( match_len >= 15 ) { op = _lz_write_len( op, match_len - 15 ); }
+    ip = anchor = mp;
+  }
+
+  vol_geom_size_t lit_len = iend - anchor;
+  *op++                   = (uint8_t)( ( lit_len < 15 ? lit_len : 15 ) << 4 );
+  if ( lit_len >= 15 ) { op = _lz_write_len( op, lit_len - 15 ); }
+  memcpy( op, anchor, (size_t)lit_len );
+  op += lit_len;
+  return op - dst_ptr;
+}
+
+/** Decompress `src_sz` bytes from `_lz_compress()` into exactly `dst_sz` bytes at `dst_ptr`.
+ * @return False if the input is malformed, or doesn't decompress to `dst_sz` bytes. Never reads or writes out of bounds.
+ */
+static bool _lz_decompress( const uint8_t* src_ptr, vol_geom_size_t src_sz, uint8_t* dst_ptr, vol_geom_size_t dst_sz ) {
+  const uint8_t* ip   = src_ptr;
+  const uint8_t* iend = src_ptr + src_sz;
+  uint8_t* op         = dst_ptr;
+  uint8_t* oend       = dst_ptr + dst_sz;
+
+  while ( ip < iend ) {
+    uint8_t token       = *ip++;
+    vol_geom_size_t len = token >> 4;
+    if ( !_lz_read_len( &ip, iend, &len ) || len > iend - ip || len > oend - op ) { return false; }
+    memcpy( op, ip, (size_t)len );
+    ip += len;
+    op += len;
+    if ( ip == iend ) { break; } // The last sequence has no match.
+
+    if ( iend - ip < 2 ) { return false; }
+    vol_geom_size_t offset = (vol_geom_size_t)ip[0] | (vol_geom_size_t)ip[1] << 8;
+    ip += 2;
+    len = token & 15;
+    if ( !_lz_read_len( &ip, iend, &len ) ) { return false; }
+    len += VOL_GEOM_LZ_MIN_MATCH;
+    if ( 0 == offset || offset > op - dst_ptr || len > oend - op ) { return false; }
+    // Overlapping matches repeat the last `offset` bytes. Each copy takes all the whole repeats written so far, so copies double in size.
+    for ( vol_geom_size_t copied_sz = 0; copied_sz < len; ) {
+      vol_geom_size_t period_sz = ( copied_sz / offset + 1 ) * offset;
+      vol_geom_size_t chunk_sz  = len - copied_sz < period_sz ? len - copied_sz : period_sz;
+      memcpy( &op[copied_sz], &op[copied_sz - period_sz], (size_t)chunk_sz );
+      copied_sz += chunk_sz;
+    }
+    op += len;
+  }
+  return op == oend;
+}
+
+/** Split the 4-byte words of `sz` bytes, from `start`, into 4 planes of their first, second, third and fourth bytes. Bytes before `start`, and any
+ * left over after the last whole word, are copied as they are. `_unshuffle4()` reverses it.
+ */
+static void _shuffle4( const uint8_t* src_ptr, uint8_t* dst_ptr, vol_geom_size_t start, vol_geom_size_t sz ) {
+  if ( start > sz ) { start = sz; }
+  vol_geom_size_t n = ( sz - start ) / 4;
+  const uint8_t* word_ptr = &src_ptr[start];
+  uint8_t* plane_ptr      = &dst_ptr[start];
+  memcpy( dst_ptr, src_ptr, (size_t)start );
+  for ( vol_geom_size_t i = 0; i < n; i++ ) {
+    plane_ptr[i]         = word_ptr[i * 4];
+    plane_ptr[n + i]     = word_ptr[i * 4 + 1];
+    plane_ptr[2 * n + i] = word_ptr[i * 4 + 2];
+    plane_ptr[3 * n + i] = word_ptr[i * 4 + 3];
+  }
+  memcpy( &dst_ptr[start + n * 4], &src_ptr[start + n * 4], (size_t)( sz - start - n * 4 ) );
+}
+
+static void _unshuffle4( const uint8_t* src_ptr, uint8_t* dst_ptr, vol_geom_size_t start, vol_geom_size_t sz ) {
+  if ( start > sz ) { start = sz; }
+  vol_geom_size_t n = ( sz - start ) / 4;
+  const uint8_t* plane_ptr = &src_ptr[start];
+  uint8_t* word_ptr        = &dst_ptr[start];
+  memcpy( dst_ptr, src_ptr, (size_t)start );
+  for ( vol_geom_size_t i = 0; i < n; i++ ) {
+    word_ptr[i * 4]     = plane_ptr[i];
+    word_ptr[i * 4 + 1] = plane_ptr[n + i];
+    word_ptr[i * 4 + 2] = plane_ptr[2 * n + i];
+    word_ptr[i * 4 + 3] = plane_ptr[3 * n + i];
+  }
+  memcpy( &dst_ptr[start + n * 4], &src_ptr[start + n * 4], (size_t)( sz - start - n * 4 ) );
+}
+
+static void _free_compressed_seq( vol_geom_compressed_seq_t* cseq_ptr ) {
+  if ( !cseq_ptr ) { return; }
+  free( cseq_ptr->blob_ptr );
+  free( cseq_ptr->frame_offsets_ptr );
+  free( cseq_ptr );
+}
+
+/** Helper function to read the frames of an open sequence file a frame at a time, and compress each one.
+ * The frames directory must already be built. The blob grows as frames are added, so the file's size is never allocated at once.
+ * @return The compressed frames, or NULL on any error.
+ */
+static vol_geom_compressed_seq_t* _compress_frames( const vol_geom_io_t* io_ptr, void* handle_ptr, vol_geom_size_t seq_sz, const vol_geom_info_t* info_ptr ) {
+  int frame_count          = info_ptr->hdr.frame_count;
+  vol_geom_size_t capacity = _lz_bound( info_ptr->biggest_frame_blob_sz );
+  vol_geom_size_t used     = 0;
+  // An empty sequence has no biggest frame, and malloc( 0 ) may return NULL, so the frame buffers are never 0 bytes.
+  size_t frame_buf_sz                 = info_ptr->biggest_frame_blob_sz > 0 ? (size_t)info_ptr->biggest_frame_blob_sz : 1;
+  vol_geom_compressed_seq_t* cseq_ptr = calloc( 1, sizeof( vol_geom_compressed_seq_t ) );
+  uint8_t* frame_ptr                  = malloc( frame_buf_sz );
+  uint8_t* shuffled_ptr               = malloc( frame_buf_sz );
+  uint32_t* table_ptr                 = malloc( sizeof( uint32_t ) << VOL_GEOM_LZ_HASH_BITS );
+  if ( cseq_ptr ) {
+    cseq_ptr->frame_offsets_ptr = calloc( (size_t)frame_count + 1, sizeof( vol_geom_size_t ) );
+    cseq_ptr->blob_ptr          = malloc( (size_t)capacity );
+  }
+  if ( !cseq_ptr || !cseq_ptr->frame_offsets_ptr || !cseq_ptr->blob_ptr || !frame_ptr || !shuffled_ptr || !table_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating compressed pre-load.\n" );
+    goto failed_compressed_preload;
+  }
+
+  for ( int i = 0; i < frame_count; i++ ) {
+    const vol_geom_frame_directory_entry_t* dir_ptr = &info_ptr->frames_directory_ptr[i];
+    if ( seq_sz < dir_ptr->offset_sz + dir_ptr->total_sz || !io_ptr->read_at_fn( handle_ptr, dir_ptr->offset_sz, frame_ptr, dir_ptr->total_sz ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", i );
+      goto failed_compressed_preload;
+    }
+    if ( used + _lz_bound( dir_ptr->total_sz ) > capacity ) {
+      vol_geom_size_t new_capacity = capacity + capacity / 2;
+      if ( new_capacity < used + _lz_bound( dir_ptr->total_sz ) ) { new_capacity = used + _lz_bound( dir_ptr->total_sz ); }
+      uint8_t* new_blob_ptr = realloc( cseq_ptr->blob_ptr, (size_t)new_capacity );
+      if ( !new_blob_ptr ) {
+        _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory growing compressed pre-load to %" PRId64 " bytes.\n", new_capacity );
+        goto failed_compressed_preload;
+      }
+      cseq_ptr->blob_ptr = new_blob_ptr;
+      capacity           = new_capacity;
+    }
+    // Frame headers are a few odd bytes, so words are split from the start of the payload, where the arrays' 4-byte values line up.
+    _shuffle4( frame_ptr, shuffled_ptr, dir_ptr->hdr_sz, dir_ptr->total_sz );
+    used += _lz_compress( shuffled_ptr, dir_ptr->total_sz, &cseq_ptr->blob_ptr[used], table_ptr );
+    cseq_ptr->frame_offsets_ptr[i + 1] = used;
+  }
+
+  // Give back the slack from growing the blob. This only shrinks, so if it fails the bigger blob is kept.
+  uint8_t* shrunk_blob_ptr = realloc( cseq_ptr->blob_ptr, (size_t)( used > 0 ? used : 1 ) );
+  if ( shrunk_blob_ptr ) { cseq_ptr->blob_ptr = shrunk_blob_ptr; }
+  cseq_ptr->blob_sz = used;
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Compressed %" PRId64 " byte sequence to %" PRId64 " bytes in memory\n", seq_sz, used );
+
+  free( frame_ptr );
+  free( shuffled_ptr );
+  free( table_ptr );
+  return cseq_ptr;
+
+failed_compressed_preload:
+  free( frame_ptr );
+  free( shuffled_ptr );
+  free( table_ptr );
+  _free_compressed_seq( cseq_ptr );
+  return NULL;
+}
+
+/** Helper function to get the bytes a compressed sequence holds, including its frame offsets. */
+static vol_geom_size_t _compressed_seq_sz( const vol_geom_compressed_seq_t* cseq_ptr, int frame_count ) {
+  return cseq_ptr->blob_sz + ( (vol_geom_size_t)frame_count + 1 ) * (vol_geom_size_t)sizeof( vol_geom_size_t );
+}
+
+/** Helper function to compress the sequence file into `info_ptr->compressed_seq_ptr`.
+ * @return False on any error, leaving `info_ptr` unchanged.
+ */
+static bool _load_compressed_sequence( const char* seq_filename, vol_geom_info_t* info_ptr ) {
+  const vol_geom_io_t* io_ptr = _get_io( info_ptr );
+  vol_geom_size_t seq_sz      = 0;
+  void* handle_ptr            = _io_open_sized( io_ptr, seq_filename, &seq_sz );
+  if ( !handle_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file `%s` could not be opened.\n", seq_filename );
+    return false;
+  }
+  vol_geom_compressed_seq_t* cseq_ptr = _compress_frames( io_ptr, handle_ptr, seq_sz, info_ptr );
+  io_ptr->close_fn( handle_ptr );
+  if ( !cseq_ptr ) { return false; }
+  info_ptr->compressed_seq_ptr = cseq_ptr;
+  _track_resident_sz( _compressed_seq_sz( cseq_ptr, info_ptr->hdr.frame_count ) );
+  return true;
+}
+
+/** Helper function to decompress a frame of a compressed pre-load into the frame blob, through `compressed_frame_scratch_ptr`. */
+static bool _fetch_compressed_frame( const vol_geom_info_t* info_ptr, int frame_idx ) {
+  const vol_geom_compressed_seq_t* cseq_ptr       = (const vol_geom_compressed_seq_t*)info_ptr->compressed_seq_ptr;
+  const vol_geom_frame_directory_entry_t* dir_ptr = &info_ptr->frames_directory_ptr[frame_idx];
+  vol_geom_size_t offset                          = cseq_ptr->frame_offsets_ptr[frame_idx];
+  vol_geom_size_t sz                              = cseq_ptr->frame_offsets_ptr[frame_idx + 1] - offset;
+  if ( !_lz_decompress( &cseq_ptr->blob_ptr[offset], sz, info_ptr->compressed_frame_scratch_ptr, dir_ptr->total_sz ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: compressed frame %i is corrupt\n", frame_idx );
+    return false;
+  }
+  _unshuffle4( info_ptr->compressed_frame_scratch_ptr, info_ptr->preallocated_frame_blob_ptr, dir_ptr->hdr_sz, dir_ptr->total_sz );
+  return true;
+}
+
+/******************************************************************************
+  LOAD POLICY
+******************************************************************************/
+
+/** Helper function to get how a sequence is held in memory from what it has loaded. */
+static vol_geom_load_mode_t _held_load_mode( const vol_geom_info_t* owner_ptr ) {
+  if ( owner_ptr->compressed_seq_ptr ) { return VOL_GEOM_LOAD_PRELOAD_COMPRESSED; }
+  if ( owner_ptr->sequence_map_handle_ptr ) { return VOL_GEOM_LOAD_MAPPED; }
+  if ( owner_ptr->progressive_preload_ptr ) { return VOL_GEOM_LOAD_PROGRESSIVE; }
+  if ( owner_ptr->sequence_blob_byte_ptr ) { return VOL_GEOM_LOAD_PRELOAD; }
+  return VOL_GEOM_LOAD_STREAMING;
+}
+
+/** Helper function to get the bytes of sequence memory allocated by `owner_ptr`, which count against the budget. */
+static vol_geom_size_t _owned_sequence_sz( const vol_geom_info_t* owner_ptr ) {
+  vol_geom_size_t sz = 0;
+  if ( owner_ptr->sequence_blob_byte_ptr && !owner_ptr->sequence_map_handle_ptr ) { sz += owner_ptr->sequence_blob_sz; }
+  if ( owner_ptr->compressed_seq_ptr ) { sz += _compressed_seq_sz( (const vol_geom_compressed_seq_t*)owner_ptr->compressed_seq_ptr, owner_ptr->hdr.frame_count ); }
+  return sz;
+}
+
+/** Helper function to free whatever holds `owner_ptr`'s sequence in memory, so its frames are read from the file again. */
+static void _release_sequence( vol_geom_info_t* owner_ptr ) {
+  _track_resident_sz( -_owned_sequence_sz( owner_ptr ) );
+  if ( owner_ptr->progressive_preload_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Stopping progressive pre-load\n" );
+    _stop_progressive_preload( (vol_geom_progressive_preload_t*)owner_ptr->progressive_preload_ptr );
+  }
+  if ( owner_ptr->sequence_map_handle_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Closing mapped sequence file\n" );
+    _get_io( owner_ptr )->close_fn( owner_ptr->sequence_map_handle_ptr );
+  } else if ( owner_ptr->sequence_blob_byte_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing sequence_blob_byte_ptr\n" );
+    free( owner_ptr->sequence_blob_byte_ptr );
+  }
+  if ( owner_ptr->compressed_seq_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing compressed sequence\n" );
+    _free_compressed_seq( (vol_geom_compressed_seq_t*)owner_ptr->compressed_seq_ptr );
+  }
+  owner_ptr->progressive_preload_ptr = NULL;
+  owner_ptr->sequence_map_handle_ptr = NULL;
+  owner_ptr->sequence_blob_byte_ptr  = NULL;
+  owner_ptr->sequence_blob_sz        = 0;
+  owner_ptr->compressed_seq_ptr      = NULL;
+}
+
+/** Helper function to map the sequence file to `sequence_blob_byte_ptr`. Files on disk are switched to the mapped-file backend to do it,
+ * but only once the mapping has worked, so a file that can't be mapped is streamed with the plain backend.
+ * @return False if the backend can't map the file, leaving the sequence streamed.
+ */
+static bool _map_sequence( const char* seq_filename, vol_geom_info_t* info_ptr ) {
+  const vol_geom_io_t* io_ptr = info_ptr->io.open_fn ? &info_ptr->io : &_mapped_file_io;
+  if ( !io_ptr->map_fn ) { return false; }
+  vol_geom_size_t seq_sz = 0;
+  void* seq_handle_ptr   = _io_open_sized( io_ptr, seq_filename, &seq_sz );
+  if ( !seq_handle_ptr ) { return false; }
+  const uint8_t* map_ptr = io_ptr->map_fn( seq_handle_ptr );
+  if ( !map_ptr ) {
+    io_ptr->close_fn( seq_handle_ptr );
+    return false;
+  }
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Using mapped sequence file\n" );
+  if ( !info_ptr->io.open_fn ) { info_ptr->io = _mapped_file_io; }
+  info_ptr->sequence_blob_byte_ptr  = (uint8_t*)map_ptr;
+  info_ptr->sequence_blob_sz        = seq_sz;
+  info_ptr->sequence_map_handle_ptr = seq_handle_ptr;
+  return true;
+}
+
+/** Helper function for `VOL_GEOM_LOAD_AUTO` to pick how to load a sequence, from its size and what is left of the memory budget.
+ * The frames directory must already be built.
+ */
+static vol_geom_load_mode_t _choose_load_mode( const vol_geom_info_t* info_ptr ) {
+  // Backends that map their files, like memory and packed volograms, have the sequence in memory already.
+  if ( _get_io( info_ptr )->map_fn ) { return VOL_GEOM_LOAD_MAPPED; }
+  vol_geom_size_t seq_sz = 0;
+  if ( info_ptr->hdr.frame_count > 0 ) {
+    const vol_geom_frame_directory_entry_t* last_ptr = &info_ptr->frames_directory_ptr[info_ptr->hdr.frame_count - 1];
+    seq_sz                                           = last_ptr->offset_sz + last_ptr->total_sz;
+  }
+  vol_geom_size_t budget_sz    = _atomic_load_i64( &_memory_budget_sz );
+  vol_geom_size_t available_sz = budget_sz - _atomic_load_i64( &_resident_sz );
+  vol_geom_load_mode_t mode    = VOL_GEOM_LOAD_STREAMING;
+  if ( 0 == budget_sz || seq_sz <= available_sz ) {
+    mode = VOL_GEOM_LOAD_PRELOAD;
+  } else if ( seq_sz / VOL_GEOM_AUTO_COMPRESSION_RATIO <= available_sz ) {
+    mode = VOL_GEOM_LOAD_PRELOAD_COMPRESSED;
+  } else if ( !info_ptr->io.open_fn ) {
+    // Mapped pages are read on first use, and dropped by the OS under memory pressure, so they don't count against the budget.
+    mode = VOL_GEOM_LOAD_MAPPED;
+  }
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Automatic load mode %i for %" PRId64 " byte sequence, %" PRId64 "/%" PRId64 " bytes of budget available\n", (int)mode,
+    seq_sz, available_sz, budget_sz );
+  return mode;
+}
+
+/******************************************************************************
+  IO_URING READ-AHEAD
+******************************************************************************/
+
+#ifdef VOL_GEOM_HAS_IO_URING
+
+/// Alignment of O_DIRECT reads' buffers, offsets, and sizes. Covers the logical block size of common devices.
+#define VOL_GEOM_URING_ALIGN 4096
+#define VOL_GEOM_URING_MAX_DEPTH 64
+
+typedef enum vol_geom_uring_slot_state_t {
+  VOL_GEOM_URING_SLOT_FREE = 0, //
+  VOL_GEOM_URING_SLOT_IN_FLIGHT,
+  VOL_GEOM_URING_SLOT_READY,
+  VOL_GEOM_URING_SLOT_FAILED
+} vol_geom_uring_slot_state_t;
+
+/// A buffer that one frame is read into.
+typedef struct vol_geom_uring_slot_t {
+  uint8_t* buffer_ptr;
+  /// Used for reads when the buffers couldn't be registered.
+  struct iovec iov;
+  int frame_idx;
+  /// Where the frame starts in the buffer. With O_DIRECT the read starts at the aligned offset before it.
+  vol_geom_size_t data_offset;
+  /// Bytes the read must return for the whole frame to be in the buffer.
+  vol_geom_size_t needed_sz;
+  vol_geom_uring_slot_state_t state;
+} vol_geom_uring_slot_t;
+
+/// Read-ahead state of one `vol_geom_info_t`, which must only be read from one thread at a time.
+typedef struct vol_geom_uring_readahead_t {
+  int ring_fd;
+  int file_fd;
+  bool direct_io;
+  bool registered_buffers;
+  int depth;
+  /// 1 when playing forwards, -1 when playing backwards. Worked out from the order frames are read in.
+  int step;
+  int last_frame_idx;
+  int in_flight;
+  vol_geom_uring_slot_t slots[VOL_GEOM_URING_MAX_DEPTH];
+
+  // The submission and completion rings, shared with the kernel.
+  uint8_t* sq_ring_ptr;
+  size_t sq_ring_sz;
+  uint8_t* cq_ring_ptr;
+  size_t cq_ring_sz;
+  struct io_uring_sqe* sqes_ptr;
+  size_t sqes_sz;
+  unsigned* sq_tail_ptr;
+  unsigned* sq_mask_ptr;
+  unsigned* sq_array_ptr;
+  unsigned* cq_head_ptr;
+  unsigned* cq_tail_ptr;
+  unsigned* cq_mask_ptr;
+  struct io_uring_cqe* cqes_ptr;
+} vol_geom_uring_readahead_t;
+
+/** Helper function to create the ring and map its submission and completion queues. */
+static bool _uring_setup( vol_geom_uring_readahead_t* ra_ptr, unsigned entries ) {
+  struct io_uring_params params;
+  memset( &params, 0, sizeof( params ) );
+  ra_ptr->ring_fd = (int)syscall( __NR_io_uring_setup, entries, &params );
+  if ( ra_ptr->ring_fd < 0 ) { return false; }
+
+  ra_ptr->sq_ring_sz = params.sq_off.array + params.sq_entries * sizeof( unsigned );
+  ra_ptr->cq_ring_sz = params.cq_off.cqes + params.cq_entries * sizeof( struct io_uring_cqe );
+  bool single_mmap   = 0 != ( params.features & IORING_FEAT_SINGLE_MMAP );
+  if ( single_mmap ) {
+    if ( ra_ptr->cq_ring_sz > ra_ptr->sq_ring_sz ) { ra_ptr->sq_ring_sz = ra_ptr->cq_ring_sz; }
+    ra_ptr->cq_ring_sz = ra_ptr->sq_ring_sz;
+  }
+  ra_ptr->sq_ring_ptr = mmap( NULL, ra_ptr->sq_ring_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ra_ptr->ring_fd, IORING_OFF_SQ_RING );
+  if ( MAP_FAILED == ra_ptr->sq_ring_ptr ) {
+    ra_ptr->sq_ring_ptr = NULL;
+    return false;
+  }
+  if ( single_mmap ) {
+    ra_ptr->cq_ring_ptr = ra_ptr->sq_ring_ptr;
+  } else {
+    ra_ptr->cq_ring_ptr = mmap( NULL, ra_ptr->cq_ring_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ra_ptr->ring_fd, IORING_OFF_CQ_RING );
+    if ( MAP_FAILED == ra_ptr->cq_ring_ptr ) {
+      ra_ptr->cq_ring_ptr = NULL;
+      return false;
+    }
+  }
+  ra_ptr->sqes_sz  = params.sq_entries * sizeof( struct io_uring_sqe );
+  ra_ptr->sqes_ptr = mmap( NULL, ra_ptr->sqes_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ra_ptr->ring_fd, IORING_OFF_SQES );
+  if ( MAP_FAILED == ra_ptr->sqes_ptr ) {
+    ra_ptr->sqes_ptr = NULL;
+    return false;
+  }
+
+  ra_ptr->sq_tail_ptr  = (unsigned*)( ra_ptr->sq_ring_ptr + params.sq_off.tail );
+  ra_ptr->sq_mask_ptr  = (unsigned*)( ra_ptr->sq_ring_ptr + params.sq_off.ring_mask );
+  ra_ptr->sq_array_ptr = (unsigned*)( ra_ptr->sq_ring_ptr + params.sq_off.array );
+  ra_ptr->cq_head_ptr  = (unsigned*)( ra_ptr->cq_ring_ptr + params.cq_off.head );
+  ra_ptr->cq_tail_ptr  = (unsigned*)( ra_ptr->cq_ring_ptr + params.cq_off.tail );
+  ra_ptr->cq_mask_ptr  = (unsigned*)( ra_ptr->cq_ring_ptr + params.cq_off.ring_mask );
+  ra_ptr->cqes_ptr     = (struct io_uring_cqe*)( ra_ptr->cq_ring_ptr + params.cq_off.cqes );
+  return true;
+}
+
+/** Helper function to submit queued reads and optionally wait for at least one completion.
+ * @return False on any error other than an interrupted wait.
+ */
+static bool _uring_enter( vol_geom_uring_readahead_t* ra_ptr, unsigned to_submit, bool wait ) {
+  if ( 0 == to_submit && !wait ) { return true; }
+  unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+  if ( syscall( __NR_io_uring_enter, ra_ptr->ring_fd, to_submit, wait ? 1 : 0, flags, NULL, 0 ) < 0 && EINTR != errno ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: io_uring_enter failed (errno %i).\n", errno );
+    return false;
+  }
+  return true;
+}
+
+/** Helper function to mark the slots of finished reads as ready or failed, without blocking. */
+static void _uring_reap( vol_geom_uring_readahead_t* ra_ptr ) {
+  unsigned head = *ra_ptr->cq_head_ptr;
+  unsigned tail = __atomic_load_n( ra_ptr->cq_tail_ptr, __ATOMIC_ACQUIRE );
+  for ( ; head != tail; head++ ) {
+    const struct io_uring_cqe* cqe_ptr = &ra_ptr->cqes_ptr[head & *ra_ptr->cq_mask_ptr];
+    vol_geom_uring_slot_t* slot_ptr    = &ra_ptr->slots[cqe_ptr->user_data];
+    slot_ptr->state = cqe_ptr->res >= 0 && (vol_geom_size_t)cqe_ptr->res >= slot_ptr->needed_sz ? VOL_GEOM_URING_SLOT_READY : VOL_GEOM_URING_SLOT_FAILED;
+    ra_ptr->in_flight--;
+  }
+  __atomic_store_n( ra_ptr->cq_head_ptr, head, __ATOMIC_RELEASE );
+}
+
+/** Helper function to queue a read of a frame into a slot. The read is sent to the kernel by the next `_uring_enter()`. */
+static void _uring_queue_read( vol_geom_uring_readahead_t* ra_ptr, const vol_geom_info_t* info_ptr, int slot_idx, int frame_idx ) {
+  vol_geom_uring_slot_t* slot_ptr = &ra_ptr->slots[slot_idx];
+  vol_geom_size_t offset_sz       = info_ptr->frames_directory_ptr[frame_idx].offset_sz;
+  vol_geom_size_t total_sz        = info_ptr->frames_directory_ptr[frame_idx].total_sz;
+  vol_geom_size_t read_offset     = offset_sz;
+  vol_geom_size_t read_sz         = total_sz;
+  if ( ra_ptr->direct_io ) {
+    read_offset = offset_sz & ~(vol_geom_size_t)( VOL_GEOM_URING_ALIGN - 1 );
+    read_sz     = ( offset_sz + total_sz - read_offset + VOL_GEOM_URING_ALIGN - 1 ) & ~(vol_geom_size_t)( VOL_GEOM_URING_ALIGN - 1 );
+  }
+  slot_ptr->frame_idx   = frame_idx;
+  slot_ptr->data_offset = offset_sz - read_offset;
+  slot_ptr->needed_sz   = slot_ptr->data_offset + total_sz;
+  slot_ptr->state       = VOL_GEOM_URING_SLOT_IN_FLIGHT;
+  slot_ptr->iov         = ( struct iovec ){ .iov_base = slot_ptr->buffer_ptr, .iov_len = (size_t)read_sz };
+
+  unsigned tail                = *ra_ptr->sq_tail_ptr;
+  unsigned idx                 = tail & *ra_ptr->sq_mask_ptr;
+  struct io_uring_sqe* sqe_ptr = &ra_ptr->sqes_ptr[idx];
+  memset( sqe_ptr, 0, sizeof( struct io_uring_sqe ) );
+  sqe_ptr->fd        = ra_ptr->file_fd;
+  sqe_ptr->off       = (uint64_t)read_offset;
+  sqe_ptr->user_data = (uint64_t)slot_idx;
+  if ( ra_ptr->registered_buffers ) {
+    sqe_ptr->opcode    = IORING_OP_READ_FIXED;
+    sqe_ptr->addr      = (uint64_t)(uintptr_t)slot_ptr->buffer_ptr;
+    sqe_ptr->len       = (uint32_t)read_sz;
+    sqe_ptr->buf_index = (uint16_t)slot_idx;
+  } else {
+    sqe_ptr->opcode = IORING_OP_READV;
+    sqe_ptr->addr   = (uint64_t)(uintptr_t)&slot_ptr->iov;
+    sqe_ptr->len    = 1;
+  }
+  ra_ptr->sq_array_ptr[idx] = idx;
+  __atomic_store_n( ra_ptr->sq_tail_ptr, tail + 1, __ATOMIC_RELEASE );
+  ra_ptr->in_flight++;
+}
+
+/** Helper function to find the slot holding, or reading, a frame.
+ * @return The slot index, or -1 if the frame isn't in a slot.
+ */
+static int _uring_find_slot( const vol_geom_uring_readahead_t* ra_ptr, int frame_idx ) {
+  for ( int i = 0; i < ra_ptr->depth; i++ ) {
+    if ( VOL_GEOM_URING_SLOT_FREE != ra_ptr->slots[i].state && ra_ptr->slots[i].frame_idx == frame_idx ) { return i; }
+  }
+  return -1;
+}
+
+/** Helper function to find a slot that can be read into: one that is free, or holds a frame outside the read-ahead window starting at `frame_idx`.
+ * @return The slot index, or -1 if every slot is being read into or still wanted.
+ */
+static int _uring_free_slot( const vol_geom_uring_readahead_t* ra_ptr, int frame_idx ) {
+  for ( int i = 0; i < ra_ptr->depth; i++ ) {
+    const vol_geom_uring_slot_t* slot_ptr = &ra_ptr->slots[i];
+    if ( VOL_GEOM_URING_SLOT_IN_FLIGHT == slot_ptr->state ) { continue; }
+    int ahead = ( slot_ptr->frame_idx - frame_idx ) * ra_ptr->step;
+    if ( VOL_GEOM_URING_SLOT_FREE == slot_ptr->state || ahead < 0 || ahead >= ra_ptr->depth ) { return i; }
+  }
+  return -1;
+}
+
+/** Helper function for `_fetch_frame_blob()` to get a streamed frame from the read-ahead slots, reading it now if it wasn't read ahead.
+ * Then reads for the frames after it are submitted in one batch. With `in_place` the frame is left in its slot, which stays valid until the next read.
+ */
+static bool _uring_fetch_frame( const vol_geom_info_t* info_ptr, int frame_idx, bool in_place, uint8_t** frame_blob_ptr ) {
+  vol_geom_uring_readahead_t* ra_ptr = (vol_geom_uring_readahead_t*)info_ptr->uring_readahead_ptr;
+  if ( frame_idx != ra_ptr->last_frame_idx ) { ra_ptr->step = frame_idx < ra_ptr->last_frame_idx ? -1 : 1; }
+  ra_ptr->last_frame_idx = frame_idx;
+  _uring_reap( ra_ptr );
+
+  // A frame that wasn't read ahead, e.g. after a seek, is read now. Every slot may be busy with reads for the old position, so wait for one.
+  int slot_idx = _uring_find_slot( ra_ptr, frame_idx );
+  while ( slot_idx < 0 ) {
+    slot_idx = _uring_free_slot( ra_ptr, frame_idx );
+    if ( slot_idx >= 0 ) {
+      _uring_queue_read( ra_ptr, info_ptr, slot_idx, frame_idx );
+      if ( !_uring_enter( ra_ptr, 1, false ) ) { return false; }
+    } else {
+      if ( !_uring_enter( ra_ptr, 0, true ) ) { return false; }
+      _uring_reap( ra_ptr );
+    }
+  }
+
+  // Queue the rest of the window together, so the kernel gets them in one submission while this frame is waited for and parsed.
+  unsigned n_queued = 0;
+  for ( int i = 1; i < ra_ptr->depth; i++ ) {
+    int ahead_idx = frame_idx + i * ra_ptr->step;
+    if ( ahead_idx < 0 || ahead_idx >= info_ptr->hdr.frame_count ) { break; }
+    if ( _uring_find_slot( ra_ptr, ahead_idx ) >= 0 ) { continue; }
+    int free_idx = _uring_free_slot( ra_ptr, frame_idx );
+    if ( free_idx < 0 ) { break; }
+    _uring_queue_read( ra_ptr, info_ptr, free_idx, ahead_idx );
+    n_queued++;
+  }
+  if ( !_uring_enter( ra_ptr, n_queued, false ) ) { return false; }
+
+  vol_geom_uring_slot_t* slot_ptr = &ra_ptr->slots[slot_idx];
+  while ( VOL_GEOM_URING_SLOT_IN_FLIGHT == slot_ptr->state ) {
+    if ( !_uring_enter( ra_ptr, 0, true ) ) { return false; }
+    _uring_reap( ra_ptr );
+  }
+  if ( VOL_GEOM_URING_SLOT_READY != slot_ptr->state ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", frame_idx );
+    slot_ptr->state = VOL_GEOM_URING_SLOT_FREE;
+    return false;
+  }
+
+  uint8_t* data_ptr = &slot_ptr->buffer_ptr[slot_ptr->data_offset];
+  if ( in_place ) {
+    *frame_blob_ptr = data_ptr;
+  } else {
+    memcpy( info_ptr->preallocated_frame_blob_ptr, data_ptr, (size_t)info_ptr->frames_directory_ptr[frame_idx].total_sz );
+    *frame_blob_ptr = info_ptr->preallocated_frame_blob_ptr;
+  }
+  return true;
+}
+
+/** Helper function to wait for any reads still going into the slots, then free the read-ahead state. */
+static void _free_uring_readahead( vol_geom_uring_readahead_t* ra_ptr ) {
+  while ( ra_ptr->in_flight > 0 && ra_ptr->cqes_ptr ) {
+    if ( !_uring_enter( ra_ptr, 0, true ) ) { break; }
+    _uring_reap( ra_ptr );
+  }
+  if ( ra_ptr->sqes_ptr ) { munmap( ra_ptr->sqes_ptr, ra_ptr->sqes_sz ); }
+  if ( ra_ptr->cq_ring_ptr && ra_ptr->cq_ring_ptr != ra_ptr->sq_ring_ptr ) { munmap( ra_ptr->cq_ring_ptr, ra_ptr->cq_ring_sz ); }
+  if ( ra_ptr->sq_ring_ptr ) { munmap( ra_ptr->sq_ring_ptr, ra_ptr->sq_ring_sz ); }
+  if ( ra_ptr->ring_fd >= 0 ) { close( ra_ptr->ring_fd ); }
+  if ( ra_ptr->file_fd >= 0 ) { close( ra_ptr->file_fd ); }
+  for ( int i = 0; i < VOL_GEOM_URING_MAX_DEPTH; i++ ) { free( ra_ptr->slots[i].buffer_ptr ); }
+  free( ra_ptr );
+}
+
+#endif /* VOL_GEOM_HAS_IO_URING */
+
+bool vol_geom_enable_uring_readahead( const char* seq_filename, vol_geom_info_t* info_ptr, int depth, bool direct_io ) {
+  assert( seq_filename && info_ptr );
+  if ( !seq_filename || !info_ptr ) { return false; }
+#ifdef VOL_GEOM_HAS_IO_URING
+  if ( info_ptr->sequence_blob_byte_ptr || info_ptr->compressed_seq_ptr || info_ptr->io.open_fn || info_ptr->uring_readahead_ptr || depth < 2 ||
+       depth > VOL_GEOM_URING_MAX_DEPTH ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: io_uring read-ahead needs a sequence streamed from disk, and a depth of 2-%i.\n", VOL_GEOM_URING_MAX_DEPTH );
+    return false;
+  }
+  vol_geom_uring_readahead_t* ra_ptr = calloc( 1, sizeof( vol_geom_uring_readahead_t ) );
+  if ( !ra_ptr ) { return false; }
+  ra_ptr->ring_fd        = -1;
+  ra_ptr->depth          = depth;
+  ra_ptr->step           = 1;
+  ra_ptr->last_frame_idx = -1;
+  ra_ptr->direct_io      = direct_io;
+  ra_ptr->file_fd        = open( seq_filename, O_RDONLY | O_CLOEXEC | ( direct_io ? O_DIRECT : 0 ) );
+  if ( ra_ptr->file_fd < 0 && direct_io ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_WARNING, "WARNING: O_DIRECT not supported for `%s`, using cached reads.\n", seq_filename );
+    ra_ptr->direct_io = false;
+    ra_ptr->file_fd   = open( seq_filename, O_RDONLY | O_CLOEXEC );
+  }
+  if ( ra_ptr->file_fd < 0 ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not open file `%s` for io_uring read-ahead.\n", seq_filename );
+    goto failed_uring_readahead;
+  }
+
+  // With O_DIRECT a frame's read is widened to aligned boundaries on both sides.
+  vol_geom_size_t slot_sz = info_ptr->biggest_frame_blob_sz;
+  if ( ra_ptr->direct_io ) { slot_sz = ( slot_sz + 2 * VOL_GEOM_URING_ALIGN - 1 ) & ~(vol_geom_size_t)( VOL_GEOM_URING_ALIGN - 1 ); }
+  struct iovec iovs[VOL_GEOM_URING_MAX_DEPTH];
+  for ( int i = 0; i < depth; i++ ) {
+    void* buffer_ptr = NULL;
+    if ( 0 != posix_memalign( &buffer_ptr, VOL_GEOM_URING_ALIGN, (size_t)slot_sz ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating io_uring read-ahead buffers.\n" );
+      goto failed_uring_readahead;
+    }
+    ra_ptr->slots[i].buffer_ptr = buffer_ptr;
+    iovs[i]                     = ( struct iovec ){ .iov_base = buffer_ptr, .iov_len = (size_t)slot_sz };
+  }
+
+  if ( !_uring_setup( ra_ptr, (unsigned)depth ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_WARNING, "WARNING: io_uring is not available (errno %i).\n", errno );
+    goto failed_uring_readahead;
+  }
+  // Registered buffers save mapping them on every read, but count against RLIMIT_MEMLOCK, so reads work without them too.
+  ra_ptr->registered_buffers = 0 == syscall( __NR_io_uring_register, ra_ptr->ring_fd, IORING_REGISTER_BUFFERS, iovs, (unsigned)depth );
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "io_uring read-ahead of %i frames, direct_io %i, registered buffers %i\n", depth, (int)ra_ptr->direct_io,
+    (int)ra_ptr->registered_buffers );
+
+  info_ptr->uring_readahead_ptr = ra_ptr;
+  return true;
+
+failed_uring_readahead:
+  _free_uring_readahead( ra_ptr );
   return false;
+#else
+  (void)depth;
+  (void)direct_io;
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_WARNING, "WARNING: io_uring read-ahead needs a Linux build with VOL_GEOM_IO_URING defined.\n" );
+  return false;
+#endif
 }
 
+/******************************************************************************
+  BASIC API
+******************************************************************************/
+
 /** Helper function to read Unity-style strings, specified in VOL format, from a loaded file.
  * @warning      The file's string format is ambiguous so insecure assumptions are made here.
  * @param fr_ptr Pointer to a file record loaded with a call to `_read_entire_file()`. Must not be NULL.
@@ -146,8 +1148,125 @@ static bool _read_short_str( const vol_geom_file_record_t* fr_ptr, vol_geom_size
   return true;
 }
 
+/// Compile-time check, as C99 has no `static_assert`. An array of size -1 doesn't compile.
+#define VOL_GEOM_STATIC_ASSERT( cond, name ) typedef char vol_geom_static_assert_##name[( cond ) ? 1 : -1]
+
+// v13 headers and directories are cast straight from file bytes, so a compiler that pads these structs differently can't read them.
+VOL_GEOM_STATIC_ASSERT( sizeof( vol_geom_v13_file_hdr_t ) == 456, v13_file_hdr_sz );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, version ) == 8, v13_version_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, frame_count ) == 20, v13_frame_count_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, mesh_name ) == 24, v13_mesh_name_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, normals ) == 408, v13_normals_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, texture_width ) == 410, v13_texture_width_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, translation ) == 416, v13_translation_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, scale ) == 444, v13_scale_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_file_hdr_t, directory_offset ) == 448, v13_directory_offset_offset );
+VOL_GEOM_STATIC_ASSERT( sizeof( vol_geom_frame_sections_t ) == 40, frame_sections_sz );
+VOL_GEOM_STATIC_ASSERT( sizeof( vol_geom_v13_frame_entry_t ) == 56, v13_frame_entry_sz );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_frame_entry_t, sz ) == 8, v13_frame_entry_sz_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_frame_entry_t, keyframe ) == 12, v13_frame_entry_keyframe_offset );
+VOL_GEOM_STATIC_ASSERT( offsetof( vol_geom_v13_frame_entry_t, sections ) == 16, v13_frame_entry_sections_offset );
+
+/// First bytes of a v13 header file. Older versions have their version number where the zeroes are.
+static const uint8_t _v13_format[8] = { 4, 'V', 'O', 'L', 'S', 0, 0, 0 };
+
+/** Helper function to copy a nul-terminated string from a v13 header into a short string. */
+static bool _copy_v13_str( const char* src_ptr, vol_geom_short_str_t* sstr ) {
+  const char* end_ptr = memchr( src_ptr, '\0', sizeof( sstr->bytes ) );
+  if ( !end_ptr ) { return false; }
+  sstr->sz = (uint8_t)( end_ptr - src_ptr );
+  memcpy( sstr->bytes, src_ptr, (size_t)sstr->sz + 1 );
+  return true;
+}
+
+/** Helper function to parse a v13 header, which is cast straight from the file's bytes.
+ * The frame directory that follows it is validated and read later, by `_read_v13_directory()`.
+ */
+static bool _read_v13_file_hdr( const vol_geom_file_record_t* fr, vol_geom_file_hdr_t* hdr, vol_geom_size_t* hdr_sz ) {
+  if ( fr->sz < (vol_geom_size_t)sizeof( vol_geom_v13_file_hdr_t ) ) { return false; } // OOB
+  const vol_geom_v13_file_hdr_t* v13_ptr = (const vol_geom_v13_file_hdr_t*)fr->byte_ptr; // The record's bytes are malloc()ed, so they are aligned.
+  if ( VOL_GEOM_V13_VERSION != v13_ptr->version || v13_ptr->frame_count < 0 || v13_ptr->normals > 1 || v13_ptr->textured > 1 ) { return false; }
+  if ( 0 != v13_ptr->directory_offset % 8 || v13_ptr->directory_offset < sizeof( vol_geom_v13_file_hdr_t ) ||
+       v13_ptr->directory_offset > (uint64_t)fr->sz ||
+       (uint64_t)v13_ptr->frame_count * sizeof( vol_geom_v13_frame_entry_t ) > (uint64_t)fr->sz - v13_ptr->directory_offset ) {
+    return false; // OOB
+  }
+
+  *hdr = ( vol_geom_file_hdr_t ){ .version = v13_ptr->version };
+  memcpy( hdr->format.bytes, "VOLS", 5 );
+  hdr->format.sz = 4;
+  if ( !_copy_v13_str( v13_ptr->mesh_name, &hdr->mesh_name ) || !_copy_v13_str( v13_ptr->material, &hdr->material ) ||
+       !_copy_v13_str( v13_ptr->shader, &hdr->shader ) ) {
+    return false;
+  }
+  hdr->compression    = v13_ptr->compression;
+  hdr->topology       = v13_ptr->topology;
+  hdr->frame_count    = v13_ptr->frame_count;
+  hdr->normals        = (bool)v13_ptr->normals;
+  hdr->textured       = (bool)v13_ptr->textured;
+  hdr->texture_width  = v13_ptr->texture_width;
+  hdr->texture_height = v13_ptr->texture_height;
+  hdr->texture_format = v13_ptr->texture_format;
+  memcpy( hdr->translation, v13_ptr->translation, sizeof( hdr->translation ) );
+  memcpy( hdr->rotation, v13_ptr->rotation, sizeof( hdr->rotation ) );
+  hdr->scale = v13_ptr->scale;
+
+  *hdr_sz = (vol_geom_size_t)sizeof( vol_geom_v13_file_hdr_t );
+  return true;
+}
+
+/** Helper function to check that an attribute array of a v13 frame is aligned and lies within the frame. */
+static bool _v13_section_valid( uint32_t offset, uint32_t sz, uint32_t frame_sz ) {
+  return 0 == offset % VOL_GEOM_V13_ARRAY_ALIGN && offset <= frame_sz && sz <= frame_sz - offset;
+}
+
+/** Helper function to fill in the frames directory, frame headers, and frame sections from a v13 header file's frame directory.
+ * Every entry is validated here, so reading a frame is only pointer arithmetic.
+ * @param fr_ptr           The header file, already checked by `_read_v13_file_hdr()`.
+ * @param sequence_file_sz Size of the sequence file, which every frame must lie within.
+ * @return                 False if any entry is invalid.
+ */
+static bool _read_v13_directory( const vol_geom_file_record_t* fr_ptr, vol_geom_size_t sequence_file_sz, vol_geom_info_t* info_ptr, int* biggest_frame_idx_ptr ) {
+  const vol_geom_v13_file_hdr_t* v13_ptr        = (const vol_geom_v13_file_hdr_t*)fr_ptr->byte_ptr;
+  const vol_geom_v13_frame_entry_t* entries_ptr = (const vol_geom_v13_frame_entry_t*)&fr_ptr->byte_ptr[v13_ptr->directory_offset];
+  uint64_t prev_end                             = 0;
+
+  for ( int32_t i = 0; i < info_ptr->hdr.frame_count; i++ ) {
+    const vol_geom_v13_frame_entry_t* entry_ptr = &entries_ptr[i];
+    const vol_geom_frame_sections_t* sec_ptr    = &entry_ptr->sections;
+    bool valid = 0 == entry_ptr->offset % VOL_GEOM_V13_FRAME_ALIGN && entry_ptr->offset >= prev_end && entry_ptr->offset <= (uint64_t)sequence_file_sz &&
+                 entry_ptr->sz <= (uint64_t)sequence_file_sz - entry_ptr->offset && entry_ptr->keyframe <= 2;
+    valid = valid && _v13_section_valid( sec_ptr->vertices_offset, sec_ptr->vertices_sz, entry_ptr->sz ) &&
+            _v13_section_valid( sec_ptr->normals_offset, sec_ptr->normals_sz, entry_ptr->sz ) &&
+            _v13_section_valid( sec_ptr->indices_offset, sec_ptr->indices_sz, entry_ptr->sz ) &&
+            _v13_section_valid( sec_ptr->uvs_offset, sec_ptr->uvs_sz, entry_ptr->sz ) &&
+            _v13_section_valid( sec_ptr->texture_offset, sec_ptr->texture_sz, entry_ptr->sz );
+    // Tracked frames reuse their keyframe's indices and UVs, and arrays the header doesn't enable are empty.
+    valid = valid && ( 0 != entry_ptr->keyframe || ( 0 == sec_ptr->indices_sz && 0 == sec_ptr->uvs_sz ) );
+    valid = valid && ( info_ptr->hdr.normals || 0 == sec_ptr->normals_sz ) && ( info_ptr->hdr.textured || 0 == sec_ptr->texture_sz );
+    if ( !valid ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: v13 directory entry for frame %i is invalid for a sequence of %" PRId64 " bytes\n", i, sequence_file_sz );
+      return false;
+    }
+    prev_end = entry_ptr->offset + entry_ptr->sz;
+
+    info_ptr->frames_directory_ptr[i] = ( vol_geom_frame_directory_entry_t ){ .offset_sz = (vol_geom_size_t)entry_ptr->offset,
+      .total_sz                                                                    = (vol_geom_size_t)entry_ptr->sz,
+      .hdr_sz                                                                      = 0,
+      .corrected_payload_sz                                                        = (vol_geom_size_t)entry_ptr->sz };
+    info_ptr->frame_headers_ptr[i] = ( vol_geom_frame_hdr_t ){ .frame_number = i, .mesh_data_sz = (int32_t)entry_ptr->sz, .keyframe = entry_ptr->keyframe };
+    info_ptr->frame_sections_ptr[i] = *sec_ptr;
+    if ( info_ptr->frames_directory_ptr[i].total_sz > info_ptr->biggest_frame_blob_sz ) {
+      info_ptr->biggest_frame_blob_sz = info_ptr->frames_directory_ptr[i].total_sz;
+      *biggest_frame_idx_ptr          = i;
+    }
+  }
+  return true;
+}
+
 static bool _read_vol_file_hdr( const vol_geom_file_record_t* fr, vol_geom_file_hdr_t* hdr, vol_geom_size_t* hdr_sz ) {
   if ( !fr || !hdr || !hdr_sz || fr->sz < VOL_GEOM_FILE_HDR_V10_MIN_SZ ) { return false; }
+  if ( 0 == memcmp( fr->byte_ptr, _v13_format, sizeof( _v13_format ) ) ) { return _read_v13_file_hdr( fr, hdr, hdr_sz ); }
 
   vol_geom_size_t offset = 0;
 
@@ -209,17 +1328,35 @@ static bool _read_vol_file_hdr( const vol_geom_file_record_t* fr, vol_geom_file_
   return true;
 }
 
-static bool _read_vol_frame( const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
-  assert( info_ptr && info_ptr->preallocated_frame_blob_ptr && frame_data_ptr );
-  if ( !info_ptr || !info_ptr->preallocated_frame_blob_ptr || !frame_data_ptr ) { return false; }
+/** Helper function to parse the data sections of a frame.
+ * @param frame_blob_ptr Start of the frame's bytes, including its header. Either the pre-allocated frame blob or a frame inside the pre-loaded sequence blob.
+ */
+static bool _read_vol_frame( const vol_geom_info_t* info_ptr, int frame_idx, uint8_t* frame_blob_ptr, vol_geom_frame_data_t* frame_data_ptr ) {
+  assert( info_ptr && frame_blob_ptr && frame_data_ptr );
+  if ( !info_ptr || !frame_blob_ptr || !frame_data_ptr ) { return false; }
   if ( frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count ) { return false; }
 
   *frame_data_ptr = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
 
-  uint8_t* byte_blob_ptr         = (uint8_t*)info_ptr->preallocated_frame_blob_ptr;
-  frame_data_ptr->block_data_ptr = &byte_blob_ptr[info_ptr->frames_directory_ptr[frame_idx].hdr_sz];
+  frame_data_ptr->block_data_ptr = &frame_blob_ptr[info_ptr->frames_directory_ptr[frame_idx].hdr_sz];
   frame_data_ptr->block_data_sz  = info_ptr->frames_directory_ptr[frame_idx].corrected_payload_sz;
 
+  // The table was validated when it was made, from the v13 frame directory or by vol_geom_resolve_frame_sections(), so the arrays are where it says.
+  if ( info_ptr->frame_sections_ptr ) {
+    const vol_geom_frame_sections_t* sec_ptr = &info_ptr->frame_sections_ptr[frame_idx];
+    frame_data_ptr->vertices_offset          = sec_ptr->vertices_offset;
+    frame_data_ptr->vertices_sz              = (int32_t)sec_ptr->vertices_sz;
+    frame_data_ptr->normals_offset           = sec_ptr->normals_offset;
+    frame_data_ptr->normals_sz               = (int32_t)sec_ptr->normals_sz;
+    frame_data_ptr->indices_offset           = sec_ptr->indices_offset;
+    frame_data_ptr->indices_sz               = (int32_t)sec_ptr->indices_sz;
+    frame_data_ptr->uvs_offset               = sec_ptr->uvs_offset;
+    frame_data_ptr->uvs_sz                   = (int32_t)sec_ptr->uvs_sz;
+    frame_data_ptr->texture_offset           = sec_ptr->texture_offset;
+    frame_data_ptr->texture_sz               = (int32_t)sec_ptr->texture_sz;
+    return true;
+  }
+
   {
     // start within the frame's memory but after its frame header and at the start of mesh data
     vol_geom_size_t curr_offset = 0;
@@ -292,10 +1429,12 @@ static bool _read_vol_frame( const vol_geom_info_t* info_ptr, int frame_idx, vol
   return true;
 }
 
-bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
-  assert( seq_filename && info_ptr && frame_data_ptr );
-  if ( !seq_filename || !info_ptr || !frame_data_ptr ) { return false; }
-
+/** Helper function to get a frame's bytes, from the pre-loaded sequence blob or from the sequence file.
+ * @param in_place       If set, and the sequence was pre-loaded, point straight into the sequence blob instead of copying into the pre-allocated frame blob.
+ * @param frame_blob_ptr Set to the start of the frame's bytes, including its header.
+ * @return               False on any error.
+ */
+static bool _fetch_frame_blob( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, bool in_place, uint8_t** frame_blob_ptr ) {
   if ( frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame requested (%i) is not in valid range of 0-%i for sequence\n", frame_idx, info_ptr->hdr.frame_count );
     return false;
@@ -305,64 +1444,210 @@ bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_
   vol_geom_size_t offset_sz = info_ptr->frames_directory_ptr[frame_idx].offset_sz;
   vol_geom_size_t total_sz  = info_ptr->frames_directory_ptr[frame_idx].total_sz;
 
-  // Get file size and check for file size issues before allocating memory or reading
-  vol_geom_size_t file_sz = 0;
-  if ( !_get_file_sz( seq_filename, &file_sz ) ) {
+  if ( info_ptr->biggest_frame_blob_sz < total_sz ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: pre-allocated frame blob was too small for frame %i: %" PRId64 "/%" PRId64 " bytes.\n", frame_idx,
+      info_ptr->biggest_frame_blob_sz, total_sz );
+    return false;
+  }
+
+  *frame_blob_ptr = info_ptr->preallocated_frame_blob_ptr;
+
+  // Find frame section within sequence file blob if it was pre-loaded. A progressive pre-load may not have reached it yet, so then read from file.
+  bool in_memory = frame_idx < vol_geom_get_frames_in_memory( info_ptr ) && ( offset_sz + total_sz ) <= info_ptr->sequence_blob_sz;
+  if ( in_memory && in_place ) {
+    *frame_blob_ptr = &info_ptr->sequence_blob_byte_ptr[offset_sz];
+    return true;
+  } else if ( in_memory ) {
+    memcpy( info_ptr->preallocated_frame_blob_ptr, &info_ptr->sequence_blob_byte_ptr[offset_sz], total_sz );
+    return true;
+  } else if ( info_ptr->compressed_seq_ptr ) {
+    return _fetch_compressed_frame( info_ptr, frame_idx );
+  }
+
+#ifdef VOL_GEOM_HAS_IO_URING
+  if ( info_ptr->uring_readahead_ptr ) { return _uring_fetch_frame( info_ptr, frame_idx, in_place, frame_blob_ptr ); }
+#endif
+
+  // Read frame blob from file. Check for file size issues before reading.
+  const vol_geom_io_t* io_ptr = _get_io( info_ptr );
+  vol_geom_size_t file_sz     = 0;
+  void* handle_ptr            = _io_open_sized( io_ptr, seq_filename, &file_sz );
+  if ( !handle_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file `%s` could not be opened.\n", seq_filename );
     return false;
   }
   if ( file_sz < ( offset_sz + total_sz ) ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file is too short to contain frame %i data.\n", frame_idx );
+    io_ptr->close_fn( handle_ptr );
+    return false;
+  }
+  if ( !io_ptr->read_at_fn( handle_ptr, offset_sz, info_ptr->preallocated_frame_blob_ptr, total_sz ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", frame_idx );
+    io_ptr->close_fn( handle_ptr );
     return false;
   }
+  io_ptr->close_fn( handle_ptr );
 
-  if ( info_ptr->biggest_frame_blob_sz < total_sz ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: pre-allocated frame blob was too small for frame %i: %" PRId64 "/%" PRId64 " bytes.\n", frame_idx,
-      info_ptr->biggest_frame_blob_sz, total_sz );
+  return true;
+}
+
+bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
+  assert( seq_filename && info_ptr && frame_data_ptr );
+  if ( !seq_filename || !info_ptr || !frame_data_ptr ) { return false; }
+
+  uint8_t* frame_blob_ptr = NULL;
+  if ( !_fetch_frame_blob( seq_filename, info_ptr, frame_idx, false, &frame_blob_ptr ) ) { return false; }
+  if ( !_read_vol_frame( info_ptr, frame_idx, frame_blob_ptr, frame_data_ptr ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
     return false;
   }
+  return true;
+}
 
-  // Find frame section within sequence file blob if it was pre-loaded.
-  if ( info_ptr->sequence_blob_byte_ptr ) {
-    memcpy( info_ptr->preallocated_frame_blob_ptr, &info_ptr->sequence_blob_byte_ptr[offset_sz], total_sz );
+/** Helper function to copy one of a frame's attribute arrays into a caller's buffer.
+ * @return False if the buffer is too small. A NULL buffer is skipped, and the array's size is still reported.
+ */
+static bool _copy_attrib( const vol_geom_frame_data_t* frame_data_ptr, vol_geom_size_t offset, int32_t sz, vol_geom_attrib_t* attrib_ptr, int frame_idx ) {
+  attrib_ptr->sz = sz;
+  if ( !attrib_ptr->ptr ) { return true; }
+  if ( sz > attrib_ptr->capacity ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i has a %i byte attribute array, but its output buffer holds %i bytes\n", frame_idx, sz,
+      attrib_ptr->capacity );
+    return false;
+  }
+  memcpy( attrib_ptr->ptr, &frame_data_ptr->block_data_ptr[offset], (size_t)sz );
+  return true;
+}
 
-    // Read frame blob from file.
-  } else {
-    FILE* f_ptr = fopen( seq_filename, "rb" );
-    if ( !f_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR could not open file `%s` for frame data.\n", seq_filename );
-      return false;
-    }
-    if ( 0 != vol_geom_fseeko( f_ptr, offset_sz, SEEK_SET ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR seeking frame %i from sequence file - file too small for data\n", frame_idx );
-      fclose( f_ptr );
-      return false;
+bool vol_geom_read_frame_attribs( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_attrib_buffers_t* buffers_ptr ) {
+  assert( seq_filename && info_ptr && buffers_ptr );
+  if ( !seq_filename || !info_ptr || !buffers_ptr ) { return false; }
+
+  buffers_ptr->changed = 0;
+  // A pre-loaded frame is parsed where it is, so the attributes are only copied once, into the caller's buffers.
+  uint8_t* frame_blob_ptr           = NULL;
+  vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+  if ( !_fetch_frame_blob( seq_filename, info_ptr, frame_idx, true, &frame_blob_ptr ) ) { return false; }
+  if ( !_read_vol_frame( info_ptr, frame_idx, frame_blob_ptr, &frame_data ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
+    return false;
+  }
+
+  if ( !_copy_attrib( &frame_data, frame_data.vertices_offset, frame_data.vertices_sz, &buffers_ptr->vertices, frame_idx ) ) { return false; }
+  buffers_ptr->changed |= VOL_GEOM_ATTRIB_VERTICES;
+  if ( info_ptr->hdr.normals && info_ptr->hdr.version >= 11 ) {
+    if ( !_copy_attrib( &frame_data, frame_data.normals_offset, frame_data.normals_sz, &buffers_ptr->normals, frame_idx ) ) { return false; }
+    buffers_ptr->changed |= VOL_GEOM_ATTRIB_NORMALS;
+  }
+  // Only keyframes carry indices and UVs. Tracked frames reuse the ones already in the buffers.
+  if ( info_ptr->frame_headers_ptr[frame_idx].keyframe == 1 || ( info_ptr->hdr.version >= 12 && info_ptr->frame_headers_ptr[frame_idx].keyframe == 2 ) ) {
+    if ( !_copy_attrib( &frame_data, frame_data.indices_offset, frame_data.indices_sz, &buffers_ptr->indices, frame_idx ) ) { return false; }
+    if ( !_copy_attrib( &frame_data, frame_data.uvs_offset, frame_data.uvs_sz, &buffers_ptr->uvs, frame_idx ) ) { return false; }
+    buffers_ptr->changed |= VOL_GEOM_ATTRIB_INDICES | VOL_GEOM_ATTRIB_UVS;
+  }
+  return true;
+}
+
+/** Helper function to allocate the frame blob that frames are read into, once the directory's biggest frame is known.
+ * @return False on any error.
+ */
+static bool _preallocate_frame_blob( vol_geom_info_t* info_ptr, int biggest_frame_idx ) {
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating preallocated_frame_blob_ptr bytes %" PRId64 " (frame %i)\n", info_ptr->biggest_frame_blob_sz, biggest_frame_idx );
+  if ( info_ptr->biggest_frame_blob_sz >= 1024 * 1024 * 1024 ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: extremely high frame size %" PRId64 " reported - assuming error.\n", info_ptr->biggest_frame_blob_sz );
+    return false;
+  }
+  info_ptr->preallocated_frame_blob_ptr = calloc( 1, info_ptr->biggest_frame_blob_sz > 0 ? (size_t)info_ptr->biggest_frame_blob_sz : 1 );
+  if ( !info_ptr->preallocated_frame_blob_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating frame blob reserve.\n" );
+    return false;
+  }
+  return true;
+}
+
+/** Helper function to load the sequence file into `sequence_blob_byte_ptr` as `load_mode` asks, once the directory is built.
+ * @return False on any error. Anything already loaded is freed by `vol_geom_free_file_info()`.
+ */
+static bool _load_sequence( const char* seq_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode ) {
+  vol_geom_load_mode_t requested_mode = load_mode;
+  if ( VOL_GEOM_LOAD_AUTO == load_mode ) { load_mode = _choose_load_mode( info_ptr ); }
+  const vol_geom_io_t* io_ptr = _get_io( info_ptr );
+
+  // If not dealing with huge sequence files - preload the whole thing to memory to avoid file i/o problems.
+  // A backend that can map the file gives the whole sequence in memory straight away, so there is nothing to read.
+  // If a file on disk can't be mapped, it is streamed instead.
+  if ( VOL_GEOM_LOAD_MAPPED == load_mode || ( VOL_GEOM_LOAD_STREAMING != load_mode && io_ptr->map_fn ) ) {
+    if ( _map_sequence( seq_filename, info_ptr ) || VOL_GEOM_LOAD_MAPPED == load_mode ) { return true; }
+  }
+  if ( VOL_GEOM_LOAD_PROGRESSIVE == load_mode ) {
+    if ( !_start_progressive_preload( seq_filename, info_ptr ) ) { return false; }
+  } else if ( VOL_GEOM_LOAD_PRELOAD == load_mode ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Reading entire sequence file to blob memory\n" );
+    vol_geom_file_record_t seq_blob = ( vol_geom_file_record_t ){ .sz = 0 };
+    if ( !_read_entire_file( io_ptr, seq_filename, &seq_blob ) ) {
+        _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to read entire file.\n");
+        return false;
     }
-    if ( !fread( info_ptr->preallocated_frame_blob_ptr, total_sz, 1, f_ptr ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", frame_idx );
-      fclose( f_ptr );
-      return false;
+    info_ptr->sequence_blob_byte_ptr = (uint8_t*)seq_blob.byte_ptr;
+    info_ptr->sequence_blob_sz       = seq_blob.sz;
+    _track_resident_sz( seq_blob.sz );
+  } else if ( VOL_GEOM_LOAD_PRELOAD_COMPRESSED == load_mode ) {
+    if ( !_load_compressed_sequence( seq_filename, info_ptr ) ) { return false; }
+    // The compression ratio was a guess. If it was too hopeful the sequence is mapped instead, to stay within the budget.
+    vol_geom_size_t budget_sz = _atomic_load_i64( &_memory_budget_sz );
+    if ( VOL_GEOM_LOAD_AUTO == requested_mode && budget_sz > 0 && _atomic_load_i64( &_resident_sz ) > budget_sz && !info_ptr->io.open_fn ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Compressed sequence is over the memory budget, mapping it instead\n" );
+      _release_sequence( info_ptr );
+      _map_sequence( seq_filename, info_ptr );
     }
-    fclose( f_ptr );
-  } // end FILE i/o block
+  }
+  return true;
+}
 
-  if ( !_read_vol_frame( info_ptr, frame_idx, frame_data_ptr ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
+/** Helper function to allocate the buffer frames of a compressed sequence are decompressed into, if it isn't already.
+ * @return False if out of memory.
+ */
+static bool _alloc_frame_scratch( vol_geom_info_t* info_ptr ) {
+  if ( info_ptr->compressed_frame_scratch_ptr ) { return true; }
+  info_ptr->compressed_frame_scratch_ptr = malloc( info_ptr->biggest_frame_blob_sz > 0 ? (size_t)info_ptr->biggest_frame_blob_sz : 1 );
+  if ( !info_ptr->compressed_frame_scratch_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating compressed frame scratch.\n" );
     return false;
   }
   return true;
 }
 
+/** Helper function to allocate the decompression scratch if the sequence is compressed, or free it if not.
+ * @return False if out of memory.
+ */
+static bool _update_frame_scratch( vol_geom_info_t* info_ptr ) {
+  if ( info_ptr->compressed_seq_ptr ) { return _alloc_frame_scratch( info_ptr ); }
+  free( info_ptr->compressed_frame_scratch_ptr );
+  info_ptr->compressed_frame_scratch_ptr = NULL;
+  return true;
+}
+
 bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode ) {
+  return vol_geom_create_file_info_ex( hdr_filename, seq_filename, info_ptr, streaming_mode ? VOL_GEOM_LOAD_STREAMING : VOL_GEOM_LOAD_PRELOAD );
+}
+
+bool vol_geom_create_file_info_ex( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode ) {
+  return vol_geom_create_file_info_io( hdr_filename, seq_filename, NULL, info_ptr, load_mode );
+}
+
+bool vol_geom_create_file_info_io(
+  const char* hdr_filename, const char* seq_filename, const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode ) {
   if ( !hdr_filename || !seq_filename || !info_ptr ) { return false; }
 
-  FILE* f_ptr = NULL; // this is checked later so declare & init up top.
+  void* seq_handle_ptr = NULL; // this is checked later so declare & init up top.
   // Read file header.
   vol_geom_file_record_t record = ( vol_geom_file_record_t ){ .sz = 0 };
   vol_geom_size_t hdr_sz        = 0;
   *info_ptr                     = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 }; // zero in case of struct re-use.
+  if ( io_ptr ) { info_ptr->io = *io_ptr; }
+  io_ptr = _get_io( info_ptr );
   {
-    if ( !_read_entire_file( hdr_filename, &record ) ) {
+    if ( !_read_entire_file( io_ptr, hdr_filename, &record ) ) {
         _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to read entire file header.\n");
         goto failed_to_read_info;
     }
@@ -371,30 +1656,33 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         goto failed_to_read_info;
     }
 
-    // done with file record so tidy-up memory
-    if ( record.byte_ptr != NULL ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing record.byte_ptr\n" );
-      free( record.byte_ptr );
-      record.byte_ptr = NULL; // this is checked later, so make = NULL
-    }
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "hdr sz was %" PRId64 ". %" PRId64 " bytes in file\n", hdr_sz, record.sz );
   }
 
   { // allocate memory for frame headers and frames directory
     vol_geom_size_t frame_headers_sz = info_ptr->hdr.frame_count * sizeof( vol_geom_frame_hdr_t );
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for frame headers.\n", frame_headers_sz );
-    info_ptr->frame_headers_ptr = calloc( 1, (size_t)frame_headers_sz );
+    // One spare entry, so a sequence with no frames doesn't call calloc() for 0 bytes, which may return NULL.
+    info_ptr->frame_headers_ptr = calloc( (size_t)info_ptr->hdr.frame_count + 1, sizeof( vol_geom_frame_hdr_t ) );
     if ( !info_ptr->frame_headers_ptr ) {
       _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames headers\n" );
-      return false;
+      goto failed_to_read_info;
     }
 
     vol_geom_size_t frames_directory_sz = info_ptr->hdr.frame_count * sizeof( vol_geom_frame_directory_entry_t );
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for frames directory.\n", frames_directory_sz );
-    info_ptr->frames_directory_ptr = calloc( 1, (size_t)frames_directory_sz );
+    info_ptr->frames_directory_ptr = calloc( (size_t)info_ptr->hdr.frame_count + 1, sizeof( vol_geom_frame_directory_entry_t ) );
     if ( !info_ptr->frames_directory_ptr ) {
       _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames directory\n" );
-      return false;
+      goto failed_to_read_info;
+    }
+
+    if ( VOL_GEOM_V13_VERSION == info_ptr->hdr.version ) {
+      info_ptr->frame_sections_ptr = calloc( (size_t)info_ptr->hdr.frame_count + 1, sizeof( vol_geom_frame_sections_t ) );
+      if ( !info_ptr->frame_sections_ptr ) {
+        _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frame sections\n" );
+        goto failed_to_read_info;
+      }
     }
   }
 
@@ -402,28 +1690,34 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
   int biggest_frame_idx           = -1;
 
   // find out the size and offset of every frame
-  { // fetch frame from sequence file
+  if ( VOL_GEOM_V13_VERSION == info_ptr->hdr.version ) {
+    // v13 keeps its frame directory in the header file, so the sequence file is only opened to check that the frames fit in it.
     vol_geom_size_t sequence_file_sz = 0;
-    if ( !_get_file_sz( seq_filename, &sequence_file_sz ) ) {
+    seq_handle_ptr                   = _io_open_sized( io_ptr, seq_filename, &sequence_file_sz );
+    if ( !seq_handle_ptr ) {
         _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to get sequence file %s size.\n", seq_filename);
         goto failed_to_read_info;
     }
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Sequence file is %" PRId64 " bytes\n", sequence_file_sz );
-
-    f_ptr = fopen( seq_filename, "rb" );
-    if ( !f_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Could not open file `%s`\n", seq_filename );
-      goto failed_to_read_info;
+    io_ptr->close_fn( seq_handle_ptr );
+    seq_handle_ptr = NULL;
+    if ( !_read_v13_directory( &record, sequence_file_sz, info_ptr, &biggest_frame_idx ) ) { goto failed_to_read_info; }
+  } else { // fetch frame from sequence file
+    vol_geom_size_t sequence_file_sz = 0;
+    seq_handle_ptr                   = _io_open_sized( io_ptr, seq_filename, &sequence_file_sz );
+    if ( !seq_handle_ptr ) {
+        _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to get sequence file %s size.\n", seq_filename);
+        goto failed_to_read_info;
     }
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Sequence file is %" PRId64 " bytes\n", sequence_file_sz );
 
-    // loop to get each frame's details
+    // loop to get each frame's details. Frames are stored back-to-back, so only their headers are read, at this running offset.
+    vol_geom_size_t frame_current_offset = 0;
     for ( int32_t i = 0; i < info_ptr->hdr.frame_count; i++ ) {
       vol_geom_frame_hdr_t frame_hdr = ( vol_geom_frame_hdr_t ){ .mesh_data_sz = 0 };
 
-      vol_geom_size_t frame_start_offset = vol_geom_ftello( f_ptr );
-      if ( -1LL == frame_start_offset ) { goto failed_to_read_info; }
+      vol_geom_size_t frame_start_offset = frame_current_offset;
 
-      if ( !fread( &frame_hdr.frame_number, sizeof( int32_t ), 1, f_ptr ) ) {
+      if ( !io_ptr->read_at_fn( seq_handle_ptr, frame_current_offset, &frame_hdr.frame_number, sizeof( int32_t ) ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number at frame %i in sequence file was out of file size range\n", i );
         goto failed_to_read_info;
       }
@@ -431,7 +1725,8 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number was %i at frame %i in sequence file\n", frame_hdr.frame_number, i );
         goto failed_to_read_info;
       }
-      if ( !fread( &frame_hdr.mesh_data_sz, sizeof( int32_t ), 1, f_ptr ) ) {
+      frame_current_offset += sizeof( int32_t );
+      if ( !io_ptr->read_at_fn( seq_handle_ptr, frame_current_offset, &frame_hdr.mesh_data_sz, sizeof( int32_t ) ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: mesh_data_sz %i was out of file size range in sequence file\n", frame_hdr.mesh_data_sz );
         goto failed_to_read_info;
       }
@@ -440,16 +1735,12 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
           frame_hdr.mesh_data_sz, sequence_file_sz );
         goto failed_to_read_info;
       }
-      if ( !fread( &frame_hdr.keyframe, sizeof( uint8_t ), 1, f_ptr ) ) {
+      frame_current_offset += sizeof( int32_t );
+      if ( !io_ptr->read_at_fn( seq_handle_ptr, frame_current_offset, &frame_hdr.keyframe, sizeof( uint8_t ) ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: keyframe (type) was out of file size range in sequence file\n" );
         goto failed_to_read_info;
       }
-
-      vol_geom_size_t frame_current_offset = vol_geom_ftello( f_ptr );
-      if ( -1LL == frame_current_offset ) {
-          _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to retrieve correct file offset (1).\n");
-          goto failed_to_read_info;
-      }
+      frame_current_offset += sizeof( uint8_t );
     
       info_ptr->frames_directory_ptr[i].hdr_sz = (vol_geom_size_t)frame_current_offset - (vol_geom_size_t)frame_start_offset;
 
@@ -474,16 +1765,8 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         goto failed_to_read_info;
       }
 
-      // seek past mesh data and past the final integer "frame data size". see if file is big enough
-      if ( 0 != vol_geom_fseeko( f_ptr, info_ptr->frames_directory_ptr[i].corrected_payload_sz + 4, SEEK_CUR ) ) {
-        _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: not enough memory in sequence file for frame %i contents\n", i );
-        goto failed_to_read_info;
-      }
-      frame_current_offset = vol_geom_ftello( f_ptr );
-      if ( -1LL == frame_current_offset ) {
-          _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to retrieve correct file offset (2).\n");
-          goto failed_to_read_info;
-      }
+      // skip past mesh data and past the final integer "frame data size". reading a frame checks that the file is big enough for it
+      frame_current_offset += info_ptr->frames_directory_ptr[i].corrected_payload_sz + 4;
 
       // update frame directory and store frame header
       info_ptr->frames_directory_ptr[i].offset_sz = (vol_geom_size_t)frame_start_offset;
@@ -500,38 +1783,26 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         biggest_frame_idx               = i;
       }
     }
-    fclose( f_ptr );
-    f_ptr = NULL; // this is checked later, so make = NULL
+    io_ptr->close_fn( seq_handle_ptr );
+    seq_handle_ptr = NULL; // this is checked later, so make = NULL
   }
 
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating preallocated_frame_blob_ptr bytes %" PRId64 " (frame %i)\n", info_ptr->biggest_frame_blob_sz, biggest_frame_idx );
-  if ( info_ptr->biggest_frame_blob_sz >= 1024 * 1024 * 1024 ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: extremely high frame size %" PRId64 " reported - assuming error.\n", info_ptr->biggest_frame_blob_sz );
-    goto failed_to_read_info;
-  }
-  info_ptr->preallocated_frame_blob_ptr = calloc( 1, info_ptr->biggest_frame_blob_sz );
-  if ( !info_ptr->preallocated_frame_blob_ptr ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating frame blob reserve.\n" );
-    goto failed_to_read_info;
+  // done with file record so tidy-up memory
+  if ( record.byte_ptr != NULL ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing record.byte_ptr\n" );
+    free( record.byte_ptr );
+    record.byte_ptr = NULL; // this is checked later, so make = NULL
   }
 
-  // If not dealing with huge sequence files - preload the whole thing to memory to avoid file i/o problems.
-  if ( !streaming_mode ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Reading entire sequence file to blob memory\n" );
-    vol_geom_file_record_t seq_blob = ( vol_geom_file_record_t ){ .sz = 0 };
-    if ( !_read_entire_file( seq_filename, &seq_blob ) ) {
-        _vol_loggerf(VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to read entire file.\n");
-        goto failed_to_read_info;
-    }
-    info_ptr->sequence_blob_byte_ptr = (uint8_t*)seq_blob.byte_ptr;
-  }
+  if ( !_preallocate_frame_blob( info_ptr, biggest_frame_idx ) ) { goto failed_to_read_info; }
+  if ( !_load_sequence( seq_filename, info_ptr, load_mode ) || !_update_frame_scratch( info_ptr ) ) { goto failed_to_read_info; }
 
   return true;
 
 failed_to_read_info:
 
   _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to parse info from vologram geometry files.\n" );
-  if ( f_ptr ) { fclose( f_ptr ); }
+  if ( seq_handle_ptr ) { io_ptr->close_fn( seq_handle_ptr ); }
   if ( record.byte_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing record.byte_ptr\n" );
     free( record.byte_ptr );
@@ -541,14 +1812,519 @@ failed_to_read_info:
   return false;
 }
 
+/******************************************************************************
+  PACKED VOLOGRAMS
+******************************************************************************/
+
+/** Helper function to check that a section of a packed vologram lies within the file. */
+static bool _pack_section_valid( uint64_t offset, uint64_t sz, vol_geom_size_t file_sz ) {
+  return offset <= (uint64_t)file_sz && sz <= (uint64_t)file_sz - offset;
+}
+
+bool vol_geom_create_packed_file_info( const char* pack_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode ) {
+  if ( !pack_filename || !info_ptr ) { return false; }
+
+  vol_geom_file_record_t record       = ( vol_geom_file_record_t ){ .sz = 0 };
+  vol_geom_pack_entry_t* entries_ptr = NULL;
+  *info_ptr                           = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 }; // zero in case of struct re-use.
+  info_ptr->io                        = _mapped_file_io;
+  const vol_geom_io_t* io_ptr         = &info_ptr->io;
+  vol_geom_pack_hdr_t* pack_hdr_ptr   = &info_ptr->pack_hdr;
+
+  vol_geom_size_t pack_sz = 0;
+  void* pack_handle_ptr   = _io_open_sized( io_ptr, pack_filename, &pack_sz );
+  if ( !pack_handle_ptr ) { goto failed_to_read_pack; }
+  if ( pack_sz < (vol_geom_size_t)sizeof( vol_geom_pack_hdr_t ) || !io_ptr->read_at_fn( pack_handle_ptr, 0, pack_hdr_ptr, sizeof( vol_geom_pack_hdr_t ) ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: file `%s` is too short to be a packed vologram.\n", pack_filename );
+    goto failed_to_read_pack;
+  }
+  if ( 0 != memcmp( pack_hdr_ptr->magic, VOL_GEOM_PACK_MAGIC, sizeof( pack_hdr_ptr->magic ) ) || VOL_GEOM_PACK_VERSION != pack_hdr_ptr->version ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: file `%s` is not a version %i packed vologram.\n", pack_filename, VOL_GEOM_PACK_VERSION );
+    goto failed_to_read_pack;
+  }
+  if ( pack_hdr_ptr->hdr_sz < VOL_GEOM_FILE_HDR_V10_MIN_SZ || !_pack_section_valid( pack_hdr_ptr->hdr_offset, pack_hdr_ptr->hdr_sz, pack_sz ) ||
+       !_pack_section_valid( pack_hdr_ptr->directory_offset, (uint64_t)pack_hdr_ptr->frame_count * sizeof( vol_geom_pack_entry_t ), pack_sz ) ||
+       !_pack_section_valid( pack_hdr_ptr->video_offset, pack_hdr_ptr->video_sz, pack_sz ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: packed vologram sections are outside of its %" PRId64 " bytes.\n", pack_sz );
+    goto failed_to_read_pack;
+  }
+
+  { // The header section is parsed as if it were the header file.
+    record.sz       = (vol_geom_size_t)pack_hdr_ptr->hdr_sz;
+    record.byte_ptr = malloc( (size_t)record.sz );
+    if ( !record.byte_ptr ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating packed vologram header\n" );
+      goto failed_to_read_pack;
+    }
+    vol_geom_size_t hdr_sz = 0;
+    if ( !io_ptr->read_at_fn( pack_handle_ptr, (vol_geom_size_t)pack_hdr_ptr->hdr_offset, record.byte_ptr, record.sz ) ||
+         !_read_vol_file_hdr( &record, &info_ptr->hdr, &hdr_sz ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to read vol file header.\n" );
+      goto failed_to_read_pack;
+    }
+    free( record.byte_ptr );
+    record.byte_ptr = NULL;
+    if ( VOL_GEOM_V13_VERSION == info_ptr->hdr.version ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: packed volograms hold v10-v12 frames, but the header is v13.\n" );
+      goto failed_to_read_pack;
+    }
+    if ( info_ptr->hdr.frame_count < 0 || (uint32_t)info_ptr->hdr.frame_count != pack_hdr_ptr->frame_count ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: header has %i frames, but the packed frame directory has %u.\n", info_ptr->hdr.frame_count,
+        (unsigned)pack_hdr_ptr->frame_count );
+      goto failed_to_read_pack;
+    }
+  }
+
+  { // allocate memory for frame headers and frames directory, and read the packed directory in one go.
+    int32_t frame_count            = info_ptr->hdr.frame_count;
+    info_ptr->frame_headers_ptr    = calloc( (size_t)frame_count + 1, sizeof( vol_geom_frame_hdr_t ) );
+    info_ptr->frames_directory_ptr = calloc( (size_t)frame_count + 1, sizeof( vol_geom_frame_directory_entry_t ) );
+    entries_ptr                    = malloc( ( (size_t)frame_count + 1 ) * sizeof( vol_geom_pack_entry_t ) );
+    if ( !info_ptr->frame_headers_ptr || !info_ptr->frames_directory_ptr || !entries_ptr ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames directory\n" );
+      goto failed_to_read_pack;
+    }
+    if ( !io_ptr->read_at_fn( pack_handle_ptr, (vol_geom_size_t)pack_hdr_ptr->directory_offset, entries_ptr, (vol_geom_size_t)frame_count * sizeof( vol_geom_pack_entry_t ) ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: failed to read packed frame directory.\n" );
+      goto failed_to_read_pack;
+    }
+  }
+  io_ptr->close_fn( pack_handle_ptr );
+  pack_handle_ptr = NULL;
+
+  int biggest_frame_idx = -1;
+  for ( int32_t i = 0; i < info_ptr->hdr.frame_count; i++ ) {
+    const vol_geom_pack_entry_t* entry_ptr = &entries_ptr[i];
+    // Frames have a 9 byte header and 4 byte trailing size around their mesh data. That and the alignment is all that is checked before reading one.
+    const vol_geom_size_t frame_hdr_sz = (vol_geom_size_t)( sizeof( int32_t ) * 2 + sizeof( uint8_t ) );
+    if ( entry_ptr->sz < (uint64_t)frame_hdr_sz + 4 || 0 != entry_ptr->offset % VOL_GEOM_PACK_ALIGN ||
+         !_pack_section_valid( entry_ptr->offset, entry_ptr->sz, pack_sz ) || entry_ptr->mesh_data_sz < 0 ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: packed frame %i at %" PRIu64 " of %" PRIu64 " bytes is invalid.\n", i, entry_ptr->offset, entry_ptr->sz );
+      goto failed_to_read_pack;
+    }
+    info_ptr->frames_directory_ptr[i] = ( vol_geom_frame_directory_entry_t ){ .offset_sz = (vol_geom_size_t)entry_ptr->offset,
+      .total_sz                                                                    = (vol_geom_size_t)entry_ptr->sz,
+      .hdr_sz                                                                      = frame_hdr_sz,
+      .corrected_payload_sz                                                        = (vol_geom_size_t)entry_ptr->sz - frame_hdr_sz - 4 };
+    info_ptr->frame_headers_ptr[i] = ( vol_geom_frame_hdr_t ){ .frame_number = i, .mesh_data_sz = entry_ptr->mesh_data_sz, .keyframe = entry_ptr->keyframe };
+    if ( info_ptr->frames_directory_ptr[i].total_sz > info_ptr->biggest_frame_blob_sz ) {
+      info_ptr->biggest_frame_blob_sz = info_ptr->frames_directory_ptr[i].total_sz;
+      biggest_frame_idx               = i;
+    }
+  }
+  free( entries_ptr );
+  entries_ptr = NULL;
+
+  if ( !_preallocate_frame_blob( info_ptr, biggest_frame_idx ) ) { goto failed_to_read_pack; }
+  if ( !_load_sequence( pack_filename, info_ptr, load_mode ) ) { goto failed_to_read_pack; }
+
+  return true;
+
+failed_to_read_pack:
+
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to parse info from packed vologram `%s`.\n", pack_filename );
+  if ( pack_handle_ptr ) { io_ptr->close_fn( pack_handle_ptr ); }
+  free( record.byte_ptr );
+  free( entries_ptr );
+  vol_geom_free_file_info( info_ptr );
+
+  return false;
+}
+
+/******************************************************************************
+  SHARED SEQUENCES
+******************************************************************************/
+
+/// A sequence opened by `vol_geom_create_shared_file_info()`, shared by every instance opened from the same files.
+typedef struct vol_geom_shared_seq_t {
+  char* hdr_filename;
+  char* seq_filename;
+  /// Size and modification time of the sequence file, so a changed file on disk isn't matched to an old entry.
+  vol_geom_size_t seq_sz;
+  int64_t seq_mtime;
+  /// Number of `vol_geom_info_t` using this entry.
+  int ref_count;
+  /// Header, directory, frame headers, and sequence blob shared by the instances. It has no frame blob of its own.
+  vol_geom_info_t info;
+  struct vol_geom_shared_seq_t* next_ptr;
+} vol_geom_shared_seq_t;
+
+/// Registry of shared sequences. Only accessed with `_shared_seqs_lock` held.
+static vol_geom_shared_seq_t* _shared_seqs_ptr;
+static vol_mutex_t _shared_seqs_lock = VOL_MUTEX_INITIALIZER;
+
+static void _shared_seqs_lock_acquire( void ) { _mutex_lock( &_shared_seqs_lock ); }
+
+static void _shared_seqs_lock_release( void ) { _mutex_unlock( &_shared_seqs_lock ); }
+
+/** Helper function to get the size and modification time of a file, which identify its contents for the registry. */
+static bool _get_file_identity( const char* filename, vol_geom_size_t* sz_ptr, int64_t* mtime_ptr ) {
+  struct vol_geom_stat64_t stbuf;
+  if ( 0 != vol_geom_stat64( filename, &stbuf ) ) { return false; }
+  *sz_ptr    = stbuf.st_size;
+  *mtime_ptr = (int64_t)stbuf.st_mtime;
+  return true;
+}
+
+static char* _copy_str( const char* str ) {
+  size_t len    = strlen( str );
+  char* new_ptr = malloc( len + 1 );
+  if ( new_ptr ) { memcpy( new_ptr, str, len + 1 ); }
+  return new_ptr;
+}
+
+static void _free_shared_seq( vol_geom_shared_seq_t* seq_ptr ) {
+  vol_geom_free_file_info( &seq_ptr->info );
+  free( seq_ptr->hdr_filename );
+  free( seq_ptr->seq_filename );
+  free( seq_ptr );
+}
+
+bool vol_geom_create_shared_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode ) {
+  return vol_geom_create_shared_file_info_ex( hdr_filename, seq_filename, info_ptr, streaming_mode ? VOL_GEOM_LOAD_STREAMING : VOL_GEOM_LOAD_PRELOAD );
+}
+
+bool vol_geom_create_shared_file_info_ex( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode ) {
+  if ( !hdr_filename || !seq_filename || !info_ptr ) { return false; }
+
+  *info_ptr              = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 };
+  vol_geom_size_t seq_sz = 0;
+  int64_t seq_mtime      = 0;
+  if ( !_get_file_identity( seq_filename, &seq_sz, &seq_mtime ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to get sequence file %s size.\n", seq_filename );
+    return false;
+  }
+
+  // The lock is held while a new entry is parsed, so instances opened at the same time don't both parse and pre-load the sequence.
+  _shared_seqs_lock_acquire();
+  vol_geom_shared_seq_t* seq_ptr = _shared_seqs_ptr;
+  for ( ; seq_ptr; seq_ptr = seq_ptr->next_ptr ) {
+    if ( seq_ptr->seq_sz == seq_sz && seq_ptr->seq_mtime == seq_mtime && 0 == strcmp( seq_ptr->seq_filename, seq_filename ) &&
+         0 == strcmp( seq_ptr->hdr_filename, hdr_filename ) ) {
+      break;
+    }
+  }
+
+  if ( !seq_ptr ) {
+    seq_ptr = calloc( 1, sizeof( vol_geom_shared_seq_t ) );
+    if ( !seq_ptr ) { goto failed_shared_info; }
+    seq_ptr->hdr_filename = _copy_str( hdr_filename );
+    seq_ptr->seq_filename = _copy_str( seq_filename );
+    seq_ptr->seq_sz       = seq_sz;
+    seq_ptr->seq_mtime    = seq_mtime;
+    if ( !seq_ptr->hdr_filename || !seq_ptr->seq_filename || !vol_geom_create_file_info_ex( hdr_filename, seq_filename, &seq_ptr->info, load_mode ) ) {
+      free( seq_ptr->hdr_filename );
+      free( seq_ptr->seq_filename );
+      free( seq_ptr );
+      goto failed_shared_info;
+    }
+    // Only instances read frames, into their own frame blobs.
+    free( seq_ptr->info.preallocated_frame_blob_ptr );
+    free( seq_ptr->info.compressed_frame_scratch_ptr );
+    seq_ptr->info.preallocated_frame_blob_ptr  = NULL;
+    seq_ptr->info.compressed_frame_scratch_ptr = NULL;
+    seq_ptr->next_ptr                         = _shared_seqs_ptr;
+    _shared_seqs_ptr                          = seq_ptr;
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Added shared sequence `%s` to the registry\n", seq_filename );
+  } else if ( VOL_GEOM_LOAD_STREAMING != load_mode && !seq_ptr->info.sequence_blob_byte_ptr && !seq_ptr->info.compressed_seq_ptr ) {
+    // An earlier instance was streamed, so the sequence is loaded now, as this instance asks.
+    if ( !_load_sequence( seq_filename, &seq_ptr->info, load_mode ) ) { goto failed_shared_info; }
+  }
+
+  // Frames of a compressed sequence are decompressed by each instance, into its own scratch.
+  bool compressed                       = VOL_GEOM_LOAD_STREAMING != load_mode && seq_ptr->info.compressed_seq_ptr;
+  info_ptr->preallocated_frame_blob_ptr = calloc( 1, seq_ptr->info.biggest_frame_blob_sz > 0 ? (size_t)seq_ptr->info.biggest_frame_blob_sz : 1 );
+  if ( compressed ) { info_ptr->compressed_frame_scratch_ptr = malloc( seq_ptr->info.biggest_frame_blob_sz > 0 ? (size_t)seq_ptr->info.biggest_frame_blob_sz : 1 ); }
+  if ( !info_ptr->preallocated_frame_blob_ptr || ( compressed && !info_ptr->compressed_frame_scratch_ptr ) ) {
+    free( info_ptr->preallocated_frame_blob_ptr );
+    free( info_ptr->compressed_frame_scratch_ptr );
+    info_ptr->preallocated_frame_blob_ptr  = NULL;
+    info_ptr->compressed_frame_scratch_ptr = NULL;
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating frame blob reserve.\n" );
+    if ( 0 == seq_ptr->ref_count ) {
+      _shared_seqs_ptr = seq_ptr->next_ptr;
+      _free_shared_seq( seq_ptr );
+    }
+    goto failed_shared_info;
+  }
+  info_ptr->hdr                    = seq_ptr->info.hdr;
+  info_ptr->frames_directory_ptr   = seq_ptr->info.frames_directory_ptr;
+  info_ptr->frame_headers_ptr      = seq_ptr->info.frame_headers_ptr;
+  info_ptr->frame_sections_ptr     = seq_ptr->info.frame_sections_ptr;
+  info_ptr->biggest_frame_blob_sz  = seq_ptr->info.biggest_frame_blob_sz;
+  // Only the entry that started a progressive pre-load stops it, so instances just share its blob and watermark.
+  info_ptr->sequence_blob_byte_ptr  = VOL_GEOM_LOAD_STREAMING == load_mode ? NULL : seq_ptr->info.sequence_blob_byte_ptr;
+  info_ptr->sequence_blob_sz        = VOL_GEOM_LOAD_STREAMING == load_mode ? 0 : seq_ptr->info.sequence_blob_sz;
+  info_ptr->progressive_preload_ptr = VOL_GEOM_LOAD_STREAMING == load_mode ? NULL : seq_ptr->info.progressive_preload_ptr;
+  info_ptr->compressed_seq_ptr      = compressed ? seq_ptr->info.compressed_seq_ptr : NULL;
+  info_ptr->shared_seq_ptr         = seq_ptr;
+  seq_ptr->ref_count++;
+  _shared_seqs_lock_release();
+  return true;
+
+failed_shared_info:
+  _shared_seqs_lock_release();
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to open shared vologram geometry files.\n" );
+  return false;
+}
+
+/** Helper function for `vol_geom_free_file_info()` to let go of an instance's registry entry, freeing the entry if it was the last one using it. */
+static void _release_shared_seq( vol_geom_shared_seq_t* seq_ptr ) {
+  _shared_seqs_lock_acquire();
+  if ( --seq_ptr->ref_count > 0 ) {
+    _shared_seqs_lock_release();
+    return;
+  }
+  for ( vol_geom_shared_seq_t** link_ptr = &_shared_seqs_ptr; *link_ptr; link_ptr = &( *link_ptr )->next_ptr ) {
+    if ( *link_ptr == seq_ptr ) {
+      *link_ptr = seq_ptr->next_ptr;
+      break;
+    }
+  }
+  _shared_seqs_lock_release();
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing shared sequence `%s`\n", seq_ptr->seq_filename );
+  _free_shared_seq( seq_ptr );
+}
+
+/******************************************************************************
+  FRAME SECTIONS
+******************************************************************************/
+
+/// Where the section parsers read a frame's size prefixes from: the frame in memory, or the sequence file.
+typedef struct vol_geom_prefix_reader_t {
+  /// The frame's data, after its header, if it is in memory. Otherwise NULL.
+  const uint8_t* block_ptr;
+  const vol_geom_io_t* io_ptr;
+  void* handle_ptr;
+  /// Offset of the frame's data in the sequence file.
+  vol_geom_size_t file_offset;
+  /// Size of the frame's data. Every array must end within it.
+  vol_geom_size_t block_sz;
+} vol_geom_prefix_reader_t;
+
+/** Helper function for the section parsers to take the next size-prefixed array, at `*cursor_ptr` in the frame's data. */
+static bool _take_array( const vol_geom_prefix_reader_t* reader_ptr, vol_geom_size_t* cursor_ptr, uint32_t* offset_ptr, uint32_t* sz_ptr ) {
+  int32_t sz = 0;
+  if ( *cursor_ptr + (vol_geom_size_t)sizeof( int32_t ) > reader_ptr->block_sz ) { return false; }
+  if ( reader_ptr->block_ptr ) {
+    memcpy( &sz, &reader_ptr->block_ptr[*cursor_ptr], sizeof( int32_t ) );
+  } else if ( !reader_ptr->io_ptr->read_at_fn( reader_ptr->handle_ptr, reader_ptr->file_offset + *cursor_ptr, &sz, sizeof( int32_t ) ) ) {
+    return false;
+  }
+  *cursor_ptr += (vol_geom_size_t)sizeof( int32_t );
+  if ( sz < 0 || (vol_geom_size_t)sz > reader_ptr->block_sz - *cursor_ptr ) { return false; }
+  *offset_ptr = (uint32_t)*cursor_ptr;
+  *sz_ptr     = (uint32_t)sz;
+  *cursor_ptr += sz;
+  return true;
+}
+
+/// Parses a frame's arrays for one version of the format, given the header's normals and textured flags and the frame's keyframe type.
+typedef bool ( *vol_geom_section_parser_t )( const vol_geom_prefix_reader_t* reader_ptr, bool normals, bool textured, uint8_t keyframe, vol_geom_frame_sections_t* sec_ptr );
+
+/// v10: vertices, then indices and UVs on keyframes.
+static bool _parse_sections_v10( const vol_geom_prefix_reader_t* reader_ptr, bool normals, bool textured, uint8_t keyframe, vol_geom_frame_sections_t* sec_ptr ) {
+  (void)normals;
+  (void)textured;
+  vol_geom_size_t cursor = 0;
+  if ( !_take_array( reader_ptr, &cursor, &sec_ptr->vertices_offset, &sec_ptr->vertices_sz ) ) { return false; }
+  if ( 1 != keyframe ) { return true; }
+  return _take_array( reader_ptr, &cursor, &sec_ptr->indices_offset, &sec_ptr->indices_sz ) &&
+         _take_array( reader_ptr, &cursor, &sec_ptr->uvs_offset, &sec_ptr->uvs_sz );
+}
+
+/// v11: as v10, with optional normals after the vertices and an optional texture at the end.
+static bool _parse_sections_v11( const vol_geom_prefix_reader_t* reader_ptr, bool normals, bool textured, uint8_t keyframe, vol_geom_frame_sections_t* sec_ptr ) {
+  vol_geom_size_t cursor = 0;
+  if ( !_take_array( reader_ptr, &cursor, &sec_ptr->vertices_offset, &sec_ptr->vertices_sz ) ) { return false; }
+  if ( normals && !_take_array( reader_ptr, &cursor, &sec_ptr->normals_offset, &sec_ptr->normals_sz ) ) { return false; }
+  if ( 1 == keyframe && !( _take_array( reader_ptr, &cursor, &sec_ptr->indices_offset, &sec_ptr->indices_sz ) &&
+                           _take_array( reader_ptr, &cursor, &sec_ptr->uvs_offset, &sec_ptr->uvs_sz ) ) ) {
+    return false;
+  }
+  return !textured || _take_array( reader_ptr, &cursor, &sec_ptr->texture_offset, &sec_ptr->texture_sz );
+}
+
+/// v12: as v11, but "last tracked" frames (keyframe type 2) also have indices and UVs.
+static bool _parse_sections_v12( const vol_geom_prefix_reader_t* reader_ptr, bool normals, bool textured, uint8_t keyframe, vol_geom_frame_sections_t* sec_ptr ) {
+  return _parse_sections_v11( reader_ptr, normals, textured, 2 == keyframe ? 1 : keyframe, sec_ptr );
+}
+
+/** Helper function to make the frame sections table of `owner_ptr`, which is the instance itself or, if shared, its registry entry's info. */
+static bool _resolve_frame_sections( const char* seq_filename, vol_geom_info_t* owner_ptr ) {
+  vol_geom_section_parser_t parser_fn = NULL;
+  switch ( owner_ptr->hdr.version ) {
+  case 10: parser_fn = _parse_sections_v10; break;
+  case 11: parser_fn = _parse_sections_v11; break;
+  case 12: parser_fn = _parse_sections_v12; break;
+  default: return false;
+  }
+
+  int frame_count                     = owner_ptr->hdr.frame_count;
+  vol_geom_frame_sections_t* sec_ptr  = calloc( (size_t)frame_count + 1, sizeof( vol_geom_frame_sections_t ) );
+  vol_geom_prefix_reader_t reader     = ( vol_geom_prefix_reader_t ){ .io_ptr = _get_io( owner_ptr ) };
+  int frames_in_memory                = vol_geom_get_frames_in_memory( owner_ptr );
+  if ( !sec_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frame sections\n" );
+    return false;
+  }
+
+  bool ok = true;
+  for ( int i = 0; ok && i < frame_count; i++ ) {
+    const vol_geom_frame_directory_entry_t* dir_ptr = &owner_ptr->frames_directory_ptr[i];
+    reader.file_offset                              = dir_ptr->offset_sz + dir_ptr->hdr_sz;
+    reader.block_sz                                 = dir_ptr->corrected_payload_sz;
+    reader.block_ptr = i < frames_in_memory && ( dir_ptr->offset_sz + dir_ptr->total_sz ) <= owner_ptr->sequence_blob_sz ?
+                         &owner_ptr->sequence_blob_byte_ptr[reader.file_offset] :
+                         NULL;
+    // The file is only opened once a frame isn't in memory.
+    if ( !reader.block_ptr && !reader.handle_ptr ) {
+      vol_geom_size_t seq_sz = 0;
+      reader.handle_ptr      = _io_open_sized( reader.io_ptr, seq_filename, &seq_sz );
+      ok                     = reader.handle_ptr != NULL;
+    }
+    ok = ok && parser_fn( &reader, owner_ptr->hdr.normals, owner_ptr->hdr.textured, owner_ptr->frame_headers_ptr[i].keyframe, &sec_ptr[i] );
+    if ( !ok ) { _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i sections could not be resolved\n", i ); }
+  }
+  if ( reader.handle_ptr ) { reader.io_ptr->close_fn( reader.handle_ptr ); }
+  if ( !ok ) {
+    free( sec_ptr );
+    return false;
+  }
+  owner_ptr->frame_sections_ptr = sec_ptr;
+  return true;
+}
+
+bool vol_geom_resolve_frame_sections( const char* seq_filename, vol_geom_info_t* info_ptr ) {
+  assert( seq_filename && info_ptr );
+  if ( !seq_filename || !info_ptr ) { return false; }
+  if ( info_ptr->frame_sections_ptr ) { return true; }
+
+  // A shared sequence's table belongs to its registry entry, like its directory, so every instance can use it.
+  if ( !info_ptr->shared_seq_ptr ) { return _resolve_frame_sections( seq_filename, info_ptr ); }
+  vol_geom_shared_seq_t* seq_ptr = (vol_geom_shared_seq_t*)info_ptr->shared_seq_ptr;
+  _shared_seqs_lock_acquire();
+  bool ok = seq_ptr->info.frame_sections_ptr || _resolve_frame_sections( seq_filename, &seq_ptr->info );
+  if ( ok ) { info_ptr->frame_sections_ptr = seq_ptr->info.frame_sections_ptr; }
+  _shared_seqs_lock_release();
+  return ok;
+}
+
+/******************************************************************************
+  MEMORY USAGE AND TRIMMING
+******************************************************************************/
+
+bool vol_geom_get_memory_usage( const vol_geom_info_t* info_ptr, vol_geom_memory_usage_t* usage_ptr ) {
+  assert( info_ptr && usage_ptr );
+  if ( !info_ptr || !usage_ptr ) { return false; }
+
+  *usage_ptr                     = ( vol_geom_memory_usage_t ){ .load_mode = VOL_GEOM_LOAD_STREAMING };
+  const vol_geom_info_t* own_ptr = info_ptr->shared_seq_ptr ? &( (const vol_geom_shared_seq_t*)info_ptr->shared_seq_ptr )->info : info_ptr;
+  int frame_count                = info_ptr->hdr.frame_count;
+  usage_ptr->shared              = info_ptr->shared_seq_ptr != NULL;
+  usage_ptr->directory_sz = (vol_geom_size_t)frame_count * (vol_geom_size_t)( sizeof( vol_geom_frame_directory_entry_t ) + sizeof( vol_geom_frame_hdr_t ) );
+  if ( info_ptr->frame_sections_ptr ) { usage_ptr->directory_sz += ( (vol_geom_size_t)frame_count + 1 ) * (vol_geom_size_t)sizeof( vol_geom_frame_sections_t ); }
+  if ( info_ptr->preallocated_frame_blob_ptr ) { usage_ptr->frame_blobs_sz += info_ptr->biggest_frame_blob_sz; }
+  if ( info_ptr->compressed_frame_scratch_ptr ) { usage_ptr->frame_blobs_sz += info_ptr->biggest_frame_blob_sz; }
+#ifdef VOL_GEOM_HAS_IO_URING
+  if ( info_ptr->uring_readahead_ptr ) {
+    const vol_geom_uring_readahead_t* ra_ptr = (const vol_geom_uring_readahead_t*)info_ptr->uring_readahead_ptr;
+    vol_geom_size_t slot_sz                  = info_ptr->biggest_frame_blob_sz;
+    if ( ra_ptr->direct_io ) { slot_sz = ( slot_sz + 2 * VOL_GEOM_URING_ALIGN - 1 ) & ~(vol_geom_size_t)( VOL_GEOM_URING_ALIGN - 1 ); }
+    usage_ptr->frame_blobs_sz += slot_sz * ra_ptr->depth;
+  }
+#endif
+  // A streamed instance of a shared sequence doesn't use the sequence that other instances loaded.
+  if ( !info_ptr->sequence_blob_byte_ptr && !info_ptr->compressed_seq_ptr ) { return true; }
+  usage_ptr->load_mode   = _held_load_mode( own_ptr );
+  usage_ptr->sequence_sz = _owned_sequence_sz( own_ptr );
+  if ( own_ptr->sequence_map_handle_ptr ) { usage_ptr->mapped_sz = own_ptr->sequence_blob_sz; }
+  return true;
+}
+
+/** Helper function to move a sequence one step down from pre-loaded, to compressed, to mapped, to streamed.
+ * @return False if there was nothing to free.
+ */
+static bool _trim_sequence( const char* seq_filename, vol_geom_info_t* owner_ptr ) {
+  vol_geom_load_mode_t mode = _held_load_mode( owner_ptr );
+  if ( VOL_GEOM_LOAD_PRELOAD == mode ) {
+    // The frames are compressed from the blob already in memory, so the file isn't read again.
+    vol_geom_memory_file_t blob_file    = ( vol_geom_memory_file_t ){ .name = seq_filename, .byte_ptr = owner_ptr->sequence_blob_byte_ptr, .sz = owner_ptr->sequence_blob_sz };
+    vol_geom_io_t blob_io               = vol_geom_memory_io( NULL );
+    vol_geom_compressed_seq_t* cseq_ptr = _compress_frames( &blob_io, &blob_file, blob_file.sz, owner_ptr );
+    if ( cseq_ptr ) {
+      _release_sequence( owner_ptr );
+      owner_ptr->compressed_seq_ptr = cseq_ptr;
+      _track_resident_sz( _compressed_seq_sz( cseq_ptr, owner_ptr->hdr.frame_count ) );
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Trimmed pre-loaded sequence to compressed\n" );
+      return true;
+    }
+  } else if ( VOL_GEOM_LOAD_MAPPED == mode ) {
+    // Only files mapped by vol_geom are unmapped. Memory backends' mappings are the application's memory, and packed volograms' videos are read from theirs.
+    if ( _mapped_file_io_map != _get_io( owner_ptr )->map_fn || VOL_GEOM_PACK_VERSION == owner_ptr->pack_hdr.version ) { return false; }
+    _release_sequence( owner_ptr );
+    owner_ptr->io = ( vol_geom_io_t ){ .open_fn = NULL }; // Streamed frames are read with the plain backend again.
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Trimmed mapped sequence to streamed\n" );
+    return true;
+  } else if ( VOL_GEOM_LOAD_STREAMING == mode ) {
+    return false;
+  }
+  // Compressed or progressive sequences, and pre-loaded ones that couldn't be compressed, are mapped instead, or streamed if they can't be.
+  _release_sequence( owner_ptr );
+  bool mapped = _map_sequence( seq_filename, owner_ptr );
+  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Trimmed sequence to %s\n", mapped ? "mapped" : "streamed" );
+  return true;
+}
+
+bool vol_geom_trim_memory( const char* seq_filename, vol_geom_info_t* info_ptr ) {
+  assert( seq_filename && info_ptr );
+  if ( !seq_filename || !info_ptr ) { return false; }
+  // A streamed instance of a shared sequence has nothing to trim, whatever other instances hold.
+  if ( !info_ptr->sequence_blob_byte_ptr && !info_ptr->compressed_seq_ptr ) { return false; }
+
+  vol_geom_shared_seq_t* seq_ptr = (vol_geom_shared_seq_t*)info_ptr->shared_seq_ptr;
+  vol_geom_info_t* owner_ptr     = seq_ptr ? &seq_ptr->info : info_ptr;
+  bool trimmed                   = false;
+  if ( seq_ptr ) { _shared_seqs_lock_acquire(); }
+  if ( seq_ptr && seq_ptr->ref_count > 1 ) {
+    // A shared sequence can only be trimmed when no other instance is reading it.
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Not trimming shared sequence `%s`, which has %i instances\n", seq_filename, seq_ptr->ref_count );
+  } else if ( VOL_GEOM_LOAD_PRELOAD != _held_load_mode( owner_ptr ) || _alloc_frame_scratch( info_ptr ) ) {
+    // The scratch is allocated before a pre-loaded sequence is compressed, so running out of memory leaves the sequence as it was.
+    trimmed                           = _trim_sequence( seq_filename, owner_ptr );
+    info_ptr->sequence_blob_byte_ptr  = owner_ptr->sequence_blob_byte_ptr;
+    info_ptr->sequence_blob_sz        = owner_ptr->sequence_blob_sz;
+    info_ptr->progressive_preload_ptr = owner_ptr->progressive_preload_ptr;
+    info_ptr->compressed_seq_ptr      = owner_ptr->compressed_seq_ptr;
+    _update_frame_scratch( info_ptr );
+  }
+  if ( seq_ptr ) { _shared_seqs_lock_release(); }
+  return trimmed;
+}
+
 bool vol_geom_free_file_info( vol_geom_info_t* info_ptr ) {
   if ( !info_ptr ) { return false; }
 
-  if ( info_ptr->sequence_blob_byte_ptr ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing sequence_blob_byte_ptr\n" );
-    free( info_ptr->sequence_blob_byte_ptr );
+#ifdef VOL_GEOM_HAS_IO_URING
+  if ( info_ptr->uring_readahead_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Stopping io_uring read-ahead\n" );
+    _free_uring_readahead( (vol_geom_uring_readahead_t*)info_ptr->uring_readahead_ptr );
+    info_ptr->uring_readahead_ptr = NULL;
+  }
+#endif
+
+  // The shared parts belong to the registry entry, so only this instance's frame blob and scratch are freed here.
+  if ( info_ptr->shared_seq_ptr ) {
+    free( info_ptr->preallocated_frame_blob_ptr );
+    free( info_ptr->compressed_frame_scratch_ptr );
+    _release_shared_seq( (vol_geom_shared_seq_t*)info_ptr->shared_seq_ptr );
+    *info_ptr = ( vol_geom_info_t ){ .hdr.frame_count = 0 };
+    return true;
   }
 
+  _release_sequence( info_ptr );
+  free( info_ptr->compressed_frame_scratch_ptr );
+
   if ( info_ptr->preallocated_frame_blob_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing preallocated_frame_blob_ptr\n" );
     free( info_ptr->preallocated_frame_blob_ptr );
@@ -561,6 +2337,7 @@ bool vol_geom_free_file_info( vol_geom_info_t* info_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing frames_directory_ptr\n" );
     free( info_ptr->frames_directory_ptr );
   }
+  free( info_ptr->frame_sections_ptr );
   *info_ptr = ( vol_geom_info_t ){ .hdr.frame_count = 0 };
 
   return true;
@@ -584,6 +2361,17 @@ int vol_geom_find_previous_keyframe( const vol_geom_info_t* info_ptr, int frame_
   return -1;
 }
 
+int vol_geom_find_reverse_keyframe( const vol_geom_info_t* info_ptr, int frame_idx ) {
+  assert( info_ptr );
+  if ( !info_ptr ) { return -1; }
+  if ( frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count || info_ptr->hdr.version < 12 ) { return -1; }
+  for ( int i = frame_idx; i < info_ptr->hdr.frame_count; i++ ) {
+    if ( 2 == info_ptr->frame_headers_ptr[i].keyframe ) { return i; }
+    if ( i > frame_idx && 1 == info_ptr->frame_headers_ptr[i].keyframe ) { return -1; } // Reached the next segment.
+  }
+  return -1;
+}
+
 void vol_geom_set_log_callback( void ( *user_function_ptr )( vol_geom_log_type_t log_type, const char* message_str ) ) { _logger_ptr = user_function_ptr; }
 
 void vol_geom_reset_log_callback( void ) { _logger_ptr = _default_logger; }
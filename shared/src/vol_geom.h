@@ -3,7 +3,7 @@
  *
  * vol_geom  | .vol Geometry Decoding API
  * --------- | ---------------------
- * Version   | 0.10.1
+ * Version   | 0.11.0
  * Authors   | Anton Gerdelan     <anton@volograms.com>
  *           | Patrick Geoghegan  <patrick@volograms.com>
  * Copyright | 2021, Volograms (http://volograms.com/)
@@ -14,6 +14,10 @@
  * Core library code that reads geometry data for a VOL sequence.
  * These functions are to be built into an application/engine and called from engine code.
  *
+ * Build Options
+ * -------------
+ * - VOL_GEOM_IO_URING - On Linux, enables vol_geom_enable_uring_readahead(), which reads streamed frames ahead of playback with io_uring.
+ *
  * Eventually
  * ----------
  * - allow custom allocator
@@ -21,6 +25,20 @@
  *
  * History
  * -------
+ * - 0.11.0 (2026/10/18) - Playback and loading performance:
+ *                          - vol_geom_find_reverse_keyframe() uses the v12 "last tracked frame" keyframes for reverse play.
+ *                          - vol_geom_read_frame_attribs() writes a frame's attributes straight into caller-owned buffers.
+ *                          - vol_geom_create_shared_file_info() shares a sequence's directory and pre-loaded blob between instances.
+ *                          - VOL_GEOM_LOAD_PROGRESSIVE pre-loads the sequence on a background thread. See vol_geom_get_frames_in_memory().
+ *                          - vol_geom_io_t pluggable I/O backends, with vol_geom_create_file_info_io() and the vol_geom_memory_io() backend.
+ *                          - vol_geom_enable_uring_readahead() batches io_uring reads of streamed frames on Linux.
+ *                          - Packed volograms, with the header, frame directory, frames and video in one file, read by
+ *                            vol_geom_create_packed_file_info().
+ *                          - VOL format v13, with a fixed-layout header, the frame directory in the header file, and aligned frame sections.
+ *                          - vol_geom_resolve_frame_sections() so v10-v12 frames are read by table lookup instead of being parsed on every read.
+ *                          - VOL_GEOM_LOAD_PRELOAD_COMPRESSED keeps the sequence in memory compressed and decompresses frames as they are read.
+ *                          - VOL_GEOM_LOAD_MAPPED, VOL_GEOM_LOAD_AUTO with vol_geom_set_memory_budget(), vol_geom_get_memory_usage(), and
+ *                            vol_geom_trim_memory().
  * - 0.10.1 (2022/03/31) - More verbose file reading error logs.
  * - 0.10.0 (2022/03/22) - Support added for reading >2GB volograms.
  * - 0.9.0  (2022/03/22) - Version bump for parity with vol_av.
@@ -70,7 +88,7 @@ VOL_GEOM_EXPORT typedef struct vol_geom_short_str_t {
 VOL_GEOM_EXPORT typedef struct vol_geom_file_hdr_t {
   /// Must be leading byte of decimal value 4, then "VOLS".
   vol_geom_short_str_t format;
-  /// 10,11,12.
+  /// 10,11,12,13.
   int32_t version;
   int32_t compression;
   vol_geom_short_str_t mesh_name;
@@ -119,6 +137,139 @@ VOL_GEOM_EXPORT typedef struct vol_geom_frame_directory_entry_t {
   vol_geom_size_t corrected_payload_sz;
 } vol_geom_frame_directory_entry_t;
 
+/// Version of the VOL format with a fixed-layout header and an up-front frame directory. See `vol_geom_v13_file_hdr_t`.
+#define VOL_GEOM_V13_VERSION 13
+/// Alignment in bytes of each frame in a v13 sequence file.
+#define VOL_GEOM_V13_FRAME_ALIGN 64
+/// Alignment in bytes of each attribute array within a v13 frame, from the start of the frame.
+#define VOL_GEOM_V13_ARRAY_ALIGN 16
+
+/** Offsets and sizes in bytes of a frame's attribute arrays, from the start of the frame's data. Arrays that a frame doesn't have are 0 bytes. */
+VOL_GEOM_EXPORT typedef struct vol_geom_frame_sections_t {
+  uint32_t vertices_offset;
+  uint32_t vertices_sz;
+  uint32_t normals_offset;
+  uint32_t normals_sz;
+  uint32_t indices_offset;
+  uint32_t indices_sz;
+  uint32_t uvs_offset;
+  uint32_t uvs_sz;
+  uint32_t texture_offset;
+  uint32_t texture_sz;
+} vol_geom_frame_sections_t;
+
+/** V13 header file. It has a fixed layout, so it is read by pointer cast, and is followed by the frame directory.
+ * The sequence file is just the frames' attribute arrays. Each frame starts on a `VOL_GEOM_V13_FRAME_ALIGN` byte boundary, and its arrays are where
+ * its directory entry says, so nothing in the sequence file is read to open a vologram or to find a frame's arrays. All values are little-endian.
+ */
+VOL_GEOM_EXPORT typedef struct vol_geom_v13_file_hdr_t {
+  /// Leading byte of decimal value 4, then "VOLS", then 3 zeroes. Readers of older versions see an invalid version number and reject the file.
+  uint8_t format[8];
+  /// `VOL_GEOM_V13_VERSION`.
+  int32_t version;
+  int32_t compression;
+  int32_t topology;
+  int32_t frame_count;
+  /// Nul-terminated strings.
+  char mesh_name[128];
+  char material[128];
+  char shader[128];
+  uint8_t normals;
+  uint8_t textured;
+  uint16_t texture_width;
+  uint16_t texture_height;
+  /// Follows UnityEngine.TextureFormat enum.
+  uint16_t texture_format;
+  float translation[3];
+  /// w, x, y, z. where [1,0,0,0] is identity.
+  float rotation[4];
+  float scale;
+  /// Offset in this file of the frame directory, `frame_count` `vol_geom_v13_frame_entry_t`s. A multiple of 8.
+  uint64_t directory_offset;
+} vol_geom_v13_file_hdr_t;
+
+/** Directory entry for a frame of a v13 vologram. */
+VOL_GEOM_EXPORT typedef struct vol_geom_v13_frame_entry_t {
+  /// Where the frame starts in the sequence file, a multiple of `VOL_GEOM_V13_FRAME_ALIGN`. Frames are in order and don't overlap.
+  uint64_t offset;
+  /// Size of the frame in bytes. All of its arrays lie within it.
+  uint32_t sz;
+  /// 0 = tracked frame, 1 = first/key frame, 2 = last tracked frame. Only frames of type 1 or 2 have indices and UVs.
+  uint8_t keyframe;
+  uint8_t reserved[3];
+  /// Offsets from `offset`, each a multiple of `VOL_GEOM_V13_ARRAY_ALIGN`.
+  vol_geom_frame_sections_t sections;
+} vol_geom_v13_frame_entry_t;
+
+/** An I/O backend, so volograms can be read from somewhere other than files on disk, such as app package assets or an archive.
+ * Files are referred to by the names given to `vol_geom_create_file_info_io()` and `vol_geom_read_frame()`, which the backend can interpret however it likes.
+ * A zeroed struct means the default backend, which reads files from disk. Functions may be called from a progressive pre-load's background thread.
+ */
+VOL_GEOM_EXPORT typedef struct vol_geom_io_t {
+  /// Passed to `open_fn`, e.g. an asset manager or archive. Must outlive every `vol_geom_info_t` using the backend.
+  void* user_ptr;
+  /// Open the named file for reading. Returns a handle that is passed to the other functions, or NULL on failure.
+  void* ( *open_fn )( void* user_ptr, const char* name );
+  /// Write the size of the file, in bytes, to `sz_ptr`. Returns false on failure.
+  bool ( *size_fn )( void* handle_ptr, vol_geom_size_t* sz_ptr );
+  /// Read exactly `sz` bytes starting `offset` bytes into the file. Returns false on failure, including if fewer bytes are available.
+  bool ( *read_at_fn )( void* handle_ptr, vol_geom_size_t offset, void* dst_ptr, vol_geom_size_t sz );
+  /// Optional, may be NULL. Returns the whole file's contents, in memory that stays valid until the handle is closed, or NULL if it can't.
+  /// Pre-loading uses this instead of copying the sequence file.
+  const uint8_t* ( *map_fn )( void* handle_ptr );
+  /// Close a handle returned by `open_fn`.
+  void ( *close_fn )( void* handle_ptr );
+} vol_geom_io_t;
+
+/** A named file in memory, for `vol_geom_memory_io()`. */
+VOL_GEOM_EXPORT typedef struct vol_geom_memory_file_t {
+  const char* name;
+  const uint8_t* byte_ptr;
+  vol_geom_size_t sz;
+} vol_geom_memory_file_t;
+
+/// First bytes of a packed vologram file, including the nul terminator.
+#define VOL_GEOM_PACK_MAGIC "VOLPACK"
+/// Packed vologram format version written by the packer and accepted by `vol_geom_create_packed_file_info()`.
+#define VOL_GEOM_PACK_VERSION 1
+/// Alignment in bytes of the frame directory, each frame, and the video in a packed vologram.
+#define VOL_GEOM_PACK_ALIGN 64
+
+/** Header at the start of a packed vologram, which holds a vologram's header file, a frame directory, its frames, and its video texture in one file.
+ * Offsets are in bytes from the start of the file. All values are little-endian.
+ * The frame directory is `frame_count` `vol_geom_pack_entry_t`s, so a frame's offset is found without scanning the frames before it.
+ * Each frame is stored as in the sequence file, from its frame number to its trailing size, starting on a `VOL_GEOM_PACK_ALIGN` byte boundary.
+ */
+VOL_GEOM_EXPORT typedef struct vol_geom_pack_hdr_t {
+  /// `VOL_GEOM_PACK_MAGIC`.
+  char magic[8];
+  /// `VOL_GEOM_PACK_VERSION`.
+  uint32_t version;
+  /// Number of entries in the frame directory. Matches the frame count in the header section.
+  uint32_t frame_count;
+  /// The original header file.
+  uint64_t hdr_offset;
+  uint64_t hdr_sz;
+  /// The frame directory.
+  uint64_t directory_offset;
+  /// The original video texture file. Both are 0 if the vologram has no video.
+  uint64_t video_offset;
+  uint64_t video_sz;
+  uint8_t reserved[8];
+} vol_geom_pack_hdr_t;
+
+/** Fixed-size frame directory entry in a packed vologram. */
+VOL_GEOM_EXPORT typedef struct vol_geom_pack_entry_t {
+  /// Where the frame starts in the file, a multiple of `VOL_GEOM_PACK_ALIGN`.
+  uint64_t offset;
+  /// Size of the frame in bytes, including its header and trailing size.
+  uint64_t sz;
+  /// Copies of the frame header's values, so they are known without reading the frame.
+  int32_t mesh_data_sz;
+  uint8_t keyframe;
+  uint8_t reserved[11];
+} vol_geom_pack_entry_t;
+
 /** Meta-data about the whole Vologram sequence. Load this once with `vol_geom_create_file_info()` before using the Vologram. */
 VOL_GEOM_EXPORT typedef struct vol_geom_info_t {
   vol_geom_file_hdr_t hdr;
@@ -130,6 +281,10 @@ VOL_GEOM_EXPORT typedef struct vol_geom_info_t {
   /// NOTE(Anton) if frame headers were fixed size we probably don't need to parse or store the field and can just struct pointer cast at frame offset
   vol_geom_frame_hdr_t* frame_headers_ptr;
 
+  /// Each frame's attribute array offsets, so frames are not parsed when read. From the frame directory of v13 volograms, or made by
+  /// `vol_geom_resolve_frame_sections()`. Otherwise NULL.
+  vol_geom_frame_sections_t* frame_sections_ptr;
+
   /// This is a pre-allocated block of memory, large enough to store the data of any frame in the vologram sequence. Do not manually allocate or free this memory!
   uint8_t* preallocated_frame_blob_ptr;
   /// This is the maximum size of the buffer pointed to by preallocated_frame_blob_ptr.
@@ -137,6 +292,32 @@ VOL_GEOM_EXPORT typedef struct vol_geom_info_t {
 
   /// If streaming_mode was not set then sequence file is read to a blob pointed to by this pointer. Otherwise it is NULL and file I/O occurs on every frame read.
   uint8_t* sequence_blob_byte_ptr;
+  /// Size of the buffer pointed to by sequence_blob_byte_ptr.
+  vol_geom_size_t sequence_blob_sz;
+
+  /// Backend the files were opened with. Zeroed for files on disk.
+  vol_geom_io_t io;
+  /// If the backend mapped the sequence file to sequence_blob_byte_ptr, the handle that keeps it mapped until `vol_geom_free_file_info()`. Otherwise NULL.
+  void* sequence_map_handle_ptr;
+
+  /// Header of the packed vologram this was opened from by `vol_geom_create_packed_file_info()`, with the offset of its video. Otherwise zeroed.
+  vol_geom_pack_hdr_t pack_hdr;
+
+  /// Set by `vol_geom_enable_uring_readahead()` to this instance's read-ahead state. Otherwise NULL. Do not modify!
+  void* uring_readahead_ptr;
+
+  /// Set by `VOL_GEOM_LOAD_PRELOAD_COMPRESSED` to the compressed frames, in place of `sequence_blob_byte_ptr`. Otherwise NULL. Do not modify!
+  void* compressed_seq_ptr;
+  /// With `compressed_seq_ptr`, a buffer of `biggest_frame_blob_sz` bytes that frames are decompressed into. Do not manually allocate or free this memory!
+  uint8_t* compressed_frame_scratch_ptr;
+
+  /// Set when the sequence blob is being filled on a background thread by `VOL_GEOM_LOAD_PROGRESSIVE`. Otherwise NULL. Do not modify!
+  /// Use `vol_geom_get_frames_in_memory()` to see how much of the blob is loaded.
+  void* progressive_preload_ptr;
+
+  /// Set by `vol_geom_create_shared_file_info()` to the registry entry that owns the directory, frame headers, and sequence blob. Otherwise NULL.
+  /// Only `preallocated_frame_blob_ptr` and `compressed_frame_scratch_ptr` belong to this struct then. Do not modify!
+  void* shared_seq_ptr;
 
 } vol_geom_info_t;
 
@@ -175,6 +356,38 @@ VOL_GEOM_EXPORT typedef struct vol_geom_frame_data_t {
   int32_t texture_sz;
 } vol_geom_frame_data_t;
 
+/** Bit flags for the attribute arrays of a frame, as reported in `vol_geom_attrib_buffers_t::changed`. */
+typedef enum vol_geom_attrib_flags_t {
+  VOL_GEOM_ATTRIB_VERTICES = 1 << 0,
+  VOL_GEOM_ATTRIB_NORMALS  = 1 << 1,
+  VOL_GEOM_ATTRIB_INDICES  = 1 << 2,
+  VOL_GEOM_ATTRIB_UVS      = 1 << 3
+} vol_geom_attrib_flags_t;
+
+/** A caller-owned destination buffer for one attribute array. */
+VOL_GEOM_EXPORT typedef struct vol_geom_attrib_t {
+  /// Buffer the array is copied into, or NULL to skip the attribute. Owned by the application, which must keep it alive and in place while it is registered.
+  void* ptr;
+  /// Size of the buffer in bytes. No array is bigger than `vol_geom_info_t::biggest_frame_blob_sz`.
+  int32_t capacity;
+  /// Size in bytes of the array last written. Keeps its value for frames that don't carry the attribute.
+  int32_t sz;
+} vol_geom_attrib_t;
+
+/** Caller-owned destination buffers for the attributes of a frame, filled by `vol_geom_read_frame_attribs()`. */
+VOL_GEOM_EXPORT typedef struct vol_geom_attrib_buffers_t {
+  /// Tightly-packed float x,y,z positions.
+  vol_geom_attrib_t vertices;
+  /// Tightly-packed float x,y,z normals. Only if version >= 11 and the header says the sequence has normals.
+  vol_geom_attrib_t normals;
+  /// Tightly-packed uint16 triangle indices. Only written for keyframes.
+  vol_geom_attrib_t indices;
+  /// Tightly-packed float u,v texture coordinates. Only written for keyframes.
+  vol_geom_attrib_t uvs;
+  /// `vol_geom_attrib_flags_t` bits for the arrays written by the last read, so the application only needs to upload those.
+  uint32_t changed;
+} vol_geom_attrib_buffers_t;
+
 /** In your application these enum values can be used to filter out or categorise messages given by vol_geom_log_callback. */
 typedef enum vol_geom_log_type_t {
   VOL_GEOM_LOG_TYPE_INFO = 0, //
@@ -184,6 +397,42 @@ typedef enum vol_geom_log_type_t {
   VOL_GEOM_LOG_STR_MAX_LEN // Not an error type, just used to count the error types.
 } vol_geom_log_type_t;
 
+/** How a sequence file is read, for `vol_geom_create_file_info_ex()`. */
+typedef enum vol_geom_load_mode_t {
+  /// The sequence file is not pre-loaded, and file I/O occurs on every frame read. Same as `streaming_mode` being set.
+  VOL_GEOM_LOAD_STREAMING = 0,
+  /// The whole sequence file is read into memory before returning. Same as `streaming_mode` not being set.
+  VOL_GEOM_LOAD_PRELOAD,
+  /// Memory for the whole sequence file is allocated, and filled front-to-back on a background thread.
+  /// Frames that are already loaded are read from memory and later frames are read from the file, so the first frame is ready as soon as the header is.
+  VOL_GEOM_LOAD_PROGRESSIVE,
+  /// Each frame is compressed as the sequence file is read, and only the compressed frames are kept in memory, typically a fraction of the file's size.
+  /// Frames are decompressed into the frame blob as they are read, so there is no file I/O during playback. For sequences too big to pre-load.
+  VOL_GEOM_LOAD_PRELOAD_COMPRESSED,
+  /// The sequence file is memory-mapped, and frames are read from the mapping. Pages are read by the OS when first used, and can be dropped by it
+  /// under memory pressure. Streams instead if the file can't be mapped.
+  VOL_GEOM_LOAD_MAPPED,
+  /// One of the modes above is picked from the sequence's size and what is left of the budget set by `vol_geom_set_memory_budget()`:
+  /// pre-loaded if it fits, compressed if half of it fits, otherwise mapped, or streamed if the I/O backend can't map it.
+  VOL_GEOM_LOAD_AUTO
+} vol_geom_load_mode_t;
+
+/** Memory held by one `vol_geom_info_t`, from `vol_geom_get_memory_usage()`. Sizes are in bytes. */
+typedef struct vol_geom_memory_usage_t {
+  /// How the sequence is held now. Never `VOL_GEOM_LOAD_AUTO`. Progressive pre-loads report `VOL_GEOM_LOAD_PROGRESSIVE` until freed or trimmed.
+  vol_geom_load_mode_t load_mode;
+  /// If set, `directory_sz` and `sequence_sz` are shared with other instances of the same vologram, and only counted once between them.
+  bool shared;
+  /// Frames directory, frame headers, and any table of frame sections.
+  vol_geom_size_t directory_sz;
+  /// This instance's frame blob, and any decompression scratch and read-ahead buffers.
+  vol_geom_size_t frame_blobs_sz;
+  /// Allocated sequence blob or compressed sequence, which counts against the memory budget. 0 if mapped or streamed.
+  vol_geom_size_t sequence_sz;
+  /// Size of the mapped sequence file. The OS only keeps the pages in use resident. 0 if not mapped.
+  vol_geom_size_t mapped_sz;
+} vol_geom_memory_usage_t;
+
 VOL_GEOM_EXPORT void vol_geom_set_log_callback( void ( *user_function_ptr )( vol_geom_log_type_t log_type, const char* message_str ) );
 VOL_GEOM_EXPORT void vol_geom_reset_log_callback( void );
 
@@ -203,14 +452,118 @@ VOL_GEOM_EXPORT void vol_geom_reset_log_callback( void );
  */
 VOL_GEOM_EXPORT bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode );
 
+/** As `vol_geom_create_file_info()`, with a choice of how the sequence file is read.
+ * @param load_mode      A `vol_geom_load_mode_t`. With `VOL_GEOM_LOAD_PROGRESSIVE`, `vol_geom_free_file_info()` stops the background thread.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_ex( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode );
+
+/** As `vol_geom_create_file_info_ex()`, reading the files through an I/O backend instead of from disk.
+ * @param hdr_filename   Name of the header file, passed to the backend's `open_fn`. Must not be NULL.
+ * @param seq_filename   Name of the sequence file, passed to the backend's `open_fn`. Pass the same name to `vol_geom_read_frame()`. Must not be NULL.
+ * @param io_ptr         The backend, which is copied into `info_ptr`. NULL to read files from disk.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_io(
+  const char* hdr_filename, const char* seq_filename, const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode );
+
+/** Make an I/O backend that reads files from memory, e.g. a vologram in an asset bundle or one downloaded to RAM. Its `map_fn` lets pre-loading use
+ * the memory in place.
+ * @param files_ptr      Array of files, ended by an entry with a NULL name. The array and the bytes it points to are not copied, and must outlive
+ *                       every `vol_geom_info_t` using the backend.
+ * @returns              The backend, to pass to `vol_geom_create_file_info_io()`.
+ */
+VOL_GEOM_EXPORT vol_geom_io_t vol_geom_memory_io( const vol_geom_memory_file_t* files_ptr );
+
+/** As `vol_geom_create_file_info_ex()`, for a packed vologram made by the vol_pack tool, which is a single file. See `vol_geom_pack_hdr_t`.
+ * The header section and frame directory are read with two reads, instead of a scan of every frame.
+ * Unless `load_mode` is `VOL_GEOM_LOAD_STREAMING`, the whole file is memory-mapped once, and frames are read where they are in the mapping.
+ * The video section is then at `info_ptr->sequence_blob_byte_ptr + info_ptr->pack_hdr.video_offset`, valid until `vol_geom_free_file_info()`.
+ * @param pack_filename  Path to the packed vologram. Pass the same path to `vol_geom_read_frame()`. Must not be NULL.
+ * @param load_mode      A `vol_geom_load_mode_t`. `VOL_GEOM_LOAD_PROGRESSIVE` maps the file too, as pages are only read when first used.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_packed_file_info( const char* pack_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode );
+
+/** Like `vol_geom_create_file_info()`, but volograms opened more than once share the parts that don't change during playback.
+ * A process-wide registry, keyed by the file paths, sizes and modification times, keeps one reference-counted copy of the header, frames directory,
+ * frame headers, and pre-loaded sequence blob. Each `vol_geom_info_t` only gets its own frame blob, so it can be read from independently of the others.
+ * Free it with `vol_geom_free_file_info()` as normal, which frees the shared parts when the last instance is freed.
+ * This function is thread-safe with respect to other calls to it and to `vol_geom_free_file_info()`.
+ * Video is shared separately, by opening each instance's video with `vol_av_open_shared()`, so that instances showing the same frame share one decode.
+ * @param streaming_mode If not set, and an earlier instance was streamed, the sequence is pre-loaded now for this and later instances.
+ * @returns              Returns false on any error, as for `vol_geom_create_file_info()`.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_shared_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode );
+
+/** As `vol_geom_create_shared_file_info()`, with a choice of how the sequence file is read.
+ * @param load_mode      A `vol_geom_load_mode_t`. If an earlier instance was streamed, the shared sequence starts loading now. Otherwise instances
+ *                       that don't stream share whichever blob the first one loaded, progressive or not.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_shared_file_info_ex( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, vol_geom_load_mode_t load_mode );
+
 /** Call this function to free memory allocated by a call to `vol_geom_create_file_info()` and reset struct to defaults.
  * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application that will be populated by this function. Must not be NULL.
  * @returns              False error such as NULL pointers where allocated memory was expected.
  */
 VOL_GEOM_EXPORT bool vol_geom_free_file_info( vol_geom_info_t* info_ptr );
 
+/** Read streamed frames ahead of playback with io_uring, on Linux builds with VOL_GEOM_IO_URING defined.
+ * Each frame read submits reads for the frames after it, in one batch, into buffers registered with the kernel. When a read comes to a frame it is
+ * usually already there, so a single thread can keep a deep I/O queue going for many streams. Playing backwards reads ahead backwards.
+ * Only for sequences streamed from disk: not pre-loaded, and opened with the default I/O backend. `vol_geom_free_file_info()` stops it.
+ * @param seq_filename   Path to the sequence file, as given to `vol_geom_create_file_info()`. Must not be NULL.
+ * @param info_ptr       A streamed sequence. Must not be NULL.
+ * @param depth          Number of frames to keep read, or being read, including the current one. 2 to 64.
+ * @param direct_io      Open the file with O_DIRECT, bypassing the page cache, into aligned buffers. Falls back to cached reads if not supported.
+ * @returns              False if not supported by this build or kernel, or on any error. Reads then stay synchronous.
+ */
+VOL_GEOM_EXPORT bool vol_geom_enable_uring_readahead( const char* seq_filename, vol_geom_info_t* info_ptr, int depth, bool direct_io );
+
+/** Find the offsets and sizes of every frame's attribute arrays now, so that `vol_geom_read_frame()` and `vol_geom_read_frame_attribs()` look them up
+ * instead of parsing each frame's size prefixes as it is read. v13 volograms already have them in their frame directory.
+ * Frames are checked once here, with a parser for the vologram's version. Only the size prefixes are read: from memory for pre-loaded frames,
+ * otherwise with a few small reads per frame. Call after opening, from the thread that reads frames. For shared volograms, later instances get the
+ * table too.
+ * @param seq_filename   The sequence file name the vologram was opened with. Must not be NULL.
+ * @returns              False on any error, including a malformed frame, in which case frames are parsed as they are read, as before.
+ */
+VOL_GEOM_EXPORT bool vol_geom_resolve_frame_sections( const char* seq_filename, vol_geom_info_t* info_ptr );
+
+/** Find out how many frames, from the start of the sequence, are read from memory rather than from the file.
+ * This is safe to call while a progressive pre-load is running, and only grows until it finishes.
+ * @param info_ptr       Collected VOL sequence information created by `vol_geom_create_file_info()`. Must not be NULL.
+ * @returns              The frame count if the sequence was pre-loaded, compressed or not, the number of frames loaded so far by `VOL_GEOM_LOAD_PROGRESSIVE`,
+ *                       or 0 if streaming.
+ */
+VOL_GEOM_EXPORT int vol_geom_get_frames_in_memory( const vol_geom_info_t* info_ptr );
+
+/** Set the process-wide budget for sequences held in memory by `VOL_GEOM_LOAD_AUTO`. Volograms already open are not changed.
+ * Every pre-loaded and compressed sequence counts against it, however it was opened. Mapped and streamed sequences don't.
+ * @param budget_sz      Budget in bytes. 0, the default, for no budget, so `VOL_GEOM_LOAD_AUTO` always pre-loads.
+ */
+VOL_GEOM_EXPORT void vol_geom_set_memory_budget( vol_geom_size_t budget_sz );
+
+/** @returns             Bytes of sequence memory counted against the budget by every open vologram. This is thread-safe. */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_get_memory_budget_used( void );
+
+/** Find out how much memory a vologram holds, and how its sequence is loaded. Video textures are not included.
+ * @param info_ptr       Collected VOL sequence information created by `vol_geom_create_file_info()`. Must not be NULL.
+ * @param usage_ptr      Filled in by this function. Must not be NULL.
+ * @returns              False if either pointer is NULL.
+ */
+VOL_GEOM_EXPORT bool vol_geom_get_memory_usage( const vol_geom_info_t* info_ptr, vol_geom_memory_usage_t* usage_ptr );
+
+/** Free some of a vologram's memory by moving its sequence one step from pre-loaded, to compressed, to mapped, to streamed. Call it again to go further,
+ * e.g. when the OS warns of low memory. Playback carries on from the next frame read, which is identical whichever way the sequence is held.
+ * Pre-loaded sequences are compressed from memory without reading the file. Mappings of memory backends and packed volograms are kept.
+ * A shared vologram is only trimmed when this is its only instance. Call from the thread that reads frames, not while a frame read is in progress.
+ * Frame data from an earlier `vol_geom_read_frame()` may point into freed memory, so read the frame again before using it.
+ * @param seq_filename   The sequence file name the vologram was opened with. Must not be NULL.
+ * @param info_ptr       Collected VOL sequence information created by `vol_geom_create_file_info()`. Must not be NULL.
+ * @returns              True if memory was freed. False if there was nothing more to free, or on any error, leaving the sequence as it was.
+ */
+VOL_GEOM_EXPORT bool vol_geom_trim_memory( const char* seq_filename, vol_geom_info_t* info_ptr );
+
 /** Read a single frame from a Vologram sequence file.
- * @param seq_filename   Pointer to a char array containing the file path to the Vologram sequence file. Must not be NULL.
+ * @param seq_filename   Pointer to a char array containing the file path to the Vologram sequence file, or its name for the I/O backend. Must not be NULL.
  * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application as populated by a previous call `vol_geom_create_file_info()`.
  * @param frame_idx      Index of the frame you wish to read. Frames start at index 0.
  * @param frame_data_ptr Pointer to a `vol_geom_frame_data_t` struct in your application that this function will populate with data.
@@ -219,6 +572,18 @@ VOL_GEOM_EXPORT bool vol_geom_free_file_info( vol_geom_info_t* info_ptr );
  */
 VOL_GEOM_EXPORT bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr );
 
+/** Read a single frame from a Vologram sequence file, and write its attribute arrays straight into buffers owned by the application.
+ * Register the same buffers for the whole sequence, so no memory is allocated or handed over per frame. If the sequence was pre-loaded then each array is
+ * copied only once, from the sequence blob into its buffer.
+ * Tracked frames only carry vertices and normals. Read the keyframe of a frame's segment first, so the buffers hold its indices and UVs.
+ * @param seq_filename   Pointer to a char array containing the file path to the Vologram sequence file. Must not be NULL.
+ * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application as populated by a previous call `vol_geom_create_file_info()`.
+ * @param frame_idx      Index of the frame you wish to read. Frames start at index 0.
+ * @param buffers_ptr    Destination buffers. The sizes of the arrays written, and the `changed` flags, are updated. Must not be NULL.
+ * @returns              False on any error including `frame_idx` range validation, File I/O, or an array that doesn't fit its buffer.
+ */
+VOL_GEOM_EXPORT bool vol_geom_read_frame_attribs( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_attrib_buffers_t* buffers_ptr );
+
 /** This function can be used to determine if a frame can be skipped or has essential keyframe data.
  * @param info_ptr       Collected VOL sequence information created by `vol_geom_create_file_info()`. Must not be NULL.
  * @param frame_idx      Index number of the frame to query within the sequence, starting at 0.
@@ -234,6 +599,16 @@ VOL_GEOM_EXPORT bool vol_geom_is_keyframe( const vol_geom_info_t* info_ptr, int
  */
 VOL_GEOM_EXPORT int vol_geom_find_previous_keyframe( const vol_geom_info_t* info_ptr, int frame_idx );
 
+/** Look forwards from a frame to the last tracked frame of its segment, which has keyframe value 2 in version 12 and later, and carries the segment's
+ * indices and UVs. This is useful when playing backwards, as that frame is reached before the segment's first keyframe, so the mesh's base data can
+ * be loaded without going back to the start of the segment.
+ * @param info_ptr       Pointer to vologram meta-data loaded by a call to vol_geom_create_file_info().
+ * @param frame_idx      Index of the current frame to start looking forwards from. If this frame has keyframe value 2 then the function will return this index.
+ * @returns              The index of the frame with keyframe value 2 that ends the segment containing `frame_idx`. Returns -1 on error, for older
+ *                       versions, or if the segment doesn't end with one.
+ */
+VOL_GEOM_EXPORT int vol_geom_find_reverse_keyframe( const vol_geom_info_t* info_ptr, int frame_idx );
+
 #ifdef __cplusplus
 }
 #endif /* CPP */
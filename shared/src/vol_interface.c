@@ -9,6 +9,13 @@
  * Licence:   The MIT License. See LICENSE.md for details. \n
  */
 
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#define _POSIX_C_SOURCE 200809L // nanosleep() and clock_gettime() in vol_threads.h aren't declared by -std=c99 on its own.
+#endif
+#if defined( __APPLE__ ) && !defined( _DARWIN_C_SOURCE )
+#define _DARWIN_C_SOURCE // _POSIX_C_SOURCE alone hides Apple's extensions, e.g. _SC_NPROCESSORS_ONLN in vol_threads.h.
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
@@ -30,6 +37,7 @@
 
 #include "vol_av.h"
 #include "vol_geom.h"
+#include "vol_threads.h" // The worker thread for native_vol_open_async(), and the render thread hand-off.
 
 #ifdef _WIN32
 #define DllExport __declspec (dllexport)
@@ -43,7 +51,6 @@ extern "C"
 #endif
 
 #include <stdbool.h>
-#include <math.h> // TODO: Remove when test function `Plasma` is removed
     
 #ifdef ENABLE_UNITY_RENDER_FUNCS
 #include "IUnityRenderingExtensions.h"
@@ -144,10 +151,64 @@ double apg_time_s( void ) {
  * Geometry file
  */
 
-/** Struct containing details of the opened geometry file */
-static vol_geom_info_t geom_file_ptr;
-/** Struct containing read geometry data */
-static vol_geom_frame_data_t geom_frame_data;
+/** Geometry reading state of a player: the default player's below, or each instance's from `native_vol_instance_open()` */
+typedef struct vol_interface_geom_t {
+    /** Struct containing details of the opened geometry file */
+    vol_geom_info_t info;
+    /** Struct containing read geometry data */
+    vol_geom_frame_data_t frame_data;
+    /** Copy of the sequence file path, so that frames can be read by `native_vol_read_frame_at_time()` */
+    char* seq_filename;
+    /** Index of the geometry frame in `frame_data`, or -1 */
+    int loaded_frame_idx;
+    /** Data of the keyframe that the frame in `frame_data` follows, with its indices and UVs. See `native_vol_get_geom_key_ptr_data()` */
+    vol_geom_frame_data_t key_frame_data;
+    /** Copy of a keyframe's data block, kept when a tracked frame is read straight after it and overwrites the original */
+    uint8_t* key_blob_ptr;
+    vol_geom_size_t key_blob_sz;
+    /** Application-owned buffers that frames' attributes are written into, instead of `frame_data`. See `native_vol_set_geom_output_buffers()` */
+    vol_geom_attrib_buffers_t attrib_buffers;
+    bool attrib_buffers_set;
+} vol_interface_geom_t;
+
+/** Geometry of the default player */
+static vol_interface_geom_t geom = { .loaded_frame_idx = -1 };
+/** Copies of the files opened by `native_vol_open_geom_memory()`, read through vol_geom's memory backend. The last entry ends the list */
+static vol_geom_memory_file_t geom_memory_files[3];
+/** Set while the video is read from the mapping of the packed vologram in `geom.info`. See `native_vol_open_packed_file()` */
+static bool vid_in_geom_pack = false;
+
+DllExport bool native_vol_close_video_file(void);
+
+/** Reset a player's reading state for a sequence that was just opened into its `info` */
+static void _geom_file_opened( vol_interface_geom_t* geom_ptr, const char* seq_filename )
+{
+    memset( &geom_ptr->frame_data, 0, sizeof(vol_geom_frame_data_t));
+    geom_ptr->loaded_frame_idx = -1;
+    memset( &geom_ptr->attrib_buffers, 0, sizeof(vol_geom_attrib_buffers_t) );
+    geom_ptr->attrib_buffers_set = false;
+    free( geom_ptr->seq_filename );
+    size_t len = strlen( seq_filename );
+    geom_ptr->seq_filename = malloc( len + 1 );
+    if ( geom_ptr->seq_filename ) { memcpy( geom_ptr->seq_filename, seq_filename, len + 1 ); }
+}
+
+/** Free a player's geometry and reset its reading state
+ @returns               `true` if the file closed successfully */
+static bool _free_geom( vol_interface_geom_t* geom_ptr )
+{
+    bool ret = vol_geom_free_file_info( &geom_ptr->info );
+    free( geom_ptr->seq_filename );
+    geom_ptr->seq_filename = NULL;
+    geom_ptr->loaded_frame_idx = -1;
+    free( geom_ptr->key_blob_ptr );
+    geom_ptr->key_blob_ptr = NULL;
+    geom_ptr->key_blob_sz = 0;
+    memset( &geom_ptr->key_frame_data, 0, sizeof(vol_geom_frame_data_t) );
+    memset( &geom_ptr->attrib_buffers, 0, sizeof(vol_geom_attrib_buffers_t) );
+    geom_ptr->attrib_buffers_set = false;
+    return ret;
+}
 
 /** Open the geometry file
  @param hdr_filename    Path to the header file
@@ -156,23 +217,229 @@ static vol_geom_frame_data_t geom_frame_data;
  */
 DllExport bool native_vol_open_geom_file(const char* hdr_filename, const char* seq_filename, bool streaming_mode)
 {
-    memset(&geom_file_ptr, 0, sizeof(vol_geom_info_t));
-    bool opened = vol_geom_create_file_info(hdr_filename, seq_filename, &geom_file_ptr, streaming_mode);
+    memset(&geom.info, 0, sizeof(vol_geom_info_t));
+    // Opening a vologram that is already open, e.g. on Restart() or by another player, shares its directory and pre-loaded sequence.
+    bool opened = vol_geom_create_shared_file_info(hdr_filename, seq_filename, &geom.info, streaming_mode);
     
     if ( !opened )
         return opened;
         
-    memset( &geom_frame_data, 0, sizeof(vol_geom_frame_data_t));
-    
+    _geom_file_opened( &geom, seq_filename );
+    return true;
+}
+
+/** Open the geometry file, and pre-load the sequence file on a background thread.
+ * Playback can start straight away: frames that aren't loaded yet are read from the file
+ @param hdr_filename    Path to the header file
+ @param seq_filename    Path to the sequence file
+ @returns               If the operation was successful
+ */
+DllExport bool native_vol_open_geom_file_progressive(const char* hdr_filename, const char* seq_filename)
+{
+    memset(&geom.info, 0, sizeof(vol_geom_info_t));
+    if ( !vol_geom_create_shared_file_info_ex(hdr_filename, seq_filename, &geom.info, VOL_GEOM_LOAD_PROGRESSIVE) )
+        return false;
+
+    _geom_file_opened( &geom, seq_filename );
+    return true;
+}
+
+/** Open the geometry file, and pre-load the sequence file compressed, for sequences too big to pre-load as they are.
+ * Frames are decompressed as they are read, so there is no file I/O during playback
+ @param hdr_filename    Path to the header file
+ @param seq_filename    Path to the sequence file
+ @returns               If the operation was successful
+ */
+DllExport bool native_vol_open_geom_file_compressed(const char* hdr_filename, const char* seq_filename)
+{
+    memset(&geom.info, 0, sizeof(vol_geom_info_t));
+    if ( !vol_geom_create_shared_file_info_ex(hdr_filename, seq_filename, &geom.info, VOL_GEOM_LOAD_PRELOAD_COMPRESSED) )
+        return false;
+
+    _geom_file_opened( &geom, seq_filename );
+    return true;
+}
+
+/** Open the geometry file, choosing whether to pre-load it, pre-load it compressed, map it, or stream it, from its size and what is left of the budget
+ * set by `native_vol_set_memory_budget()`
+ @param hdr_filename    Path to the header file
+ @param seq_filename    Path to the sequence file
+ @returns               If the operation was successful
+ */
+DllExport bool native_vol_open_geom_file_auto(const char* hdr_filename, const char* seq_filename)
+{
+    memset(&geom.info, 0, sizeof(vol_geom_info_t));
+    if ( !vol_geom_create_shared_file_info_ex(hdr_filename, seq_filename, &geom.info, VOL_GEOM_LOAD_AUTO) )
+        return false;
+
+    _geom_file_opened( &geom, seq_filename );
+    return true;
+}
+
+/** Set the budget for geometry sequences held in memory, shared by every vologram opened with `native_vol_open_geom_file_auto()`.
+ * Volograms that are already open are not changed
+ @param budget_bytes    Budget in bytes, or 0 for no budget
+ */
+DllExport void native_vol_set_memory_budget(int64_t budget_bytes)
+{
+    vol_geom_set_memory_budget( budget_bytes );
+}
+
+/** Free some of the open geometry's memory, e.g. when the OS warns of low memory, by moving it one step from pre-loaded, to compressed, to mapped,
+ * to streamed. Playback carries on, as the next frame shown is read again from wherever the sequence now is. Call again to free more
+ @returns               `true` if memory was freed, `false` if there was nothing more to free
+ */
+DllExport bool native_vol_trim_memory(void)
+{
+    if ( !geom.seq_filename || !vol_geom_trim_memory( geom.seq_filename, &geom.info ) )
+        return false;
+    // The last frame read may have pointed into the memory that was freed. Geometry buffers registered by the application are unaffected.
+    if ( !geom.attrib_buffers_set ) {
+        memset( &geom.frame_data, 0, sizeof(vol_geom_frame_data_t) );
+        geom.loaded_frame_idx = -1;
+    }
     return true;
 }
 
+/** Free the copies made by `native_vol_open_geom_memory()` */
+static void _free_geom_memory_files( void )
+{
+    for ( int i = 0; geom_memory_files[i].name; i++ ) {
+        free( (void*)geom_memory_files[i].byte_ptr );
+    }
+    memset( geom_memory_files, 0, sizeof(geom_memory_files) );
+}
+
+/** Open geometry that is already in memory, e.g. from an asset bundle or the app package, without extracting it to disk first.
+ * The bytes are copied, so the caller's buffers can be released as soon as this returns
+ @param hdr_ptr         Contents of the header file
+ @param hdr_sz          Size of the header file in bytes
+ @param seq_ptr         Contents of the sequence file
+ @param seq_sz          Size of the sequence file in bytes
+ @returns               If the operation was successful
+ */
+DllExport bool native_vol_open_geom_memory(const uint8_t* hdr_ptr, int64_t hdr_sz, const uint8_t* seq_ptr, int64_t seq_sz)
+{
+    memset(&geom.info, 0, sizeof(vol_geom_info_t));
+    _free_geom_memory_files();
+    if ( !hdr_ptr || !seq_ptr || hdr_sz <= 0 || seq_sz <= 0 )
+        return false;
+
+    uint8_t* hdr_copy_ptr = malloc( (size_t)hdr_sz );
+    uint8_t* seq_copy_ptr = malloc( (size_t)seq_sz );
+    if ( !hdr_copy_ptr || !seq_copy_ptr ) {
+        free( hdr_copy_ptr );
+        free( seq_copy_ptr );
+        return false;
+    }
+    memcpy( hdr_copy_ptr, hdr_ptr, (size_t)hdr_sz );
+    memcpy( seq_copy_ptr, seq_ptr, (size_t)seq_sz );
+    geom_memory_files[0] = (vol_geom_memory_file_t){ .name = "header.vols", .byte_ptr = hdr_copy_ptr, .sz = hdr_sz };
+    geom_memory_files[1] = (vol_geom_memory_file_t){ .name = "sequence_0.vols", .byte_ptr = seq_copy_ptr, .sz = seq_sz };
+
+    // The memory backend maps the copy, so pre-loading doesn't copy it again.
+    vol_geom_io_t io = vol_geom_memory_io( geom_memory_files );
+    if ( !vol_geom_create_file_info_io( geom_memory_files[0].name, geom_memory_files[1].name, &io, &geom.info, VOL_GEOM_LOAD_PRELOAD ) ) {
+        _free_geom_memory_files();
+        return false;
+    }
+
+    _geom_file_opened( &geom, geom_memory_files[1].name );
+    return true;
+}
+
+/** Read frames of the open, streamed, geometry ahead of playback with io_uring. Only in Linux builds with VOL_GEOM_IO_URING defined.
+ * Call after `native_vol_open_geom_file()` with `streaming_mode` set
+ @param depth           Number of frames to keep read ahead, including the current one. 2 to 64
+ @param direct_io       Bypass the page cache with O_DIRECT
+ @returns               `false` if not supported, in which case frames are still read synchronously
+ */
+DllExport bool native_vol_enable_geom_readahead(int depth, bool direct_io)
+{
+    if ( !geom.seq_filename )
+        return false;
+    return vol_geom_enable_uring_readahead( geom.seq_filename, &geom.info, depth, direct_io );
+}
+
+/** Find the attribute array offsets of every frame of the open geometry now, so frames are looked up instead of parsed as they are read.
+ * Call after opening the geometry
+ @returns               `false` if not open, or a frame is malformed, in which case frames are still parsed as they are read
+ */
+DllExport bool native_vol_resolve_geom_frame_sections(void)
+{
+    if ( !geom.seq_filename )
+        return false;
+    return vol_geom_resolve_frame_sections( geom.seq_filename, &geom.info );
+}
+
+/** Get the number of frames, from the start of the sequence, that are read from memory
+ @returns   The frame count if pre-loaded, compressed or not, the frames loaded so far by `native_vol_open_geom_file_progressive()`, or 0 if streaming
+ */
+DllExport int native_vol_get_geom_frames_in_memory(void)
+{
+    return vol_geom_get_frames_in_memory( &geom.info );
+}
+
 /** Clears the loaded geometry data
  @returns   `true` if the file closed successfully, `false` otherwise
  */
 DllExport bool native_vol_free_geom_data(void)
 {
-    bool ret = vol_geom_free_file_info( &geom_file_ptr );
+    // The video of a packed vologram is read from the geometry's mapping, so it can't outlive it.
+    if ( vid_in_geom_pack ) { native_vol_close_video_file(); }
+    bool ret = _free_geom( &geom );
+    _free_geom_memory_files();
+    return ret;
+}
+
+/** Register buffers owned by the application that geometry frames read by `native_vol_update()`, `native_vol_read_frame_at_time()` and
+ * `native_vol_scrub_to_time()` are written straight into. They must stay alive and in place until the geometry is freed or they are unregistered.
+ * Register them once per sequence, after opening it. The frame results report which arrays were written, and their sizes.
+ * While they are set, `native_vol_get_geom_ptr_data()` and `native_vol_get_geom_key_ptr_data()` aren't updated by those calls. Each buffer can be NULL to skip that attribute, and no array is bigger than `native_vol_get_geom_max_attrib_size()` bytes
+ @param vertices_ptr    Buffer for float x,y,z positions
+ @param normals_ptr     Buffer for float x,y,z normals
+ @param indices_ptr     Buffer for uint16 triangle indices, only written on keyframes
+ @param uvs_ptr         Buffer for float u,v texture coordinates, only written on keyframes
+ @param capacities      Sizes in bytes of the four buffers, in the same order
+ @returns               `false` if no geometry is open
+ */
+DllExport bool native_vol_set_geom_output_buffers( void* vertices_ptr, void* normals_ptr, void* indices_ptr, void* uvs_ptr, const int32_t* capacities )
+{
+    memset( &geom.attrib_buffers, 0, sizeof(vol_geom_attrib_buffers_t) );
+    geom.attrib_buffers_set = false;
+    if ( !geom.seq_filename || !capacities ) { return false; }
+    geom.attrib_buffers.vertices = ( vol_geom_attrib_t ){ .ptr = vertices_ptr, .capacity = capacities[0] };
+    geom.attrib_buffers.normals  = ( vol_geom_attrib_t ){ .ptr = normals_ptr, .capacity = capacities[1] };
+    geom.attrib_buffers.indices  = ( vol_geom_attrib_t ){ .ptr = indices_ptr, .capacity = capacities[2] };
+    geom.attrib_buffers.uvs      = ( vol_geom_attrib_t ){ .ptr = uvs_ptr, .capacity = capacities[3] };
+    geom.attrib_buffers_set = true;
+    // The next frame is read again, into the new buffers.
+    geom.loaded_frame_idx = -1;
+    return true;
+}
+
+/** Stop writing geometry frames into the buffers registered with `native_vol_set_geom_output_buffers()` */
+DllExport void native_vol_clear_geom_output_buffers(void)
+{
+    memset( &geom.attrib_buffers, 0, sizeof(vol_geom_attrib_buffers_t) );
+    geom.attrib_buffers_set = false;
+    geom.loaded_frame_idx = -1;
+}
+
+/** @returns The largest size in bytes of any attribute array in the open sequence, to size the buffers for `native_vol_set_geom_output_buffers()` */
+DllExport int64_t native_vol_get_geom_max_attrib_size(void)
+{
+    return geom.info.biggest_frame_blob_sz;
+}
+
+/** Read a player's geometry frame into the buffers registered with `native_vol_set_geom_output_buffers()`, or else into `frame_data`.
+ * The flags of the arrays written are added to `attrib_buffers.changed`, so a keyframe read first is reported too */
+static bool _read_geom_frame( vol_interface_geom_t* geom_ptr, int frame_idx )
+{
+    if ( !geom_ptr->attrib_buffers_set ) { return vol_geom_read_frame( geom_ptr->seq_filename, &geom_ptr->info, frame_idx, &geom_ptr->frame_data ); }
+    uint32_t changed = geom_ptr->attrib_buffers.changed;
+    bool ret = vol_geom_read_frame_attribs( geom_ptr->seq_filename, &geom_ptr->info, frame_idx, &geom_ptr->attrib_buffers );
+    geom_ptr->attrib_buffers.changed |= changed;
     return ret;
 }
 
@@ -181,7 +448,7 @@ DllExport bool native_vol_free_geom_data(void)
  */
 DllExport int native_vol_get_geom_frame_count(void)
 {
-    return geom_file_ptr.hdr.frame_count;
+    return geom.info.hdr.frame_count;
 }
 
 /** Reads the specified geometry frame
@@ -191,10 +458,12 @@ DllExport int native_vol_get_geom_frame_count(void)
  */
 DllExport bool native_vol_read_geom_frame(const char* seq_filename, int frame) 
 {
-    if ( frame >= geom_file_ptr.hdr.frame_count )
+    if ( frame >= geom.info.hdr.frame_count )
         return false;
 
-    bool ret = vol_geom_read_frame( seq_filename, &geom_file_ptr, frame, &geom_frame_data );
+    bool ret = vol_geom_read_frame( seq_filename, &geom.info, frame, &geom.frame_data );
+    // This frame isn't in the registered buffers, so the next timestamp-driven read starts its segment again.
+    geom.loaded_frame_idx = ret && !geom.attrib_buffers_set ? frame : -1;
     return ret; 
 }
 
@@ -202,14 +471,30 @@ DllExport bool native_vol_read_geom_frame(const char* seq_filename, int frame)
  * @returns Returns true if the given frame_idx is valid and is also a keyframe, in the currently opened vologram's geometry.
  */
 DllExport bool native_vol_geom_is_keyframe( int frame_idx ) {
-    return vol_geom_is_keyframe( &geom_file_ptr, frame_idx );
+    return vol_geom_is_keyframe( &geom.info, frame_idx );
 }
 
 /**
  * @returns Returns the index of the keyframe prior to frame_idx, in the currently opened vologram's geometry.
  */
 DllExport int native_vol_geom_find_previous_keyframe( int frame_idx ) {
-    return vol_geom_find_previous_keyframe( &geom_file_ptr, frame_idx );
+    return vol_geom_find_previous_keyframe( &geom.info, frame_idx );
+}
+
+/**
+ * @returns Returns the index of the last tracked frame (keyframe value 2) of frame_idx's segment, for playing backwards, or -1 if there isn't one.
+ */
+DllExport int native_vol_geom_find_reverse_keyframe( int frame_idx ) {
+    return vol_geom_find_reverse_keyframe( &geom.info, frame_idx );
+}
+
+/** @returns Index of the keyframe (value 1) that starts the segment `frame_idx` is in. Frames in a segment share their indices and UVs. */
+static int _geom_segment_start( const vol_interface_geom_t* geom_ptr, int frame_idx )
+{
+    for ( int i = frame_idx; i > 0; i-- ) {
+        if ( 1 == geom_ptr->info.frame_headers_ptr[i].keyframe ) { return i; }
+    }
+    return 0;
 }
 
 /** Get the geometry data of the current loaded frame
@@ -217,7 +502,15 @@ DllExport int native_vol_geom_find_previous_keyframe( int frame_idx ) {
  */
 DllExport vol_geom_frame_data_t native_vol_get_geom_ptr_data(void)
 {
-    return geom_frame_data;
+    return geom.frame_data;
+}
+
+/** Get the keyframe data, with indices and UVs, for the frame last read by `native_vol_read_frame_at_time()`
+ @returns   Struct containing details of the keyframe's geometry data. Only valid when that call reported `geom_keyframe`
+ */
+DllExport vol_geom_frame_data_t native_vol_get_geom_key_ptr_data(void)
+{
+    return geom.key_frame_data;
 }
 
 /** Gets the geom info struct including the data of the last loaded mesh
@@ -225,7 +518,7 @@ DllExport vol_geom_frame_data_t native_vol_get_geom_ptr_data(void)
  */
 DllExport vol_geom_info_t native_vol_get_geom_info(void)
 {
-    return geom_file_ptr;
+    return geom.info;
 }
 
 /**
@@ -244,6 +537,126 @@ static double vid_dur = 0.0;
 static int64_t vid_num_frms = 0;
 /** The number of bytes in a single from of the loaded video */
 static int vid_frm_size = 0;
+/** Whole video file read into memory by `native_vol_open_video_file_preloaded()`, freed when the video is closed */
+static uint8_t* vid_preload_ptr = NULL;
+static int64_t vid_preload_sz = 0;
+
+/** Buffers decoded frames are handed to the render thread in: the newest frame, one the render thread may still be reading, and one to decode into */
+#define VOL_INTERFACE_RENDER_BUFFERS 3
+/** Video frames are decoded into `render_buffers` for the render thread to upload. See `native_vol_set_render_thread_upload()` */
+static bool render_upload_enabled = false;
+static uint8_t* render_buffers[VOL_INTERFACE_RENDER_BUFFERS];
+/** Size in bytes of each of `render_buffers`, as allocated when the upload was turned on */
+static int64_t render_buffer_sz = 0;
+/** Main thread only. The buffer holds a published frame, and hasn't been given back to vol_av yet */
+static bool render_buffer_held[VOL_INTERFACE_RENDER_BUFFERS];
+/** Image dimensions of each buffer. Written before the buffer is published */
+static int render_buffer_w[VOL_INTERFACE_RENDER_BUFFERS], render_buffer_h[VOL_INTERFACE_RENDER_BUFFERS];
+/** Written by the main thread: the buffer with the newest frame, or -1 */
+static volatile int32_t render_latest_idx = -1;
+/** Written by the render thread: the buffer it is uploading from, or -1. The main thread doesn't give this buffer back to vol_av */
+static volatile int32_t render_reading_idx = -1;
+/** Render thread only. Frames are expanded into this for 4-channel textures. Only freed while the render thread holds no claim */
+static uint8_t* render_rgba_ptr = NULL;
+/** Size of `render_rgba_ptr`. Only changed with `render_rgba_lock` held, so `native_vol_get_memory_usage()` can read it from the main thread */
+static size_t render_rgba_sz = 0;
+static vol_mutex_t render_rgba_lock = VOL_MUTEX_INITIALIZER;
+
+/** Publish the frame vol_av just decoded into one of `render_buffers` to the render thread, and give back any older frames it isn't reading */
+static void _publish_render_frame( void )
+{
+    int idx = video_file_ptr.buffer_idx;
+    if ( !render_upload_enabled || idx < 0 || idx == _atomic_load_i32( &render_latest_idx ) ) { return; }
+
+    render_buffer_w[idx] = video_file_ptr.w;
+    render_buffer_h[idx] = video_file_ptr.h;
+    render_buffer_held[idx] = true;
+    _atomic_store_i32( &render_latest_idx, idx );
+    // The render thread only starts reading a buffer that is still the newest once it has said so, so an older buffer it hasn't claimed is free.
+    int reading_idx = _atomic_load_i32( &render_reading_idx );
+    for ( int i = 0; i < VOL_INTERFACE_RENDER_BUFFERS; i++ ) {
+        if ( !render_buffer_held[i] || i == idx || i == reading_idx ) { continue; }
+        vol_av_release_output_buffer( &video_file_ptr, i );
+        render_buffer_held[i] = false;
+    }
+}
+
+#ifdef ENABLE_UNITY_RENDER_FUNCS // Only the texture update callback runs on the render thread.
+/** Called on the render thread. Claim the buffer with the newest frame, so it isn't decoded into until `_release_render_frame()`
+ @returns   Index of the buffer, or -1 if there is no frame, in which case nothing is claimed
+ */
+static int _acquire_render_frame( void )
+{
+    for ( int i = 0; i < 4; i++ ) {
+        int idx = _atomic_load_i32( &render_latest_idx );
+        if ( idx < 0 ) { break; } // Uploads were stopped after an earlier claim, which `_stop_render_upload()` is waiting on.
+        _atomic_store_i32( &render_reading_idx, idx );
+        // If a newer frame was published meanwhile, the main thread may have given this buffer back before seeing the claim.
+        if ( _atomic_load_i32( &render_latest_idx ) == idx ) { return idx; }
+    }
+    _atomic_store_i32( &render_reading_idx, -1 );
+    return -1;
+}
+
+/** Called on the render thread when it has finished reading the buffer from `_acquire_render_frame()`, and anything made from it */
+static void _release_render_frame( void )
+{
+    _atomic_store_i32( &render_reading_idx, -1 );
+}
+#endif
+
+/** Stop handing frames to the render thread, and free the buffers once it has finished with them */
+static void _stop_render_upload( void )
+{
+    if ( !render_upload_enabled ) { return; }
+    _atomic_store_i32( &render_latest_idx, -1 );
+    while ( _atomic_load_i32( &render_reading_idx ) >= 0 ) { _sleep_ms( 1 ); }
+    vol_av_set_output_buffers( &video_file_ptr, NULL, 0, 0 );
+    for ( int i = 0; i < VOL_INTERFACE_RENDER_BUFFERS; i++ ) {
+        free( render_buffers[i] );
+        render_buffers[i] = NULL;
+        render_buffer_held[i] = false;
+    }
+    free( render_rgba_ptr );
+    render_rgba_ptr = NULL;
+    _mutex_lock( &render_rgba_lock );
+    render_rgba_sz = 0;
+    _mutex_unlock( &render_rgba_lock );
+    render_buffer_sz = 0;
+    render_upload_enabled = false;
+}
+
+/** Cache the details of a video that was just opened */
+static void _read_video_info( void )
+{
+    vol_av_dimensions( &video_file_ptr, &vid_w, &vid_h );
+    vid_num_frms = vol_av_frame_count( &video_file_ptr );
+    vid_dur = vol_av_duration_s( &video_file_ptr );
+    vid_frm_size = vid_w * vid_h * 3;
+}
+
+/** Read a whole file into memory
+ @param filename    Path to the file
+ @param size_ptr    Set to the size of the file in bytes
+ @returns           The file's contents, to be freed by the caller, or NULL on error
+ */
+static uint8_t* _read_whole_file( const char* filename, long* size_ptr )
+{
+    FILE* f_ptr = fopen( filename, "rb" );
+    if ( !f_ptr ) { return NULL; }
+    fseek( f_ptr, 0, SEEK_END );
+    long size = ftell( f_ptr );
+    fseek( f_ptr, 0, SEEK_SET );
+    uint8_t* data_ptr = size > 0 ? malloc( size ) : NULL;
+    bool read_ok = data_ptr && fread( data_ptr, size, 1, f_ptr ) == 1;
+    fclose( f_ptr );
+    if ( !read_ok ) {
+        free( data_ptr );
+        return NULL;
+    }
+    *size_ptr = size;
+    return data_ptr;
+}
 
 /** Open the video texture file for a vologram
  @param filename    Path to the video texture file
@@ -256,16 +669,39 @@ DllExport bool native_vol_open_video_file(const char* filename)
 #ifdef VOL_TEST_TIMERS
     apg_time_init();
 #endif
-    if ( ret ) {
-        vol_av_dimensions( &video_file_ptr, &vid_w, &vid_h );
-        vid_num_frms = vol_av_frame_count( &video_file_ptr );
-        vid_dur = vol_av_duration_s( &video_file_ptr );
-        vid_frm_size = vid_w * vid_h * 3;
-    }
+    if ( ret ) { _read_video_info(); }
     
     return ret;
 }
 
+/** Open a video texture file that is already in memory
+ @param data        The whole video file. Must stay allocated until the video is closed
+ @param size        Size of `data` in bytes
+ @returns           `true` if the video was opened sucessfully, `false` otherwise
+ */
+DllExport bool native_vol_open_video_memory( const uint8_t* data, int64_t size )
+{
+    memset( &video_file_ptr, 0, sizeof(vol_av_video_t));
+    bool ret = vol_av_open_memory( data, size, 0, &video_file_ptr );
+    if ( ret ) { _read_video_info(); }
+
+    return ret;
+}
+
+/** Read the whole video texture file into memory and open it from there, so playback doesn't read from disk. Best for short clips
+ @param filename    Path to the video texture file
+ @returns           `true` if file was read and opened sucessfully, `false` otherwise
+ */
+DllExport bool native_vol_open_video_file_preloaded( const char* filename )
+{
+    free( vid_preload_ptr );
+    long size = 0;
+    vid_preload_ptr = _read_whole_file( filename, &size );
+    vid_preload_sz = vid_preload_ptr ? size : 0;
+    if ( !vid_preload_ptr ) { return false; }
+    return native_vol_open_video_memory( vid_preload_ptr, size );
+}
+
 /** Close the video texture file
  @returns   `true` if the file was closed sucessfully, `false` otherwise
  */
@@ -276,7 +712,221 @@ DllExport bool native_vol_close_video_file(void)
     vid_dur = 0.0;
     vid_num_frms = 0;
     vid_frm_size = 0;
-    return vol_av_close( &video_file_ptr );
+    _stop_render_upload();
+    bool ret = vol_av_close( &video_file_ptr );
+    // Only after closing, as the decoder reads from it.
+    free( vid_preload_ptr );
+    vid_preload_ptr = NULL;
+    vid_preload_sz = 0;
+    vid_in_geom_pack = false;
+    return ret;
+}
+
+/** Open the geometry and video of a packed vologram, made by the vol_pack tool, which holds them both in one file.
+ * The file is memory-mapped once. Geometry frames and video packets are read from their offsets in the mapping.
+ * Read frames with the pack's path as the sequence file. Freeing the geometry closes the video too
+ @param pack_filename   Path to the packed vologram
+ @returns               If the operation was successful. A pack without a video section opens its geometry only
+ */
+DllExport bool native_vol_open_packed_file(const char* pack_filename)
+{
+    memset(&geom.info, 0, sizeof(vol_geom_info_t));
+    if ( !vol_geom_create_packed_file_info( pack_filename, &geom.info, VOL_GEOM_LOAD_PRELOAD ) )
+        return false;
+    _geom_file_opened( &geom, pack_filename );
+
+    if ( 0 == geom.info.pack_hdr.video_sz )
+        return true;
+    const uint8_t* video_ptr = &geom.info.sequence_blob_byte_ptr[geom.info.pack_hdr.video_offset];
+    if ( !native_vol_open_video_memory( video_ptr, (int64_t)geom.info.pack_hdr.video_sz ) ) {
+        native_vol_free_geom_data();
+        return false;
+    }
+    vid_in_geom_pack = true;
+    return true;
+}
+
+/**
+ * Asynchronous open
+ */
+
+/** Progress of `native_vol_open_async()`. Matches `VolEnums.OpenStatus` */
+typedef enum vol_interface_open_status_t {
+    VOL_INTERFACE_OPEN_NONE = 0,
+    VOL_INTERFACE_OPEN_PENDING,
+    VOL_INTERFACE_OPEN_READY,
+    VOL_INTERFACE_OPEN_FAILED,
+    VOL_INTERFACE_OPEN_CANCELLED
+} vol_interface_open_status_t;
+
+/** A vologram being opened on a worker thread. The worker only writes to this, until it sets `status` to a final value */
+typedef struct vol_interface_async_open_t {
+    char* hdr_filename;
+    char* seq_filename;
+    /** NULL if the vologram has no video texture */
+    char* video_filename;
+    vol_geom_load_mode_t load_mode;
+    bool preload_video;
+    vol_geom_info_t geom;
+    vol_av_video_t video;
+    uint8_t* video_preload_ptr;
+    int64_t video_preload_sz;
+    /** A `vol_interface_open_status_t`. Set by the worker when it finishes */
+    volatile int32_t status;
+    /** Set by the main thread to ask the worker to stop after its current step */
+    volatile int32_t cancel;
+    vol_thread_t thread;
+    /** The worker was started and hasn't been joined yet */
+    bool thread_running;
+} vol_interface_async_open_t;
+
+static vol_interface_async_open_t async_open;
+
+static char* _copy_str( const char* str )
+{
+    if ( !str ) { return NULL; }
+    size_t len = strlen( str );
+    char* copy_ptr = malloc( len + 1 );
+    if ( copy_ptr ) { memcpy( copy_ptr, str, len + 1 ); }
+    return copy_ptr;
+}
+
+/** Free whatever the worker opened, when the open failed or was cancelled */
+static void _free_async_open( void )
+{
+    if ( async_open.geom.frames_directory_ptr ) { vol_geom_free_file_info( &async_open.geom ); }
+    if ( async_open.video._context_ptr ) { vol_av_close( &async_open.video ); }
+    free( async_open.video_preload_ptr );
+    free( async_open.hdr_filename );
+    free( async_open.seq_filename );
+    free( async_open.video_filename );
+    memset( &async_open, 0, sizeof(vol_interface_async_open_t) );
+}
+
+/** Opens the geometry and then the video of `async_open`, checking for cancellation between the two */
+static vol_interface_open_status_t _async_open_run( void )
+{
+    if ( !vol_geom_create_shared_file_info_ex( async_open.hdr_filename, async_open.seq_filename, &async_open.geom, async_open.load_mode ) ) {
+        return VOL_INTERFACE_OPEN_FAILED;
+    }
+    if ( _atomic_load_i32( &async_open.cancel ) ) { return VOL_INTERFACE_OPEN_CANCELLED; }
+    if ( !async_open.video_filename ) { return VOL_INTERFACE_OPEN_READY; }
+
+    bool opened = false;
+    if ( async_open.preload_video ) {
+        long size = 0;
+        async_open.video_preload_ptr = _read_whole_file( async_open.video_filename, &size );
+        if ( !async_open.video_preload_ptr ) { return VOL_INTERFACE_OPEN_FAILED; }
+        async_open.video_preload_sz = size;
+        if ( _atomic_load_i32( &async_open.cancel ) ) { return VOL_INTERFACE_OPEN_CANCELLED; }
+        opened = vol_av_open_memory( async_open.video_preload_ptr, size, 0, &async_open.video );
+    } else {
+        opened = vol_av_open( async_open.video_filename, &async_open.video );
+    }
+    if ( !opened ) { return VOL_INTERFACE_OPEN_FAILED; }
+    if ( _atomic_load_i32( &async_open.cancel ) ) { return VOL_INTERFACE_OPEN_CANCELLED; }
+    return VOL_INTERFACE_OPEN_READY;
+}
+
+static VOL_THREAD_FUNC _async_open_thread_main( void* arg_ptr )
+{
+    (void)arg_ptr;
+    _atomic_store_i32( &async_open.status, (int32_t)_async_open_run() );
+    return VOL_THREAD_RETURN;
+}
+
+/** Join the worker if it has finished
+ @returns   The open's status
+ */
+static vol_interface_open_status_t _reap_async_open( void )
+{
+    vol_interface_open_status_t status = (vol_interface_open_status_t)_atomic_load_i32( &async_open.status );
+    if ( VOL_INTERFACE_OPEN_PENDING == status || !async_open.thread_running ) { return status; }
+    _thread_join( async_open.thread );
+    async_open.thread_running = false;
+    return status;
+}
+
+/** Start opening a vologram's geometry and video texture on a worker thread, so the calling thread doesn't stall on the file I/O and stream probing.
+ * Poll `native_vol_poll_open()` until it stops returning pending. No vologram may be open, and the getters and frame functions can't be used until
+ * the open is ready
+ @param hdr_filename    Path to the geometry header file
+ @param seq_filename    Path to the geometry sequence file
+ @param load_mode       A `vol_geom_load_mode_t`, for how the geometry sequence is read, as chosen by the other geometry open functions.
+                        `VOL_GEOM_LOAD_AUTO` uses the budget from `native_vol_set_memory_budget()`
+ @param video_filename  Path to the video texture file, or NULL for no video
+ @param preload_video   Read the whole video file into memory, as for `native_vol_open_video_file_preloaded()`
+ @returns               `false` if a vologram is open, another open is still running, `load_mode` is unknown, or the worker couldn't be started
+ */
+DllExport bool native_vol_open_async( const char* hdr_filename, const char* seq_filename, int load_mode, const char* video_filename, bool preload_video )
+{
+    if ( !hdr_filename || !seq_filename || geom.seq_filename || video_file_ptr._context_ptr ) { return false; }
+    if ( load_mode < VOL_GEOM_LOAD_STREAMING || load_mode > VOL_GEOM_LOAD_AUTO ) {
+        log_callback( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: unknown geometry load mode for async open" );
+        return false;
+    }
+    // A cancelled open may still be finishing its current step.
+    if ( VOL_INTERFACE_OPEN_PENDING == _reap_async_open() ) { return false; }
+    _free_async_open();
+
+    async_open.hdr_filename   = _copy_str( hdr_filename );
+    async_open.seq_filename   = _copy_str( seq_filename );
+    async_open.video_filename = _copy_str( video_filename );
+    async_open.load_mode      = (vol_geom_load_mode_t)load_mode;
+    async_open.preload_video  = preload_video;
+    async_open.status         = VOL_INTERFACE_OPEN_PENDING;
+    if ( !async_open.hdr_filename || !async_open.seq_filename || ( video_filename && !async_open.video_filename ) ) {
+        _free_async_open();
+        return false;
+    }
+    async_open.thread_running = _thread_create( &async_open.thread, _async_open_thread_main, NULL );
+    if ( !async_open.thread_running ) {
+        _free_async_open();
+        return false;
+    }
+    return true;
+}
+
+/** Check on `native_vol_open_async()`. When the open is ready, the vologram becomes the open one, as if it had been opened with
+ * `native_vol_open_geom_file()` and one of the video open functions. Failed and cancelled opens are cleaned up.
+ * A final status is only returned once, after which this returns `VOL_INTERFACE_OPEN_NONE`
+ @returns   A `vol_interface_open_status_t`
+ */
+DllExport int native_vol_poll_open(void)
+{
+    vol_interface_open_status_t status = _reap_async_open();
+    if ( VOL_INTERFACE_OPEN_PENDING == status || VOL_INTERFACE_OPEN_NONE == status ) { return status; }
+    // A cancel that arrived after the worker finished still wins.
+    if ( _atomic_load_i32( &async_open.cancel ) ) { status = VOL_INTERFACE_OPEN_CANCELLED; }
+    if ( VOL_INTERFACE_OPEN_READY == status ) {
+        // Something may have been opened the usual way while the worker ran. It is replaced, rather than leaked under the new vologram.
+        if ( geom.seq_filename ) { native_vol_free_geom_data(); }
+        if ( video_file_ptr._context_ptr ) { native_vol_close_video_file(); }
+        geom.info = async_open.geom;
+        _geom_file_opened( &geom, async_open.seq_filename );
+        memset( &async_open.geom, 0, sizeof(vol_geom_info_t) );
+        if ( async_open.video._context_ptr ) {
+            video_file_ptr = async_open.video;
+            vid_preload_ptr = async_open.video_preload_ptr;
+            vid_preload_sz = async_open.video_preload_sz;
+            _read_video_info();
+            memset( &async_open.video, 0, sizeof(vol_av_video_t) );
+            async_open.video_preload_ptr = NULL;
+        }
+    }
+    _free_async_open();
+    return status;
+}
+
+/** Stop a `native_vol_open_async()`, and close whatever it opened. Waits for the worker to finish the step it is on, e.g. reading the video file
+ * into memory, so it can't be left running after a scene is unloaded. Afterwards `native_vol_poll_open()` returns `VOL_INTERFACE_OPEN_NONE` */
+DllExport void native_vol_cancel_open(void)
+{
+    if ( !async_open.thread_running ) { return; }
+    _atomic_store_i32( &async_open.cancel, 1 );
+    _thread_join( async_open.thread );
+    async_open.thread_running = false;
+    _free_async_open();
 }
 
 /** Get the width in pixels of the video
@@ -363,56 +1013,626 @@ static void _image_flip_vertical( uint8_t* bytes_ptr, int width, int height, int
 DllExport uint8_t * native_vol_read_next_video_frame( bool flip_vertical )
 {
     vol_av_read_next_frame( &video_file_ptr );
-    if ( flip_vertical ) { _image_flip_vertical(video_file_ptr.pixels_ptr, vid_w, vid_h, 3); }
+    if ( flip_vertical ) { _image_flip_vertical(video_file_ptr.pixels_ptr, video_file_ptr.w, video_file_ptr.h, 3); }
     return video_file_ptr.pixels_ptr;
 }
-    
-#ifdef ENABLE_UNITY_RENDER_FUNCS
-/**
- UNITY RENDERING FUNCTIONS
+
+/** Set the resolution video frames are converted to. The width, height, and frame size reported for the video are updated to match
+ @param level   0 for full size, 1 for half, or 2 for quarter width and height
+ @returns       `true` if the level was valid
  */
-    
-    // FOR TESTING REMOVE
-    uint32_t Plasma(int x, int y, int width, int height, unsigned int frame)
-    {
-        float px = (float)x / width;
-        float py = (float)y / height;
-        float time = frame / 60.0f;
+DllExport bool native_vol_set_video_output_scale( int level )
+{
+    if ( !vol_av_set_output_scale( &video_file_ptr, level ) ) { return false; }
+    vol_av_output_dimensions( &video_file_ptr, &vid_w, &vid_h );
+    vid_frm_size = vid_w * vid_h * 3;
+    return true;
+}
 
-        float l = sinf(px * sinf(time * 1.3f) + sinf(py * 4 + time) * sinf(time));
+/** Set the memory allowed for caching converted video frames while playing backwards. See `vol_av_set_reverse_cache_size()`
+ @param max_bytes   Maximum size of the cache in bytes, or 0 to turn it off
+ @returns           `true` if successful
+ */
+DllExport bool native_vol_set_video_reverse_cache_size( int64_t max_bytes )
+{
+    return vol_av_set_reverse_cache_size( &video_file_ptr, max_bytes );
+}
 
-        uint32_t r = sinf(l *  6) * 127 + 127;
-        uint32_t g = sinf(l *  7) * 127 + 127;
-        uint32_t b = sinf(l * 10) * 127 + 127;
+/** Choose the format video frames are given in by `native_vol_read_frame_at_time()` and `native_vol_scrub_to_time()`.
+ * Compressed formats are encoded on the CPU as frames are decoded, and upload 6x smaller than RGB. See `vol_av_set_output_compression()`
+ @param format  0 for RGB24, 1 for BC1 (DXT1), or 2 for ETC2 RGB. Matches `VolEnums.VideoTextureFormat`
+ @returns       `true` if successful
+ */
+DllExport bool native_vol_set_video_texture_format( int format )
+{
+    return vol_av_set_output_compression( &video_file_ptr, (vol_av_texture_format_t)format );
+}
+
+/** Register caller-owned memory that video frames are decoded into, instead of the video's internal storage
+ @param buffers     Array of pointers to the buffers. They must stay allocated until the video is closed
+ @param n_buffers   Number of buffers. With two or more, a frame can be uploaded while the next is decoded
+ @param buffer_size Size of each buffer in bytes. Must be at least `native_vol_get_video_frame_size()`
+ @returns           `true` if the buffers were registered
+ */
+DllExport bool native_vol_set_video_output_buffers( uint8_t** buffers, int n_buffers, int64_t buffer_size )
+{
+    return vol_av_set_output_buffers( &video_file_ptr, buffers, n_buffers, buffer_size );
+}
+
+/** Get which registered output buffer holds the last frame returned by `native_vol_read_next_video_frame()`
+ @returns   Index of the buffer, or -1 if frames are not being decoded into registered buffers
+ */
+DllExport int native_vol_get_video_output_buffer_index(void)
+{
+    return video_file_ptr.buffer_idx;
+}
+
+/** Hand a registered output buffer back once the caller has finished with the frame in it
+ @param buffer_idx  Index of the buffer to release
+ */
+DllExport void native_vol_release_video_output_buffer( int buffer_idx )
+{
+    vol_av_release_output_buffer( &video_file_ptr, buffer_idx );
+}
+
+/** Decode video frames into native buffers that the render thread uploads from, with the callback from `get_texture_update_callback()`,
+ * instead of the application copying each frame to the GPU. Frames still come from `native_vol_read_frame_at_time()` or `native_vol_scrub_to_time()`.
+ * The newest frame is handed over without copying it, and a buffer isn't decoded into again until the render thread has finished reading it
+ @param enabled     Turn the render thread upload on or off. Must be called after opening the video file
+ @returns           `true` if successful
+ */
+DllExport bool native_vol_set_render_thread_upload( bool enabled )
+{
+    _stop_render_upload();
+    if ( !enabled ) { return true; }
+    if ( !video_file_ptr._context_ptr ) { return false; }
 
-        return r + (g << 8) + (b << 16) + 0xff000000u;
+    int64_t buffer_sz = (int64_t)vid_w * vid_h * 3;
+    for ( int i = 0; i < VOL_INTERFACE_RENDER_BUFFERS; i++ ) {
+        render_buffers[i] = malloc( (size_t)buffer_sz );
+        if ( !render_buffers[i] ) {
+            render_upload_enabled = true; // So the buffers allocated so far are freed.
+            _stop_render_upload();
+            return false;
+        }
     }
-    
-void _texture_update_callback( int event_id, void *data)
-{
-    if (event_id == kUnityRenderingExtEventUpdateTextureBeginV2)
-    {
-        // UpdateTextureBegin: Generate and return texture image data.
-        UnityRenderingExtTextureUpdateParamsV2 *params = data;
-                        
-        //uint32_t *img = malloc(params->width * params->height * 4);
-        //memcpy(img, video_file_ptr.pixels_ptr, params->width * params->height * 3);
-        
-        //params->format = kUnityRenderingExtFormatR8G8B8_UInt;
-        params->texData = video_file_ptr.pixels_ptr;
+    render_upload_enabled = true;
+    render_buffer_sz = buffer_sz;
+    if ( !vol_av_set_output_buffers( &video_file_ptr, render_buffers, VOL_INTERFACE_RENDER_BUFFERS, buffer_sz ) ) {
+        _stop_render_upload();
+        return false;
+    }
+    return true;
+}
+
+/** Start decoding the video on a background thread. Use `native_vol_acquire_video_frame()` instead of `native_vol_read_next_video_frame()` after this.
+ @param n_buffers       Number of decoded frames that can be queued ahead of playback, including the one being displayed
+ @param flip_vertical   Vertically mirror frames as they are decoded
+ @returns               `true` if the thread was started
+ */
+DllExport bool native_vol_start_video_decode_thread( int n_buffers, bool flip_vertical )
+{
+    return vol_av_start_decode_thread( &video_file_ptr, n_buffers, flip_vertical );
+}
+
+/** Start a pool of decode workers shared by every video decoded on a background thread. Call before opening the video file.
+ @param n_workers   Number of worker threads, or 0 for one per CPU core
+ @returns           `true` if the pool was started
+ */
+DllExport bool native_vol_start_decode_scheduler( int n_workers )
+{
+    return vol_av_start_decode_scheduler( n_workers );
+}
+
+/** Stop the shared decode workers. Stop any video decode thread, or close the video file, first.
+ @returns   `true` if the pool was stopped
+ */
+DllExport bool native_vol_stop_decode_scheduler(void)
+{
+    return vol_av_stop_decode_scheduler();
+}
+
+/** Set how urgently the shared decode workers serve the video, e.g. from how much of the screen the vologram covers
+ @param priority    1 by default. 0 marks the vologram as culled, so it is only decoded when the workers are otherwise idle
+ */
+DllExport void native_vol_set_video_decode_priority( float priority )
+{
+    vol_av_set_decode_priority( &video_file_ptr, priority );
+}
+
+/** Get the newest decoded video frame that is due at the given playback time
+ @param pts_s   Playback time in seconds
+ @returns       Pointer to the video frame pixel data, or NULL if no frame is ready. Valid until the next call
+ */
+DllExport uint8_t * native_vol_acquire_video_frame( double pts_s )
+{
+    if ( !vol_av_acquire_frame( &video_file_ptr, pts_s ) ) { return NULL; }
+    return video_file_ptr.pixels_ptr;
+}
+
+/** Frame rate used to map time to geometry frames when there is no video texture */
+#define VOL_INTERFACE_DEFAULT_FPS 30.0
+
+/** Result of `native_vol_read_frame_at_time()`. Matches `VolPluginInterface.VolFrameResult` */
+typedef struct vol_interface_frame_result_t {
+    /** Video image for the frame, or NULL if there is no video. Block-compressed if `native_vol_set_video_texture_format()` chose a compressed format */
+    uint8_t* pixels_ptr;
+    /** Presentation time of the video image in seconds */
+    double pts_s;
+    /** Index of the frame shown, for both the video and the geometry */
+    int32_t frame_idx;
+    /** The video image is new since the last call and should be uploaded */
+    bool video_changed;
+    /** New geometry was read, and `native_vol_get_geom_ptr_data()` points to it */
+    bool geom_changed;
+    /** The geometry just read is, or follows, a newly read keyframe, so indices and UVs have changed too. See `native_vol_get_geom_key_ptr_data()` */
+    bool geom_keyframe;
+    /** The requested time is past the last frame */
+    bool end_of_stream;
+    /** Dimensions of the video image, which are smaller than the video's for scrub previews or a reduced output scale */
+    int32_t w, h;
+    /** Size in bytes of the image at `pixels_ptr` */
+    int64_t data_sz;
+    /** `vol_geom_attrib_flags_t` bits for the arrays written into the buffers registered with `native_vol_set_geom_output_buffers()`, so only those
+     * need uploading. 0 if no buffers are registered */
+    uint32_t geom_attribs_changed;
+    /** Sizes in bytes of the arrays in the registered buffers */
+    int32_t vertices_sz, normals_sz, indices_sz, uvs_sz;
+} vol_interface_frame_result_t;
+
+/** Start a player's frame result, and work out the frame count and the frame index for a time, for the frame functions below */
+static void _begin_frame_result( vol_interface_geom_t* geom_ptr, const vol_av_video_t* video_ptr, double seconds, vol_interface_frame_result_t* result_ptr, int* frame_idx_ptr, int* n_frames_ptr )
+{
+    memset( result_ptr, 0, sizeof(vol_interface_frame_result_t) );
+    geom_ptr->attrib_buffers.changed = 0;
+    bool has_video = video_ptr->_context_ptr != NULL;
+    double fps = has_video ? vol_av_frame_rate( video_ptr ) : 0.0;
+    if ( fps <= 0.0 ) { fps = VOL_INTERFACE_DEFAULT_FPS; }
+    *n_frames_ptr = geom_ptr->info.hdr.frame_count;
+    if ( has_video && 0 == *n_frames_ptr ) { *n_frames_ptr = (int)vol_av_frame_count( video_ptr ); }
+    *frame_idx_ptr = (int)( seconds * fps );
+    result_ptr->end_of_stream = *frame_idx_ptr >= *n_frames_ptr;
+}
+
+/** Fill in the registered geometry buffers' part of a frame result, after a geometry frame was read into them */
+static void _geom_buffers_result( const vol_interface_geom_t* geom_ptr, vol_interface_frame_result_t* result_ptr )
+{
+    if ( !geom_ptr->attrib_buffers_set ) { return; }
+    result_ptr->geom_attribs_changed = geom_ptr->attrib_buffers.changed;
+    result_ptr->vertices_sz          = geom_ptr->attrib_buffers.vertices.sz;
+    result_ptr->normals_sz           = geom_ptr->attrib_buffers.normals.sz;
+    result_ptr->indices_sz           = geom_ptr->attrib_buffers.indices.sz;
+    result_ptr->uvs_sz               = geom_ptr->attrib_buffers.uvs.sz;
+}
+
+/** Fill in the video part of a frame result, after vol_av has delivered a frame. `prev_pts_s` is the time of the frame delivered before */
+static void _video_frame_result( const vol_av_video_t* video_ptr, double prev_pts_s, vol_interface_frame_result_t* result_ptr, int* frame_idx_ptr )
+{
+    result_ptr->pixels_ptr    = video_ptr->compressed_ptr ? video_ptr->compressed_ptr : video_ptr->pixels_ptr;
+    result_ptr->data_sz       = video_ptr->compressed_ptr ? video_ptr->compressed_sz : (int64_t)video_ptr->w * video_ptr->h * 3;
+    result_ptr->pts_s         = video_ptr->pts_s;
+    result_ptr->w             = video_ptr->w;
+    result_ptr->h             = video_ptr->h;
+    result_ptr->video_changed = video_ptr->pts_s != prev_pts_s;
+    *frame_idx_ptr            = (int)video_ptr->frame_idx;
+}
+
+/** Bring a player's video and geometry to the frame that should be shown at a playback time. See `native_vol_read_frame_at_time()` */
+static bool _read_frame_at_time( vol_interface_geom_t* geom_ptr, vol_av_video_t* video_ptr, double seconds, bool flip_vertical, vol_interface_frame_result_t* result_ptr )
+{
+    int frame_idx = 0, n_frames = 0;
+    _begin_frame_result( geom_ptr, video_ptr, seconds, result_ptr, &frame_idx, &n_frames );
+
+    if ( video_ptr->_context_ptr ) {
+        double prev_pts_s = video_ptr->pixels_ptr ? video_ptr->pts_s : -1.0;
+        if ( !vol_av_read_frame_at_time( video_ptr, seconds, flip_vertical ) ) { return false; }
+        _video_frame_result( video_ptr, prev_pts_s, result_ptr, &frame_idx );
+    }
+    if ( n_frames > 0 && frame_idx >= n_frames ) { frame_idx = n_frames - 1; }
+    result_ptr->frame_idx = frame_idx;
+
+    if ( !geom_ptr->seq_filename || frame_idx == geom_ptr->loaded_frame_idx ) { return true; }
+    // A tracked frame only stores vertices, so the indices and UVs of its segment must be loaded first if we came from another segment.
+    // Going forwards they are in the keyframe that starts the segment. Going backwards, v12 segments also end with a copy, so reverse play
+    // loads the frame it was going to show next anyway instead of going back to the start of the segment.
+    bool is_key = vol_geom_is_keyframe( &geom_ptr->info, frame_idx );
+    bool same_segment = geom_ptr->loaded_frame_idx >= 0 && _geom_segment_start( geom_ptr, frame_idx ) == _geom_segment_start( geom_ptr, geom_ptr->loaded_frame_idx );
+    int key_idx = -1;
+    if ( !is_key && !same_segment ) {
+        if ( frame_idx < geom_ptr->loaded_frame_idx ) { key_idx = vol_geom_find_reverse_keyframe( &geom_ptr->info, frame_idx ); }
+        if ( key_idx < 0 ) { key_idx = vol_geom_find_previous_keyframe( &geom_ptr->info, frame_idx ); }
     }
-    else if (event_id == kUnityRenderingExtEventUpdateTextureEndV2)
-    {
-        // UpdateTextureEnd: Free up the temporary memory.
-        UnityRenderingExtTextureUpdateParamsV2 *params = data;
-        if ( params->texData )
-        {
-            free(params->texData);
+    if ( key_idx >= 0 && geom_ptr->attrib_buffers_set ) {
+        // The keyframe's indices and UVs stay in the application's buffers, as tracked frames don't overwrite them.
+        if ( !_read_geom_frame( geom_ptr, key_idx ) ) { return false; }
+        result_ptr->geom_keyframe = true;
+    } else if ( key_idx >= 0 ) {
+        if ( !vol_geom_read_frame( geom_ptr->seq_filename, &geom_ptr->info, key_idx, &geom_ptr->frame_data ) ) { return false; }
+        // Reading the tracked frame reuses the same memory, so keep a copy of the keyframe's block for its indices and UVs.
+        if ( geom_ptr->frame_data.block_data_sz > geom_ptr->key_blob_sz ) {
+            uint8_t* tmp_ptr = realloc( geom_ptr->key_blob_ptr, (size_t)geom_ptr->frame_data.block_data_sz );
+            if ( !tmp_ptr ) { return false; }
+            geom_ptr->key_blob_ptr = tmp_ptr;
+            geom_ptr->key_blob_sz = geom_ptr->frame_data.block_data_sz;
         }
+        memcpy( geom_ptr->key_blob_ptr, geom_ptr->frame_data.block_data_ptr, (size_t)geom_ptr->frame_data.block_data_sz );
+        geom_ptr->key_frame_data = geom_ptr->frame_data;
+        geom_ptr->key_frame_data.block_data_ptr = geom_ptr->key_blob_ptr;
+        result_ptr->geom_keyframe = true;
+    }
+    if ( !_read_geom_frame( geom_ptr, frame_idx ) ) {
+        geom_ptr->loaded_frame_idx = -1;
+        return false;
     }
+    geom_ptr->loaded_frame_idx = frame_idx;
+    result_ptr->geom_changed = true;
+    _geom_buffers_result( geom_ptr, result_ptr );
+    if ( is_key ) {
+        geom_ptr->key_frame_data = geom_ptr->frame_data;
+        result_ptr->geom_keyframe = true;
+    }
+    return true;
+}
+
+/** Bring the video and geometry to the frame that should be shown at a playback time, in one call.
+ * The video frame is picked by its timestamp, and the geometry frame matches the video frame that was actually delivered.
+ * Geometry is only read when the frame changes, and the keyframe a tracked frame depends on is read first when needed
+ @param seconds         Playback time from the start of the vologram
+ @param flip_vertical   Vertically mirror the video image
+ @param result_ptr      Filled with what was delivered and what changed
+ @returns               `false` on a decoding or file error
+ */
+DllExport bool native_vol_read_frame_at_time( double seconds, bool flip_vertical, vol_interface_frame_result_t* result_ptr )
+{
+    if ( !result_ptr ) { return false; }
+    bool ret = _read_frame_at_time( &geom, &video_file_ptr, seconds, flip_vertical, result_ptr );
+    // Even if the geometry then failed, the video frame was delivered.
+    if ( result_ptr->pixels_ptr ) { _publish_render_frame(); }
+    return ret;
+}
+
+/** Result of `native_vol_update()`. Matches `VolPluginInterface.VolUpdateResult` */
+typedef struct vol_interface_update_result_t {
+    /** What was delivered and what changed, as given by `native_vol_read_frame_at_time()` */
+    vol_interface_frame_result_t frame;
+    /** The geometry frame just read. Only valid when `frame.geom_changed` is set */
+    vol_geom_frame_data_t geom;
+    /** The keyframe with the indices and UVs for `geom`. Only valid when `frame.geom_keyframe` is set */
+    vol_geom_frame_data_t geom_key;
+} vol_interface_update_result_t;
+
+/** Fill in the geometry of an update result, after its frame result */
+static void _update_geom_result( const vol_interface_geom_t* geom_ptr, vol_interface_update_result_t* result_ptr )
+{
+    if ( result_ptr->frame.geom_changed && !geom_ptr->attrib_buffers_set ) {
+        result_ptr->geom = geom_ptr->frame_data;
+    } else {
+        memset( &result_ptr->geom, 0, sizeof(vol_geom_frame_data_t) );
+    }
+    if ( result_ptr->frame.geom_keyframe && !geom_ptr->attrib_buffers_set ) {
+        result_ptr->geom_key = geom_ptr->key_frame_data;
+    } else {
+        memset( &result_ptr->geom_key, 0, sizeof(vol_geom_frame_data_t) );
+    }
+}
+
+/** Everything a player needs each rendered frame in one call, so the engine crosses into the plugin once per frame instead of
+ * once per step. Does the same as `native_vol_read_frame_at_time()`, and also gives the geometry and keyframe data that would
+ * otherwise be fetched with `native_vol_get_geom_ptr_data()` and `native_vol_get_geom_key_ptr_data()`. Those are left empty while buffers are registered
+ * with `native_vol_set_geom_output_buffers()`, as the geometry is written into them instead
+ @param seconds         Playback time from the start of the vologram
+ @param flip_vertical   Vertically mirror the video image
+ @param result_ptr      Filled with the frame result, and the geometry if it changed
+ @returns               `false` on a decoding or file error
+ */
+DllExport bool native_vol_update( double seconds, bool flip_vertical, vol_interface_update_result_t* result_ptr )
+{
+    if ( !result_ptr ) { return false; }
+    if ( !native_vol_read_frame_at_time( seconds, flip_vertical, &result_ptr->frame ) ) { return false; }
+    _update_geom_result( &geom, result_ptr );
+    return true;
+}
+
+/** Show a quick preview of the vologram at a time, for dragging a timeline scrubber. Only keyframes are decoded, for both the video and the geometry.
+ * See `vol_av_scrub_to_time()`. The next call to `native_vol_read_frame_at_time()` goes back to full decoding
+ @param seconds         Time from the start of the vologram to preview
+ @param flip_vertical   Vertically mirror the video image
+ @param scale_level     0 for a full size video preview, 1 for half, or 2 for quarter width and height
+ @param max_latency_s   Time to stop decoding video keyframes after, when the scrubber is dragged forwards
+ @param result_ptr      Filled with what was delivered and what changed. `frame_idx` is the video frame, and the geometry is the keyframe at or before it
+ @returns               `false` on a decoding or file error
+ */
+DllExport bool native_vol_scrub_to_time( double seconds, bool flip_vertical, int scale_level, double max_latency_s, vol_interface_frame_result_t* result_ptr )
+{
+    if ( !result_ptr ) { return false; }
+    int frame_idx = 0, n_frames = 0;
+    _begin_frame_result( &geom, &video_file_ptr, seconds, result_ptr, &frame_idx, &n_frames );
+
+    if ( video_file_ptr._context_ptr ) {
+        double prev_pts_s = video_file_ptr.pixels_ptr ? video_file_ptr.pts_s : -1.0;
+        if ( !vol_av_scrub_to_time( &video_file_ptr, seconds, flip_vertical, scale_level, max_latency_s ) ) { return false; }
+        _video_frame_result( &video_file_ptr, prev_pts_s, result_ptr, &frame_idx );
+        _publish_render_frame();
+    }
+    if ( n_frames > 0 && frame_idx >= n_frames ) { frame_idx = n_frames - 1; }
+    result_ptr->frame_idx = frame_idx;
+
+    // A keyframe holds a whole mesh, so it can be shown without reading any of the frames before it.
+    if ( !geom.seq_filename ) { return true; }
+    int key_idx = vol_geom_find_previous_keyframe( &geom.info, frame_idx );
+    if ( key_idx < 0 || key_idx == geom.loaded_frame_idx ) { return true; }
+    if ( !_read_geom_frame( &geom, key_idx ) ) {
+        geom.loaded_frame_idx = -1;
+        return false;
+    }
+    geom.loaded_frame_idx = key_idx;
+    geom.key_frame_data = geom.frame_data;
+    result_ptr->geom_changed = true;
+    _geom_buffers_result( &geom, result_ptr );
+    result_ptr->geom_keyframe = true;
+    return true;
+}
+
+/** Memory held by the open vologram, from `native_vol_get_memory_usage()`. Matches `VolPluginInterface.VolMemoryUsage`. Sizes are in bytes */
+typedef struct vol_interface_memory_usage_t {
+    /** How the geometry sequence is held now, as a `vol_geom_load_mode_t` */
+    int32_t geom_load_mode;
+    /** The geometry's directory and sequence are shared with other players of the same vologram */
+    bool geom_shared;
+    /** Frames directory and frame headers */
+    int64_t geom_directory_sz;
+    /** Frame blobs, decompression scratch, read-ahead buffers, and the copy of the current keyframe */
+    int64_t geom_frame_blobs_sz;
+    /** Pre-loaded or compressed sequence, which counts against the budget */
+    int64_t geom_sequence_sz;
+    /** Size of the memory-mapped sequence file. Only the pages in use are resident */
+    int64_t geom_mapped_sz;
+    /** Decoded and converted video frames, the pre-loaded video file, and render thread upload buffers */
+    int64_t video_sz;
+    /** Geometry sequence memory of every open vologram, counted against the budget */
+    int64_t budget_used_sz;
+    /** Decoders and decoded frames of every video opened for instances, counted once however many instances share them. See `native_vol_instance_open()` */
+    int64_t shared_video_sz;
+} vol_interface_memory_usage_t;
+
+/** Fill in a player's geometry part of a memory usage result */
+static void _geom_memory_usage( const vol_interface_geom_t* geom_ptr, vol_interface_memory_usage_t* usage_ptr )
+{
+    vol_geom_memory_usage_t geom_usage;
+    if ( geom_ptr->seq_filename && vol_geom_get_memory_usage( &geom_ptr->info, &geom_usage ) ) {
+        usage_ptr->geom_load_mode = geom_usage.load_mode;
+        usage_ptr->geom_shared = geom_usage.shared;
+        usage_ptr->geom_directory_sz = geom_usage.directory_sz;
+        usage_ptr->geom_frame_blobs_sz = geom_usage.frame_blobs_sz + geom_ptr->key_blob_sz;
+        usage_ptr->geom_sequence_sz = geom_usage.sequence_sz;
+        usage_ptr->geom_mapped_sz = geom_usage.mapped_sz;
+    }
+}
+
+/** Find out how much memory the open vologram holds, e.g. to show in a profiler or to decide what to trim
+ @param usage_ptr       Filled with the sizes
+ @returns               `false` if `usage_ptr` is NULL
+ */
+DllExport bool native_vol_get_memory_usage( vol_interface_memory_usage_t* usage_ptr )
+{
+    if ( !usage_ptr ) { return false; }
+    memset( usage_ptr, 0, sizeof(vol_interface_memory_usage_t) );
+    _geom_memory_usage( &geom, usage_ptr );
+    _mutex_lock( &render_rgba_lock );
+    int64_t rgba_sz = (int64_t)render_rgba_sz;
+    _mutex_unlock( &render_rgba_lock );
+    usage_ptr->video_sz = vol_av_memory_usage( &video_file_ptr ) + vid_preload_sz + rgba_sz + VOL_INTERFACE_RENDER_BUFFERS * render_buffer_sz;
+    usage_ptr->budget_used_sz = vol_geom_get_memory_budget_used();
+    usage_ptr->shared_video_sz = vol_av_shared_memory_usage();
+    return true;
+}
+
+/**
+ * Instances
+ * Players of the same vologram that each have their own playback position, for example a crowd. Their geometry directory and sequence are
+ * shared, as for `native_vol_open_geom_file()`, and so is their video: instances showing the same frame share one decode and one image
+ */
+
+/** A player opened with `native_vol_instance_open()` */
+typedef struct vol_interface_instance_t {
+    vol_interface_geom_t geom;
+    vol_av_video_t video;
+} vol_interface_instance_t;
+
+DllExport void native_vol_instance_close( void* instance );
+
+/** Open an instance of a vologram, with its own playback position
+ @param hdr_filename    Path to the header file, or NULL for no geometry
+ @param seq_filename    Path to the sequence file, or NULL for no geometry
+ @param video_filename  Path to the video file, or NULL for no video
+ @param streaming_mode  Stream the geometry sequence from disk instead of pre-loading it, as for `native_vol_open_geom_file()`
+ @returns               The instance, to pass to the other `native_vol_instance_` functions, or NULL on error
+ */
+DllExport void* native_vol_instance_open( const char* hdr_filename, const char* seq_filename, const char* video_filename, bool streaming_mode )
+{
+    vol_interface_instance_t* instance_ptr = calloc( 1, sizeof(vol_interface_instance_t) );
+    if ( !instance_ptr ) { return NULL; }
+    instance_ptr->geom.loaded_frame_idx = -1;
+    bool opened = true;
+    if ( hdr_filename && seq_filename ) {
+        opened = vol_geom_create_shared_file_info( hdr_filename, seq_filename, &instance_ptr->geom.info, streaming_mode );
+        if ( opened ) { _geom_file_opened( &instance_ptr->geom, seq_filename ); }
+    }
+    if ( opened && video_filename ) { opened = vol_av_open_shared( video_filename, &instance_ptr->video ); }
+    if ( !opened ) {
+        native_vol_instance_close( instance_ptr );
+        return NULL;
+    }
+    return instance_ptr;
+}
+
+/** Close an instance. A vologram's shared geometry and video are freed with its last instance
+ @param instance        From `native_vol_instance_open()`. Can be NULL
+ */
+DllExport void native_vol_instance_close( void* instance )
+{
+    vol_interface_instance_t* instance_ptr = instance;
+    if ( !instance_ptr ) { return; }
+    _free_geom( &instance_ptr->geom );
+    if ( instance_ptr->video._context_ptr ) { vol_av_close( &instance_ptr->video ); }
+    free( instance_ptr );
+}
+
+/** `native_vol_update()` for an instance. The video image is shared with other instances showing the same frame, so it must not be written to.
+ * Every instance of a video must be flipped the same way
+ @param instance        From `native_vol_instance_open()`
+ @param seconds         Playback time from the start of the vologram
+ @param flip_vertical   Vertically mirror the video image
+ @param result_ptr      Filled with the frame result, and the geometry if it changed
+ @returns               `false` on a decoding or file error
+ */
+DllExport bool native_vol_instance_update( void* instance, double seconds, bool flip_vertical, vol_interface_update_result_t* result_ptr )
+{
+    vol_interface_instance_t* instance_ptr = instance;
+    if ( !instance_ptr || !result_ptr ) { return false; }
+    if ( !_read_frame_at_time( &instance_ptr->geom, &instance_ptr->video, seconds, flip_vertical, &result_ptr->frame ) ) { return false; }
+    _update_geom_result( &instance_ptr->geom, result_ptr );
+    return true;
+}
+
+/** Set the output scale of an instance's video, which changes it for every instance of the video. See `native_vol_set_video_output_scale()`
+ @param instance        From `native_vol_instance_open()`
+ @param level           0 for full size, 1 for half, or 2 for quarter width and height
+ @returns               `false` if the instance has no video or the level is out of range
+ */
+DllExport bool native_vol_instance_set_video_output_scale( void* instance, int level )
+{
+    vol_interface_instance_t* instance_ptr = instance;
+    if ( !instance_ptr || !instance_ptr->video._context_ptr ) { return false; }
+    return vol_av_set_output_scale( &instance_ptr->video, level );
+}
+
+/** Find out how much memory an instance holds. Its shared video is only counted in `shared_video_sz`, which covers every instance
+ @param instance        From `native_vol_instance_open()`
+ @param usage_ptr       Filled with the sizes
+ @returns               `false` if `instance` or `usage_ptr` is NULL
+ */
+DllExport bool native_vol_instance_get_memory_usage( void* instance, vol_interface_memory_usage_t* usage_ptr )
+{
+    vol_interface_instance_t* instance_ptr = instance;
+    if ( !instance_ptr || !usage_ptr ) { return false; }
+    memset( usage_ptr, 0, sizeof(vol_interface_memory_usage_t) );
+    _geom_memory_usage( &instance_ptr->geom, usage_ptr );
+    usage_ptr->budget_used_sz = vol_geom_get_memory_budget_used();
+    usage_ptr->shared_video_sz = vol_av_shared_memory_usage();
+    return true;
+}
+
+/** Check if the video file has an audio track that is decoded alongside the video
+ @returns   `true` if `native_vol_read_audio()` will give samples
+ */
+DllExport bool native_vol_has_audio(void)
+{
+    return vol_av_has_audio( &video_file_ptr );
+}
+
+/** Get the sample rate of the audio given by `native_vol_read_audio()`
+ @returns   The sample rate in Hz, or 0 if there is no audio
+ */
+DllExport int native_vol_get_audio_sample_rate(void)
+{
+    int sample_rate = 0, n_channels = 0;
+    vol_av_audio_format( &video_file_ptr, &sample_rate, &n_channels );
+    return sample_rate;
+}
+
+/** Get the number of interleaved channels in the audio given by `native_vol_read_audio()`
+ @returns   The channel count, or 0 if there is no audio
+ */
+DllExport int native_vol_get_audio_channels(void)
+{
+    int sample_rate = 0, n_channels = 0;
+    vol_av_audio_format( &video_file_ptr, &sample_rate, &n_channels );
+    return n_channels;
+}
+
+/** Turn audio decoding on or off. It is on by default when the video has audio
+ @param enabled     If `false`, audio packets are skipped without being decoded
+ */
+DllExport void native_vol_set_audio_enabled( bool enabled )
+{
+    vol_av_set_audio_enabled( &video_file_ptr, enabled );
+}
+
+/** Copy decoded audio samples out. Safe to call from the audio thread
+ @param samples     Interleaved float output with room for `n_frames` times the channel count. Padded with silence if not enough audio is ready
+ @param n_frames    Number of sample frames wanted
+ @returns           Number of sample frames of decoded audio copied
+ */
+DllExport int native_vol_read_audio( float* samples, int n_frames )
+{
+    return vol_av_read_audio( &video_file_ptr, samples, n_frames );
+}
+
+/** Get the playback time of the audio, for presenting video and geometry in sync with it
+ @returns   Seconds from the start of the audio, or -1 if there is no audio clock yet
+ */
+DllExport double native_vol_get_audio_clock(void)
+{
+    return vol_av_audio_clock_s( &video_file_ptr );
 }
     
-UnityRenderingEventAndData UNITY_INTERFACE_API get_texture_update_callback(void)
+#ifdef ENABLE_UNITY_RENDER_FUNCS
+/**
+ UNITY RENDERING FUNCTIONS
+ */
+
+/** Texture update callback, run on Unity's render thread by `CommandBuffer.IssuePluginCustomTextureUpdateV2()`.
+ * Begin points Unity at the newest frame from `native_vol_set_render_thread_upload()`, and End lets that buffer be decoded into again.
+ * 3-channel textures are uploaded straight from the decoded buffer. 4-channel textures are expanded into a buffer owned by the render thread.
+ * Either way the claim is held from Begin to End, as Unity reads texData in between and the buffers are only freed once nothing is claimed
+ */
+static void UNITY_INTERFACE_API _texture_update_callback( int event_id, void* data )
+{
+    UnityRenderingExtTextureUpdateParamsV2* params = data;
+    if ( event_id == kUnityRenderingExtEventUpdateTextureBeginV2 ) {
+        params->texData = NULL;
+        int idx = _acquire_render_frame();
+        if ( idx < 0 ) { return; }
+        // A frame from before the texture was resized, e.g. when leaving a scrub preview. Unity skips the update when texData is NULL.
+        if ( (int)params->width != render_buffer_w[idx] || (int)params->height != render_buffer_h[idx] || ( params->bpp != 3 && params->bpp != 4 ) ) {
+            _release_render_frame();
+            return;
+        }
+        if ( params->bpp == 3 ) {
+            params->texData = render_buffers[idx];
+            return;
+        }
+        size_t n_pixels = (size_t)params->width * params->height;
+        if ( n_pixels * 4 > render_rgba_sz ) {
+            uint8_t* tmp_ptr = realloc( render_rgba_ptr, n_pixels * 4 );
+            if ( !tmp_ptr ) {
+                _release_render_frame();
+                return;
+            }
+            render_rgba_ptr = tmp_ptr;
+            _mutex_lock( &render_rgba_lock ); // Only taken when the buffer grows.
+            render_rgba_sz = n_pixels * 4;
+            _mutex_unlock( &render_rgba_lock );
+        }
+        const uint8_t* src_ptr = render_buffers[idx];
+        for ( size_t i = 0; i < n_pixels; i++ ) {
+            render_rgba_ptr[i * 4 + 0] = src_ptr[i * 3 + 0];
+            render_rgba_ptr[i * 4 + 1] = src_ptr[i * 3 + 1];
+            render_rgba_ptr[i * 4 + 2] = src_ptr[i * 3 + 2];
+            render_rgba_ptr[i * 4 + 3] = 255;
+        }
+        params->texData = render_rgba_ptr;
+    } else if ( event_id == kUnityRenderingExtEventUpdateTextureEndV2 ) {
+        // texData belongs to the decoder or to the render thread's own buffer, so nothing is freed here. Begin only sets it with a claim held.
+        if ( params->texData ) { _release_render_frame(); }
+    }
+}
+
+/** Get the texture update callback to pass to `CommandBuffer.IssuePluginCustomTextureUpdateV2()`
+ @returns   Pointer to the callback
+ */
+DllExport UnityRenderingEventAndData UNITY_INTERFACE_API get_texture_update_callback(void)
 {
     return _texture_update_callback;
 }
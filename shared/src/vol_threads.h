@@ -0,0 +1,250 @@
+/** @file vol_threads.h
+ * Volograms Threads and Atomics
+ *
+ * vol_threads | Threads and Atomics
+ * ----------- | ---------------------
+ * Version     | 0.1.0
+ * Authors     | See vol_geom.h.
+ * Copyright   | 2021, Volograms (http://volograms.com/)
+ * Language    | C99
+ * Files       | 1
+ * Licence     | The MIT License. See LICENSE.md for details.
+ * Notes       | Internal to vol_geom.c, vol_av.c and vol_interface.c, so that they share one set of threads, locks and atomics.
+ *               This is not part of the public API: it isn't installed with the other headers, and may change at any time.
+ *
+ * Every atomic here is sequentially consistent. That is more than most of the hand-offs need, but the render thread hand-off in vol_interface.c
+ * relies on it, and one ordering for everything is easier to reason about.
+ */
+
+#ifndef VOL_THREADS_H_
+#define VOL_THREADS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#ifdef _WIN32
+#include <windows.h> // Threads, SRW locks, condition variables and Interlocked functions.
+#else
+#include <pthread.h>
+#include <time.h>   // nanosleep(), clock_gettime()
+#include <unistd.h> // sysconf()
+#endif
+
+#ifdef _WIN32
+typedef HANDLE vol_thread_t;
+#define VOL_THREAD_FUNC DWORD WINAPI
+#define VOL_THREAD_RETURN 0
+typedef DWORD( WINAPI* vol_thread_fn_t )( void* );
+/** Slim reader-writer locks, as unlike critical sections they can be statically initialised with `VOL_MUTEX_INITIALIZER`. Not recursive. */
+typedef SRWLOCK vol_mutex_t;
+#define VOL_MUTEX_INITIALIZER SRWLOCK_INIT
+typedef CONDITION_VARIABLE vol_cond_t;
+#define VOL_COND_INITIALIZER CONDITION_VARIABLE_INIT
+#else
+typedef pthread_t vol_thread_t;
+#define VOL_THREAD_FUNC void*
+#define VOL_THREAD_RETURN NULL
+typedef void* ( *vol_thread_fn_t )( void* );
+typedef pthread_mutex_t vol_mutex_t;
+#define VOL_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+typedef pthread_cond_t vol_cond_t;
+#define VOL_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+#endif
+
+/******************************************************************************
+  THREADS
+******************************************************************************/
+
+static inline bool _thread_create( vol_thread_t* thread_ptr, vol_thread_fn_t fn_ptr, void* arg_ptr ) {
+#ifdef _WIN32
+  *thread_ptr = CreateThread( NULL, 0, fn_ptr, arg_ptr, 0, NULL );
+  return *thread_ptr != NULL;
+#else
+  return 0 == pthread_create( thread_ptr, NULL, fn_ptr, arg_ptr );
+#endif
+}
+
+static inline void _thread_join( vol_thread_t thread ) {
+#ifdef _WIN32
+  WaitForSingleObject( thread, INFINITE );
+  CloseHandle( thread );
+#else
+  pthread_join( thread, NULL );
+#endif
+}
+
+static inline void _sleep_ms( int ms ) {
+#ifdef _WIN32
+  Sleep( ms );
+#else
+  struct timespec ts;
+  ts.tv_sec  = ms / 1000;
+  ts.tv_nsec = ( ms % 1000 ) * 1000000L;
+  nanosleep( &ts, NULL );
+#endif
+}
+
+/** @return Seconds from an arbitrary point, from a monotonic clock. */
+static inline double _time_s( void ) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency( &freq );
+  QueryPerformanceCounter( &count );
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/** @return Number of logical CPU cores, or 1 if it can't be found. */
+static inline int _cpu_count( void ) {
+#ifdef _WIN32
+  SYSTEM_INFO sys_info;
+  GetSystemInfo( &sys_info );
+  int n = (int)sys_info.dwNumberOfProcessors;
+#else
+  int n = (int)sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+  return n > 0 ? n : 1;
+}
+
+/******************************************************************************
+  LOCKS AND CONDITION VARIABLES
+******************************************************************************/
+
+static inline void _mutex_init( vol_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  InitializeSRWLock( mutex_ptr );
+#else
+  pthread_mutex_init( mutex_ptr, NULL );
+#endif
+}
+
+static inline void _mutex_destroy( vol_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  (void)mutex_ptr; // SRW locks hold no resources.
+#else
+  pthread_mutex_destroy( mutex_ptr );
+#endif
+}
+
+static inline void _mutex_lock( vol_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  AcquireSRWLockExclusive( mutex_ptr );
+#else
+  pthread_mutex_lock( mutex_ptr );
+#endif
+}
+
+static inline void _mutex_unlock( vol_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  ReleaseSRWLockExclusive( mutex_ptr );
+#else
+  pthread_mutex_unlock( mutex_ptr );
+#endif
+}
+
+static inline void _cond_init( vol_cond_t* cond_ptr ) {
+#ifdef _WIN32
+  InitializeConditionVariable( cond_ptr );
+#else
+  pthread_cond_init( cond_ptr, NULL );
+#endif
+}
+
+static inline void _cond_destroy( vol_cond_t* cond_ptr ) {
+#ifdef _WIN32
+  (void)cond_ptr; // Condition variables hold no resources.
+#else
+  pthread_cond_destroy( cond_ptr );
+#endif
+}
+
+/** Unlock `mutex_ptr`, wait until signalled, and lock it again. Wakeups can be spurious, so always wait in a loop that checks the condition. */
+static inline void _cond_wait( vol_cond_t* cond_ptr, vol_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  SleepConditionVariableSRW( cond_ptr, mutex_ptr, INFINITE, 0 );
+#else
+  pthread_cond_wait( cond_ptr, mutex_ptr );
+#endif
+}
+
+static inline void _cond_signal( vol_cond_t* cond_ptr ) {
+#ifdef _WIN32
+  WakeConditionVariable( cond_ptr );
+#else
+  pthread_cond_signal( cond_ptr );
+#endif
+}
+
+static inline void _cond_broadcast( vol_cond_t* cond_ptr ) {
+#ifdef _WIN32
+  WakeAllConditionVariable( cond_ptr );
+#else
+  pthread_cond_broadcast( cond_ptr );
+#endif
+}
+
+/******************************************************************************
+  ATOMICS
+******************************************************************************/
+
+static inline uint32_t _atomic_load_u32( const volatile uint32_t* ptr ) {
+#ifdef _WIN32
+  return (uint32_t)InterlockedCompareExchange( (volatile LONG*)ptr, 0, 0 );
+#else
+  return __atomic_load_n( ptr, __ATOMIC_SEQ_CST );
+#endif
+}
+
+static inline void _atomic_store_u32( volatile uint32_t* ptr, uint32_t value ) {
+#ifdef _WIN32
+  InterlockedExchange( (volatile LONG*)ptr, (LONG)value );
+#else
+  __atomic_store_n( ptr, value, __ATOMIC_SEQ_CST );
+#endif
+}
+
+static inline int32_t _atomic_load_i32( const volatile int32_t* ptr ) {
+#ifdef _WIN32
+  return (int32_t)InterlockedCompareExchange( (volatile LONG*)ptr, 0, 0 );
+#else
+  return __atomic_load_n( ptr, __ATOMIC_SEQ_CST );
+#endif
+}
+
+static inline void _atomic_store_i32( volatile int32_t* ptr, int32_t value ) {
+#ifdef _WIN32
+  InterlockedExchange( (volatile LONG*)ptr, (LONG)value );
+#else
+  __atomic_store_n( ptr, value, __ATOMIC_SEQ_CST );
+#endif
+}
+
+static inline int64_t _atomic_load_i64( const volatile int64_t* ptr ) {
+#ifdef _WIN32
+  return (int64_t)InterlockedCompareExchange64( (volatile LONG64*)ptr, 0, 0 );
+#else
+  return __atomic_load_n( ptr, __ATOMIC_SEQ_CST );
+#endif
+}
+
+static inline void _atomic_store_i64( volatile int64_t* ptr, int64_t value ) {
+#ifdef _WIN32
+  InterlockedExchange64( (volatile LONG64*)ptr, (LONG64)value );
+#else
+  __atomic_store_n( ptr, value, __ATOMIC_SEQ_CST );
+#endif
+}
+
+/** @return The value after adding `delta`. */
+static inline int64_t _atomic_add_i64( volatile int64_t* ptr, int64_t delta ) {
+#ifdef _WIN32
+  return (int64_t)InterlockedExchangeAdd64( (volatile LONG64*)ptr, (LONG64)delta ) + delta;
+#else
+  return __atomic_add_fetch( ptr, delta, __ATOMIC_SEQ_CST );
+#endif
+}
+
+#endif
@@ -0,0 +1,156 @@
+/** @file vol_alloc_check.c
+ * Volograms Allocation Check
+ *
+ * vol_alloc_check | Counts heap allocations per decoded video frame
+ * --------------- | ---------------------
+ * Version         | 0.1.0
+ * Authors         | See vol_geom.h.
+ * Copyright       | 2021, Volograms (http://volograms.com/)
+ * Language        | C99
+ * Licence         | The MIT License. See LICENSE.md for details.
+ *
+ * Plays a video on a loop with vol_av_read_next_frame(), going back to the start with vol_av_read_frame_at_time(), and counts every heap
+ * allocation made in the process while it does. This includes FFmpeg's allocations and those of its decoder threads, as they come from the same
+ * allocator. It warms up by playing the video through until a whole pass makes no allocations, as with frame threads FFmpeg's own pools grow
+ * for a few passes, to the most frames any thread has had in flight, or for at most MAX_WARM_UP_LOOPS passes. Then it plays LOOPS more passes,
+ * and fails if they make more than MAX_PER_FRAME allocations per frame on average, 0 by default.
+ *
+ * FFmpeg makes about twenty allocations a frame for buffer and frame references, and the demuxer one for each packet's payload, so only a
+ * vol_av built with VOL_AV_MALLOC_PREFIX, against an FFmpeg configured with --malloc-prefix=vol_av_mem_, passes. Then FFmpeg's blocks are
+ * recycled by vol_av, and only those it has to get from the system are counted here.
+ *
+ * The allocator is replaced by defining malloc() and friends here and forwarding them to glibc's internal entry points, so this only builds
+ * against glibc, and not with AddressSanitizer, which replaces the allocator itself.
+ *
+ * Usage:
+ *
+ *     vol_alloc_check VIDEO.mp4 [MAX_PER_FRAME] [LOOPS] [MAX_WARM_UP_LOOPS]
+ *
+ * Build, with FFMPEG set to the install prefix of an FFmpeg configured with --malloc-prefix=vol_av_mem_:
+ *
+ *     cc -std=c99 -O2 -D_GNU_SOURCE -DVOL_AV_THREADED -DVOL_AV_MALLOC_PREFIX -I../src -I$FFMPEG/include vol_alloc_check.c ../src/vol_av.c \
+ *       -L$FFMPEG/lib -lavformat -lavcodec -lswscale -lswresample -lavutil -lpthread -lm -o vol_alloc_check
+ */
+
+#include "vol_av.h"
+#include "vol_threads.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern void* __libc_malloc( size_t sz );
+extern void* __libc_calloc( size_t n, size_t sz );
+extern void* __libc_realloc( void* ptr, size_t sz );
+extern void* __libc_memalign( size_t alignment, size_t sz );
+extern void __libc_free( void* ptr );
+
+/// Allocations made by any thread since the program started.
+static volatile int64_t _n_allocs;
+
+void* malloc( size_t sz ) {
+  _atomic_add_i64( &_n_allocs, 1 );
+  return __libc_malloc( sz );
+}
+
+void* calloc( size_t n, size_t sz ) {
+  _atomic_add_i64( &_n_allocs, 1 );
+  return __libc_calloc( n, sz );
+}
+
+/** A realloc() that grows or moves a block is as slow as a malloc(), so they are all counted. Shrinking to 0 frees. */
+void* realloc( void* ptr, size_t sz ) {
+  if ( sz > 0 ) { _atomic_add_i64( &_n_allocs, 1 ); }
+  return __libc_realloc( ptr, sz );
+}
+
+/** FFmpeg's av_malloc() uses this on most platforms. */
+int posix_memalign( void** ptr_ptr, size_t alignment, size_t sz ) {
+  _atomic_add_i64( &_n_allocs, 1 );
+  void* ptr = __libc_memalign( alignment, sz );
+  if ( !ptr ) { return 12; } // ENOMEM
+  *ptr_ptr = ptr;
+  return 0;
+}
+
+void* aligned_alloc( size_t alignment, size_t sz ) {
+  _atomic_add_i64( &_n_allocs, 1 );
+  return __libc_memalign( alignment, sz );
+}
+
+void* memalign( size_t alignment, size_t sz ) {
+  _atomic_add_i64( &_n_allocs, 1 );
+  return __libc_memalign( alignment, sz );
+}
+
+void free( void* ptr ) { __libc_free( ptr ); }
+
+/** Only errors are printed, so the counts aren't mixed with vol_av's progress messages. */
+static void _log_errors( vol_av_log_type_t log_type, const char* message_str ) {
+  if ( VOL_AV_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+/** Play the video through once from the start.
+ * @return The number of frames read, or -1 on error.
+ */
+static int _play_pass( vol_av_video_t* video_ptr ) {
+  if ( !vol_av_read_frame_at_time( video_ptr, 0.0, false ) ) { return -1; }
+  int n_read = 1;
+  while ( vol_av_read_next_frame( video_ptr ) ) { n_read++; }
+  return vol_av_end_of_stream( video_ptr ) ? n_read : -1;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 2 ) {
+    printf( "Usage: %s VIDEO.mp4 [MAX_PER_FRAME] [LOOPS] [MAX_WARM_UP_LOOPS]\n", argv[0] );
+    return 0;
+  }
+  double max_per_frame = argc > 2 ? atof( argv[2] ) : 0.0;
+  int n_loops          = argc > 3 ? atoi( argv[3] ) : 3;
+  int max_warm_up      = argc > 4 ? atoi( argv[4] ) : 20;
+  int ret              = 1;
+  vol_av_video_t video;
+  memset( &video, 0, sizeof( video ) );
+
+  vol_av_set_log_callback( _log_errors );
+  if ( !vol_av_open( argv[1], &video ) ) {
+    fprintf( stderr, "ERROR: could not open video `%s`\n", argv[1] );
+    return 1;
+  }
+  int n_warm_up = 0;
+  for ( int64_t n_allocs = 1; n_allocs > 0 && n_warm_up < max_warm_up; n_warm_up++ ) {
+    int64_t n_allocs_start = _atomic_load_i64( &_n_allocs );
+    if ( _play_pass( &video ) < 0 ) {
+      fprintf( stderr, "ERROR: failed to play the video through\n" );
+      goto cleanup;
+    }
+    n_allocs = _atomic_load_i64( &_n_allocs ) - n_allocs_start;
+  }
+
+  int64_t n_allocs_start = _atomic_load_i64( &_n_allocs );
+  int n_read             = 0;
+  for ( int i = 0; i < n_loops; i++ ) {
+    int n_pass = _play_pass( &video );
+    if ( n_pass < 0 ) {
+      fprintf( stderr, "ERROR: failed to play the video through\n" );
+      goto cleanup;
+    }
+    n_read += n_pass;
+  }
+  int64_t n_allocs = _atomic_load_i64( &_n_allocs ) - n_allocs_start;
+  if ( 0 == n_read ) {
+    fprintf( stderr, "ERROR: no frames after the warm-up\n" );
+    goto cleanup;
+  }
+
+  double per_frame = (double)n_allocs / n_read;
+  printf( "%lli allocations over %i frames after %i warm-up passes, %.2f per frame\n", (long long)n_allocs, n_read, n_warm_up, per_frame );
+  if ( per_frame > max_per_frame ) {
+    fprintf( stderr, "ERROR: more than %.2f allocations per frame\n", max_per_frame );
+    goto cleanup;
+  }
+  ret = 0;
+
+cleanup:
+  vol_av_close( &video );
+  return ret;
+}
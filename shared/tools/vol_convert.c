@@ -0,0 +1,156 @@
+/** @file vol_convert.c
+ * Volograms Format Converter
+ *
+ * vol_convert | Converts v10-v12 volograms to v13
+ * ----------- | ---------------------
+ * Version     | 0.1.0
+ * Authors     | See vol_geom.h.
+ * Copyright   | 2021, Volograms (http://volograms.com/)
+ * Language    | C99
+ * Licence     | The MIT License. See LICENSE.md for details.
+ *
+ * Rewrites a v10, v11 or v12 vologram's header and sequence files as v13, which has a fixed-layout header, the frame directory in the header file,
+ * and aligned frame sections. See vol_geom_v13_file_hdr_t for the layout. The video texture file is unchanged.
+ *
+ * Usage:
+ *
+ *     vol_convert HEADER.vols SEQUENCE.vols OUT_HEADER.vols OUT_SEQUENCE.vols
+ *
+ * Build:
+ *
+ *     cc -std=c99 -O2 -I../src vol_convert.c ../src/vol_geom.c -lpthread -o vol_convert
+ */
+
+#include "vol_geom.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Write zeroes to `f_ptr` up to the next multiple of `align`, updating the write offset at `offset_ptr`. */
+static bool _write_padding( FILE* f_ptr, uint64_t align, uint64_t* offset_ptr ) {
+  static const uint8_t zeroes[VOL_GEOM_V13_FRAME_ALIGN] = { 0 };
+  size_t n = (size_t)( ( align - *offset_ptr % align ) % align );
+  if ( n > 0 && 1 != fwrite( zeroes, n, 1, f_ptr ) ) { return false; }
+  *offset_ptr += n;
+  return true;
+}
+
+/** Write one of a frame's attribute arrays at the next array-aligned offset, and record where it went in `offset_ptr` and `sz_ptr`. */
+static bool _write_array( FILE* f_ptr, const uint8_t* src_ptr, int32_t sz, uint64_t frame_start, uint64_t* write_offset_ptr, uint32_t* offset_ptr,
+  uint32_t* sz_ptr ) {
+  *offset_ptr = 0;
+  *sz_ptr     = 0;
+  if ( sz <= 0 ) { return true; }
+  if ( !_write_padding( f_ptr, VOL_GEOM_V13_ARRAY_ALIGN, write_offset_ptr ) ) { return false; }
+  *offset_ptr = (uint32_t)( *write_offset_ptr - frame_start );
+  *sz_ptr     = (uint32_t)sz;
+  if ( 1 != fwrite( src_ptr, (size_t)sz, 1, f_ptr ) ) { return false; }
+  *write_offset_ptr += (uint64_t)sz;
+  return true;
+}
+
+/** Copy a short string into a fixed, nul-terminated v13 header string. */
+static void _copy_str( char* dst_ptr, const vol_geom_short_str_t* sstr ) {
+  size_t len = sstr->sz < 127 ? sstr->sz : 127;
+  memcpy( dst_ptr, sstr->bytes, len );
+  dst_ptr[len] = '\0';
+}
+
+int main( int argc, char** argv ) {
+  if ( argc != 5 ) {
+    fprintf( stderr, "Usage: %s HEADER.vols SEQUENCE.vols OUT_HEADER.vols OUT_SEQUENCE.vols\n", argv[0] );
+    return 1;
+  }
+  const char* hdr_filename     = argv[1];
+  const char* seq_filename     = argv[2];
+  const char* out_hdr_filename = argv[3];
+  const char* out_seq_filename = argv[4];
+
+  vol_geom_info_t info = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 };
+  if ( !vol_geom_create_file_info( hdr_filename, seq_filename, &info, true ) ) {
+    fprintf( stderr, "ERROR: failed to read vologram `%s` `%s`\n", hdr_filename, seq_filename );
+    return 1;
+  }
+  if ( VOL_GEOM_V13_VERSION == info.hdr.version ) {
+    fprintf( stderr, "ERROR: `%s` is already v13\n", hdr_filename );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+
+  int ret                                 = 1;
+  vol_geom_v13_frame_entry_t* entries_ptr = calloc( (size_t)info.hdr.frame_count + 1, sizeof( vol_geom_v13_frame_entry_t ) );
+  FILE* out_hdr_ptr                       = fopen( out_hdr_filename, "wb" );
+  FILE* out_seq_ptr                       = fopen( out_seq_filename, "wb" );
+  if ( !entries_ptr || !out_hdr_ptr || !out_seq_ptr ) {
+    fprintf( stderr, "ERROR: failed to open `%s` and `%s` for writing\n", out_hdr_filename, out_seq_filename );
+    goto vol_convert_done;
+  }
+
+  // Frames are parsed by vol_geom, and their arrays written back aligned, in a fixed order.
+  uint64_t offset = 0;
+  bool ok         = true;
+  for ( int i = 0; ok && i < info.hdr.frame_count; i++ ) {
+    vol_geom_frame_data_t fd = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+    if ( !vol_geom_read_frame( seq_filename, &info, i, &fd ) ) {
+      fprintf( stderr, "ERROR: failed to read frame %i\n", i );
+      ok = false;
+      break;
+    }
+    vol_geom_v13_frame_entry_t* entry_ptr = &entries_ptr[i];
+    vol_geom_frame_sections_t* sec_ptr    = &entry_ptr->sections;
+    ok                                    = _write_padding( out_seq_ptr, VOL_GEOM_V13_FRAME_ALIGN, &offset );
+    entry_ptr->offset                     = offset;
+    entry_ptr->keyframe                   = info.frame_headers_ptr[i].keyframe;
+    const uint8_t* b_ptr                  = fd.block_data_ptr;
+    ok = ok && _write_array( out_seq_ptr, &b_ptr[fd.vertices_offset], fd.vertices_sz, entry_ptr->offset, &offset, &sec_ptr->vertices_offset, &sec_ptr->vertices_sz );
+    ok = ok && _write_array( out_seq_ptr, &b_ptr[fd.normals_offset], fd.normals_sz, entry_ptr->offset, &offset, &sec_ptr->normals_offset, &sec_ptr->normals_sz );
+    ok = ok && _write_array( out_seq_ptr, &b_ptr[fd.indices_offset], fd.indices_sz, entry_ptr->offset, &offset, &sec_ptr->indices_offset, &sec_ptr->indices_sz );
+    ok = ok && _write_array( out_seq_ptr, &b_ptr[fd.uvs_offset], fd.uvs_sz, entry_ptr->offset, &offset, &sec_ptr->uvs_offset, &sec_ptr->uvs_sz );
+    ok = ok && _write_array( out_seq_ptr, &b_ptr[fd.texture_offset], fd.texture_sz, entry_ptr->offset, &offset, &sec_ptr->texture_offset, &sec_ptr->texture_sz );
+    entry_ptr->sz = (uint32_t)( offset - entry_ptr->offset );
+  }
+  if ( !ok ) {
+    fprintf( stderr, "ERROR: failed to write `%s`\n", out_seq_filename );
+    goto vol_convert_done;
+  }
+
+  vol_geom_v13_file_hdr_t v13_hdr = ( vol_geom_v13_file_hdr_t ){ .format = { 4, 'V', 'O', 'L', 'S' },
+    .version                                                             = VOL_GEOM_V13_VERSION,
+    .compression                                                         = info.hdr.compression,
+    .topology                                                            = info.hdr.topology,
+    .frame_count                                                         = info.hdr.frame_count,
+    .normals                                                             = info.hdr.normals && info.hdr.version >= 11,
+    .textured                                                            = info.hdr.textured && info.hdr.version >= 11,
+    .texture_width                                                       = info.hdr.texture_width,
+    .texture_height                                                      = info.hdr.texture_height,
+    .texture_format                                                      = info.hdr.texture_format,
+    .directory_offset                                                    = sizeof( vol_geom_v13_file_hdr_t ) };
+  _copy_str( v13_hdr.mesh_name, &info.hdr.mesh_name );
+  _copy_str( v13_hdr.material, &info.hdr.material );
+  _copy_str( v13_hdr.shader, &info.hdr.shader );
+  // Older versions have no transform, so theirs is the identity.
+  if ( info.hdr.version >= 12 ) {
+    memcpy( v13_hdr.translation, info.hdr.translation, sizeof( v13_hdr.translation ) );
+    memcpy( v13_hdr.rotation, info.hdr.rotation, sizeof( v13_hdr.rotation ) );
+    v13_hdr.scale = info.hdr.scale;
+  } else {
+    v13_hdr.rotation[0] = 1.0f;
+    v13_hdr.scale       = 1.0f;
+  }
+  ok = 1 == fwrite( &v13_hdr, sizeof( v13_hdr ), 1, out_hdr_ptr ) &&
+       ( 0 == info.hdr.frame_count || 1 == fwrite( entries_ptr, sizeof( vol_geom_v13_frame_entry_t ) * (size_t)info.hdr.frame_count, 1, out_hdr_ptr ) );
+  if ( !ok ) {
+    fprintf( stderr, "ERROR: failed to write `%s`\n", out_hdr_filename );
+    goto vol_convert_done;
+  }
+
+  printf( "Converted %i frames from v%i to v%i.\n", info.hdr.frame_count, info.hdr.version, VOL_GEOM_V13_VERSION );
+  ret = 0;
+
+vol_convert_done:
+  if ( out_hdr_ptr && 0 != fclose( out_hdr_ptr ) ) { ret = 1; }
+  if ( out_seq_ptr && 0 != fclose( out_seq_ptr ) ) { ret = 1; }
+  free( entries_ptr );
+  vol_geom_free_file_info( &info );
+  return ret;
+}
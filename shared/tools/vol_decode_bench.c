@@ -0,0 +1,91 @@
+/** @file vol_decode_bench.c
+ * Volograms Decode Benchmark
+ *
+ * vol_decode_bench | Compares video decode rates for each kind of decoder threading
+ * ---------------- | ---------------------
+ * Version          | 0.1.0
+ * Authors          | See vol_geom.h.
+ * Copyright        | 2021, Volograms (http://volograms.com/)
+ * Language         | C99
+ * Licence          | The MIT License. See LICENSE.md for details.
+ *
+ * Decodes a video with vol_av_read_next_frame() with no decoder threading, slice threading, frame threading, and both, and prints the
+ * frames per second of each. Each kind is opened afresh, and timed from open, so the start-up delay of frame threading is included.
+ * Kinds the codec doesn't support fall back to no threading, which is shown by the active thread type.
+ *
+ * vol_av.c picks the threading from VOL_AV_THREAD_TYPE when it is built with VOL_AV_THREADED, so it is built into this file with that macro
+ * pointing at a variable.
+ *
+ * Usage:
+ *
+ *     vol_decode_bench VIDEO.mp4 [FRAMES] [RUNS]
+ *
+ * Build:
+ *
+ *     cc -std=c99 -O2 -I../src vol_decode_bench.c -lavformat -lavcodec -lswscale -lswresample -lavutil -lpthread -lm -o vol_decode_bench
+ */
+
+#define VOL_AV_THREADED
+#define VOL_AV_THREAD_TYPE _bench_thread_type
+static int _bench_thread_type;
+#include "../src/vol_av.c"
+
+typedef struct vol_decode_bench_kind_t {
+  const char* name_str;
+  int thread_type;
+} vol_decode_bench_kind_t;
+
+static const vol_decode_bench_kind_t _kinds[] = {
+  { "none", 0 }, { "slice", FF_THREAD_SLICE }, { "frame", FF_THREAD_FRAME }, { "frame+slice", FF_THREAD_FRAME | FF_THREAD_SLICE } //
+};
+
+/** Only errors are printed, so the results aren't mixed with vol_av's progress messages. */
+static void _log_errors( vol_av_log_type_t log_type, const char* message_str ) {
+  if ( VOL_AV_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+/** Open `filename` and decode up to `max_frames` frames with the threading in `_bench_thread_type`.
+ * @return Frames per second, or 0 on error. */
+static double _time_decode( const char* filename, int max_frames, int* n_frames_ptr, int* active_type_ptr ) {
+  vol_av_video_t video;
+  memset( &video, 0, sizeof( video ) );
+  double start_s = _time_s();
+  if ( !vol_av_open( filename, &video ) ) { return 0.0; }
+  int n_frames = 0;
+  for ( ; n_frames < max_frames && vol_av_read_next_frame( &video ); n_frames++ ) {}
+  double elapsed_s = _time_s() - start_s;
+  *active_type_ptr = video._context_ptr->codec_ctx_ptr->active_thread_type;
+  *n_frames_ptr    = n_frames;
+  vol_av_close( &video );
+  return n_frames > 0 && elapsed_s > 0.0 ? n_frames / elapsed_s : 0.0;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 2 ) {
+    printf( "Usage: %s VIDEO.mp4 [FRAMES] [RUNS]\n", argv[0] );
+    return 0;
+  }
+  int max_frames = argc > 2 ? atoi( argv[2] ) : 300;
+  int n_runs     = argc > 3 ? atoi( argv[3] ) : 3;
+  if ( max_frames <= 0 ) { max_frames = INT32_MAX; }
+  if ( n_runs < 1 ) { n_runs = 1; }
+
+  vol_av_set_log_callback( _log_errors );
+  printf( "%-12s %8s %8s %10s\n", "threading", "active", "frames", "best fps" );
+  for ( size_t k = 0; k < sizeof( _kinds ) / sizeof( _kinds[0] ); k++ ) {
+    _bench_thread_type = _kinds[k].thread_type;
+    double best_fps    = 0.0;
+    int n_frames = 0, active_type = 0;
+    // The best of several runs, as the first also pays for the file coming into the OS cache.
+    for ( int r = 0; r < n_runs; r++ ) {
+      double fps = _time_decode( argv[1], max_frames, &n_frames, &active_type );
+      if ( fps <= 0.0 ) {
+        fprintf( stderr, "ERROR: could not decode `%s`\n", argv[1] );
+        return 1;
+      }
+      if ( fps > best_fps ) { best_fps = fps; }
+    }
+    printf( "%-12s %8i %8i %10.1f\n", _kinds[k].name_str, active_type, n_frames, best_fps );
+  }
+  return 0;
+}
@@ -0,0 +1,421 @@
+/** @file vol_geom_check.c
+ * Volograms Geometry Check
+ *
+ * vol_geom_check | Checks every way of opening a vologram reads the same frames
+ * -------------- | ---------------------
+ * Version        | 0.1.0
+ * Authors        | See vol_geom.h.
+ * Copyright      | 2021, Volograms (http://volograms.com/)
+ * Language       | C99
+ * Licence        | The MIT License. See LICENSE.md for details.
+ *
+ * Opens a vologram from disk, pre-loaded, as the reference. It then opens it again in every load mode, from disk, through the shared
+ * registry of vol_geom_create_shared_file_info_ex(), and from memory through vol_geom_memory_io(). For each, it reads every frame, and checks
+ * each frame's keyframe type and vertices, normals, indices, UVs and texture are byte-for-byte the same as the reference's. It also checks the
+ * memory backend refuses a file it doesn't have, and that a sequence cut short is reported as an error rather than read past its end.
+ *
+ * The other ways of reading frames are checked against the same reference, from disk in every load mode: vol_geom_read_frame_attribs() into
+ * buffers owned by the check, vol_geom_resolve_frame_sections(), whose table has to match the offsets the reference parsed, and
+ * vol_geom_trim_memory(), trimming a step at a time until there is nothing left to trim and reading every frame after each step. Streamed
+ * frames are also read forwards and backwards with vol_geom_enable_uring_readahead(), on builds with VOL_GEOM_IO_URING defined, and skipped
+ * otherwise, or if the kernel doesn't support io_uring.
+ *
+ * Packed volograms made from the same files by vol_pack, and header and sequence pairs converted from them, for example to v13 by vol_convert,
+ * are checked the same way, in every load mode, after the files themselves. Arguments ending in .volp are packed files.
+ *
+ * Build it with AddressSanitizer too, so a read outside the memory files is reported even when the frames match.
+ *
+ * Usage:
+ *
+ *     vol_geom_check HEADER.vols SEQUENCE.vols [PACKED.volp | OTHER_HEADER.vols OTHER_SEQUENCE.vols]...
+ *
+ * Build:
+ *
+ *     cc -std=c99 -O2 -I../src vol_geom_check.c ../src/vol_geom.c -lpthread -o vol_geom_check
+ *
+ * Add -DVOL_GEOM_IO_URING on Linux to check io_uring read-ahead too.
+ */
+
+#include "vol_geom.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Names the files are given in the memory backend, which needn't match the names on disk.
+#define VOL_GEOM_CHECK_HDR_NAME "header.vols"
+#define VOL_GEOM_CHECK_SEQ_NAME "sequence_0.vols"
+
+/** How a vologram is opened, besides its load mode. */
+typedef enum vol_geom_check_open_t { VOL_GEOM_CHECK_OPEN_FILES, VOL_GEOM_CHECK_OPEN_SHARED, VOL_GEOM_CHECK_OPEN_PACKED } vol_geom_check_open_t;
+
+static const char* _mode_names[] = { "streaming", "preload", "progressive", "preload compressed", "mapped", "auto" };
+
+/** A check run on a vologram opened by _check_load_modes().
+ * @return True if it passed. */
+typedef bool ( *vol_geom_check_fn_t )(
+  const char* name_str, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, vol_geom_info_t* info_ptr, const char* seq_filename );
+
+/** Only errors are printed, so the results aren't mixed with vol_geom's progress messages. */
+static void _log_errors( vol_geom_log_type_t log_type, const char* message_str ) {
+  if ( VOL_GEOM_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+/** For the checks that expect errors. */
+static void _log_nothing( vol_geom_log_type_t log_type, const char* message_str ) {
+  (void)log_type;
+  (void)message_str;
+}
+
+/** @return True if `str` ends with `suffix_str`. */
+static bool _ends_with( const char* str, const char* suffix_str ) {
+  size_t len = strlen( str ), suffix_len = strlen( suffix_str );
+  return len >= suffix_len && 0 == strcmp( &str[len - suffix_len], suffix_str );
+}
+
+/** Read a whole file into memory.
+ * @return The contents, to free(), or NULL on error. */
+static uint8_t* _read_file( const char* filename, vol_geom_size_t* sz_ptr ) {
+  FILE* f_ptr = fopen( filename, "rb" );
+  if ( !f_ptr ) { return NULL; }
+  uint8_t* bytes_ptr = NULL;
+  if ( 0 == fseek( f_ptr, 0, SEEK_END ) ) {
+    long sz = ftell( f_ptr );
+    if ( sz > 0 && 0 == fseek( f_ptr, 0, SEEK_SET ) ) {
+      bytes_ptr = malloc( (size_t)sz );
+      if ( bytes_ptr && 1 != fread( bytes_ptr, (size_t)sz, 1, f_ptr ) ) {
+        free( bytes_ptr );
+        bytes_ptr = NULL;
+      }
+      *sz_ptr = (vol_geom_size_t)sz;
+    }
+  }
+  fclose( f_ptr );
+  return bytes_ptr;
+}
+
+/** @return True if one attribute array of two frames has the same size and bytes. */
+static bool _same_array( const vol_geom_frame_data_t* a_ptr, vol_geom_size_t a_offset, int32_t a_sz, const vol_geom_frame_data_t* b_ptr,
+  vol_geom_size_t b_offset, int32_t b_sz ) {
+  if ( a_sz != b_sz ) { return false; }
+  return 0 == a_sz || 0 == memcmp( &a_ptr->block_data_ptr[a_offset], &b_ptr->block_data_ptr[b_offset], (size_t)a_sz );
+}
+
+/** Read every frame of `info_ptr`, first to last or last to first, and compare it with the same frame of the reference.
+ * @return True if they all match. */
+static bool _check_frames( const char* name_str, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, const vol_geom_info_t* info_ptr,
+  const char* seq_filename, bool backwards ) {
+  if ( info_ptr->hdr.frame_count != ref_ptr->hdr.frame_count ) {
+    fprintf( stderr, "ERROR: %s: %i frames, expected %i\n", name_str, (int)info_ptr->hdr.frame_count, (int)ref_ptr->hdr.frame_count );
+    return false;
+  }
+  for ( int n = 0; n < ref_ptr->hdr.frame_count; n++ ) {
+    int i = backwards ? ref_ptr->hdr.frame_count - 1 - n : n;
+    vol_geom_frame_data_t ref, frame;
+    if ( !vol_geom_read_frame( ref_seq_filename, ref_ptr, i, &ref ) ) {
+      fprintf( stderr, "ERROR: reference: failed to read frame %i\n", i );
+      return false;
+    }
+    if ( !vol_geom_read_frame( seq_filename, info_ptr, i, &frame ) ) {
+      fprintf( stderr, "ERROR: %s: failed to read frame %i\n", name_str, i );
+      return false;
+    }
+    const char* diff_str = NULL;
+    if ( vol_geom_is_keyframe( info_ptr, i ) != vol_geom_is_keyframe( ref_ptr, i ) ) {
+      diff_str = "keyframe type";
+    } else if ( !_same_array( &frame, frame.vertices_offset, frame.vertices_sz, &ref, ref.vertices_offset, ref.vertices_sz ) ) {
+      diff_str = "vertices";
+    } else if ( !_same_array( &frame, frame.normals_offset, frame.normals_sz, &ref, ref.normals_offset, ref.normals_sz ) ) {
+      diff_str = "normals";
+    } else if ( !_same_array( &frame, frame.indices_offset, frame.indices_sz, &ref, ref.indices_offset, ref.indices_sz ) ) {
+      diff_str = "indices";
+    } else if ( !_same_array( &frame, frame.uvs_offset, frame.uvs_sz, &ref, ref.uvs_offset, ref.uvs_sz ) ) {
+      diff_str = "UVs";
+    } else if ( !_same_array( &frame, frame.texture_offset, frame.texture_sz, &ref, ref.texture_offset, ref.texture_sz ) ) {
+      diff_str = "texture";
+    }
+    if ( diff_str ) {
+      fprintf( stderr, "ERROR: %s: frame %i has different %s\n", name_str, i, diff_str );
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Read every frame with vol_geom_read_frame(). */
+static bool _check_read_frame(
+  const char* name_str, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, vol_geom_info_t* info_ptr, const char* seq_filename ) {
+  return _check_frames( name_str, ref_ptr, ref_seq_filename, info_ptr, seq_filename, false );
+}
+
+/** @return True if an array written by vol_geom_read_frame_attribs() has the same size and bytes as the reference frame's. */
+static bool _same_attrib( const vol_geom_attrib_t* attrib_ptr, const vol_geom_frame_data_t* ref_ptr, vol_geom_size_t ref_offset, int32_t ref_sz ) {
+  if ( attrib_ptr->sz != ref_sz ) { return false; }
+  return 0 == ref_sz || 0 == memcmp( attrib_ptr->ptr, &ref_ptr->block_data_ptr[ref_offset], (size_t)ref_sz );
+}
+
+/** Read every frame into buffers owned by the check, with vol_geom_read_frame_attribs(), and compare the arrays it says it wrote with the reference's.
+ * Vertices are written for every frame, normals for every frame of a sequence that has them, and indices and UVs for keyframes only. */
+static bool _check_frame_attribs(
+  const char* name_str, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, vol_geom_info_t* info_ptr, const char* seq_filename ) {
+  vol_geom_attrib_buffers_t buffers;
+  memset( &buffers, 0, sizeof( buffers ) );
+  vol_geom_attrib_t* attribs_ptr[] = { &buffers.vertices, &buffers.normals, &buffers.indices, &buffers.uvs };
+  size_t capacity                  = info_ptr->biggest_frame_blob_sz > 0 ? (size_t)info_ptr->biggest_frame_blob_sz : 1;
+  bool ok                          = true;
+  for ( int i = 0; i < 4; i++ ) {
+    attribs_ptr[i]->ptr      = malloc( capacity );
+    attribs_ptr[i]->capacity = (int32_t)capacity;
+    if ( !attribs_ptr[i]->ptr ) { ok = false; }
+  }
+  if ( !ok ) { fprintf( stderr, "ERROR: %s: out of memory for attribute buffers\n", name_str ); }
+
+  bool has_normals = info_ptr->hdr.normals && info_ptr->hdr.version >= 11;
+  for ( int i = 0; ok && i < ref_ptr->hdr.frame_count; i++ ) {
+    vol_geom_frame_data_t ref;
+    if ( !vol_geom_read_frame( ref_seq_filename, ref_ptr, i, &ref ) ) {
+      fprintf( stderr, "ERROR: reference: failed to read frame %i\n", i );
+      ok = false;
+      break;
+    }
+    if ( !vol_geom_read_frame_attribs( seq_filename, info_ptr, i, &buffers ) ) {
+      fprintf( stderr, "ERROR: %s: failed to read frame %i\n", name_str, i );
+      ok = false;
+      break;
+    }
+    uint32_t expected = VOL_GEOM_ATTRIB_VERTICES | ( has_normals ? VOL_GEOM_ATTRIB_NORMALS : 0 ) |
+                        ( vol_geom_is_keyframe( ref_ptr, i ) ? VOL_GEOM_ATTRIB_INDICES | VOL_GEOM_ATTRIB_UVS : 0 );
+    const char* diff_str = NULL;
+    if ( buffers.changed != expected ) {
+      diff_str = "changed flags";
+    } else if ( !_same_attrib( &buffers.vertices, &ref, ref.vertices_offset, ref.vertices_sz ) ) {
+      diff_str = "vertices";
+    } else if ( has_normals && !_same_attrib( &buffers.normals, &ref, ref.normals_offset, ref.normals_sz ) ) {
+      diff_str = "normals";
+    } else if ( ( expected & VOL_GEOM_ATTRIB_INDICES ) && !_same_attrib( &buffers.indices, &ref, ref.indices_offset, ref.indices_sz ) ) {
+      diff_str = "indices";
+    } else if ( ( expected & VOL_GEOM_ATTRIB_UVS ) && !_same_attrib( &buffers.uvs, &ref, ref.uvs_offset, ref.uvs_sz ) ) {
+      diff_str = "UVs";
+    }
+    if ( diff_str ) {
+      fprintf( stderr, "ERROR: %s: frame %i has different %s\n", name_str, i, diff_str );
+      ok = false;
+    }
+  }
+  for ( int i = 0; i < 4; i++ ) { free( attribs_ptr[i]->ptr ); }
+  return ok;
+}
+
+/** Resolve the frame sections table, check every entry against the offsets and sizes the reference parsed from the frame itself, then read
+ * every frame through the table, both ways. */
+static bool _check_frame_sections(
+  const char* name_str, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, vol_geom_info_t* info_ptr, const char* seq_filename ) {
+  if ( !vol_geom_resolve_frame_sections( seq_filename, info_ptr ) || !info_ptr->frame_sections_ptr ) {
+    fprintf( stderr, "ERROR: %s: failed to resolve frame sections\n", name_str );
+    return false;
+  }
+  for ( int i = 0; i < ref_ptr->hdr.frame_count; i++ ) {
+    vol_geom_frame_data_t ref;
+    if ( !vol_geom_read_frame( ref_seq_filename, ref_ptr, i, &ref ) ) {
+      fprintf( stderr, "ERROR: reference: failed to read frame %i\n", i );
+      return false;
+    }
+    const vol_geom_frame_sections_t* sec_ptr = &info_ptr->frame_sections_ptr[i];
+    if ( sec_ptr->vertices_offset != ref.vertices_offset || sec_ptr->vertices_sz != (uint32_t)ref.vertices_sz ||
+         sec_ptr->normals_offset != ref.normals_offset || sec_ptr->normals_sz != (uint32_t)ref.normals_sz || sec_ptr->indices_offset != ref.indices_offset ||
+         sec_ptr->indices_sz != (uint32_t)ref.indices_sz || sec_ptr->uvs_offset != ref.uvs_offset || sec_ptr->uvs_sz != (uint32_t)ref.uvs_sz ||
+         sec_ptr->texture_offset != ref.texture_offset || sec_ptr->texture_sz != (uint32_t)ref.texture_sz ) {
+      fprintf( stderr, "ERROR: %s: frame %i sections don't match the parsed frame\n", name_str, i );
+      return false;
+    }
+  }
+  return _check_frames( name_str, ref_ptr, ref_seq_filename, info_ptr, seq_filename, false ) &&
+         _check_frames( name_str, ref_ptr, ref_seq_filename, info_ptr, seq_filename, true ) &&
+         _check_frame_attribs( name_str, ref_ptr, ref_seq_filename, info_ptr, seq_filename );
+}
+
+/** Trim the sequence's memory a step at a time, until there is nothing left to trim, reading every frame before the first step and after each. */
+static bool _check_trim_memory(
+  const char* name_str, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, vol_geom_info_t* info_ptr, const char* seq_filename ) {
+  // Each step moves the sequence on from pre-loaded, to compressed, to mapped, to streamed, so there can only be a few.
+  bool held = info_ptr->sequence_blob_byte_ptr || info_ptr->compressed_seq_ptr;
+  for ( int n_trims = 0; n_trims < 8; n_trims++ ) {
+    // Reading half the frames first leaves the next read in the middle of the sequence, as it would be during playback.
+    for ( int i = 0; i < ref_ptr->hdr.frame_count / 2; i++ ) {
+      vol_geom_frame_data_t frame;
+      if ( !vol_geom_read_frame( seq_filename, info_ptr, i, &frame ) ) {
+        fprintf( stderr, "ERROR: %s: failed to read frame %i after %i trims\n", name_str, i, n_trims );
+        return false;
+      }
+    }
+    if ( !_check_frames( name_str, ref_ptr, ref_seq_filename, info_ptr, seq_filename, false ) ) {
+      fprintf( stderr, "ERROR: %s: frames differ after %i trims\n", name_str, n_trims );
+      return false;
+    }
+    if ( vol_geom_trim_memory( seq_filename, info_ptr ) ) { continue; }
+    // Everything a single instance holds can be trimmed, down to streaming from the file.
+    if ( ( held && 0 == n_trims ) || info_ptr->sequence_blob_byte_ptr || info_ptr->compressed_seq_ptr ) {
+      fprintf( stderr, "ERROR: %s: sequence still held in memory after %i trims\n", name_str, n_trims );
+      return false;
+    }
+    return true;
+  }
+  fprintf( stderr, "ERROR: %s: still trimming after 8 steps\n", name_str );
+  return false;
+}
+
+/** Open a vologram in every load mode and run a check on it.
+ * @param seq_filename The packed file for VOL_GEOM_CHECK_OPEN_PACKED, which has no header file.
+ * @param io_ptr       The I/O backend for VOL_GEOM_CHECK_OPEN_FILES, or NULL for files on disk.
+ * @return The number of load modes that failed. */
+static int _check_load_modes( const char* source_str, vol_geom_check_fn_t check_fn, const vol_geom_info_t* ref_ptr, const char* ref_seq_filename,
+  vol_geom_check_open_t open, const char* hdr_filename, const char* seq_filename, const vol_geom_io_t* io_ptr ) {
+  int n_failed = 0;
+  for ( int mode = VOL_GEOM_LOAD_STREAMING; mode <= VOL_GEOM_LOAD_AUTO; mode++ ) {
+    char name_str[64];
+    snprintf( name_str, sizeof( name_str ), "%s, %s", source_str, _mode_names[mode] );
+    vol_geom_info_t info;
+    memset( &info, 0, sizeof( info ) );
+    bool opened = false;
+    switch ( open ) {
+    case VOL_GEOM_CHECK_OPEN_FILES: opened = vol_geom_create_file_info_io( hdr_filename, seq_filename, io_ptr, &info, (vol_geom_load_mode_t)mode ); break;
+    case VOL_GEOM_CHECK_OPEN_SHARED: opened = vol_geom_create_shared_file_info_ex( hdr_filename, seq_filename, &info, (vol_geom_load_mode_t)mode ); break;
+    case VOL_GEOM_CHECK_OPEN_PACKED: opened = vol_geom_create_packed_file_info( seq_filename, &info, (vol_geom_load_mode_t)mode ); break;
+    }
+    if ( !opened ) {
+      fprintf( stderr, "ERROR: %s: failed to open\n", name_str );
+      n_failed++;
+      continue;
+    }
+    bool ok = check_fn( name_str, ref_ptr, ref_seq_filename, &info, seq_filename );
+    printf( "%-32s %s\n", name_str, ok ? "ok" : "FAILED" );
+    if ( !ok ) { n_failed++; }
+    vol_geom_free_file_info( &info );
+  }
+  return n_failed;
+}
+
+/** Stream the sequence from disk with io_uring read-ahead, through the page cache and then with O_DIRECT, reading every frame forwards, then
+ * backwards, which reads ahead backwards.
+ * @return The number of checks that failed. Read-ahead that isn't supported by the build or the kernel is skipped. */
+static int _check_uring_readahead( const vol_geom_info_t* ref_ptr, const char* ref_seq_filename, const char* hdr_filename, const char* seq_filename ) {
+  int n_failed = 0;
+  for ( int direct_io = 0; direct_io < 2; direct_io++ ) {
+    const char* name_str = direct_io ? "disk, io_uring direct" : "disk, io_uring";
+    vol_geom_info_t info;
+    memset( &info, 0, sizeof( info ) );
+    if ( !vol_geom_create_file_info_ex( hdr_filename, seq_filename, &info, VOL_GEOM_LOAD_STREAMING ) ) {
+      fprintf( stderr, "ERROR: %s: failed to open\n", name_str );
+      n_failed++;
+      continue;
+    }
+    if ( !vol_geom_enable_uring_readahead( seq_filename, &info, 8, direct_io ) ) {
+      printf( "%-32s skipped, not supported\n", name_str );
+    } else {
+      bool ok = _check_frames( name_str, ref_ptr, ref_seq_filename, &info, seq_filename, false ) &&
+                _check_frames( name_str, ref_ptr, ref_seq_filename, &info, seq_filename, true );
+      printf( "%-32s %s\n", name_str, ok ? "ok" : "FAILED" );
+      if ( !ok ) { n_failed++; }
+    }
+    vol_geom_free_file_info( &info );
+  }
+  return n_failed;
+}
+
+/** Open the memory files in every load mode, and read every frame, expecting an error before the end.
+ * @return The number of load modes that read the whole sequence without one. */
+static int _check_memory_io_refused( const char* name_str, const vol_geom_memory_file_t* files_ptr, int n_frames ) {
+  vol_geom_io_t io = vol_geom_memory_io( files_ptr );
+  int n_failed     = 0;
+  for ( int mode = VOL_GEOM_LOAD_STREAMING; mode <= VOL_GEOM_LOAD_AUTO; mode++ ) {
+    vol_geom_info_t info;
+    memset( &info, 0, sizeof( info ) );
+    bool refused = !vol_geom_create_file_info_io( VOL_GEOM_CHECK_HDR_NAME, VOL_GEOM_CHECK_SEQ_NAME, &io, &info, (vol_geom_load_mode_t)mode );
+    if ( !refused ) {
+      // v13 keeps its directory in the header, so a short sequence may open and only fail on the frames that are missing.
+      vol_geom_frame_data_t frame;
+      for ( int i = 0; i < n_frames && !refused; i++ ) { refused = !vol_geom_read_frame( VOL_GEOM_CHECK_SEQ_NAME, &info, i, &frame ); }
+      vol_geom_free_file_info( &info );
+    }
+    if ( !refused ) {
+      fprintf( stderr, "ERROR: %s, %s: read without an error\n", name_str, _mode_names[mode] );
+      n_failed++;
+    }
+  }
+  printf( "%-32s %s\n", name_str, n_failed ? "FAILED" : "ok" );
+  return n_failed;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 3 ) {
+    printf( "Usage: %s HEADER.vols SEQUENCE.vols [PACKED.volp | OTHER_HEADER.vols OTHER_SEQUENCE.vols]...\n", argv[0] );
+    return 0;
+  }
+  int ret                 = 1;
+  vol_geom_size_t hdr_sz  = 0, seq_sz = 0;
+  uint8_t* hdr_bytes_ptr  = NULL;
+  uint8_t* seq_bytes_ptr  = NULL;
+  vol_geom_info_t ref;
+  memset( &ref, 0, sizeof( ref ) );
+
+  vol_geom_set_log_callback( _log_errors );
+  if ( !vol_geom_create_file_info_ex( argv[1], argv[2], &ref, VOL_GEOM_LOAD_PRELOAD ) ) {
+    fprintf( stderr, "ERROR: could not open `%s` `%s`\n", argv[1], argv[2] );
+    return 1;
+  }
+  hdr_bytes_ptr = _read_file( argv[1], &hdr_sz );
+  seq_bytes_ptr = _read_file( argv[2], &seq_sz );
+  if ( !hdr_bytes_ptr || !seq_bytes_ptr ) {
+    fprintf( stderr, "ERROR: could not read `%s` `%s` into memory\n", argv[1], argv[2] );
+    goto cleanup;
+  }
+
+  vol_geom_memory_file_t files[] = {
+    { VOL_GEOM_CHECK_HDR_NAME, hdr_bytes_ptr, hdr_sz }, { VOL_GEOM_CHECK_SEQ_NAME, seq_bytes_ptr, seq_sz }, { NULL, NULL, 0 } //
+  };
+  vol_geom_io_t memory_io = vol_geom_memory_io( files );
+  int n_failed            = 0;
+  n_failed += _check_load_modes( "disk", _check_read_frame, &ref, argv[2], VOL_GEOM_CHECK_OPEN_FILES, argv[1], argv[2], NULL );
+  n_failed += _check_load_modes( "shared", _check_read_frame, &ref, argv[2], VOL_GEOM_CHECK_OPEN_SHARED, argv[1], argv[2], NULL );
+  n_failed += _check_load_modes(
+    "memory", _check_read_frame, &ref, argv[2], VOL_GEOM_CHECK_OPEN_FILES, VOL_GEOM_CHECK_HDR_NAME, VOL_GEOM_CHECK_SEQ_NAME, &memory_io );
+  n_failed += _check_load_modes( "attribs", _check_frame_attribs, &ref, argv[2], VOL_GEOM_CHECK_OPEN_FILES, argv[1], argv[2], NULL );
+  n_failed += _check_load_modes( "sections", _check_frame_sections, &ref, argv[2], VOL_GEOM_CHECK_OPEN_FILES, argv[1], argv[2], NULL );
+  n_failed += _check_load_modes( "shared sections", _check_frame_sections, &ref, argv[2], VOL_GEOM_CHECK_OPEN_SHARED, argv[1], argv[2], NULL );
+  n_failed += _check_load_modes( "trim", _check_trim_memory, &ref, argv[2], VOL_GEOM_CHECK_OPEN_FILES, argv[1], argv[2], NULL );
+  n_failed += _check_load_modes( "shared trim", _check_trim_memory, &ref, argv[2], VOL_GEOM_CHECK_OPEN_SHARED, argv[1], argv[2], NULL );
+  n_failed += _check_uring_readahead( &ref, argv[2], argv[1], argv[2] );
+
+  // Errors have to come back through the backend too. These are expected, so they aren't printed.
+  vol_geom_set_log_callback( _log_nothing );
+  vol_geom_memory_file_t missing[] = { { VOL_GEOM_CHECK_HDR_NAME, hdr_bytes_ptr, hdr_sz }, { NULL, NULL, 0 } };
+  n_failed += _check_memory_io_refused( "memory, no sequence", missing, ref.hdr.frame_count );
+  vol_geom_memory_file_t truncated[] = {
+    { VOL_GEOM_CHECK_HDR_NAME, hdr_bytes_ptr, hdr_sz }, { VOL_GEOM_CHECK_SEQ_NAME, seq_bytes_ptr, seq_sz - 1 }, { NULL, NULL, 0 } //
+  };
+  n_failed += _check_memory_io_refused( "memory, sequence cut short", truncated, ref.hdr.frame_count );
+  vol_geom_set_log_callback( _log_errors );
+
+  for ( int i = 3; i < argc; i++ ) {
+    if ( _ends_with( argv[i], ".volp" ) ) {
+      n_failed += _check_load_modes( argv[i], _check_read_frame, &ref, argv[2], VOL_GEOM_CHECK_OPEN_PACKED, NULL, argv[i], NULL );
+    } else if ( i + 1 < argc ) {
+      n_failed += _check_load_modes( argv[i + 1], _check_read_frame, &ref, argv[2], VOL_GEOM_CHECK_OPEN_FILES, argv[i], argv[i + 1], NULL );
+      i++;
+    } else {
+      fprintf( stderr, "ERROR: `%s` has no sequence file after it\n", argv[i] );
+      n_failed++;
+    }
+  }
+
+  if ( n_failed > 0 ) {
+    fprintf( stderr, "ERROR: %i checks failed\n", n_failed );
+    goto cleanup;
+  }
+  ret = 0;
+
+cleanup:
+  vol_geom_free_file_info( &ref );
+  free( hdr_bytes_ptr );
+  free( seq_bytes_ptr );
+  return ret;
+}
@@ -0,0 +1,188 @@
+/** @file vol_pack.c
+ * Volograms Packer
+ *
+ * vol_pack  | Packs a vologram into a single file
+ * --------- | ---------------------
+ * Version   | 0.1.0
+ * Authors   | See vol_geom.h.
+ * Copyright | 2021, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Writes a vologram's header file, sequence file, and optional video texture file into one packed vologram, which is read by
+ * vol_geom_create_packed_file_info(). See vol_geom_pack_hdr_t for the layout.
+ *
+ * Usage:
+ *
+ *     vol_pack HEADER.vols SEQUENCE.vols [VIDEO.mp4] OUTPUT.volp
+ *
+ * Build:
+ *
+ *     cc -std=c99 -O2 -I../src vol_pack.c ../src/vol_geom.c -lpthread -o vol_pack
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#define _POSIX_C_SOURCE 200809L // For fseeko() and ftello().
+#endif
+
+#include "vol_geom.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define vol_pack_fseeko _fseeki64
+#define vol_pack_ftello _ftelli64
+#else
+#define vol_pack_fseeko fseeko
+#define vol_pack_ftello ftello
+#endif
+
+/// Size of the buffer the video file is copied through.
+#define VOL_PACK_COPY_BUFFER_SZ ( 1024 * 1024 )
+
+/** Write zeroes to `f_ptr` up to the next multiple of VOL_GEOM_PACK_ALIGN, updating the write offset at `offset_ptr`. */
+static bool _write_padding( FILE* f_ptr, uint64_t* offset_ptr ) {
+  static const uint8_t zeroes[VOL_GEOM_PACK_ALIGN] = { 0 };
+  size_t n = (size_t)( ( VOL_GEOM_PACK_ALIGN - *offset_ptr % VOL_GEOM_PACK_ALIGN ) % VOL_GEOM_PACK_ALIGN );
+  if ( n > 0 && 1 != fwrite( zeroes, n, 1, f_ptr ) ) { return false; }
+  *offset_ptr += n;
+  return true;
+}
+
+/** Write `sz` bytes to `f_ptr`, updating the write offset at `offset_ptr`. */
+static bool _write_bytes( FILE* f_ptr, const void* src_ptr, uint64_t sz, uint64_t* offset_ptr ) {
+  if ( sz > 0 && 1 != fwrite( src_ptr, (size_t)sz, 1, f_ptr ) ) { return false; }
+  *offset_ptr += sz;
+  return true;
+}
+
+/** Read a whole file into memory. The caller frees the returned pointer. */
+static uint8_t* _read_whole_file( const char* filename, uint64_t* sz_ptr ) {
+  FILE* f_ptr = fopen( filename, "rb" );
+  if ( !f_ptr ) { return NULL; }
+  uint8_t* bytes_ptr = NULL;
+  if ( 0 == vol_pack_fseeko( f_ptr, 0, SEEK_END ) ) {
+    int64_t sz = vol_pack_ftello( f_ptr );
+    if ( sz > 0 && 0 == vol_pack_fseeko( f_ptr, 0, SEEK_SET ) ) {
+      bytes_ptr = malloc( (size_t)sz );
+      if ( bytes_ptr && 1 != fread( bytes_ptr, (size_t)sz, 1, f_ptr ) ) {
+        free( bytes_ptr );
+        bytes_ptr = NULL;
+      }
+      *sz_ptr = (uint64_t)sz;
+    }
+  }
+  fclose( f_ptr );
+  return bytes_ptr;
+}
+
+/** Copy the whole of the file `filename` to `f_ptr`, updating the write offset at `offset_ptr`, and write its size to `sz_ptr`. */
+static bool _copy_file( FILE* f_ptr, const char* filename, uint64_t* offset_ptr, uint64_t* sz_ptr ) {
+  FILE* src_ptr = fopen( filename, "rb" );
+  if ( !src_ptr ) { return false; }
+  uint8_t* buffer_ptr = malloc( VOL_PACK_COPY_BUFFER_SZ );
+  bool ok             = buffer_ptr != NULL;
+  *sz_ptr             = 0;
+  while ( ok ) {
+    size_t n = fread( buffer_ptr, 1, VOL_PACK_COPY_BUFFER_SZ, src_ptr );
+    if ( 0 == n ) { break; }
+    ok = _write_bytes( f_ptr, buffer_ptr, n, offset_ptr );
+    *sz_ptr += n;
+  }
+  ok = ok && !ferror( src_ptr );
+  free( buffer_ptr );
+  fclose( src_ptr );
+  return ok;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc != 4 && argc != 5 ) {
+    fprintf( stderr, "Usage: %s HEADER.vols SEQUENCE.vols [VIDEO.mp4] OUTPUT.volp\n", argv[0] );
+    return 1;
+  }
+  const char* hdr_filename   = argv[1];
+  const char* seq_filename   = argv[2];
+  const char* video_filename = 5 == argc ? argv[3] : NULL;
+  const char* out_filename   = argv[argc - 1];
+
+  // The frames directory comes from vol_geom, which also validates the files.
+  vol_geom_info_t info = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 };
+  if ( !vol_geom_create_file_info( hdr_filename, seq_filename, &info, true ) ) {
+    fprintf( stderr, "ERROR: failed to read vologram `%s` `%s`\n", hdr_filename, seq_filename );
+    return 1;
+  }
+  if ( VOL_GEOM_V13_VERSION == info.hdr.version ) {
+    fprintf( stderr, "ERROR: v13 volograms can't be packed. Pack the v10-v12 files instead.\n" );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+
+  int ret                            = 1;
+  uint64_t hdr_file_sz               = 0;
+  uint8_t* hdr_file_ptr              = _read_whole_file( hdr_filename, &hdr_file_sz );
+  vol_geom_pack_entry_t* entries_ptr = calloc( (size_t)info.hdr.frame_count + 1, sizeof( vol_geom_pack_entry_t ) );
+  uint8_t* frame_ptr                 = malloc( (size_t)info.biggest_frame_blob_sz );
+  FILE* seq_ptr                      = fopen( seq_filename, "rb" );
+  FILE* out_ptr                      = fopen( out_filename, "wb" );
+  if ( !hdr_file_ptr || !entries_ptr || !frame_ptr || !seq_ptr || !out_ptr ) {
+    fprintf( stderr, "ERROR: failed to read inputs or to open `%s` for writing\n", out_filename );
+    goto vol_pack_done;
+  }
+
+  vol_geom_pack_hdr_t pack_hdr = ( vol_geom_pack_hdr_t ){ .version = VOL_GEOM_PACK_VERSION, .frame_count = (uint32_t)info.hdr.frame_count };
+  memcpy( pack_hdr.magic, VOL_GEOM_PACK_MAGIC, sizeof( pack_hdr.magic ) );
+  uint64_t offset = 0;
+
+  // The pack header is written again at the end, once the offsets are known.
+  bool ok             = _write_bytes( out_ptr, &pack_hdr, sizeof( pack_hdr ), &offset );
+  pack_hdr.hdr_offset = offset;
+  pack_hdr.hdr_sz     = hdr_file_sz;
+  ok                  = ok && _write_bytes( out_ptr, hdr_file_ptr, hdr_file_sz, &offset ) && _write_padding( out_ptr, &offset );
+
+  // Reserve the directory. Entries are filled in as frames are copied.
+  pack_hdr.directory_offset = offset;
+  uint64_t directory_sz     = (uint64_t)info.hdr.frame_count * sizeof( vol_geom_pack_entry_t );
+  ok                        = ok && _write_bytes( out_ptr, entries_ptr, directory_sz, &offset ) && _write_padding( out_ptr, &offset );
+
+  for ( int i = 0; ok && i < info.hdr.frame_count; i++ ) {
+    const vol_geom_frame_directory_entry_t* dir_ptr = &info.frames_directory_ptr[i];
+    ok = 0 == vol_pack_fseeko( seq_ptr, dir_ptr->offset_sz, SEEK_SET ) && 1 == fread( frame_ptr, (size_t)dir_ptr->total_sz, 1, seq_ptr );
+    if ( !ok ) {
+      fprintf( stderr, "ERROR: failed to read frame %i from `%s`\n", i, seq_filename );
+      break;
+    }
+    entries_ptr[i] = ( vol_geom_pack_entry_t ){ .offset = offset,
+      .sz                                                = (uint64_t)dir_ptr->total_sz,
+      .mesh_data_sz                                      = info.frame_headers_ptr[i].mesh_data_sz,
+      .keyframe                                          = info.frame_headers_ptr[i].keyframe };
+    ok = _write_bytes( out_ptr, frame_ptr, (uint64_t)dir_ptr->total_sz, &offset ) && _write_padding( out_ptr, &offset );
+  }
+
+  if ( ok && video_filename ) {
+    pack_hdr.video_offset = offset;
+    ok                    = _copy_file( out_ptr, video_filename, &offset, &pack_hdr.video_sz );
+    if ( !ok ) { fprintf( stderr, "ERROR: failed to copy video `%s`\n", video_filename ); }
+  }
+
+  ok = ok && 0 == vol_pack_fseeko( out_ptr, 0, SEEK_SET ) && 1 == fwrite( &pack_hdr, sizeof( pack_hdr ), 1, out_ptr );
+  ok = ok && 0 == vol_pack_fseeko( out_ptr, (int64_t)pack_hdr.directory_offset, SEEK_SET ) &&
+       ( 0 == directory_sz || 1 == fwrite( entries_ptr, (size_t)directory_sz, 1, out_ptr ) );
+  if ( !ok ) {
+    fprintf( stderr, "ERROR: failed to write `%s`\n", out_filename );
+    goto vol_pack_done;
+  }
+
+  printf( "Packed %i frames and %" PRIu64 " bytes of video into `%s`, %" PRIu64 " bytes.\n", info.hdr.frame_count, pack_hdr.video_sz, out_filename, offset );
+  ret = 0;
+
+vol_pack_done:
+  if ( out_ptr && 0 != fclose( out_ptr ) ) { ret = 1; }
+  if ( seq_ptr ) { fclose( seq_ptr ); }
+  free( frame_ptr );
+  free( entries_ptr );
+  free( hdr_file_ptr );
+  vol_geom_free_file_info( &info );
+  return ret;
+}
@@ -0,0 +1,133 @@
+/** @file vol_render_check.c
+ * Volograms Render Hand-off Check
+ *
+ * vol_render_check | Drives vol_interface's render thread upload like Unity does
+ * ---------------- | ---------------------
+ * Version          | 0.1.0
+ * Authors          | See vol_geom.h.
+ * Copyright        | 2021, Volograms (http://volograms.com/)
+ * Language         | C99
+ * Licence          | The MIT License. See LICENSE.md for details.
+ *
+ * Plays a video through native_vol_read_frame_at_time() with native_vol_set_render_thread_upload() on, while a second thread stands in for
+ * Unity's render thread and issues the texture update events of CommandBuffer.IssuePluginCustomTextureUpdateV2(). Between Begin and End it
+ * reads texData the way Unity's upload does, and checks the data doesn't change underneath it. The main thread turns the upload off and on
+ * again every few frames, which frees every buffer the render thread could be reading, and it alternates between 3- and 4-channel textures.
+ * Each frame it also reads native_vol_get_memory_usage(), which must count the render buffers while the render thread may be growing its own.
+ *
+ * Build it with AddressSanitizer or ThreadSanitizer, so a buffer that is decoded into or freed during an upload is reported even when the
+ * check itself misses it.
+ *
+ * Usage:
+ *
+ *     vol_render_check VIDEO.mp4 [SECONDS]
+ *
+ * Build, with UNITY_PLUGIN_API set to the PluginAPI folder of a Unity install:
+ *
+ *     cc -std=c99 -O1 -g -fsanitize=address -I../src -I$UNITY_PLUGIN_API vol_render_check.c ../src/vol_av.c ../src/vol_geom.c \
+ *       -lavformat -lavcodec -lswscale -lswresample -lavutil -lpthread -lm -o vol_render_check
+ */
+
+// The texture update callback and the hand-off state are internal to vol_interface.c, so it is built into this file.
+#define ENABLE_UNITY_RENDER_FUNCS
+#include "../src/vol_interface.c"
+
+/// Turn the upload off and on again after this many frames.
+#define VOL_RENDER_CHECK_TOGGLE_FRAMES 7
+
+static volatile uint32_t _quit;
+static volatile int64_t _n_uploads;
+static volatile int64_t _n_changed;
+
+/** Sum the bytes Unity would upload from `data_ptr`. */
+static uint64_t _checksum( const uint8_t* data_ptr, size_t sz ) {
+  uint64_t sum = 0;
+  for ( size_t i = 0; i < sz; i++ ) { sum = sum * 31 + data_ptr[i]; }
+  return sum;
+}
+
+/** Stands in for Unity's render thread. */
+static VOL_THREAD_FUNC _render_thread_main( void* arg_ptr ) {
+  (void)arg_ptr;
+  UnityRenderingEventAndData callback_ptr = get_texture_update_callback();
+  for ( unsigned int bpp = 3; !_atomic_load_u32( &_quit ); bpp = 7 - bpp ) {
+    UnityRenderingExtTextureUpdateParamsV2 params;
+    memset( &params, 0, sizeof( params ) );
+    params.width  = (unsigned int)vid_w;
+    params.height = (unsigned int)vid_h;
+    params.bpp    = bpp;
+    callback_ptr( kUnityRenderingExtEventUpdateTextureBeginV2, &params );
+    if ( params.texData ) {
+      size_t sz    = (size_t)params.width * params.height * params.bpp;
+      uint64_t sum = _checksum( params.texData, sz );
+      _sleep_ms( 1 ); // The upload takes a while, and the main thread keeps decoding.
+      if ( _checksum( params.texData, sz ) != sum ) { _atomic_add_i64( &_n_changed, 1 ); }
+      _atomic_add_i64( &_n_uploads, 1 );
+    }
+    callback_ptr( kUnityRenderingExtEventUpdateTextureEndV2, &params );
+  }
+  return VOL_THREAD_RETURN;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 2 ) {
+    printf( "Usage: %s VIDEO.mp4 [SECONDS]\n", argv[0] );
+    return 0;
+  }
+  double duration_s   = argc > 2 ? atof( argv[2] ) : 5.0;
+  int ret             = 1;
+  bool thread_started = false;
+  vol_thread_t render_thread;
+
+  if ( !native_vol_open_video_file( argv[1] ) ) {
+    fprintf( stderr, "ERROR: could not open video `%s`\n", argv[1] );
+    return 1;
+  }
+  if ( !native_vol_set_render_thread_upload( true ) ) {
+    fprintf( stderr, "ERROR: could not turn on the render thread upload\n" );
+    goto cleanup;
+  }
+  if ( !_thread_create( &render_thread, _render_thread_main, NULL ) ) {
+    fprintf( stderr, "ERROR: could not start the render thread\n" );
+    goto cleanup;
+  }
+  thread_started = true;
+
+  double fps = native_vol_get_video_frame_rate();
+  if ( fps <= 0.0 ) { fps = 30.0; }
+  int n_frames = (int)( duration_s * fps );
+  for ( int i = 0; i < n_frames; i++ ) {
+    vol_interface_frame_result_t result;
+    if ( !native_vol_read_frame_at_time( i / fps, false, &result ) ) {
+      fprintf( stderr, "ERROR: failed to read the frame at %.3fs\n", i / fps );
+      goto cleanup;
+    }
+    if ( result.end_of_stream ) { break; }
+    vol_interface_memory_usage_t usage;
+    if ( !native_vol_get_memory_usage( &usage ) || usage.video_sz < (int64_t)VOL_INTERFACE_RENDER_BUFFERS * vid_w * vid_h * 3 ) {
+      fprintf( stderr, "ERROR: memory usage of %lli bytes doesn't include the render buffers\n", (long long)usage.video_sz );
+      goto cleanup;
+    }
+    _sleep_ms( 2 ); // The rest of the application's frame, so the render thread gets to upload most frames.
+    if ( i % VOL_RENDER_CHECK_TOGGLE_FRAMES == VOL_RENDER_CHECK_TOGGLE_FRAMES - 1 ) {
+      if ( !native_vol_set_render_thread_upload( false ) || !native_vol_set_render_thread_upload( true ) ) {
+        fprintf( stderr, "ERROR: could not turn the render thread upload off and on again\n" );
+        goto cleanup;
+      }
+    }
+  }
+  ret = 0;
+
+cleanup:
+  _atomic_store_u32( &_quit, 1 );
+  if ( thread_started ) { _thread_join( render_thread ); }
+  native_vol_close_video_file();
+
+  int64_t n_uploads = _atomic_load_i64( &_n_uploads ), n_changed = _atomic_load_i64( &_n_changed );
+  printf( "%lli uploads, %lli changed while being read\n", (long long)n_uploads, (long long)n_changed );
+  if ( n_changed > 0 ) {
+    fprintf( stderr, "ERROR: texture data changed between the Begin and End events\n" );
+    ret = 1;
+  }
+  return ret;
+}
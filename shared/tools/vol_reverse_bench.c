@@ -0,0 +1,149 @@
+/** @file vol_reverse_bench.c
+ * Volograms Reverse Play Benchmark
+ *
+ * vol_reverse_bench | Measures sustained frame rates playing a vologram backwards
+ * ----------------- | ---------------------
+ * Version           | 0.1.0
+ * Authors           | See vol_geom.h.
+ * Copyright         | 2021, Volograms (http://volograms.com/)
+ * Language          | C99
+ * Licence           | The MIT License. See LICENSE.md for details.
+ *
+ * Plays a video backwards with vol_av_read_frame_at_time(), one frame at a time, as fast as it will go, for a few seconds, wrapping from the
+ * first frame back to the last like a looping reverse player. It prints the sustained frames per second, with the same measured forwards
+ * for comparison, and the memory the reverse cache took. Run it with a few cache sizes to pick one: when a GOP doesn't fit, each refill
+ * decodes from the keyframe again.
+ *
+ * Given a geometry header and sequence too, the geometry is played backwards the way vol_interface.c does it: a tracked frame from another
+ * segment first loads the v12 "last tracked frame" that ends its segment, from vol_geom_find_reverse_keyframe(), for its indices and UVs.
+ * The sequence is streamed from disk, as a pre-loaded sequence costs next to nothing to read in any order.
+ *
+ * Usage:
+ *
+ *     vol_reverse_bench VIDEO.mp4 [CACHE_MB] [SECONDS] [HEADER.vols SEQUENCE.vols]
+ *
+ * Build:
+ *
+ *     cc -std=c99 -O2 -I../src vol_reverse_bench.c ../src/vol_av.c ../src/vol_geom.c -lavformat -lavcodec -lswscale -lswresample -lavutil \
+ *       -lpthread -lm -o vol_reverse_bench
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#define _POSIX_C_SOURCE 200809L // For vol_threads.h.
+#endif
+
+#include "vol_av.h"
+#include "vol_geom.h"
+#include "vol_threads.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Only errors are printed, so the results aren't mixed with vol_av's and vol_geom's progress messages. */
+static void _log_av_errors( vol_av_log_type_t log_type, const char* message_str ) {
+  if ( VOL_AV_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+static void _log_geom_errors( vol_geom_log_type_t log_type, const char* message_str ) {
+  if ( VOL_GEOM_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+/** Play the video for `seconds` of wall time, a frame at a time, forwards if `step` is 1 or backwards if it is -1.
+ * @return Frames per second, or 0 on error. */
+static double _play_video( vol_av_video_t* video_ptr, int64_t n_frames, double fps, int step, double seconds ) {
+  int64_t frame_idx = step > 0 ? 0 : n_frames - 1;
+  int64_t n_played  = 0;
+  double start_s    = _time_s();
+  while ( _time_s() - start_s < seconds ) {
+    // Half a frame in, so rounding never picks the neighbouring frame.
+    if ( !vol_av_read_frame_at_time( video_ptr, ( frame_idx + 0.5 ) / fps, false ) ) { return 0.0; }
+    n_played++;
+    frame_idx += step;
+    if ( frame_idx < 0 ) { frame_idx = n_frames - 1; }
+    if ( frame_idx >= n_frames ) { frame_idx = 0; }
+  }
+  return n_played / ( _time_s() - start_s );
+}
+
+/** Play the geometry backwards for `seconds` of wall time.
+ * @return Frames per second, or 0 on error. */
+static double _play_geom_reverse( const char* seq_filename, const vol_geom_info_t* info_ptr, double seconds, int* n_key_reads_ptr ) {
+  int n_frames = info_ptr->hdr.frame_count, frame_idx = n_frames - 1, segment_idx = -1, n_played = 0;
+  vol_geom_frame_data_t frame_data;
+  double start_s = _time_s();
+  while ( n_frames > 0 && _time_s() - start_s < seconds ) {
+    int frame_segment_idx = vol_geom_find_previous_keyframe( info_ptr, frame_idx );
+    if ( !vol_geom_is_keyframe( info_ptr, frame_idx ) && frame_segment_idx != segment_idx ) {
+      int key_idx = vol_geom_find_reverse_keyframe( info_ptr, frame_idx );
+      if ( key_idx < 0 ) { key_idx = frame_segment_idx; } // Older versions have no type-2 keyframes to come back in by.
+      if ( !vol_geom_read_frame( seq_filename, info_ptr, key_idx, &frame_data ) ) { return 0.0; }
+      ( *n_key_reads_ptr )++;
+    }
+    if ( !vol_geom_read_frame( seq_filename, info_ptr, frame_idx, &frame_data ) ) { return 0.0; }
+    segment_idx = frame_segment_idx;
+    n_played++;
+    frame_idx = frame_idx > 0 ? frame_idx - 1 : n_frames - 1;
+  }
+  return n_played / ( _time_s() - start_s );
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 2 ) {
+    printf( "Usage: %s VIDEO.mp4 [CACHE_MB] [SECONDS] [HEADER.vols SEQUENCE.vols]\n", argv[0] );
+    return 0;
+  }
+  int64_t cache_sz = (int64_t)( ( argc > 2 ? atof( argv[2] ) : 64.0 ) * 1024.0 * 1024.0 );
+  double seconds   = argc > 3 ? atof( argv[3] ) : 5.0;
+  int ret          = 1;
+  vol_av_video_t video;
+  vol_geom_info_t geom;
+  memset( &video, 0, sizeof( video ) );
+  memset( &geom, 0, sizeof( geom ) );
+
+  vol_av_set_log_callback( _log_av_errors );
+  vol_geom_set_log_callback( _log_geom_errors );
+  if ( !vol_av_open( argv[1], &video ) ) {
+    fprintf( stderr, "ERROR: could not open video `%s`\n", argv[1] );
+    return 1;
+  }
+  if ( !vol_av_set_reverse_cache_size( &video, cache_sz ) ) {
+    fprintf( stderr, "ERROR: could not set a reverse cache of %lli bytes\n", (long long)cache_sz );
+    goto cleanup;
+  }
+  double fps       = vol_av_frame_rate( &video );
+  int64_t n_frames = vol_av_frame_count( &video );
+  if ( fps <= 0.0 || n_frames <= 0 ) {
+    fprintf( stderr, "ERROR: the video has no frame rate or frame count\n" );
+    goto cleanup;
+  }
+
+  double forward_fps = _play_video( &video, n_frames, fps, 1, seconds );
+  double reverse_fps = _play_video( &video, n_frames, fps, -1, seconds );
+  if ( forward_fps <= 0.0 || reverse_fps <= 0.0 ) {
+    fprintf( stderr, "ERROR: failed to read a video frame\n" );
+    goto cleanup;
+  }
+  printf( "video    %lli frames at %.2f fps, reverse cache %.1f MB\n", (long long)n_frames, fps, cache_sz / ( 1024.0 * 1024.0 ) );
+  printf( "video    forward %.1f fps, reverse %.1f fps\n", forward_fps, reverse_fps );
+  printf( "video    %.1f MB of frame buffers after reverse play\n", vol_av_memory_usage( &video ) / ( 1024.0 * 1024.0 ) );
+
+  if ( argc > 5 ) {
+    if ( !vol_geom_create_file_info( argv[4], argv[5], &geom, true ) ) {
+      fprintf( stderr, "ERROR: could not open geometry `%s` `%s`\n", argv[4], argv[5] );
+      goto cleanup;
+    }
+    int n_key_reads = 0;
+    double geom_fps = _play_geom_reverse( argv[5], &geom, seconds, &n_key_reads );
+    if ( geom_fps <= 0.0 ) {
+      fprintf( stderr, "ERROR: failed to read a geometry frame\n" );
+      goto cleanup;
+    }
+    printf( "geometry %i frames, reverse %.1f fps, %i extra keyframe reads\n", geom.hdr.frame_count, geom_fps, n_key_reads );
+  }
+  ret = 0;
+
+cleanup:
+  if ( geom.frames_directory_ptr ) { vol_geom_free_file_info( &geom ); }
+  vol_av_close( &video );
+  return ret;
+}
@@ -0,0 +1,293 @@
+/** @file vol_scrub_check.c
+ * Volograms Scrub Check
+ *
+ * vol_scrub_check | Checks timeline scrubbing previews, their latency, and playing on after them
+ * --------------- | ---------------------
+ * Version         | 0.1.0
+ * Authors         | See vol_geom.h.
+ * Copyright       | 2021, Volograms (http://volograms.com/)
+ * Language        | C99
+ * Licence         | The MIT License. See LICENSE.md for details.
+ *
+ * Decodes every frame of a video at each output scale level first, as the reference. Then, at each scale level, it scrubs with
+ * vol_av_scrub_to_time() and native_vol_scrub_to_time(), first jumping backwards through the video, then dragging forwards a few frames at a
+ * time. Each preview must be the reference frame it says it is, no later than the time asked for, and at the scale level asked for.
+ * A backward jump costs one seek and one keyframe decode, and the slowest of those is the most a forward drag may run past MAX_LATENCY_S,
+ * as the keyframe it is decoding when time runs out is still shown. With a geometry sequence, native_vol_scrub_to_time() must also load the
+ * geometry keyframe at or before the frame shown.
+ * After a scrub, vol_av_read_next_frame() and the decode thread must carry on from the frame after the one shown, without showing it again.
+ *
+ * Usage:
+ *
+ *     vol_scrub_check VIDEO.mp4 [MAX_LATENCY_S] [HEADER.vols SEQUENCE.vols]
+ *
+ * Build:
+ *
+ *     cc -std=c99 -O2 -I../src vol_scrub_check.c ../src/vol_av.c ../src/vol_geom.c -lavformat -lavcodec -lswscale -lswresample -lavutil \
+ *       -lpthread -lm -o vol_scrub_check
+ */
+
+// The geometry frame loaded is internal to vol_interface.c, so it is built into this file.
+#include "../src/vol_interface.c"
+
+/// Backward jumps made at each scale level, evenly spread from the end of the video to the start.
+#define VOL_SCRUB_CHECK_JUMPS 8
+/// Frames the scrubber moves on by between calls when dragging forwards.
+#define VOL_SCRUB_CHECK_DRAG_FRAMES 2
+/// Leeway on the latency bound for the scheduler, in seconds.
+#define VOL_SCRUB_CHECK_SLACK_S 0.005
+/// Same as VOL_AV_PTS_TOLERANCE_S.
+#define VOL_SCRUB_CHECK_PTS_TOLERANCE_S 0.001
+
+static void _log_errors( vol_av_log_type_t log_type, const char* message_str ) {
+  if ( VOL_AV_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+static void _log_geom_errors( vol_geom_log_type_t log_type, const char* message_str ) {
+  if ( VOL_GEOM_LOG_TYPE_ERROR == log_type ) { fprintf( stderr, "%s", message_str ); }
+}
+
+/** Reference frames at one output scale level. */
+typedef struct vol_scrub_check_ref_t {
+  uint64_t* sums_ptr; /** Checksum of each frame's image, by frame index. */
+  bool* have_ptr;     /** The frame at that index was decoded. */
+  int w, h;
+} vol_scrub_check_ref_t;
+
+static uint64_t _checksum( const uint8_t* data_ptr, size_t sz ) {
+  uint64_t sum = 0;
+  for ( size_t i = 0; i < sz; i++ ) { sum = sum * 31 + data_ptr[i]; }
+  return sum;
+}
+
+/** Decode the whole video at output scale `level` into `ref_ptr`. */
+static bool _read_reference( const char* filename, int level, int64_t n_frames, vol_scrub_check_ref_t* ref_ptr ) {
+  vol_av_video_t video = { NULL };
+  if ( !vol_av_open( filename, &video ) || !vol_av_set_output_scale( &video, level ) ) {
+    vol_av_close( &video );
+    return false;
+  }
+  vol_av_output_dimensions( &video, &ref_ptr->w, &ref_ptr->h );
+  ref_ptr->sums_ptr = calloc( (size_t)n_frames, sizeof( uint64_t ) );
+  ref_ptr->have_ptr = calloc( (size_t)n_frames, sizeof( bool ) );
+  bool ok           = ref_ptr->sums_ptr && ref_ptr->have_ptr;
+  while ( ok && vol_av_read_next_frame( &video ) ) {
+    if ( video.frame_idx < 0 || video.frame_idx >= n_frames ) { continue; }
+    ref_ptr->sums_ptr[video.frame_idx] = _checksum( video.pixels_ptr, (size_t)video.w * video.h * 3 );
+    ref_ptr->have_ptr[video.frame_idx] = true;
+  }
+  vol_av_close( &video );
+  return ok;
+}
+
+/** Check a frame shown for time `pts_s` is the reference frame it says it is. */
+static bool _check_shown( const char* what_str, double pts_s, double shown_s, int64_t frame_idx, int w, int h, const uint8_t* pixels_ptr,
+  int64_t n_frames, const vol_scrub_check_ref_t* ref_ptr ) {
+  if ( shown_s > pts_s + VOL_SCRUB_CHECK_PTS_TOLERANCE_S ) {
+    fprintf( stderr, "ERROR: %s at %.3fs showed the later frame at %.3fs\n", what_str, pts_s, shown_s );
+    return false;
+  }
+  if ( w != ref_ptr->w || h != ref_ptr->h ) {
+    fprintf( stderr, "ERROR: %s at %.3fs gave %ix%i, not %ix%i\n", what_str, pts_s, w, h, ref_ptr->w, ref_ptr->h );
+    return false;
+  }
+  if ( frame_idx < 0 || frame_idx >= n_frames || !ref_ptr->have_ptr[frame_idx] ) {
+    fprintf( stderr, "ERROR: %s at %.3fs showed frame %lli, which the reference doesn't have\n", what_str, pts_s, (long long)frame_idx );
+    return false;
+  }
+  if ( _checksum( pixels_ptr, (size_t)w * h * 3 ) != ref_ptr->sums_ptr[frame_idx] ) {
+    fprintf( stderr, "ERROR: %s at %.3fs doesn't match frame %lli\n", what_str, pts_s, (long long)frame_idx );
+    return false;
+  }
+  return true;
+}
+
+/** Scrub `video_ptr` at scale `level`, with backward jumps and then a forward drag. */
+static bool _check_vol_av_scrub( vol_av_video_t* video_ptr, int level, double max_latency_s, int64_t n_frames, double fps,
+  const vol_scrub_check_ref_t* ref_ptr ) {
+  double duration_s = vol_av_duration_s( video_ptr );
+  double key_s      = 0.0;
+  for ( int i = 0; i < VOL_SCRUB_CHECK_JUMPS; i++ ) {
+    double pts_s   = duration_s * ( 1.0 - ( i + 0.5 ) / VOL_SCRUB_CHECK_JUMPS );
+    double start_s = _time_s();
+    if ( !vol_av_scrub_to_time( video_ptr, pts_s, false, level, max_latency_s ) ) {
+      fprintf( stderr, "ERROR: vol_av_scrub_to_time() failed jumping back to %.3fs\n", pts_s );
+      return false;
+    }
+    double took_s = _time_s() - start_s;
+    if ( took_s > key_s ) { key_s = took_s; }
+    if ( !_check_shown( "vol_av_scrub_to_time()", pts_s, video_ptr->pts_s, video_ptr->frame_idx, video_ptr->w, video_ptr->h, video_ptr->pixels_ptr,
+           n_frames, ref_ptr ) ) {
+      return false;
+    }
+  }
+
+  double max_s = 0.0;
+  for ( int64_t i = 0; i < n_frames; i += VOL_SCRUB_CHECK_DRAG_FRAMES ) {
+    double pts_s   = i / fps;
+    double start_s = _time_s();
+    if ( !vol_av_scrub_to_time( video_ptr, pts_s, false, level, max_latency_s ) ) {
+      fprintf( stderr, "ERROR: vol_av_scrub_to_time() failed dragging to %.3fs\n", pts_s );
+      return false;
+    }
+    double took_s = _time_s() - start_s;
+    if ( took_s > max_s ) { max_s = took_s; }
+    if ( took_s > max_latency_s + key_s + VOL_SCRUB_CHECK_SLACK_S ) {
+      fprintf( stderr, "ERROR: vol_av_scrub_to_time() took %.4fs dragging to %.3fs, with a limit of %.4fs and a keyframe costing %.4fs\n", took_s,
+        pts_s, max_latency_s, key_s );
+      return false;
+    }
+    if ( !_check_shown( "vol_av_scrub_to_time()", pts_s, video_ptr->pts_s, video_ptr->frame_idx, video_ptr->w, video_ptr->h, video_ptr->pixels_ptr,
+           n_frames, ref_ptr ) ) {
+      return false;
+    }
+  }
+  printf( "vol_av_scrub_to_time() level %i: keyframe %.4fs, drag %.4fs at most\n", level, key_s, max_s );
+  return true;
+}
+
+/** Scrub to `pts_s`, then check the next frame read, or acquired from the decode thread, is the one after the frame shown. */
+static bool _check_resume( vol_av_video_t* video_ptr, double pts_s, int level, bool decode_thread, int64_t n_frames,
+  const vol_scrub_check_ref_t* full_ref_ptr ) {
+  const char* what_str = decode_thread ? "the decode thread" : "vol_av_read_next_frame()";
+  if ( !vol_av_scrub_to_time( video_ptr, pts_s, false, level, 1.0 ) ) {
+    fprintf( stderr, "ERROR: vol_av_scrub_to_time() failed at %.3fs\n", pts_s );
+    return false;
+  }
+  int64_t shown_idx = video_ptr->frame_idx;
+  if ( shown_idx + 1 >= n_frames ) { return true; }
+
+  bool got = false;
+  if ( decode_thread ) {
+    if ( !vol_av_start_decode_thread( video_ptr, 3, false ) ) {
+      fprintf( stderr, "ERROR: could not start the decode thread after scrubbing\n" );
+      return false;
+    }
+    for ( int i = 0; i < 5000 && !got; i++ ) {
+      got = vol_av_acquire_frame( video_ptr, -1.0 );
+      if ( !got ) { _sleep_ms( 1 ); }
+    }
+  } else {
+    got = vol_av_read_next_frame( video_ptr );
+  }
+  bool ok = got && video_ptr->frame_idx == shown_idx + 1;
+  if ( !got ) {
+    fprintf( stderr, "ERROR: %s gave no frame after scrubbing to frame %lli\n", what_str, (long long)shown_idx );
+  } else if ( !ok ) {
+    fprintf( stderr, "ERROR: %s gave frame %lli after scrubbing to frame %lli\n", what_str, (long long)video_ptr->frame_idx, (long long)shown_idx );
+  } else {
+    ok = _check_shown( what_str, video_ptr->pts_s, video_ptr->pts_s, video_ptr->frame_idx, video_ptr->w, video_ptr->h, video_ptr->pixels_ptr,
+      n_frames, full_ref_ptr );
+  }
+  if ( decode_thread ) {
+    if ( got ) { vol_av_release_frame( video_ptr ); }
+    vol_av_stop_decode_thread( video_ptr );
+  }
+  return ok;
+}
+
+/** The same as _check_vol_av_scrub(), through vol_interface, which also loads the geometry keyframe if a sequence is open. */
+static bool _check_native_scrub( int level, double max_latency_s, int64_t n_frames, double fps, const vol_scrub_check_ref_t* ref_ptr ) {
+  double duration_s = vid_dur;
+  double key_s = 0.0, max_s = 0.0;
+  for ( int i = 0; i < VOL_SCRUB_CHECK_JUMPS + n_frames; i++ ) {
+    bool jumping   = i < VOL_SCRUB_CHECK_JUMPS;
+    double pts_s   = jumping ? duration_s * ( 1.0 - ( i + 0.5 ) / VOL_SCRUB_CHECK_JUMPS ) : ( i - VOL_SCRUB_CHECK_JUMPS ) / fps;
+    if ( !jumping && ( i - VOL_SCRUB_CHECK_JUMPS ) % VOL_SCRUB_CHECK_DRAG_FRAMES != 0 ) { continue; }
+    vol_interface_frame_result_t result;
+    double start_s = _time_s();
+    if ( !native_vol_scrub_to_time( pts_s, false, level, max_latency_s, &result ) ) {
+      fprintf( stderr, "ERROR: native_vol_scrub_to_time() failed at %.3fs\n", pts_s );
+      return false;
+    }
+    double took_s = _time_s() - start_s;
+    if ( jumping && took_s > key_s ) { key_s = took_s; }
+    if ( !jumping && took_s > max_s ) { max_s = took_s; }
+    if ( !jumping && took_s > max_latency_s + key_s + VOL_SCRUB_CHECK_SLACK_S ) {
+      fprintf( stderr, "ERROR: native_vol_scrub_to_time() took %.4fs dragging to %.3fs, with a limit of %.4fs and a keyframe costing %.4fs\n",
+        took_s, pts_s, max_latency_s, key_s );
+      return false;
+    }
+    // `result.frame_idx` stops at the last geometry frame, so the image is checked against the video's own frame index.
+    if ( !_check_shown( "native_vol_scrub_to_time()", pts_s, result.pts_s, video_file_ptr.frame_idx, result.w, result.h, result.pixels_ptr, n_frames,
+           ref_ptr ) ) {
+      return false;
+    }
+    if ( !geom.seq_filename ) { continue; }
+    int key_idx = vol_geom_find_previous_keyframe( &geom.info, result.frame_idx );
+    if ( geom.loaded_frame_idx != key_idx ) {
+      fprintf( stderr, "ERROR: native_vol_scrub_to_time() at frame %i loaded geometry frame %i, not keyframe %i\n", (int)result.frame_idx,
+        geom.loaded_frame_idx, key_idx );
+      return false;
+    }
+  }
+  printf( "native_vol_scrub_to_time() level %i: keyframe %.4fs, drag %.4fs at most\n", level, key_s, max_s );
+  return true;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 2 || argc == 4 ) {
+    printf( "Usage: %s VIDEO.mp4 [MAX_LATENCY_S] [HEADER.vols SEQUENCE.vols]\n", argv[0] );
+    return 0;
+  }
+  const char* video_filename = argv[1];
+  double max_latency_s       = argc > 2 ? atof( argv[2] ) : 0.02;
+  int ret                    = 1;
+  vol_scrub_check_ref_t refs[VOL_AV_OUTPUT_SCALE_MAX + 1];
+  memset( refs, 0, sizeof( refs ) );
+  vol_av_video_t video = { NULL };
+
+  vol_av_set_log_callback( _log_errors );
+  vol_geom_set_log_callback( _log_geom_errors );
+  if ( !vol_av_open( video_filename, &video ) ) {
+    fprintf( stderr, "ERROR: could not open video `%s`\n", video_filename );
+    return 1;
+  }
+  int64_t n_frames = vol_av_frame_count( &video );
+  double fps       = vol_av_frame_rate( &video );
+  if ( n_frames <= 0 || fps <= 0.0 ) {
+    fprintf( stderr, "ERROR: video `%s` has no frame count or frame rate\n", video_filename );
+    goto cleanup;
+  }
+  for ( int level = 0; level <= VOL_AV_OUTPUT_SCALE_MAX; level++ ) {
+    if ( !_read_reference( video_filename, level, n_frames, &refs[level] ) ) {
+      fprintf( stderr, "ERROR: could not decode the reference frames at scale level %i\n", level );
+      goto cleanup;
+    }
+  }
+
+  // The first scrub opens the keyframe decoder, which isn't part of the latency.
+  if ( !vol_av_scrub_to_time( &video, 0.0, false, 0, max_latency_s ) ) { goto cleanup; }
+  for ( int level = 0; level <= VOL_AV_OUTPUT_SCALE_MAX; level++ ) {
+    if ( !_check_vol_av_scrub( &video, level, max_latency_s, n_frames, fps, &refs[level] ) ) { goto cleanup; }
+    double mid_s = ( n_frames / 2 ) / fps;
+    if ( !_check_resume( &video, mid_s + ( level + 0.5 ) / fps, level, false, n_frames, &refs[0] ) ) { goto cleanup; }
+    if ( !_check_resume( &video, mid_s - ( level + 0.5 ) / fps, level, true, n_frames, &refs[0] ) ) { goto cleanup; }
+  }
+
+  if ( !native_vol_open_video_file( video_filename ) ) {
+    fprintf( stderr, "ERROR: vol_interface could not open video `%s`\n", video_filename );
+    goto cleanup;
+  }
+  if ( argc > 4 && !native_vol_open_geom_file( argv[3], argv[4], true ) ) {
+    fprintf( stderr, "ERROR: vol_interface could not open geometry `%s` `%s`\n", argv[3], argv[4] );
+    goto cleanup;
+  }
+  vol_interface_frame_result_t result;
+  if ( !native_vol_scrub_to_time( 0.0, false, 0, max_latency_s, &result ) ) { goto cleanup; }
+  for ( int level = 0; level <= VOL_AV_OUTPUT_SCALE_MAX; level++ ) {
+    if ( !_check_native_scrub( level, max_latency_s, n_frames, fps, &refs[level] ) ) { goto cleanup; }
+  }
+  printf( "Scrubbing ok\n" );
+  ret = 0;
+
+cleanup:
+  native_vol_free_geom_data();
+  native_vol_close_video_file();
+  vol_av_close( &video );
+  for ( int level = 0; level <= VOL_AV_OUTPUT_SCALE_MAX; level++ ) {
+    free( refs[level].sums_ptr );
+    free( refs[level].have_ptr );
+  }
+  return ret;
+}